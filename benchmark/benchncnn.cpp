@@ -14,10 +14,15 @@
 
 #include <float.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
-#ifdef _WIN32
 #include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
 #include <windows.h> // Sleep()
 #else
 #include <unistd.h> // sleep()
@@ -47,19 +52,186 @@ public:
     }
 };
 
+// tracks the live and peak bytes requested through the wrapped allocator
+class MemoryCountingAllocator : public ncnn::Allocator
+{
+public:
+    MemoryCountingAllocator(ncnn::Allocator* _allocator)
+        : allocator(_allocator), current(0), peak(0)
+    {
+    }
+
+    virtual void* fastMalloc(size_t size)
+    {
+        void* ptr = allocator->fastMalloc(size);
+
+        lock.lock();
+        sizes[ptr] = size;
+        current += size;
+        peak = std::max(peak, current);
+        lock.unlock();
+
+        return ptr;
+    }
+
+    virtual void fastFree(void* ptr)
+    {
+        lock.lock();
+        std::map<void*, size_t>::iterator it = sizes.find(ptr);
+        if (it != sizes.end())
+        {
+            current -= it->second;
+            sizes.erase(it);
+        }
+        lock.unlock();
+
+        allocator->fastFree(ptr);
+    }
+
+public:
+    ncnn::Allocator* allocator;
+    ncnn::Mutex lock;
+    std::map<void*, size_t> sizes;
+    size_t current;
+    size_t peak;
+};
+
+struct LayerTime
+{
+    int layer_index;
+    int typeindex;
+#if NCNN_STRING
+    std::string name;
+    std::string type;
+#endif // NCNN_STRING
+    double time;
+};
+
+struct BenchmarkResult
+{
+    std::string comment;
+    double time_min;
+    double time_max;
+    double time_avg;
+    double time_p50;
+    double time_p90;
+    double time_p99;
+    // inferences per second over all instances
+    double throughput;
+    // peak live blob and workspace bytes of all instances
+    size_t peak_memory;
+    // average per-layer time of one inference, in execution order
+    std::vector<LayerTime> layer_times;
+};
+
 static int g_warmup_loop_count = 8;
 static int g_loop_count = 4;
 static bool g_enable_cooling_down = true;
+static int g_instance_count = 1;
+static bool g_enable_layer_times = false;
 
 static ncnn::UnlockedPoolAllocator g_blob_pool_allocator;
 static ncnn::PoolAllocator g_workspace_pool_allocator;
 
+static std::vector<BenchmarkResult> g_results;
+
 #if NCNN_VULKAN
 static ncnn::VulkanDevice* g_vkdev = 0;
 static ncnn::VkAllocator* g_blob_vkallocator = 0;
 static ncnn::VkAllocator* g_staging_vkallocator = 0;
 #endif // NCNN_VULKAN
 
+// one extractor loop, instances share the net but own their allocators
+class BenchmarkInstance
+{
+public:
+    BenchmarkInstance(const ncnn::Net* _net, const ncnn::Mat& _in, ncnn::Allocator* blob_allocator, ncnn::Allocator* workspace_allocator)
+        : blob_counter(blob_allocator), workspace_counter(workspace_allocator), net(_net), in(_in)
+    {
+    }
+
+    void run()
+    {
+        const std::vector<const char*>& input_names = net->input_names();
+        const std::vector<const char*>& output_names = net->output_names();
+
+        times.resize(g_loop_count);
+
+        for (int i = 0; i < g_loop_count; i++)
+        {
+            double start = ncnn::get_current_time();
+
+            {
+                ncnn::Extractor ex = net->create_extractor();
+                ex.set_blob_allocator(&blob_counter);
+                ex.set_workspace_allocator(&workspace_counter);
+                ex.set_profiling(g_enable_layer_times);
+                ex.input(input_names[0], in);
+                ex.extract(output_names[0], out);
+
+                if (g_enable_layer_times)
+                {
+                    // sum by layer, the record order may change between runs on parallel layer forward
+                    const std::vector<ncnn::LayerProfile>& profiles = ex.layer_profiles();
+                    for (size_t j = 0; j < profiles.size(); j++)
+                    {
+                        const ncnn::LayerProfile& p = profiles[j];
+
+                        std::map<int, size_t>::iterator it = profiles_slot.find(p.layer_index);
+                        if (it == profiles_slot.end())
+                        {
+                            LayerTime lt;
+                            lt.layer_index = p.layer_index;
+                            lt.typeindex = p.typeindex;
+#if NCNN_STRING
+                            lt.name = p.name;
+                            lt.type = p.type;
+#endif // NCNN_STRING
+                            lt.time = 0.0;
+
+                            it = profiles_slot.insert(std::make_pair(p.layer_index, profiles_sum.size())).first;
+                            profiles_sum.push_back(lt);
+                        }
+
+                        profiles_sum[it->second].time += p.end - p.start;
+                    }
+                }
+            }
+
+            double end = ncnn::get_current_time();
+
+            times[i] = end - start;
+        }
+    }
+
+public:
+    // the counters outlive the mats allocated from them
+    MemoryCountingAllocator blob_counter;
+    MemoryCountingAllocator workspace_counter;
+    const ncnn::Net* net;
+    ncnn::Mat in;
+    ncnn::Mat out;
+    std::vector<double> times;
+    // in the order layers first ran
+    std::vector<LayerTime> profiles_sum;
+    std::map<int, size_t> profiles_slot;
+};
+
+#if NCNN_THREADS
+static void* benchmark_instance_worker(void* args)
+{
+    ((BenchmarkInstance*)args)->run();
+    return 0;
+}
+#endif // NCNN_THREADS
+
+static double percentile(const std::vector<double>& sorted_times, int p)
+{
+    // nearest rank
+    int rank = (int)((sorted_times.size() * p + 99) / 100);
+    return sorted_times[std::max(rank, 1) - 1];
+}
+
 void benchmark(const char* comment, const ncnn::Mat& _in, const ncnn::Option& opt)
 {
     ncnn::Mat in = _in;
@@ -93,9 +265,17 @@ void benchmark(const char* comment, const ncnn::Mat& _in, const ncnn::Option& op
 #define MODEL_DIR ""
 #endif
 
-    char parampath[256];
-    sprintf(parampath, MODEL_DIR "%s.param", comment);
-    net.load_param(parampath);
+    if (strlen(comment) > 6 && strcmp(comment + strlen(comment) - 6, ".param") == 0)
+    {
+        // custom model path given on command line
+        net.load_param(comment);
+    }
+    else
+    {
+        char parampath[256];
+        sprintf(parampath, MODEL_DIR "%s.param", comment);
+        net.load_param(parampath);
+    }
 
     DataReaderFromEmpty dr;
     net.load_model(dr);
@@ -130,32 +310,171 @@ void benchmark(const char* comment, const ncnn::Mat& _in, const ncnn::Option& op
         ex.extract(output_names[0], out);
     }
 
-    double time_min = DBL_MAX;
-    double time_max = -DBL_MAX;
-    double time_avg = 0;
+    // the global pool allocators are not shared across threads, so extra instances get their own
+    const int instance_count = opt.use_vulkan_compute ? 1 : g_instance_count;
+    ncnn::UnlockedPoolAllocator* blob_pool_allocators = new ncnn::UnlockedPoolAllocator[instance_count - 1];
+    ncnn::PoolAllocator* workspace_pool_allocators = new ncnn::PoolAllocator[instance_count - 1];
+    std::vector<BenchmarkInstance*> instances(instance_count);
+    for (int i = 0; i < instance_count; i++)
+    {
+        ncnn::Allocator* blob_allocator = &g_blob_pool_allocator;
+        ncnn::Allocator* workspace_allocator = &g_workspace_pool_allocator;
+        if (i > 0)
+        {
+            blob_pool_allocators[i - 1].set_size_compare_ratio(0.0f);
+            workspace_pool_allocators[i - 1].set_size_compare_ratio(0.5f);
+            blob_allocator = &blob_pool_allocators[i - 1];
+            workspace_allocator = &workspace_pool_allocators[i - 1];
+        }
+        instances[i] = new BenchmarkInstance(&net, in, blob_allocator, workspace_allocator);
+    }
+
+    double wall_start = ncnn::get_current_time();
 
-    for (int i = 0; i < g_loop_count; i++)
+#if NCNN_THREADS
+    std::vector<ncnn::Thread*> threads(instance_count - 1);
+    for (int i = 1; i < instance_count; i++)
     {
-        double start = ncnn::get_current_time();
+        threads[i - 1] = new ncnn::Thread(benchmark_instance_worker, (void*)instances[i]);
+    }
+#endif // NCNN_THREADS
+
+    // current thread runs the first instance
+    instances[0]->run();
 
+#if NCNN_THREADS
+    for (int i = 1; i < instance_count; i++)
+    {
+        threads[i - 1]->join();
+        delete threads[i - 1];
+    }
+#endif // NCNN_THREADS
+
+    double wall_end = ncnn::get_current_time();
+
+    BenchmarkResult result;
+    result.comment = comment;
+    result.peak_memory = 0;
+
+    std::vector<double> times;
+    for (int i = 0; i < instance_count; i++)
+    {
+        const BenchmarkInstance* instance = instances[i];
+        times.insert(times.end(), instance->times.begin(), instance->times.end());
+        result.peak_memory += instance->blob_counter.peak + instance->workspace_counter.peak;
+    }
+
+    std::sort(times.begin(), times.end());
+
+    result.time_min = times[0];
+    result.time_max = times[times.size() - 1];
+    result.time_avg = 0;
+    for (size_t i = 0; i < times.size(); i++)
+    {
+        result.time_avg += times[i];
+    }
+    result.time_avg /= times.size();
+    result.time_p50 = percentile(times, 50);
+    result.time_p90 = percentile(times, 90);
+    result.time_p99 = percentile(times, 99);
+    result.throughput = times.size() * 1000.0 / (wall_end - wall_start);
+
+    if (g_enable_layer_times)
+    {
+        result.layer_times = instances[0]->profiles_sum;
+        for (size_t i = 0; i < result.layer_times.size(); i++)
         {
-            ncnn::Extractor ex = net.create_extractor();
-            ex.input(input_names[0], in);
-            ex.extract(output_names[0], out);
+            result.layer_times[i].time /= g_loop_count;
         }
+    }
+
+    for (int i = 0; i < instance_count; i++)
+    {
+        delete instances[i];
+    }
+    delete[] blob_pool_allocators;
+    delete[] workspace_pool_allocators;
+
+    fprintf(stderr, "%20s  min = %7.2f  max = %7.2f  avg = %7.2f  p50 = %7.2f  p90 = %7.2f  p99 = %7.2f  fps = %7.2f  mem = %7.2fMB\n", comment,
+            result.time_min, result.time_max, result.time_avg, result.time_p50, result.time_p90, result.time_p99, result.throughput, result.peak_memory / 1024.0 / 1024.0);
 
-        double end = ncnn::get_current_time();
+    for (size_t i = 0; i < result.layer_times.size(); i++)
+    {
+        const LayerTime& lt = result.layer_times[i];
+#if NCNN_STRING
+        fprintf(stderr, "    %-24s %-30s %8.2lfms  %5.1f%%\n", lt.type.c_str(), lt.name.c_str(), lt.time, lt.time * 100.0 / result.time_avg);
+#else
+        fprintf(stderr, "    type %-19d layer %-24d %8.2lfms  %5.1f%%\n", lt.typeindex, lt.layer_index, lt.time, lt.time * 100.0 / result.time_avg);
+#endif // NCNN_STRING
+    }
+
+    g_results.push_back(result);
+}
+
+static int save_json_report(const char* path, int num_threads, int powersave, int gpu_device)
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", path);
+        return -1;
+    }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"loop_count\": %d,\n", g_loop_count);
+    fprintf(fp, "  \"num_threads\": %d,\n", num_threads);
+    fprintf(fp, "  \"powersave\": %d,\n", powersave);
+    fprintf(fp, "  \"gpu_device\": %d,\n", gpu_device);
+    fprintf(fp, "  \"instances\": %d,\n", g_instance_count);
+    fprintf(fp, "  \"models\": [\n");
+    for (size_t i = 0; i < g_results.size(); i++)
+    {
+        const BenchmarkResult& r = g_results[i];
 
-        double time = end - start;
+        fprintf(fp, "    {\"name\": ");
+        ncnn::fprint_json_string(fp, r.comment.c_str());
+        fprintf(fp, ", \"min\": %.3f, \"max\": %.3f, \"avg\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"throughput\": %.3f, \"peak_memory\": %lu",
+                r.time_min, r.time_max, r.time_avg, r.time_p50, r.time_p90, r.time_p99, r.throughput, (unsigned long)r.peak_memory);
 
-        time_min = std::min(time_min, time);
-        time_max = std::max(time_max, time);
-        time_avg += time;
+        fprintf(fp, ", \"layers\": [");
+        for (size_t j = 0; j < r.layer_times.size(); j++)
+        {
+            const LayerTime& lt = r.layer_times[j];
+            fprintf(fp, j == 0 ? "{" : ", {");
+            fprintf(fp, "\"index\": %d, \"typeindex\": %d", lt.layer_index, lt.typeindex);
+#if NCNN_STRING
+            fprintf(fp, ", \"name\": ");
+            ncnn::fprint_json_string(fp, lt.name.c_str());
+            fprintf(fp, ", \"type\": ");
+            ncnn::fprint_json_string(fp, lt.type.c_str());
+#endif // NCNN_STRING
+            fprintf(fp, ", \"time\": %.3f}", lt.time);
+        }
+        fprintf(fp, "]}%s\n", i + 1 == g_results.size() ? "" : ",");
     }
+    fprintf(fp, "  ]\n");
+    fprintf(fp, "}\n");
+
+    fclose(fp);
 
-    time_avg /= g_loop_count;
+    return 0;
+}
 
-    fprintf(stderr, "%20s  min = %7.2f  max = %7.2f  avg = %7.2f\n", comment, time_min, time_max, time_avg);
+static bool parse_shape(const char* s, ncnn::Mat& in)
+{
+    // [w,h,c] or [w,h] or [w]
+    int dims[3] = {0, 0, 0};
+    int n = sscanf(s, "[%d,%d,%d]", &dims[0], &dims[1], &dims[2]);
+    if (n == 3)
+        in.create(dims[0], dims[1], dims[2]);
+    else if (n == 2)
+        in.create(dims[0], dims[1]);
+    else if (n == 1)
+        in.create(dims[0]);
+    else
+        return false;
+
+    return true;
 }
 
 int main(int argc, char** argv)
@@ -187,6 +506,48 @@ int main(int argc, char** argv)
         cooling_down = atoi(argv[5]);
     }
 
+    // optional key=value arguments after the positional ones
+    const char* param_path = 0;
+    ncnn::Mat custom_in(224, 224, 3);
+    const char* json_path = 0;
+    for (int i = 6; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        if (strncmp(arg, "param=", 6) == 0)
+        {
+            param_path = arg + 6;
+        }
+        else if (strncmp(arg, "shape=", 6) == 0)
+        {
+            if (!parse_shape(arg + 6, custom_in))
+            {
+                fprintf(stderr, "invalid shape %s\n", arg + 6);
+                return -1;
+            }
+        }
+        else if (strncmp(arg, "instances=", 10) == 0)
+        {
+            g_instance_count = std::max(atoi(arg + 10), 1);
+        }
+        else if (strncmp(arg, "layers=", 7) == 0)
+        {
+            g_enable_layer_times = atoi(arg + 7) != 0;
+        }
+        else if (strncmp(arg, "json=", 5) == 0)
+        {
+            json_path = arg + 5;
+        }
+        else
+        {
+            fprintf(stderr, "unknown argument %s\n", arg);
+            return -1;
+        }
+    }
+
+#if !NCNN_THREADS
+    g_instance_count = 1;
+#endif
+
 #ifdef __EMSCRIPTEN__
     EM_ASM(
         FS.mkdir('/working');
@@ -248,6 +609,24 @@ int main(int argc, char** argv)
     fprintf(stderr, "powersave = %d\n", ncnn::get_cpu_powersave());
     fprintf(stderr, "gpu_device = %d\n", gpu_device);
     fprintf(stderr, "cooling_down = %d\n", (int)g_enable_cooling_down);
+    fprintf(stderr, "instances = %d\n", g_instance_count);
+
+    if (param_path)
+    {
+        benchmark(param_path, custom_in, opt);
+
+        if (json_path)
+        {
+            save_json_report(json_path, num_threads, powersave, gpu_device);
+        }
+
+#if NCNN_VULKAN
+        delete g_blob_vkallocator;
+        delete g_staging_vkallocator;
+#endif // NCNN_VULKAN
+
+        return 0;
+    }
 
     // run
     benchmark("squeezenet", ncnn::Mat(227, 227, 3), opt);
@@ -314,6 +693,11 @@ int main(int argc, char** argv)
 
     benchmark("nanodet_m", ncnn::Mat(320, 320, 3), opt);
 
+    if (json_path)
+    {
+        save_json_report(json_path, num_threads, powersave, gpu_device);
+    }
+
 #if NCNN_VULKAN
     delete g_blob_vkallocator;
     delete g_staging_vkallocator;
@@ -0,0 +1,155 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h> // Sleep()
+#else
+#include <time.h> // nanosleep()
+#endif
+
+#include "benchmark.h"
+#include "cpu.h"
+#include "layer.h"
+#include "mat.h"
+
+// the fork/join cost of the openmp runtime ncnn is built with
+// every loop forwards relu on one element per thread, so the time is the parallel region overhead
+
+static void sleep_ms(int ms)
+{
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    struct timespec ts;
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (ms % 1000) * 1000000;
+    nanosleep(&ts, &ts);
+#endif
+}
+
+// return the min and avg latency of one parallel region in us
+// idle_ms > 0 sleeps before each region so that the workers may fall asleep
+static void bench_fork_join(ncnn::Layer* relu, int num_threads, int loop_count, int idle_ms, double& time_min, double& time_avg)
+{
+    ncnn::Option opt;
+    opt.num_threads = num_threads;
+    opt.use_packing_layout = false;
+
+    // one channel per thread
+    ncnn::Mat m(1, 1, num_threads);
+    m.fill(1.f);
+
+    // warm up, spawns the worker threads
+    for (int i = 0; i < 10; i++)
+    {
+        relu->forward_inplace(m, opt);
+    }
+
+    time_min = DBL_MAX;
+    double time_sum = 0;
+    for (int i = 0; i < loop_count; i++)
+    {
+        if (idle_ms > 0)
+            sleep_ms(idle_ms);
+
+        double start = ncnn::get_current_time();
+        relu->forward_inplace(m, opt);
+        double end = ncnn::get_current_time();
+
+        double time = (end - start) * 1000;
+        time_min = time < time_min ? time : time_min;
+        time_sum += time;
+    }
+
+    time_avg = time_sum / loop_count;
+}
+
+int main(int argc, char** argv)
+{
+    int loop_count = 10000;
+    int max_threads = ncnn::get_cpu_count();
+    int idle_ms = 0;
+
+    if (argc >= 2)
+    {
+        loop_count = atoi(argv[1]);
+    }
+    if (argc >= 3)
+    {
+        max_threads = atoi(argv[2]);
+    }
+    if (argc >= 4)
+    {
+        idle_ms = atoi(argv[3]);
+    }
+
+    if (loop_count < 1 || max_threads < 1 || idle_ms < 0)
+    {
+        fprintf(stderr, "Usage: %s [loop count] [max threads] [idle ms]\n", argv[0]);
+        return -1;
+    }
+
+    ncnn::Layer* relu = ncnn::create_layer("ReLU");
+    {
+        ncnn::ParamDict pd;
+        relu->load_param(pd);
+
+        ncnn::Option opt;
+        relu->create_pipeline(opt);
+    }
+
+    fprintf(stderr, "loop_count = %d\n", loop_count);
+    fprintf(stderr, "max_threads = %d\n", max_threads);
+    fprintf(stderr, "idle_ms = %d\n", idle_ms);
+
+    const int blocktimes[] = {0, 1, 20, 200};
+    const int old_blocktime = ncnn::get_kmp_blocktime();
+
+    for (int i = 0; i < (int)(sizeof(blocktimes) / sizeof(blocktimes[0])); i++)
+    {
+        ncnn::set_kmp_blocktime(blocktimes[i]);
+
+        fprintf(stderr, "blocktime = %d ms%s\n", blocktimes[i], ncnn::get_kmp_blocktime() == blocktimes[i] ? "" : " (ignored by this openmp runtime)");
+
+        // 1 2 4 ... max_threads
+        for (int num_threads = 1;; num_threads *= 2)
+        {
+            if (num_threads > max_threads)
+                num_threads = max_threads;
+
+            double time_min;
+            double time_avg;
+            bench_fork_join(relu, num_threads, loop_count, idle_ms, time_min, time_avg);
+
+            fprintf(stderr, "  threads = %2d  min = %8.2f us  avg = %8.2f us\n", num_threads, time_min, time_avg);
+
+            if (num_threads == max_threads)
+                break;
+        }
+    }
+
+    ncnn::set_kmp_blocktime(old_blocktime);
+
+    {
+        ncnn::Option opt;
+        relu->destroy_pipeline(opt);
+    }
+    delete relu;
+
+    return 0;
+}
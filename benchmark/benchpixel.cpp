@@ -0,0 +1,376 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "cpu.h"
+#include "mat.h"
+
+struct pixel_bench_t
+{
+    const char* name;
+    int type;
+    int src_channels;
+    int dst_channels;
+    // source channel of each destination channel, -1 for opaque alpha, -2 for gray from the first three entries as r g b
+    int map[4];
+};
+
+static const pixel_bench_t g_from_pixels_bench[] = {
+    {"GRAY", ncnn::Mat::PIXEL_GRAY, 1, 1, {0}},
+    {"RGB", ncnn::Mat::PIXEL_RGB, 3, 3, {0, 1, 2}},
+    {"BGR2RGB", ncnn::Mat::PIXEL_BGR2RGB, 3, 3, {2, 1, 0}},
+    {"BGR2GRAY", ncnn::Mat::PIXEL_BGR2GRAY, 3, 1, {-2, 2, 1, 0}},
+    {"RGBA", ncnn::Mat::PIXEL_RGBA, 4, 4, {0, 1, 2, 3}},
+    {"RGBA2BGR", ncnn::Mat::PIXEL_RGBA2BGR, 4, 3, {2, 1, 0}},
+};
+
+static const pixel_bench_t g_to_pixels_bench[] = {
+    {"GRAY", ncnn::Mat::PIXEL_GRAY, 1, 1, {0}},
+    {"RGB", ncnn::Mat::PIXEL_RGB, 3, 3, {0, 1, 2}},
+    {"BGR2RGB", ncnn::Mat::PIXEL_BGR2RGB, 3, 3, {2, 1, 0}},
+    {"RGB2RGBA", ncnn::Mat::PIXEL_RGB2RGBA, 3, 4, {0, 1, 2, -1}},
+};
+
+// plain per-pixel conversion used as the scalar reference
+static void from_pixels_scalar(const unsigned char* pixels, int w, int h, const pixel_bench_t& b, ncnn::Mat& m)
+{
+    m.create(w, h, b.dst_channels);
+
+    for (int q = 0; q < b.dst_channels; q++)
+    {
+        float* ptr = m.channel(q);
+        for (int i = 0; i < w * h; i++)
+        {
+            const unsigned char* px = pixels + i * b.src_channels;
+            if (b.map[0] == -2)
+                ptr[i] = (float)((px[b.map[1]] * 77 + px[b.map[2]] * 150 + px[b.map[3]] * 29) >> 8);
+            else if (b.map[q] == -1)
+                ptr[i] = 255.f;
+            else
+                ptr[i] = (float)px[b.map[q]];
+        }
+    }
+}
+
+static void to_pixels_scalar(const ncnn::Mat& m, const pixel_bench_t& b, unsigned char* pixels)
+{
+    for (int i = 0; i < m.w * m.h; i++)
+    {
+        unsigned char* px = pixels + i * b.dst_channels;
+        for (int k = 0; k < b.dst_channels; k++)
+        {
+            if (b.map[k] == -1)
+            {
+                px[k] = 255;
+                continue;
+            }
+
+            int v = (int)m.channel(b.map[k])[i];
+            px[k] = (unsigned char)(v < 0 ? 0 : v > 255 ? 255 : v);
+        }
+    }
+}
+
+static bool mat_equal(const ncnn::Mat& a, const ncnn::Mat& b)
+{
+    if (a.w != b.w || a.h != b.h || a.c != b.c)
+        return false;
+
+    for (int q = 0; q < a.c; q++)
+    {
+        if (memcmp(a.channel(q), b.channel(q), a.w * a.h * sizeof(float)) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+template<typename T>
+static double bench_min_time(int loop_count, T func)
+{
+    // warm up
+    func();
+
+    double time_min = DBL_MAX;
+    for (int i = 0; i < loop_count; i++)
+    {
+        double start = ncnn::get_current_time();
+        func();
+        double end = ncnn::get_current_time();
+
+        double time = end - start;
+        time_min = time < time_min ? time : time_min;
+    }
+
+    return time_min;
+}
+
+struct from_pixels_scalar_func
+{
+    const unsigned char* pixels;
+    int w;
+    int h;
+    const pixel_bench_t* b;
+    ncnn::Mat* m;
+    void operator()() const
+    {
+        from_pixels_scalar(pixels, w, h, *b, *m);
+    }
+};
+
+struct from_pixels_func
+{
+    const unsigned char* pixels;
+    int w;
+    int h;
+    const pixel_bench_t* b;
+    const ncnn::Option* opt;
+    ncnn::Mat* m;
+    void operator()() const
+    {
+        *m = opt ? ncnn::Mat::from_pixels(pixels, b->type, w, h, *opt) : ncnn::Mat::from_pixels(pixels, b->type, w, h);
+    }
+};
+
+struct to_pixels_scalar_func
+{
+    const ncnn::Mat* m;
+    const pixel_bench_t* b;
+    unsigned char* pixels;
+    void operator()() const
+    {
+        to_pixels_scalar(*m, *b, pixels);
+    }
+};
+
+struct to_pixels_func
+{
+    const ncnn::Mat* m;
+    const pixel_bench_t* b;
+    const ncnn::Option* opt;
+    unsigned char* pixels;
+    void operator()() const
+    {
+        if (opt)
+            m->to_pixels(pixels, b->type, *opt);
+        else
+            m->to_pixels(pixels, b->type);
+    }
+};
+
+struct resize_normalize_separate_func
+{
+    const unsigned char* pixels;
+    int w;
+    int h;
+    int target_width;
+    int target_height;
+    const float* mean_vals;
+    const float* norm_vals;
+    ncnn::Mat* m;
+    void operator()() const
+    {
+        ncnn::Mat in = ncnn::Mat::from_pixels_resize(pixels, ncnn::Mat::PIXEL_BGR2RGB, w, h, target_width, target_height);
+        in.substract_mean_normalize(mean_vals, norm_vals);
+        *m = in;
+    }
+};
+
+struct resize_normalize_fused_func
+{
+    const unsigned char* pixels;
+    int w;
+    int h;
+    int target_width;
+    int target_height;
+    const float* mean_vals;
+    const float* norm_vals;
+    const ncnn::Option* opt;
+    ncnn::Mat* m;
+    void operator()() const
+    {
+        *m = ncnn::Mat::from_pixels_resize_normalize(pixels, ncnn::Mat::PIXEL_BGR2RGB, w, h, w * 3, target_width, target_height, mean_vals, norm_vals, 1, *opt);
+    }
+};
+
+struct resize_c3_func
+{
+    const unsigned char* pixels;
+    int w;
+    int h;
+    int target_width;
+    int target_height;
+    bool area;
+    const ncnn::Option* opt;
+    unsigned char* out;
+    void operator()() const
+    {
+        if (area)
+            ncnn::resize_area_c3(pixels, w, h, w * 3, out, target_width, target_height, target_width * 3, *opt);
+        else
+            ncnn::resize_bilinear_c3(pixels, w, h, w * 3, out, target_width, target_height, target_width * 3, *opt);
+    }
+};
+
+int main(int argc, char** argv)
+{
+    int w = 1920;
+    int h = 1080;
+    int loop_count = 8;
+    int num_threads = ncnn::get_big_cpu_count();
+    int target_size = 320;
+
+    if (argc >= 3)
+    {
+        w = atoi(argv[1]);
+        h = atoi(argv[2]);
+    }
+    if (argc >= 4)
+    {
+        loop_count = atoi(argv[3]);
+    }
+    if (argc >= 5)
+    {
+        num_threads = atoi(argv[4]);
+    }
+    if (argc >= 6)
+    {
+        target_size = atoi(argv[5]);
+    }
+
+    ncnn::Option opt;
+    opt.num_threads = num_threads;
+
+    fprintf(stderr, "size = %d x %d\n", w, h);
+    fprintf(stderr, "loop_count = %d\n", loop_count);
+    fprintf(stderr, "num_threads = %d\n", num_threads);
+    fprintf(stderr, "target_size = %d\n", target_size);
+
+    unsigned char* pixels = (unsigned char*)malloc((size_t)w * h * 4);
+    unsigned char* pixels_scalar = (unsigned char*)malloc((size_t)w * h * 4);
+    for (size_t i = 0; i < (size_t)w * h * 4; i++)
+    {
+        pixels[i] = (unsigned char)(rand() % 256);
+    }
+
+    int ret = 0;
+
+    fprintf(stderr, "%-18s %10s %10s %10s\n", "convert", "scalar", "simd", "simd-mt");
+    fprintf(stderr, "resize_normalize columns are separate passes, fused, fused-mt\n");
+    fprintf(stderr, "resize_c3 columns are bilinear, area, area-mt\n");
+
+    const int from_count = sizeof(g_from_pixels_bench) / sizeof(g_from_pixels_bench[0]);
+    for (int i = 0; i < from_count; i++)
+    {
+        const pixel_bench_t& b = g_from_pixels_bench[i];
+
+        ncnn::Mat m0;
+        ncnn::Mat m1;
+        ncnn::Mat m2;
+
+        from_pixels_scalar_func f0 = {pixels, w, h, &b, &m0};
+        from_pixels_func f1 = {pixels, w, h, &b, 0, &m1};
+        from_pixels_func f2 = {pixels, w, h, &b, &opt, &m2};
+
+        double t0 = bench_min_time(loop_count, f0);
+        double t1 = bench_min_time(loop_count, f1);
+        double t2 = bench_min_time(loop_count, f2);
+
+        bool ok = mat_equal(m0, m1) && mat_equal(m0, m2);
+        if (!ok)
+            ret = -1;
+
+        fprintf(stderr, "from %-13s %8.2fms %8.2fms %8.2fms%s\n", b.name, t0, t1, t2, ok ? "" : "  MISMATCH");
+    }
+
+    const int to_count = sizeof(g_to_pixels_bench) / sizeof(g_to_pixels_bench[0]);
+    for (int i = 0; i < to_count; i++)
+    {
+        const pixel_bench_t& b = g_to_pixels_bench[i];
+
+        ncnn::Mat m = ncnn::Mat::from_pixels(pixels, b.src_channels == 1 ? ncnn::Mat::PIXEL_GRAY : b.src_channels == 3 ? ncnn::Mat::PIXEL_RGB : ncnn::Mat::PIXEL_RGBA, w, h);
+
+        const size_t size = (size_t)w * h * b.dst_channels;
+
+        to_pixels_scalar_func f0 = {&m, &b, pixels_scalar};
+        double t0 = bench_min_time(loop_count, f0);
+
+        unsigned char* out = (unsigned char*)malloc(size);
+        to_pixels_func f1 = {&m, &b, 0, out};
+        double t1 = bench_min_time(loop_count, f1);
+        bool ok = memcmp(pixels_scalar, out, size) == 0;
+
+        to_pixels_func f2 = {&m, &b, &opt, out};
+        double t2 = bench_min_time(loop_count, f2);
+        ok = ok && memcmp(pixels_scalar, out, size) == 0;
+        free(out);
+
+        if (!ok)
+            ret = -1;
+
+        fprintf(stderr, "to   %-13s %8.2fms %8.2fms %8.2fms%s\n", b.name, t0, t1, t2, ok ? "" : "  MISMATCH");
+    }
+
+    {
+        // resize + normalize as separate passes against the fused pass
+        const float mean_vals[3] = {123.675f, 116.28f, 103.53f};
+        const float norm_vals[3] = {1 / 58.395f, 1 / 57.12f, 1 / 57.375f};
+
+        ncnn::Option opt1;
+        opt1.num_threads = 1;
+
+        ncnn::Mat m0;
+        ncnn::Mat m1;
+        ncnn::Mat m2;
+
+        resize_normalize_separate_func f0 = {pixels, w, h, target_size, target_size, mean_vals, norm_vals, &m0};
+        resize_normalize_fused_func f1 = {pixels, w, h, target_size, target_size, mean_vals, norm_vals, &opt1, &m1};
+        resize_normalize_fused_func f2 = {pixels, w, h, target_size, target_size, mean_vals, norm_vals, &opt, &m2};
+
+        double t0 = bench_min_time(loop_count, f0);
+        double t1 = bench_min_time(loop_count, f1);
+        double t2 = bench_min_time(loop_count, f2);
+
+        fprintf(stderr, "%-18s %8.2fms %8.2fms %8.2fms\n", "resize_normalize", t0, t1, t2);
+    }
+
+    {
+        ncnn::Option opt1;
+        opt1.num_threads = 1;
+
+        unsigned char* out = (unsigned char*)malloc((size_t)target_size * target_size * 3);
+
+        resize_c3_func f0 = {pixels, w, h, target_size, target_size, false, &opt1, out};
+        resize_c3_func f1 = {pixels, w, h, target_size, target_size, true, &opt1, out};
+        resize_c3_func f2 = {pixels, w, h, target_size, target_size, true, &opt, out};
+
+        double t0 = bench_min_time(loop_count, f0);
+        double t1 = bench_min_time(loop_count, f1);
+        double t2 = bench_min_time(loop_count, f2);
+
+        free(out);
+
+        fprintf(stderr, "%-18s %8.2fms %8.2fms %8.2fms\n", "resize_c3", t0, t1, t2);
+    }
+
+    free(pixels);
+    free(pixels_scalar);
+
+    return ret;
+}
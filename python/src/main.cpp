@@ -101,6 +101,27 @@ LayerFactoryDefine(7);
 LayerFactoryDefine(8);
 LayerFactoryDefine(9);
 
+// the inputs may view numpy buffers, hold the latest one of each blob with the extractor
+// feeding a blob again drops the previous one, so repeated input calls do not accumulate
+static void hold_extractor_input(py::object& ex, const py::object& blob, const py::object& in)
+{
+    if (!py::hasattr(ex, "_inputs"))
+    {
+        ex.attr("_inputs") = py::dict();
+    }
+
+    py::dict inputs = ex.attr("_inputs");
+    inputs[blob] = in;
+}
+
+static void drop_extractor_inputs(py::object& ex)
+{
+    if (py::hasattr(ex, "_inputs"))
+    {
+        py::delattr(ex, "_inputs");
+    }
+}
+
 PYBIND11_MODULE(ncnn, m)
 {
     auto atexit = py::module_::import("atexit");
@@ -238,12 +259,21 @@ PYBIND11_MODULE(ncnn, m)
 
     .def(py::init<const Mat&>(), py::arg("m"))
 
-    .def(py::init([](py::buffer const b) {
+    .def(py::init([](py::buffer const b, int elempack) {
         py::buffer_info info = b.request();
-        if (info.ndim > 3)
+
+        // the innermost axis holds the elempack lanes of a packed mat
+        const int ndim = elempack == 1 ? (int)info.ndim : (int)info.ndim - 1;
+        if (elempack < 1 || ndim < 1 || ndim > 3)
+        {
+            std::stringstream ss;
+            ss << "convert numpy.ndarray to ncnn.Mat only dims <=3 support now, but given " << info.ndim << " with elempack " << elempack;
+            pybind11::pybind11_fail(ss.str());
+        }
+        if (elempack != 1 && info.shape[info.ndim - 1] != elempack)
         {
             std::stringstream ss;
-            ss << "convert numpy.ndarray to ncnn.Mat only dims <=3 support now, but given " << info.ndim;
+            ss << "convert numpy.ndarray to ncnn.Mat with elempack " << elempack << " needs the last axis of size " << elempack << ", but given " << info.shape[info.ndim - 1];
             pybind11::pybind11_fail(ss.str());
         }
 
@@ -265,38 +295,64 @@ PYBIND11_MODULE(ncnn, m)
             elemsize = 1u;
         }
 
+        // share the buffer when it is c contiguous, otherwise copy it into a contiguous one
+        bool contiguous = true;
+        ssize_t stride = info.itemsize;
+        for (int i = (int)info.ndim - 1; i >= 0; i--)
+        {
+            if (info.shape[i] != 1 && info.strides[i] != stride)
+                contiguous = false;
+            stride *= info.shape[i];
+        }
+
+        py::object holder;
+        void* data = info.ptr;
+        if (!contiguous)
+        {
+            py::array array = py::array::ensure(b, py::array::c_style);
+            if (!array)
+                throw py::error_already_set();
+
+            holder = array;
+            data = array.request().ptr;
+        }
+
         Mat* v = nullptr;
-        if (info.ndim == 1)
+        if (ndim == 1)
         {
-            v = new Mat((int)info.shape[0], info.ptr, elemsize);
+            v = new Mat((int)info.shape[0], data, elemsize * elempack, elempack);
         }
-        else if (info.ndim == 2)
+        else if (ndim == 2)
         {
-            v = new Mat((int)info.shape[1], (int)info.shape[0], info.ptr, elemsize);
+            v = new Mat((int)info.shape[1], (int)info.shape[0], data, elemsize * elempack, elempack);
         }
-        else if (info.ndim == 3)
+        else if (ndim == 3)
         {
-            v = new Mat((int)info.shape[2], (int)info.shape[1], (int)info.shape[0], info.ptr, elemsize);
+            v = new Mat((int)info.shape[2], (int)info.shape[1], (int)info.shape[0], data, elemsize * elempack, elempack);
 
             // in ncnn, buffer to construct ncnn::Mat need align to ncnn::alignSize
             // with (w * h * elemsize, 16) / elemsize, but the buffer from numpy not
             // so we set the cstep as numpy's cstep
             v->cstep = (int)info.shape[2] * (int)info.shape[1];
         }
+
+        // the contiguous copy dies with this scope
+        if (!contiguous)
+        {
+            Mat* m = new Mat(v->clone());
+            delete v;
+            v = m;
+        }
         return v;
     }),
-    py::arg("array"))
+    py::arg("array"), py::arg("elempack") = 1,
+    py::keep_alive<1, 2>()) // the mat views the numpy buffer, keep the array alive
     .def_buffer([](Mat& m) -> py::buffer_info {
-        if (m.elemsize != 1 && m.elemsize != 2 && m.elemsize != 4)
-        {
-            std::stringstream ss;
-            ss << "convert ncnn.Mat to numpy.ndarray only elemsize 1, 2, 4 support now, but given " << m.elemsize;
-            pybind11::pybind11_fail(ss.str());
-        }
-        if (m.elempack != 1)
+        const size_t scalarsize = m.elempack ? m.elemsize / m.elempack : m.elemsize;
+        if (scalarsize != 1 && scalarsize != 2 && scalarsize != 4)
         {
             std::stringstream ss;
-            ss << "convert ncnn.Mat to numpy.ndarray only elempack 1 support now, but given " << m.elempack;
+            ss << "convert ncnn.Mat to numpy.ndarray only elemsize 1, 2, 4 support now, but given " << scalarsize;
             pybind11::pybind11_fail(ss.str());
         }
         std::string format = get_mat_format(m);
@@ -323,13 +379,20 @@ PYBIND11_MODULE(ncnn, m)
             strides.push_back(m.w * m.elemsize);
             strides.push_back(m.elemsize);
         }
+        // packed mat exposes its elempack lanes as the innermost axis
+        // unpack it with ncnn.convert_packing(mat, 1) for the plain layout
+        if (m.elempack != 1)
+        {
+            shape.push_back(m.elempack);
+            strides.push_back(scalarsize);
+        }
         return py::buffer_info(
-            m.data,     /* Pointer to buffer */
-            m.elemsize, /* Size of one scalar */
-            format,     /* Python struct-style format descriptor */
-            m.dims,     /* Number of dimensions */
-            shape,      /* Buffer dimensions */
-            strides     /* Strides (in bytes) for each index */
+            m.data,                /* Pointer to buffer */
+            scalarsize,            /* Size of one scalar */
+            format,                /* Python struct-style format descriptor */
+            (ssize_t)shape.size(), /* Number of dimensions */
+            shape,                 /* Buffer dimensions */
+            strides                /* Strides (in bytes) for each index */
         );
     })
     //.def("fill", (void (Mat::*)(int))(&Mat::fill), py::arg("v"))
@@ -452,55 +515,79 @@ PYBIND11_MODULE(ncnn, m)
     //convenient construct from pixel data
     .def_static(
     "from_pixels", [](py::buffer const b, int type, int w, int h, Allocator* allocator) {
-        return Mat::from_pixels((const unsigned char*)b.request().ptr, type, w, h, allocator);
+        py::buffer_info info = b.request();
+        py::gil_scoped_release release;
+        return Mat::from_pixels((const unsigned char*)info.ptr, type, w, h, allocator);
     },
     py::arg("array"), py::arg("type"), py::arg("w"), py::arg("h"), py::arg("allocator") = nullptr)
     .def_static(
     "from_pixels", [](py::buffer const b, int type, int w, int h, int stride, Allocator* allocator) {
-        return Mat::from_pixels((const unsigned char*)b.request().ptr, type, w, h, stride, allocator);
+        py::buffer_info info = b.request();
+        py::gil_scoped_release release;
+        return Mat::from_pixels((const unsigned char*)info.ptr, type, w, h, stride, allocator);
     },
     py::arg("array"), py::arg("type"), py::arg("w"), py::arg("h"), py::arg("stride"), py::arg("allocator") = nullptr)
     .def_static(
     "from_pixels_resize", [](py::buffer const b, int type, int w, int h, int target_width, int target_height, Allocator* allocator) {
-        return Mat::from_pixels_resize((const unsigned char*)b.request().ptr,
-                                       type, w, h, target_width, target_height, allocator);
+        py::buffer_info info = b.request();
+        py::gil_scoped_release release;
+        return Mat::from_pixels_resize((const unsigned char*)info.ptr, type, w, h, target_width, target_height, allocator);
     },
     py::arg("array"), py::arg("type"), py::arg("w"), py::arg("h"), py::arg("target_width"), py::arg("target_height"), py::arg("allocator") = nullptr)
     .def_static(
     "from_pixels_resize", [](py::buffer const b, int type, int w, int h, int stride, int target_width, int target_height, Allocator* allocator) {
-        return Mat::from_pixels_resize((const unsigned char*)b.request().ptr,
-                                       type, w, h, stride, target_width, target_height, allocator);
+        py::buffer_info info = b.request();
+        py::gil_scoped_release release;
+        return Mat::from_pixels_resize((const unsigned char*)info.ptr, type, w, h, stride, target_width, target_height, allocator);
     },
     py::arg("array"), py::arg("type"), py::arg("w"), py::arg("h"), py::arg("stride"), py::arg("target_width"), py::arg("target_height"), py::arg("allocator") = nullptr)
     .def_static(
     "from_pixels_roi", [](py::buffer const b, int type, int w, int h, int roix, int roiy, int roiw, int roih, Allocator* allocator) {
-        return Mat::from_pixels_roi((const unsigned char*)b.request().ptr,
-                                    type, w, h, roix, roiy, roiw, roih, allocator);
+        py::buffer_info info = b.request();
+        py::gil_scoped_release release;
+        return Mat::from_pixels_roi((const unsigned char*)info.ptr, type, w, h, roix, roiy, roiw, roih, allocator);
     },
     py::arg("array"), py::arg("type"), py::arg("w"), py::arg("h"), py::arg("roix"), py::arg("roiy"), py::arg("roiw"), py::arg("roih"), py::arg("allocator") = nullptr)
     .def_static(
     "from_pixels_roi", [](py::buffer const b, int type, int w, int h, int stride, int roix, int roiy, int roiw, int roih, Allocator* allocator) {
-        return Mat::from_pixels_roi((const unsigned char*)b.request().ptr,
-                                    type, w, h, stride, roix, roiy, roiw, roih, allocator);
+        py::buffer_info info = b.request();
+        py::gil_scoped_release release;
+        return Mat::from_pixels_roi((const unsigned char*)info.ptr, type, w, h, stride, roix, roiy, roiw, roih, allocator);
     },
     py::arg("array"), py::arg("type"), py::arg("w"), py::arg("h"), py::arg("stride"), py::arg("roix"), py::arg("roiy"), py::arg("roiw"), py::arg("roih"), py::arg("allocator") = nullptr)
     .def_static(
     "from_pixels_roi_resize", [](py::buffer const b, int type, int w, int h, int roix, int roiy, int roiw, int roih, int target_width, int target_height, Allocator* allocator) {
-        return Mat::from_pixels_roi_resize((const unsigned char*)b.request().ptr,
-                                           type, w, h, roix, roiy, roiw, roih, target_width, target_height, allocator);
+        py::buffer_info info = b.request();
+        py::gil_scoped_release release;
+        return Mat::from_pixels_roi_resize((const unsigned char*)info.ptr, type, w, h, roix, roiy, roiw, roih, target_width, target_height, allocator);
     },
     py::arg("array"), py::arg("type"), py::arg("w"), py::arg("h"), py::arg("roix"), py::arg("roiy"), py::arg("roiw"), py::arg("roih"), py::arg("target_width"), py::arg("target_height"), py::arg("allocator") = nullptr)
     .def_static(
     "from_pixels_roi_resize", [](py::buffer const b, int type, int w, int h, int stride, int roix, int roiy, int roiw, int roih, int target_width, int target_height, Allocator* allocator) {
-        return Mat::from_pixels_roi_resize((const unsigned char*)b.request().ptr,
-                                           type, w, h, stride, roix, roiy, roiw, roih, target_width, target_height, allocator);
+        py::buffer_info info = b.request();
+        py::gil_scoped_release release;
+        return Mat::from_pixels_roi_resize((const unsigned char*)info.ptr, type, w, h, stride, roix, roiy, roiw, roih, target_width, target_height, allocator);
     },
     py::arg("array"), py::arg("type"), py::arg("w"), py::arg("h"), py::arg("stride"), py::arg("roix"), py::arg("roiy"), py::arg("roiw"), py::arg("roih"), py::arg("target_width"), py::arg("target_height"), py::arg("allocator") = nullptr)
     .def(
     "substract_mean_normalize", [](Mat& mat, std::vector<float>& mean, std::vector<float>& norm) {
         return mat.substract_mean_normalize(mean.size() > 0 ? &mean[0] : 0, norm.size() > 0 ? &norm[0] : 0);
     },
-    py::arg("mean"), py::arg("norm"))
+    py::arg("mean"), py::arg("norm"), py::call_guard<py::gil_scoped_release>())
+    .def(
+    "to_pixels", [](Mat& mat, py::buffer b, int type) {
+        py::buffer_info info = b.request(true);
+        py::gil_scoped_release release;
+        mat.to_pixels((unsigned char*)info.ptr, type);
+    },
+    py::arg("array"), py::arg("type"))
+    .def(
+    "to_pixels", [](Mat& mat, py::buffer b, int type, int stride) {
+        py::buffer_info info = b.request(true);
+        py::gil_scoped_release release;
+        mat.to_pixels((unsigned char*)info.ptr, type, stride);
+    },
+    py::arg("array"), py::arg("type"), py::arg("stride"))
     .def_readwrite("refcount", &Mat::refcount)
     .def_readwrite("elemsize", &Mat::elemsize)
     .def_readwrite("elempack", &Mat::elempack)
@@ -733,6 +820,9 @@ PYBIND11_MODULE(ncnn, m)
     .value("PIXEL_GRAY", ncnn::Mat::PixelType::PIXEL_GRAY)
     .value("PIXEL_RGBA", ncnn::Mat::PixelType::PIXEL_RGBA)
     .value("PIXEL_BGRA", ncnn::Mat::PixelType::PIXEL_BGRA)
+    .value("PIXEL_NV21", ncnn::Mat::PixelType::PIXEL_NV21)
+    .value("PIXEL_NV12", ncnn::Mat::PixelType::PIXEL_NV12)
+    .value("PIXEL_I420", ncnn::Mat::PixelType::PIXEL_I420)
 
     .value("PIXEL_RGB2BGR", ncnn::Mat::PixelType::PIXEL_RGB2BGR)
     .value("PIXEL_RGB2GRAY", ncnn::Mat::PixelType::PIXEL_RGB2GRAY)
@@ -757,38 +847,101 @@ PYBIND11_MODULE(ncnn, m)
     .value("PIXEL_BGRA2RGB", ncnn::Mat::PixelType::PIXEL_BGRA2RGB)
     .value("PIXEL_BGRA2BGR", ncnn::Mat::PixelType::PIXEL_BGRA2BGR)
     .value("PIXEL_BGRA2GRAY", ncnn::Mat::PixelType::PIXEL_BGRA2GRAY)
-    .value("PIXEL_BGRA2RGBA", ncnn::Mat::PixelType::PIXEL_BGRA2RGBA);
+    .value("PIXEL_BGRA2RGBA", ncnn::Mat::PixelType::PIXEL_BGRA2RGBA)
 
-    py::class_<Extractor>(m, "Extractor")
+    .value("PIXEL_NV212RGB", ncnn::Mat::PixelType::PIXEL_NV212RGB)
+    .value("PIXEL_NV212BGR", ncnn::Mat::PixelType::PIXEL_NV212BGR)
+    .value("PIXEL_NV122RGB", ncnn::Mat::PixelType::PIXEL_NV122RGB)
+    .value("PIXEL_NV122BGR", ncnn::Mat::PixelType::PIXEL_NV122BGR)
+    .value("PIXEL_I4202RGB", ncnn::Mat::PixelType::PIXEL_I4202RGB)
+    .value("PIXEL_I4202BGR", ncnn::Mat::PixelType::PIXEL_I4202BGR);
+
+    py::class_<Extractor>(m, "Extractor", py::dynamic_attr())
     .def("__enter__", [](Extractor& ex) -> Extractor& { return ex; })
-    .def("__exit__", [](Extractor& ex, pybind11::args) {
-        ex.clear();
+    .def("__exit__", [](py::object self, pybind11::args) {
+        self.cast<Extractor&>().clear();
+        drop_extractor_inputs(self);
+    })
+    .def("clear", [](py::object self) {
+        self.cast<Extractor&>().clear();
+        drop_extractor_inputs(self);
     })
-    .def("clear", &Extractor::clear)
     .def("set_light_mode", &Extractor::set_light_mode, py::arg("enable"))
     .def("set_num_threads", &Extractor::set_num_threads, py::arg("num_threads"))
     .def("set_blob_allocator", &Extractor::set_blob_allocator, py::arg("allocator"))
     .def("set_workspace_allocator", &Extractor::set_workspace_allocator, py::arg("allocator"))
+    // inputs may view numpy buffers, the latest one of each blob is held by the extractor
+    // extract releases the gil, so python threads with their own extractors run in parallel
 #if NCNN_STRING
-    .def("input", (int (Extractor::*)(const char*, const Mat&)) & Extractor::input, py::arg("blob_name"), py::arg("in"))
-    .def("extract", (int (Extractor::*)(const char*, Mat&, int)) & Extractor::extract, py::arg("blob_name"), py::arg("feat"), py::arg("type") = 0)
+    .def(
+    "input", [](py::object self, const char* blob_name, py::object in) {
+        int ret = self.cast<Extractor&>().input(blob_name, in.cast<const Mat&>());
+        hold_extractor_input(self, py::str(blob_name), in);
+        return ret;
+    },
+    py::arg("blob_name"), py::arg("in"))
+    .def("extract", (int (Extractor::*)(const char*, Mat&, int)) & Extractor::extract, py::arg("blob_name"), py::arg("feat"), py::arg("type") = 0,
+         py::call_guard<py::gil_scoped_release>())
     .def(
     "extract", [](Extractor& ex, const char* blob_name, int type) {
         ncnn::Mat feat;
         int ret = ex.extract(blob_name, feat, type);
-        return py::make_tuple(ret, feat.clone());
+        return std::make_pair(ret, feat.clone());
+    },
+    py::arg("blob_name"), py::arg("type") = 0, py::call_guard<py::gil_scoped_release>())
+    .def(
+    "input_batch", [](py::object self, const char* blob_name, py::object in_batch) {
+        int ret = self.cast<Extractor&>().input(blob_name, in_batch.cast<std::vector<Mat> >());
+        hold_extractor_input(self, py::str(blob_name), in_batch);
+        return ret;
     },
-    py::arg("blob_name"), py::arg("type") = 0)
+    py::arg("blob_name"), py::arg("in_batch"))
+    .def(
+    "extract_batch", [](Extractor& ex, const char* blob_name, int type) {
+        std::vector<ncnn::Mat> feat_batch;
+        int ret = ex.extract(blob_name, feat_batch, type);
+        for (size_t i = 0; i < feat_batch.size(); i++)
+        {
+            feat_batch[i] = feat_batch[i].clone();
+        }
+        return std::make_pair(ret, feat_batch);
+    },
+    py::arg("blob_name"), py::arg("type") = 0, py::call_guard<py::gil_scoped_release>())
 #endif
-    .def("input", (int (Extractor::*)(int, const Mat&)) & Extractor::input)
-    .def("extract", (int (Extractor::*)(int, Mat&, int)) & Extractor::extract, py::arg("blob_index"), py::arg("feat"), py::arg("type") = 0)
+    .def(
+    "input", [](py::object self, int blob_index, py::object in) {
+        int ret = self.cast<Extractor&>().input(blob_index, in.cast<const Mat&>());
+        hold_extractor_input(self, py::int_(blob_index), in);
+        return ret;
+    },
+    py::arg("blob_index"), py::arg("in"))
+    .def("extract", (int (Extractor::*)(int, Mat&, int)) & Extractor::extract, py::arg("blob_index"), py::arg("feat"), py::arg("type") = 0,
+         py::call_guard<py::gil_scoped_release>())
     .def(
     "extract", [](Extractor& ex, int blob_index, int type) {
         ncnn::Mat feat;
         int ret = ex.extract(blob_index, feat, type);
-        return py::make_tuple(ret, feat.clone());
+        return std::make_pair(ret, feat.clone());
+    },
+    py::arg("blob_index"), py::arg("type") = 0, py::call_guard<py::gil_scoped_release>())
+    .def(
+    "input_batch", [](py::object self, int blob_index, py::object in_batch) {
+        int ret = self.cast<Extractor&>().input(blob_index, in_batch.cast<std::vector<Mat> >());
+        hold_extractor_input(self, py::int_(blob_index), in_batch);
+        return ret;
     },
-    py::arg("blob_index"), py::arg("type") = 0);
+    py::arg("blob_index"), py::arg("in_batch"))
+    .def(
+    "extract_batch", [](Extractor& ex, int blob_index, int type) {
+        std::vector<ncnn::Mat> feat_batch;
+        int ret = ex.extract(blob_index, feat_batch, type);
+        for (size_t i = 0; i < feat_batch.size(); i++)
+        {
+            feat_batch[i] = feat_batch[i].clone();
+        }
+        return std::make_pair(ret, feat_batch);
+    },
+    py::arg("blob_index"), py::arg("type") = 0, py::call_guard<py::gil_scoped_release>());
 
     py::class_<Layer, PyLayer>(m, "Layer")
     .def(py::init<>())
@@ -804,14 +957,15 @@ PYBIND11_MODULE(ncnn, m)
     .def_readwrite("support_fp16_storage", &Layer::support_fp16_storage)
     .def_readwrite("support_image_storage", &Layer::support_image_storage)
     .def_readwrite("support_weight_fp16_storage", &Layer::support_weight_fp16_storage)
+    .def_readwrite("support_avx512_pack16", &Layer::support_avx512_pack16)
     .def("forward", (int (Layer::*)(const std::vector<Mat>&, std::vector<Mat>&, const Option&) const) & Layer::forward,
-         py::arg("bottom_blobs"), py::arg("top_blobs"), py::arg("opt"))
+         py::arg("bottom_blobs"), py::arg("top_blobs"), py::arg("opt"), py::call_guard<py::gil_scoped_release>())
     .def("forward", (int (Layer::*)(const Mat&, Mat&, const Option&) const) & Layer::forward,
-         py::arg("bottom_blob"), py::arg("top_blob"), py::arg("opt"))
+         py::arg("bottom_blob"), py::arg("top_blob"), py::arg("opt"), py::call_guard<py::gil_scoped_release>())
     .def("forward_inplace", (int (Layer::*)(std::vector<Mat>&, const Option&) const) & Layer::forward_inplace,
-         py::arg("bottom_top_blobs"), py::arg("opt"))
+         py::arg("bottom_top_blobs"), py::arg("opt"), py::call_guard<py::gil_scoped_release>())
     .def("forward_inplace", (int (Layer::*)(Mat&, const Option&) const) & Layer::forward_inplace,
-         py::arg("bottom_top_blob"), py::arg("opt"))
+         py::arg("bottom_top_blob"), py::arg("opt"), py::call_guard<py::gil_scoped_release>())
     .def_readwrite("typeindex", &Layer::typeindex)
 #if NCNN_STRING
     .def_readwrite("type", &Layer::type)
@@ -868,18 +1022,19 @@ PYBIND11_MODULE(ncnn, m)
         return net.register_custom_layer(index, lf.creator_func, lf.destroyer_func);
     },
     py::arg("index"), py::arg("creator"), py::arg("destroyer"))
+    // loading releases the gil, python data readers and custom layers take it back when called
 #if NCNN_STRING
-    .def("load_param", (int (Net::*)(const DataReader&)) & Net::load_param, py::arg("dr"))
+    .def("load_param", (int (Net::*)(const DataReader&)) & Net::load_param, py::arg("dr"), py::call_guard<py::gil_scoped_release>())
 #endif // NCNN_STRING
-    .def("load_param_bin", (int (Net::*)(const DataReader&)) & Net::load_param_bin, py::arg("dr"))
-    .def("load_model", (int (Net::*)(const DataReader&)) & Net::load_model, py::arg("dr"))
+    .def("load_param_bin", (int (Net::*)(const DataReader&)) & Net::load_param_bin, py::arg("dr"), py::call_guard<py::gil_scoped_release>())
+    .def("load_model", (int (Net::*)(const DataReader&)) & Net::load_model, py::arg("dr"), py::call_guard<py::gil_scoped_release>())
 
 #if NCNN_STDIO
 #if NCNN_STRING
-    .def("load_param", (int (Net::*)(const char*)) & Net::load_param, py::arg("protopath"))
+    .def("load_param", (int (Net::*)(const char*)) & Net::load_param, py::arg("protopath"), py::call_guard<py::gil_scoped_release>())
 #endif // NCNN_STRING
-    .def("load_param_bin", (int (Net::*)(const char*)) & Net::load_param_bin, py::arg("protopath"))
-    .def("load_model", (int (Net::*)(const char*)) & Net::load_model, py::arg("modelpath"))
+    .def("load_param_bin", (int (Net::*)(const char*)) & Net::load_param_bin, py::arg("protopath"), py::call_guard<py::gil_scoped_release>())
+    .def("load_model", (int (Net::*)(const char*)) & Net::load_model, py::arg("modelpath"), py::call_guard<py::gil_scoped_release>())
 #endif // NCNN_STDIO
 
     .def("clear", &Net::clear)
@@ -902,6 +1057,10 @@ PYBIND11_MODULE(ncnn, m)
     m.def("cpu_support_arm_neon", &cpu_support_arm_neon);
     m.def("cpu_support_arm_vfpv4", &cpu_support_arm_vfpv4);
     m.def("cpu_support_arm_asimdhp", &cpu_support_arm_asimdhp);
+    m.def("cpu_support_x86_avx512", &cpu_support_x86_avx512);
+    m.def("cpu_support_x86_avx512_vnni", &cpu_support_x86_avx512_vnni);
+    m.def("cpu_support_x86_avx512_bf16", &cpu_support_x86_avx512_bf16);
+    m.def("cpu_support_x86_avx_vnni", &cpu_support_x86_avx_vnni);
     m.def("cpu_support_x86_avx2", &cpu_support_x86_avx2);
     m.def("cpu_support_x86_avx", &cpu_support_x86_avx);
     m.def("get_cpu_count", &get_cpu_count);
@@ -965,7 +1124,7 @@ PYBIND11_MODULE(ncnn, m)
     m.def("resize_bilinear", &resize_bilinear,
           py::arg("src"), py::arg("dst"),
           py::arg("w"), py::arg("h"),
-          py::arg("opt") = Option());
+          py::arg("opt") = Option(), py::call_guard<py::gil_scoped_release>());
     m.def(
         "resize_bilinear",
     [](const Mat& src, int w, int h, const Option& opt) {
@@ -975,7 +1134,7 @@ PYBIND11_MODULE(ncnn, m)
     },
     py::arg("src"),
     py::arg("w"), py::arg("h"),
-    py::arg("opt") = Option());
+    py::arg("opt") = Option(), py::call_guard<py::gil_scoped_release>());
 
     m.def("resize_bicubic", &resize_bicubic,
           py::arg("src"), py::arg("dst"),
@@ -995,7 +1154,7 @@ PYBIND11_MODULE(ncnn, m)
     m.def("convert_packing", &convert_packing,
           py::arg("src"), py::arg("dst"),
           py::arg("elempack"),
-          py::arg("opt") = Option());
+          py::arg("opt") = Option(), py::call_guard<py::gil_scoped_release>());
     m.def(
         "convert_packing",
     [](const Mat& src, int elempack, const Option& opt) {
@@ -1005,7 +1164,7 @@ PYBIND11_MODULE(ncnn, m)
     },
     py::arg("src"),
     py::arg("elempack"),
-    py::arg("opt") = Option());
+    py::arg("opt") = Option(), py::call_guard<py::gil_scoped_release>());
 
     m.def("flatten", &flatten,
           py::arg("src"), py::arg("dst"),
@@ -25,16 +25,17 @@
 std::string get_mat_format(const ncnn::Mat& m)
 {
     std::string format;
-    if (m.elemsize == 4)
+    const size_t elemsize = m.elempack ? m.elemsize / m.elempack : m.elemsize;
+    if (elemsize == 4)
     {
         format = pybind11::format_descriptor<float>::format();
     }
-    if (m.elemsize == 2)
+    if (elemsize == 2)
     {
         // see https://docs.python.org/3/library/struct.html#format-characters
         format = "e";
     }
-    if (m.elemsize == 1)
+    if (elemsize == 1)
     {
         format = pybind11::format_descriptor<int8_t>::format();
     }
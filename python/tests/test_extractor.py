@@ -12,6 +12,10 @@
 # CONDITIONS OF ANY KIND, either express or implied. See the License for the
 # specific language governing permissions and limitations under the License.
 
+import sys
+import threading
+
+import numpy as np
 import pytest
 
 import ncnn
@@ -84,3 +88,93 @@ def test_extractor_index():
 
     # not use with sentence, call clear manually to ensure ex destruct before net
     ex.clear()
+
+
+def test_extractor_batch():
+    dr = ncnn.DataReaderFromEmpty()
+
+    net = ncnn.Net()
+    net.load_param("tests/test.param")
+    net.load_model(dr)
+
+    in_mats = [
+        ncnn.Mat(np.random.rand(3, 227, 227).astype(np.float32)) for _ in range(4)
+    ]
+    with net.create_extractor() as ex:
+        ex.input_batch("data", in_mats)
+        ret, out_mats = ex.extract_batch("conv0_fwd")
+        assert ret == 0 and len(out_mats) == 4
+        for out_mat in out_mats:
+            assert (
+                out_mat.dims == 3
+                and out_mat.w == 225
+                and out_mat.h == 225
+                and out_mat.c == 3
+            )
+
+    with net.create_extractor() as ex:
+        ex.input_batch(0, in_mats)
+        ret, out_mats = ex.extract_batch(2)
+        assert ret == 0 and len(out_mats) == 4 and out_mats[0].w == 1
+
+
+def test_extractor_threads():
+    dr = ncnn.DataReaderFromEmpty()
+
+    net = ncnn.Net()
+    net.load_param("tests/test.param")
+    net.load_model(dr)
+
+    in_mat = ncnn.Mat(np.random.rand(3, 227, 227).astype(np.float32))
+    with net.create_extractor() as ex:
+        ex.input("data", in_mat)
+        ret, ref_mat = ex.extract("conv0_fwd")
+        assert ret == 0
+    ref = np.array(ref_mat)
+
+    # extract releases the gil, every thread owns its extractor
+    results = [None] * 4
+
+    def run(i):
+        with net.create_extractor() as ex:
+            ex.set_num_threads(1)
+            ex.input("data", in_mat)
+            ret, out_mat = ex.extract("conv0_fwd")
+            results[i] = ret == 0 and (np.array(out_mat) == ref).all()
+
+    threads = [threading.Thread(target=run, args=(i,)) for i in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+
+    assert all(results)
+
+
+def test_extractor_input_replace():
+    dr = ncnn.DataReaderFromEmpty()
+
+    net = ncnn.Net()
+    net.load_param("tests/test.param")
+    net.load_model(dr)
+
+    in_mat = ncnn.Mat(np.random.rand(3, 227, 227).astype(np.float32))
+    refcount = sys.getrefcount(in_mat)
+    with net.create_extractor() as ex:
+        # the extractor holds the latest input of each blob
+        ex.input("data", in_mat)
+        assert sys.getrefcount(in_mat) == refcount + 1
+
+        # feeding the blob again drops the previous input
+        for i in range(4):
+            ex.input("data", ncnn.Mat(np.random.rand(3, 227, 227).astype(np.float32)))
+        assert sys.getrefcount(in_mat) == refcount
+
+        ret, out_mat = ex.extract("conv0_fwd")
+        assert ret == 0 and out_mat.c == 3
+
+        ex.input(0, in_mat)
+        assert sys.getrefcount(in_mat) == refcount + 1
+
+    # leaving the with block clears the inputs
+    assert sys.getrefcount(in_mat) == refcount
@@ -207,6 +207,55 @@ def test_numpy():
     assert (mat == array).all()
 
 
+def test_numpy_zero_copy():
+    array = np.random.rand(3, 4, 5).astype(np.float32)
+    mat = ncnn.Mat(array)
+    assert mat.dims == 3 and mat.w == 5 and mat.h == 4 and mat.c == 3
+    array[1, 2, 3] = 7.0
+    assert np.asarray(mat)[1, 2, 3] == 7.0
+
+    # the mat keeps the array alive
+    mat = ncnn.Mat(np.ones((2, 3), dtype=np.float32))
+    assert (np.asarray(mat) == 1.0).all()
+
+    # non-contiguous arrays are copied
+    array = np.random.rand(4, 6).astype(np.float32)
+    mat = ncnn.Mat(array[:, ::2])
+    assert mat.w == 3 and mat.h == 4
+    assert (np.array(mat) == array[:, ::2]).all()
+
+    array = np.random.rand(6, 4, 3).astype(np.float32).transpose(2, 0, 1)
+    mat = ncnn.Mat(array)
+    assert mat.w == 4 and mat.h == 6 and mat.c == 3
+    assert (np.array(mat) == array).all()
+
+
+def test_numpy_packed():
+    array = np.random.rand(2, 3, 5, 4).astype(np.float32)
+    mat = ncnn.Mat(array, elempack=4)
+    assert (
+        mat.dims == 3
+        and mat.w == 5
+        and mat.h == 3
+        and mat.c == 2
+        and mat.elemsize == 16
+        and mat.elempack == 4
+    )
+    assert (np.asarray(mat) == array).all()
+
+    unpacked = np.array(ncnn.convert_packing(mat, 1))
+    assert unpacked.shape == (8, 3, 5)
+    assert (unpacked == array.transpose(0, 3, 1, 2).reshape(8, 3, 5)).all()
+
+    mat = ncnn.Mat(np.random.rand(6, 4).astype(np.float32), elempack=4)
+    assert mat.dims == 1 and mat.w == 6 and mat.elempack == 4
+    assert np.asarray(mat).shape == (6, 4)
+
+    with pytest.raises(RuntimeError) as execinfo:
+        mat = ncnn.Mat(np.random.rand(6, 3).astype(np.float32), elempack=4)
+    assert "needs the last axis of size 4" in str(execinfo.value)
+
+
 def test_fill():
     mat = ncnn.Mat(1)
     mat.fill(1.0)
@@ -591,3 +640,16 @@ def test_substract_mean_normalize():
     assert (
         np.abs((pixels[0, 0, 0] - 127.5) * 0.007843 - mat.channel(0).row(0)[0]) < 1e-5
     )
+
+
+def test_to_pixels():
+    pixels = np.random.randint(0, 256, size=(300, 400, 3)).astype(np.uint8)  # hwc
+    mat = ncnn.Mat.from_pixels(pixels, ncnn.Mat.PixelType.PIXEL_RGB, 400, 300)  # chw
+
+    out = np.zeros((300, 400, 3), dtype=np.uint8)
+    mat.to_pixels(out, ncnn.Mat.PixelType.PIXEL_RGB)
+    assert (out == pixels).all()
+
+    out = np.zeros((300, 500, 3), dtype=np.uint8)
+    mat.to_pixels(out, ncnn.Mat.PixelType.PIXEL_RGB2BGR, 500 * 3)
+    assert (out[:, :400, :] == pixels[:, :, ::-1]).all()
@@ -17,6 +17,9 @@
 #include "gpu.h"
 #include "pipeline.h"
 
+#include <limits.h>
+#include <string.h>
+
 #if __ANDROID_API__ >= 26
 #include <android/hardware_buffer.h>
 #endif // __ANDROID_API__ >= 26
@@ -291,6 +294,809 @@ void UnlockedPoolAllocator::fastFree(void* ptr)
     ncnn::fastFree(ptr);
 }
 
+class ArenaAllocatorPrivate
+{
+public:
+    Mutex lock;
+
+    // 0 = passthrough, 1 = recording, 2 = planned
+    int state;
+
+    // recorded allocation sequence
+    std::vector<size_t> sizes;
+    std::vector<int> malloc_times;
+    std::vector<int> free_times;
+    std::list<std::pair<void*, int> > recording_payouts;
+    int clock;
+
+    // planned arena
+    unsigned char* arena;
+    size_t arena_size;
+    std::vector<size_t> offsets;
+    std::vector<int> live_slots;
+    int cursor;
+    size_t fallback_count;
+};
+
+ArenaAllocator::ArenaAllocator()
+    : Allocator(), d(new ArenaAllocatorPrivate)
+{
+    d->state = 0;
+    d->clock = 0;
+    d->arena = 0;
+    d->arena_size = 0;
+    d->cursor = 0;
+    d->fallback_count = 0;
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+    if (!d->live_slots.empty())
+    {
+        NCNN_LOGE("FATAL ERROR! arena allocator destroyed too early");
+    }
+
+    clear();
+
+    delete d;
+}
+
+ArenaAllocator::ArenaAllocator(const ArenaAllocator&)
+    : d(0)
+{
+}
+
+ArenaAllocator& ArenaAllocator::operator=(const ArenaAllocator&)
+{
+    return *this;
+}
+
+static void arena_allocator_reset(ArenaAllocatorPrivate* d)
+{
+    // recorded ones were served from heap and are freed by their owner later
+    d->recording_payouts.clear();
+
+    d->sizes.clear();
+    d->malloc_times.clear();
+    d->free_times.clear();
+    d->clock = 0;
+
+    if (d->arena)
+    {
+        ncnn::fastFree(d->arena);
+        d->arena = 0;
+    }
+    d->arena_size = 0;
+    d->offsets.clear();
+    d->cursor = 0;
+    d->fallback_count = 0;
+    d->state = 0;
+}
+
+void ArenaAllocator::begin_plan()
+{
+    MutexLockGuard guard(d->lock);
+
+    if (!d->live_slots.empty())
+    {
+        NCNN_LOGE("arena allocator begin_plan with %d slots in use", (int)d->live_slots.size());
+        return;
+    }
+
+    arena_allocator_reset(d);
+
+    d->state = 1;
+}
+
+int ArenaAllocator::end_plan()
+{
+    MutexLockGuard guard(d->lock);
+
+    if (d->state != 1)
+    {
+        NCNN_LOGE("arena allocator end_plan without begin_plan");
+        return -1;
+    }
+
+    // allocations still alive are held until the end
+    std::list<std::pair<void*, int> >::iterator it = d->recording_payouts.begin();
+    for (; it != d->recording_payouts.end(); ++it)
+    {
+        d->free_times[it->second] = d->clock;
+    }
+    d->recording_payouts.clear();
+
+    const int count = (int)d->sizes.size();
+
+    // place larger ones first
+    std::vector<int> order(count);
+    for (int i = 0; i < count; i++)
+    {
+        int j = i;
+        for (; j > 0; j--)
+        {
+            int k = order[j - 1];
+            if (d->sizes[k] >= d->sizes[i])
+                break;
+
+            order[j] = k;
+        }
+        order[j] = i;
+    }
+
+    // greedy interval packing
+    // take the lowest gap between the placed ones alive at the same time
+    d->offsets.resize(count);
+    d->arena_size = 0;
+    std::vector<int> placed;
+    std::vector<int> overlapped;
+    for (int i = 0; i < count; i++)
+    {
+        const int a = order[i];
+        const size_t size = d->sizes[a];
+
+        // collect overlapped lifetimes sorted by offset
+        overlapped.clear();
+        for (size_t j = 0; j < placed.size(); j++)
+        {
+            const int b = placed[j];
+            if (d->malloc_times[b] >= d->free_times[a] || d->malloc_times[a] >= d->free_times[b])
+                continue;
+
+            overlapped.push_back(b);
+            for (size_t k = overlapped.size() - 1; k > 0 && d->offsets[overlapped[k - 1]] > d->offsets[b]; k--)
+            {
+                overlapped[k] = overlapped[k - 1];
+                overlapped[k - 1] = b;
+            }
+        }
+
+        size_t offset = 0;
+        for (size_t j = 0; j < overlapped.size(); j++)
+        {
+            const int b = overlapped[j];
+            if (d->offsets[b] >= offset + size)
+                break;
+
+            offset = std::max(offset, d->offsets[b] + d->sizes[b]);
+        }
+
+        d->offsets[a] = offset;
+        d->arena_size = std::max(d->arena_size, offset + size);
+        placed.push_back(a);
+    }
+
+    if (d->arena_size > 0)
+    {
+        d->arena = (unsigned char*)ncnn::fastMalloc(d->arena_size);
+        if (!d->arena)
+        {
+            NCNN_LOGE("arena allocator out of memory %lu", (unsigned long)d->arena_size);
+            d->state = 0;
+            d->arena_size = 0;
+            return -1;
+        }
+    }
+
+    d->cursor = 0;
+    d->fallback_count = 0;
+    d->state = 2;
+
+    return 0;
+}
+
+void ArenaAllocator::clear()
+{
+    MutexLockGuard guard(d->lock);
+
+    if (!d->live_slots.empty())
+    {
+        NCNN_LOGE("FATAL ERROR! arena allocator clear with %d slots in use", (int)d->live_slots.size());
+        return;
+    }
+
+    arena_allocator_reset(d);
+}
+
+size_t ArenaAllocator::planned_bytes() const
+{
+    return d->arena_size;
+}
+
+size_t ArenaAllocator::fallback_count() const
+{
+    return d->fallback_count;
+}
+
+void* ArenaAllocator::fastMalloc(size_t size)
+{
+    MutexLockGuard guard(d->lock);
+
+    if (d->state == 1)
+    {
+        void* ptr = ncnn::fastMalloc(size);
+
+        d->recording_payouts.push_back(std::make_pair(ptr, (int)d->sizes.size()));
+        d->sizes.push_back(alignSize(size, NCNN_MALLOC_ALIGN));
+        d->malloc_times.push_back(d->clock);
+        d->free_times.push_back(INT_MAX);
+        d->clock++;
+
+        return ptr;
+    }
+
+    if (d->state == 2)
+    {
+        const int count = (int)d->offsets.size();
+        const size_t aligned_size = alignSize(size, NCNN_MALLOC_ALIGN);
+
+        // follow the recorded sequence, restart it on mismatch
+        int slot = -1;
+        if (d->cursor < count && d->sizes[d->cursor] == aligned_size)
+        {
+            slot = d->cursor;
+        }
+        else if (count > 0 && d->sizes[0] == aligned_size)
+        {
+            slot = 0;
+        }
+
+        if (slot != -1)
+        {
+            // the memory may be still held by outputs of the previous inference
+            const size_t offset = d->offsets[slot];
+            for (size_t i = 0; i < d->live_slots.size(); i++)
+            {
+                const int b = d->live_slots[i];
+                if (d->offsets[b] < offset + aligned_size && offset < d->offsets[b] + d->sizes[b])
+                {
+                    slot = -1;
+                    break;
+                }
+            }
+        }
+
+        if (slot != -1)
+        {
+            d->cursor = slot + 1;
+            d->live_slots.push_back(slot);
+            return d->arena + d->offsets[slot];
+        }
+
+        d->fallback_count++;
+    }
+
+    return ncnn::fastMalloc(size);
+}
+
+void ArenaAllocator::fastFree(void* ptr)
+{
+    MutexLockGuard guard(d->lock);
+
+    if (d->state == 1)
+    {
+        std::list<std::pair<void*, int> >::iterator it = d->recording_payouts.begin();
+        for (; it != d->recording_payouts.end(); ++it)
+        {
+            if (it->first == ptr)
+            {
+                d->free_times[it->second] = d->clock;
+                d->clock++;
+
+                d->recording_payouts.erase(it);
+                break;
+            }
+        }
+    }
+
+    if (d->arena && (unsigned char*)ptr >= d->arena && (unsigned char*)ptr < d->arena + d->arena_size)
+    {
+        const size_t offset = (unsigned char*)ptr - d->arena;
+        for (size_t i = 0; i < d->live_slots.size(); i++)
+        {
+            if (d->offsets[d->live_slots[i]] == offset)
+            {
+                d->live_slots.erase(d->live_slots.begin() + i);
+                return;
+            }
+        }
+
+        NCNN_LOGE("FATAL ERROR! arena allocator get wild %p", ptr);
+        return;
+    }
+
+    ncnn::fastFree(ptr);
+}
+
+#if NCNN_THREADS && defined __GNUC__ && !(defined __riscv && !defined __riscv_atomic)
+static inline bool lockfree_cas(void* volatile* addr, void* oldval, void* newval)
+{
+    return __sync_bool_compare_and_swap(addr, oldval, newval);
+}
+
+static inline bool lockfree_cas(volatile size_t* addr, size_t oldval, size_t newval)
+{
+    return __sync_bool_compare_and_swap(addr, oldval, newval);
+}
+
+static inline size_t lockfree_add(volatile size_t* addr, size_t delta)
+{
+    return __sync_add_and_fetch(addr, delta);
+}
+
+static inline size_t lockfree_sub(volatile size_t* addr, size_t delta)
+{
+    return __sync_sub_and_fetch(addr, delta);
+}
+#elif NCNN_THREADS && defined _MSC_VER
+static inline bool lockfree_cas(void* volatile* addr, void* oldval, void* newval)
+{
+    return _InterlockedCompareExchangePointer(addr, newval, oldval) == oldval;
+}
+
+static inline bool lockfree_cas(volatile size_t* addr, size_t oldval, size_t newval)
+{
+#if defined _WIN64
+    return (size_t)_InterlockedCompareExchange64((volatile __int64*)addr, (__int64)newval, (__int64)oldval) == oldval;
+#else
+    return (size_t)_InterlockedCompareExchange((volatile long*)addr, (long)newval, (long)oldval) == oldval;
+#endif
+}
+
+static inline size_t lockfree_add(volatile size_t* addr, size_t delta)
+{
+#if defined _WIN64
+    return (size_t)_InterlockedExchangeAdd64((volatile __int64*)addr, (__int64)delta) + delta;
+#else
+    return (size_t)_InterlockedExchangeAdd((volatile long*)addr, (long)delta) + delta;
+#endif
+}
+
+static inline size_t lockfree_sub(volatile size_t* addr, size_t delta)
+{
+#if defined _WIN64
+    return (size_t)_InterlockedExchangeAdd64((volatile __int64*)addr, -(__int64)delta) - delta;
+#else
+    return (size_t)_InterlockedExchangeAdd((volatile long*)addr, -(long)delta) - delta;
+#endif
+}
+#else
+// thread-unsafe branch
+static inline bool lockfree_cas(void* volatile* addr, void* oldval, void* newval)
+{
+    if (*addr != oldval)
+        return false;
+
+    *addr = newval;
+    return true;
+}
+
+static inline bool lockfree_cas(volatile size_t* addr, size_t oldval, size_t newval)
+{
+    if (*addr != oldval)
+        return false;
+
+    *addr = newval;
+    return true;
+}
+
+static inline size_t lockfree_add(volatile size_t* addr, size_t delta)
+{
+    *addr += delta;
+    return *addr;
+}
+
+static inline size_t lockfree_sub(volatile size_t* addr, size_t delta)
+{
+    *addr -= delta;
+    return *addr;
+}
+#endif
+
+// 4 size classes per power of two, from 64 bytes up to 16G
+#define LOCKFREE_POOL_MIN_SHIFT   6
+#define LOCKFREE_POOL_MAX_SHIFT   34
+#define LOCKFREE_POOL_CLASS_COUNT (1 + (LOCKFREE_POOL_MAX_SHIFT - LOCKFREE_POOL_MIN_SHIFT) * 4)
+
+// cached blocks per size class, in each thread and in the shared slots
+#define LOCKFREE_POOL_THREAD_DEPTH 4
+#define LOCKFREE_POOL_SHARED_DEPTH 32
+
+// default upper bound of cached bytes over all size classes and threads
+#define LOCKFREE_POOL_MAX_CACHED_BYTES ((size_t)256 * 1024 * 1024)
+
+// returns -1 for sizes out of the cached range
+static int lockfree_pool_size_class(size_t size, size_t* class_size)
+{
+    if (size <= ((size_t)1 << LOCKFREE_POOL_MIN_SHIFT))
+    {
+        *class_size = (size_t)1 << LOCKFREE_POOL_MIN_SHIFT;
+        return 0;
+    }
+
+    int shift = LOCKFREE_POOL_MIN_SHIFT;
+    while (shift < LOCKFREE_POOL_MAX_SHIFT && size > ((size_t)2 << shift))
+        shift++;
+
+    if (shift == LOCKFREE_POOL_MAX_SHIFT)
+        return -1;
+
+    const size_t base = (size_t)1 << shift;
+    const size_t step = base / 4;
+    const int sub = (int)((size - base - 1) / step);
+
+    *class_size = base + (sub + 1) * step;
+    return 1 + (shift - LOCKFREE_POOL_MIN_SHIFT) * 4 + sub;
+}
+
+// the header before each block keeps the size class for fastFree
+class LockFreePoolBlockHeader
+{
+public:
+    int size_class;
+    size_t class_size;
+};
+
+class LockFreePoolAllocatorPrivate;
+class LockFreePoolThreadCache
+{
+public:
+    LockFreePoolAllocatorPrivate* owner;
+    LockFreePoolThreadCache* next;
+
+    int count[LOCKFREE_POOL_CLASS_COUNT];
+    void* blocks[LOCKFREE_POOL_CLASS_COUNT][LOCKFREE_POOL_THREAD_DEPTH];
+
+    // statistics updated by the owner thread, read by others
+    volatile size_t hit_count;
+    volatile size_t miss_count;
+};
+
+static void lockfree_pool_thread_exit(void* ptr);
+
+class LockFreePoolAllocatorPrivate
+{
+public:
+    LockFreePoolAllocatorPrivate()
+        : thread_cache(lockfree_pool_thread_exit)
+    {
+    }
+
+    LockFreePoolThreadCache* get_thread_cache();
+    void retire_thread_cache(LockFreePoolThreadCache* cache);
+
+    void* pop_shared(int size_class);
+    bool push_shared(int size_class, void* block);
+
+    // account a freed block as cached, false if that exceeds max_cached_bytes
+    bool reserve_cached(size_t class_size);
+
+public:
+    ThreadLocalStorage thread_cache;
+
+    // guards the registry of thread caches, touched once per thread
+    Mutex caches_lock;
+    LockFreePoolThreadCache* caches;
+
+    // statistics of the exited threads
+    size_t retired_hit_count;
+    size_t retired_miss_count;
+
+    size_t max_cached_bytes;
+
+    // shared free slots, empty slot is null
+    void* volatile slots[LOCKFREE_POOL_CLASS_COUNT][LOCKFREE_POOL_SHARED_DEPTH];
+
+    volatile size_t cached_bytes;
+    volatile size_t held_bytes;
+    volatile size_t peak_bytes;
+};
+
+LockFreePoolThreadCache* LockFreePoolAllocatorPrivate::get_thread_cache()
+{
+    LockFreePoolThreadCache* cache = (LockFreePoolThreadCache*)thread_cache.get();
+    if (cache)
+        return cache;
+
+    cache = new LockFreePoolThreadCache;
+    cache->owner = this;
+    memset(cache->count, 0, sizeof(cache->count));
+    cache->hit_count = 0;
+    cache->miss_count = 0;
+
+    caches_lock.lock();
+    cache->next = caches;
+    caches = cache;
+    caches_lock.unlock();
+
+    thread_cache.set(cache);
+
+    return cache;
+}
+
+void LockFreePoolAllocatorPrivate::retire_thread_cache(LockFreePoolThreadCache* cache)
+{
+    MutexLockGuard guard(caches_lock);
+
+    // hand the blocks over to the other threads, release the ones not fitting the shared slots
+    for (int i = 0; i < LOCKFREE_POOL_CLASS_COUNT; i++)
+    {
+        for (int j = 0; j < cache->count[i]; j++)
+        {
+            void* block = cache->blocks[i][j];
+            if (push_shared(i, block))
+                continue;
+
+            LockFreePoolBlockHeader* header = (LockFreePoolBlockHeader*)block;
+            lockfree_sub(&cached_bytes, header->class_size);
+            lockfree_sub(&held_bytes, header->class_size);
+            ncnn::fastFree(header);
+        }
+        cache->count[i] = 0;
+    }
+
+    retired_hit_count += cache->hit_count;
+    retired_miss_count += cache->miss_count;
+
+    LockFreePoolThreadCache** link = &caches;
+    while (*link != cache)
+        link = &(*link)->next;
+    *link = cache->next;
+
+    delete cache;
+}
+
+static void lockfree_pool_thread_exit(void* ptr)
+{
+    LockFreePoolThreadCache* cache = (LockFreePoolThreadCache*)ptr;
+    cache->owner->retire_thread_cache(cache);
+}
+
+bool LockFreePoolAllocatorPrivate::reserve_cached(size_t class_size)
+{
+    // account before publishing, so that a concurrent taker never underflows
+    if (lockfree_add(&cached_bytes, class_size) <= max_cached_bytes)
+        return true;
+
+    lockfree_sub(&cached_bytes, class_size);
+    return false;
+}
+
+void* LockFreePoolAllocatorPrivate::pop_shared(int size_class)
+{
+    void* volatile* class_slots = slots[size_class];
+    for (int i = 0; i < LOCKFREE_POOL_SHARED_DEPTH; i++)
+    {
+        void* block = class_slots[i];
+
+        // a block taken and returned to the same slot in between is still free, so no aba issue
+        if (block && lockfree_cas(&class_slots[i], block, 0))
+            return block;
+    }
+
+    return 0;
+}
+
+bool LockFreePoolAllocatorPrivate::push_shared(int size_class, void* block)
+{
+    void* volatile* class_slots = slots[size_class];
+    for (int i = 0; i < LOCKFREE_POOL_SHARED_DEPTH; i++)
+    {
+        if (!class_slots[i] && lockfree_cas(&class_slots[i], 0, block))
+            return true;
+    }
+
+    return false;
+}
+
+LockFreePoolAllocator::LockFreePoolAllocator()
+    : Allocator(), d(new LockFreePoolAllocatorPrivate)
+{
+    d->caches = 0;
+    d->retired_hit_count = 0;
+    d->retired_miss_count = 0;
+    d->max_cached_bytes = LOCKFREE_POOL_MAX_CACHED_BYTES;
+    for (int i = 0; i < LOCKFREE_POOL_CLASS_COUNT; i++)
+    {
+        for (int j = 0; j < LOCKFREE_POOL_SHARED_DEPTH; j++)
+        {
+            d->slots[i][j] = 0;
+        }
+    }
+    d->cached_bytes = 0;
+    d->held_bytes = 0;
+    d->peak_bytes = 0;
+}
+
+LockFreePoolAllocator::~LockFreePoolAllocator()
+{
+    clear();
+
+    if (d->held_bytes != 0)
+    {
+        NCNN_LOGE("FATAL ERROR! lock-free pool allocator destroyed too early, %lu bytes still in use", (unsigned long)d->held_bytes);
+    }
+
+    LockFreePoolThreadCache* cache = d->caches;
+    while (cache)
+    {
+        LockFreePoolThreadCache* next = cache->next;
+        delete cache;
+        cache = next;
+    }
+
+    delete d;
+}
+
+LockFreePoolAllocator::LockFreePoolAllocator(const LockFreePoolAllocator&)
+    : d(0)
+{
+}
+
+LockFreePoolAllocator& LockFreePoolAllocator::operator=(const LockFreePoolAllocator&)
+{
+    return *this;
+}
+
+void LockFreePoolAllocator::set_max_cached_bytes(size_t max_cached_bytes)
+{
+    d->max_cached_bytes = max_cached_bytes;
+}
+
+void LockFreePoolAllocator::clear()
+{
+    MutexLockGuard guard(d->caches_lock);
+
+    for (LockFreePoolThreadCache* cache = d->caches; cache; cache = cache->next)
+    {
+        for (int i = 0; i < LOCKFREE_POOL_CLASS_COUNT; i++)
+        {
+            for (int j = 0; j < cache->count[i]; j++)
+            {
+                LockFreePoolBlockHeader* header = (LockFreePoolBlockHeader*)cache->blocks[i][j];
+                lockfree_sub(&d->cached_bytes, header->class_size);
+                lockfree_sub(&d->held_bytes, header->class_size);
+                ncnn::fastFree(header);
+            }
+            cache->count[i] = 0;
+        }
+    }
+
+    for (int i = 0; i < LOCKFREE_POOL_CLASS_COUNT; i++)
+    {
+        void* block = d->pop_shared(i);
+        while (block)
+        {
+            LockFreePoolBlockHeader* header = (LockFreePoolBlockHeader*)block;
+            lockfree_sub(&d->cached_bytes, header->class_size);
+            lockfree_sub(&d->held_bytes, header->class_size);
+            ncnn::fastFree(header);
+
+            block = d->pop_shared(i);
+        }
+    }
+}
+
+size_t LockFreePoolAllocator::hit_count() const
+{
+    MutexLockGuard guard(d->caches_lock);
+
+    size_t count = d->retired_hit_count;
+    for (LockFreePoolThreadCache* cache = d->caches; cache; cache = cache->next)
+    {
+        count += cache->hit_count;
+    }
+
+    return count;
+}
+
+size_t LockFreePoolAllocator::miss_count() const
+{
+    MutexLockGuard guard(d->caches_lock);
+
+    size_t count = d->retired_miss_count;
+    for (LockFreePoolThreadCache* cache = d->caches; cache; cache = cache->next)
+    {
+        count += cache->miss_count;
+    }
+
+    return count;
+}
+
+size_t LockFreePoolAllocator::cached_bytes() const
+{
+    return d->cached_bytes;
+}
+
+size_t LockFreePoolAllocator::peak_bytes() const
+{
+    return d->peak_bytes;
+}
+
+void* LockFreePoolAllocator::fastMalloc(size_t size)
+{
+    const size_t header_size = alignSize(sizeof(LockFreePoolBlockHeader), NCNN_MALLOC_ALIGN);
+
+    size_t class_size = size;
+    const int size_class = lockfree_pool_size_class(size, &class_size);
+
+    LockFreePoolThreadCache* cache = d->get_thread_cache();
+
+    void* block = 0;
+    if (size_class != -1)
+    {
+        if (cache->count[size_class] > 0)
+        {
+            block = cache->blocks[size_class][--cache->count[size_class]];
+        }
+        else
+        {
+            block = d->pop_shared(size_class);
+        }
+    }
+
+    if (block)
+    {
+        lockfree_add(&cache->hit_count, 1);
+        lockfree_sub(&d->cached_bytes, class_size);
+        return (unsigned char*)block + header_size;
+    }
+
+    lockfree_add(&cache->miss_count, 1);
+
+    LockFreePoolBlockHeader* header = (LockFreePoolBlockHeader*)ncnn::fastMalloc(header_size + class_size);
+    if (!header)
+        return 0;
+
+    header->size_class = size_class;
+    header->class_size = class_size;
+
+    // update high-water mark
+    const size_t held = lockfree_add(&d->held_bytes, class_size);
+    for (;;)
+    {
+        size_t peak = d->peak_bytes;
+        if (held <= peak || lockfree_cas(&d->peak_bytes, peak, held))
+            break;
+    }
+
+    return (unsigned char*)header + header_size;
+}
+
+void LockFreePoolAllocator::fastFree(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    const size_t header_size = alignSize(sizeof(LockFreePoolBlockHeader), NCNN_MALLOC_ALIGN);
+
+    LockFreePoolBlockHeader* header = (LockFreePoolBlockHeader*)((unsigned char*)ptr - header_size);
+    const int size_class = header->size_class;
+    const size_t class_size = header->class_size;
+
+    if (size_class != -1)
+    {
+        LockFreePoolThreadCache* cache = d->get_thread_cache();
+
+        if (d->reserve_cached(class_size))
+        {
+            if (cache->count[size_class] < LOCKFREE_POOL_THREAD_DEPTH)
+            {
+                cache->blocks[size_class][cache->count[size_class]++] = header;
+                return;
+            }
+
+            if (d->push_shared(size_class, header))
+                return;
+
+            lockfree_sub(&d->cached_bytes, class_size);
+        }
+    }
+
+    lockfree_sub(&d->held_bytes, class_size);
+    ncnn::fastFree(header);
+}
+
 #if NCNN_VULKAN
 VkAllocator::VkAllocator(const VulkanDevice* _vkdev)
     : vkdev(_vkdev)
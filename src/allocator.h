@@ -211,6 +211,79 @@ private:
     UnlockedPoolAllocatorPrivate* const d;
 };
 
+class ArenaAllocatorPrivate;
+class NCNN_EXPORT ArenaAllocator : public Allocator
+{
+public:
+    ArenaAllocator();
+    ~ArenaAllocator();
+
+    // start recording the allocations of one inference
+    // memory is served from heap while recording
+    void begin_plan();
+
+    // derive the lifetime of every recorded allocation
+    // and assign fixed offsets in one arena, non-overlapping lifetimes share memory
+    // return 0 if success
+    int end_plan();
+
+    // drop the plan and release the arena immediately
+    void clear();
+
+    // arena bytes of the current plan, 0 if not planned
+    size_t planned_bytes() const;
+
+    // allocations served from heap because they mismatch the plan
+    size_t fallback_count() const;
+
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+private:
+    ArenaAllocator(const ArenaAllocator&);
+    ArenaAllocator& operator=(const ArenaAllocator&);
+
+private:
+    ArenaAllocatorPrivate* const d;
+};
+
+class LockFreePoolAllocatorPrivate;
+class NCNN_EXPORT LockFreePoolAllocator : public Allocator
+{
+public:
+    LockFreePoolAllocator();
+    ~LockFreePoolAllocator();
+
+    // upper bound of bytes kept in cache, freed blocks beyond it go back to heap
+    // default is 256M
+    void set_max_cached_bytes(size_t max_cached_bytes);
+
+    // release all cached blocks immediately
+    // must not be called concurrently with fastMalloc/fastFree
+    void clear();
+
+    // allocations served from cache and from heap
+    // each thread counts atomically, the sum may miss allocations running concurrently
+    size_t hit_count() const;
+    size_t miss_count() const;
+
+    // bytes kept in cache for later reuse
+    size_t cached_bytes() const;
+
+    // high-water mark of bytes taken from heap, in use and cached
+    size_t peak_bytes() const;
+
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+private:
+    LockFreePoolAllocator(const LockFreePoolAllocator&);
+    LockFreePoolAllocator& operator=(const LockFreePoolAllocator&);
+
+private:
+    LockFreePoolAllocatorPrivate* const d;
+};
+
 #if NCNN_VULKAN
 
 class VulkanDevice;
@@ -26,9 +26,9 @@
 #include "layer/convolutiondepthwise.h"
 #include "layer/deconvolution.h"
 #include "layer/deconvolutiondepthwise.h"
+#endif // NCNN_BENCHMARK
 
 #include <stdio.h>
-#endif // NCNN_BENCHMARK
 
 namespace ncnn {
 
@@ -52,6 +52,99 @@ double get_current_time()
 }
 #endif // _WIN32
 
+LayerProfile::LayerProfile()
+{
+    layer_index = -1;
+    typeindex = -1;
+    start = 0.0;
+    end = 0.0;
+    bytes_allocated = 0;
+    num_threads = 1;
+    worker_id = 0;
+}
+
+#if NCNN_STDIO
+static void fprint_blob_shapes(FILE* fp, const std::vector<Mat>& shapes)
+{
+    fprintf(fp, "[");
+    for (size_t i = 0; i < shapes.size(); i++)
+    {
+        const Mat& m = shapes[i];
+
+        fprintf(fp, i == 0 ? "\"" : ", \"");
+        if (m.dims == 1)
+            fprintf(fp, "%d", m.w);
+        if (m.dims == 2)
+            fprintf(fp, "%d, %d", m.w, m.h);
+        if (m.dims == 3)
+            fprintf(fp, "%d, %d, %d", m.w, m.h, m.c);
+        fprintf(fp, " *%d %db\"", m.elempack, (int)m.elemsize);
+    }
+    fprintf(fp, "]");
+}
+
+void fprint_json_string(FILE* fp, const char* s)
+{
+    fprintf(fp, "\"");
+    for (const char* p = s; *p; p++)
+    {
+        const unsigned char c = (unsigned char)*p;
+        if (c == '"' || c == '\\')
+            fprintf(fp, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(fp, "\\u%04x", c);
+        else
+            fprintf(fp, "%c", c);
+    }
+    fprintf(fp, "\"");
+}
+
+int save_chrome_trace(const char* path, const std::vector<LayerProfile>& profiles)
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        NCNN_LOGE("fopen %s failed", path);
+        return -1;
+    }
+
+    // trace timestamps are in us, relative to the earliest layer
+    double origin = 0.0;
+    for (size_t i = 0; i < profiles.size(); i++)
+    {
+        if (i == 0 || profiles[i].start < origin)
+            origin = profiles[i].start;
+    }
+
+    fprintf(fp, "{\"traceEvents\":[\n");
+    for (size_t i = 0; i < profiles.size(); i++)
+    {
+        const LayerProfile& p = profiles[i];
+
+#if NCNN_STRING
+        fprintf(fp, "{\"name\":");
+        fprint_json_string(fp, p.name.c_str());
+        fprintf(fp, ",\"cat\":");
+        fprint_json_string(fp, p.type.c_str());
+        fprintf(fp, ",");
+#else
+        fprintf(fp, "{\"name\":\"%d\",\"cat\":\"%d\",", p.layer_index, p.typeindex);
+#endif
+        fprintf(fp, "\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,", p.worker_id, (p.start - origin) * 1000.0, (p.end - p.start) * 1000.0);
+        fprintf(fp, "\"args\":{\"layer_index\":%d,\"num_threads\":%d,\"bytes_allocated\":%lu,\"bottoms\":", p.layer_index, p.num_threads, (unsigned long)p.bytes_allocated);
+        fprint_blob_shapes(fp, p.bottom_shapes);
+        fprintf(fp, ",\"tops\":");
+        fprint_blob_shapes(fp, p.top_shapes);
+        fprintf(fp, i + 1 == profiles.size() ? "}}\n" : "}},\n");
+    }
+    fprintf(fp, "]}\n");
+
+    fclose(fp);
+
+    return 0;
+}
+#endif // NCNN_STDIO
+
 #if NCNN_BENCHMARK
 
 void benchmark(const Layer* layer, double start, double end)
@@ -18,12 +18,55 @@
 #include "layer.h"
 #include "mat.h"
 #include "platform.h"
+#if NCNN_STDIO
+#include <stdio.h>
+#endif
 
 namespace ncnn {
 
 // get now timestamp in ms
 NCNN_EXPORT double get_current_time();
 
+// per-layer record collected by Extractor when profiling is enabled
+class NCNN_EXPORT LayerProfile
+{
+public:
+    LayerProfile();
+
+    int layer_index;
+    int typeindex;
+#if NCNN_STRING
+    std::string type;
+    std::string name;
+#endif // NCNN_STRING
+
+    // timestamps in ms from get_current_time()
+    double start;
+    double end;
+
+    // blob shapes with elempack and elemsize, the data is not referenced
+    std::vector<Mat> bottom_shapes;
+    std::vector<Mat> top_shapes;
+
+    // bytes of the top blobs allocated by this layer, zero when forwarded inplace
+    size_t bytes_allocated;
+
+    // the thread count the layer was given
+    int num_threads;
+
+    // the inter-layer parallel worker that ran this layer, 0 on the calling thread
+    int worker_id;
+};
+
+#if NCNN_STDIO
+// write the records as chrome trace event json, viewable in chrome://tracing or perfetto
+// return 0 if success
+NCNN_EXPORT int save_chrome_trace(const char* path, const std::vector<LayerProfile>& profiles);
+
+// write s as a quoted json string, escaping quotes, backslashes and control characters
+NCNN_EXPORT void fprint_json_string(FILE* fp, const char* s);
+#endif // NCNN_STDIO
+
 #if NCNN_BENCHMARK
 
 NCNN_EXPORT void benchmark(const Layer* layer, double start, double end);
@@ -31,6 +31,8 @@
 #ifdef _MSC_VER
 #include <intrin.h>    // __cpuid()
 #include <immintrin.h> // _xgetbv()
+#elif ((__x86_64__) || (__i386__)) && (defined(__clang__) || defined(__GNUC__))
+#include <cpuid.h> // __cpuid_count()
 #endif
 
 #ifdef __EMSCRIPTEN__
@@ -38,6 +40,7 @@
 #endif
 
 #if defined __ANDROID__ || defined __linux__
+#include <errno.h>
 #include <stdint.h>
 #include <sys/syscall.h>
 #include <unistd.h>
@@ -375,6 +378,165 @@ int cpu_support_arm_asimddp()
 #endif
 }
 
+#if (_M_AMD64 || __x86_64__) || (_M_IX86 || __i386__)
+static void x86_cpuid(int level, int count, int cpu_info[4])
+{
+#if defined(_MSC_VER)
+    __cpuidex(cpu_info, level, count);
+#else
+    // every non-msvc compiler gets __cpuid_count from cpuid.h above
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    __cpuid_count(level, count, eax, ebx, ecx, edx);
+    cpu_info[0] = (int)eax;
+    cpu_info[1] = (int)ebx;
+    cpu_info[2] = (int)ecx;
+    cpu_info[3] = (int)edx;
+#endif
+}
+
+static inline unsigned int x86_get_xcr0()
+{
+#if defined(_MSC_VER)
+    return (unsigned int)_xgetbv(0);
+#else
+    unsigned int eax = 0;
+    unsigned int edx = 0;
+    // xgetbv, spelled as bytes for assemblers that do not know the mnemonic
+    __asm__ volatile(".byte 0x0f, 0x01, 0xd0"
+                     : "=a"(eax), "=d"(edx)
+                     : "c"(0));
+    return eax;
+#endif
+}
+#endif
+
+int cpu_support_x86_avx512()
+{
+#if !NCNN_AVX512
+    return 0;
+#endif
+#if (_M_AMD64 || __x86_64__) || (_M_IX86 || __i386__)
+#if defined(_MSC_VER)
+    // TODO move to init function
+    int cpu_info[4];
+    __cpuid(cpu_info, 0);
+
+    int nIds = cpu_info[0];
+    if (nIds < 7)
+        return 0;
+
+    __cpuid(cpu_info, 1);
+    // check AVX XSAVE OSXSAVE
+    if (!(cpu_info[2] & 0x10000000) || !(cpu_info[2] & 0x04000000) || !(cpu_info[2] & 0x08000000))
+        return 0;
+
+    // check XSAVE enabled by kernel, including opmask and zmm states
+    if ((_xgetbv(0) & 0xe6) != 0xe6)
+        return 0;
+
+    __cpuid(cpu_info, 7);
+    // check avx512f avx512dq avx512cd avx512bw avx512vl
+    return (cpu_info[1] & 0xd0030000) == 0xd0030000;
+#elif defined(__clang__)
+#if __clang_major__ >= 6
+    __builtin_cpu_init();
+#endif
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl");
+#elif __GNUC__ >= 5
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl");
+#else
+    // no avx512 builtins, query cpuid directly
+    int cpu_info[4];
+    x86_cpuid(0, 0, cpu_info);
+
+    int nIds = cpu_info[0];
+    if (nIds < 7)
+        return 0;
+
+    x86_cpuid(1, 0, cpu_info);
+    // check AVX XSAVE OSXSAVE
+    if (!(cpu_info[2] & 0x10000000) || !(cpu_info[2] & 0x04000000) || !(cpu_info[2] & 0x08000000))
+        return 0;
+
+    // check XSAVE enabled by kernel, including opmask and zmm states
+    if ((x86_get_xcr0() & 0xe6) != 0xe6)
+        return 0;
+
+    x86_cpuid(7, 0, cpu_info);
+    // check avx512f avx512dq avx512cd avx512bw avx512vl
+    return (cpu_info[1] & 0xd0030000) == 0xd0030000;
+#endif
+#else
+    return 0;
+#endif
+}
+
+int cpu_support_x86_avx512_vnni()
+{
+#if !NCNN_AVX512VNNI
+    return 0;
+#endif
+#if (_M_AMD64 || __x86_64__) || (_M_IX86 || __i386__)
+    // leaf 7 is known to exist once avx512 is detected
+    if (!cpu_support_x86_avx512())
+        return 0;
+
+    int cpu_info[4];
+    x86_cpuid(7, 0, cpu_info);
+    return cpu_info[2] & 0x00000800;
+#else
+    return 0;
+#endif
+}
+
+int cpu_support_x86_avx512_bf16()
+{
+#if !NCNN_AVX512BF16
+    return 0;
+#endif
+#if (_M_AMD64 || __x86_64__) || (_M_IX86 || __i386__)
+    // leaf 7 is known to exist once avx512 is detected
+    if (!cpu_support_x86_avx512())
+        return 0;
+
+    int cpu_info[4];
+    x86_cpuid(7, 0, cpu_info);
+    if (cpu_info[0] < 1)
+        return 0;
+
+    x86_cpuid(7, 1, cpu_info);
+    return cpu_info[0] & 0x00000020;
+#else
+    return 0;
+#endif
+}
+
+int cpu_support_x86_avx_vnni()
+{
+#if !NCNN_AVXVNNI
+    return 0;
+#endif
+#if (_M_AMD64 || __x86_64__) || (_M_IX86 || __i386__)
+    // leaf 7 is known to exist once avx2 is detected
+    if (!cpu_support_x86_avx2())
+        return 0;
+
+    int cpu_info[4];
+    x86_cpuid(7, 0, cpu_info);
+    if (cpu_info[0] < 1)
+        return 0;
+
+    x86_cpuid(7, 1, cpu_info);
+    return cpu_info[0] & 0x00000010;
+#else
+    return 0;
+#endif
+}
+
 int cpu_support_x86_avx2()
 {
 #if !NCNN_AVX2
@@ -694,6 +856,32 @@ static int set_sched_affinity(const CpuSet& thread_affinity_mask)
 
     return 0;
 }
+
+static int get_sched_affinity(CpuSet& thread_affinity_mask)
+{
+    // get affinity of the calling thread
+#if defined(__GLIBC__) || defined(__OHOS__)
+    pid_t pid = syscall(SYS_gettid);
+#else
+#if defined(PI3) || (defined(__MUSL__) && __MUSL_MINOR__ <= 14)
+    pid_t pid = getpid();
+#else
+    pid_t pid = gettid();
+#endif
+#endif
+
+    thread_affinity_mask.disable_all();
+
+    // the raw syscall returns the size written instead of zero
+    int syscallret = syscall(__NR_sched_getaffinity, pid, sizeof(cpu_set_t), &thread_affinity_mask.cpu_set);
+    if (syscallret < 0)
+    {
+        NCNN_LOGE("syscall error %d", syscallret);
+        return -1;
+    }
+
+    return 0;
+}
 #endif // defined __ANDROID__ || defined __linux__
 
 #if __APPLE__
@@ -765,6 +953,10 @@ static CpuSet g_thread_affinity_mask_big;
 static int setup_thread_affinity_masks()
 {
     g_thread_affinity_mask_all.disable_all();
+    for (int i = 0; i < g_cpucount; i++)
+    {
+        g_thread_affinity_mask_all.enable(i);
+    }
 
 #if defined __ANDROID__ || defined __linux__
     int max_freq_khz_min = INT_MAX;
@@ -950,6 +1142,214 @@ int set_cpu_thread_affinity(const CpuSet& thread_affinity_mask)
 #endif
 }
 
+int get_cpu_thread_affinity(CpuSet& thread_affinity_mask)
+{
+#if defined __ANDROID__ || defined __linux__
+    return get_sched_affinity(thread_affinity_mask);
+#else
+    // TODO
+    thread_affinity_mask.disable_all();
+    return -1;
+#endif
+}
+
+#if defined __ANDROID__ || defined __linux__
+// parse sysfs list like 0-3,8-11
+static int read_sysfs_index_list(const char* path, std::vector<int>& indexes)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+        return -1;
+
+    for (;;)
+    {
+        int first = 0;
+        int nscan = fscanf(fp, "%d", &first);
+        if (nscan != 1)
+            break;
+
+        int last = first;
+        int c = fgetc(fp);
+        if (c == '-')
+        {
+            nscan = fscanf(fp, "%d", &last);
+            if (nscan != 1)
+                break;
+
+            c = fgetc(fp);
+        }
+
+        for (int i = first; i <= last; i++)
+        {
+            indexes.push_back(i);
+        }
+
+        if (c != ',')
+            break;
+    }
+
+    fclose(fp);
+
+    return 0;
+}
+#endif // defined __ANDROID__ || defined __linux__
+
+static std::vector<CpuSet> g_numa_node_affinity_masks;
+
+// node indexes may have holes, only the online ones can take memory
+static std::vector<int> g_numa_online_nodes;
+
+static int setup_numa_node_affinity_masks()
+{
+#if defined __ANDROID__ || defined __linux__
+    std::vector<int>& nodes = g_numa_online_nodes;
+    read_sysfs_index_list("/sys/devices/system/node/online", nodes);
+
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        const int node = nodes[i];
+        if (node >= (int)g_numa_node_affinity_masks.size())
+            g_numa_node_affinity_masks.resize(node + 1);
+
+        char path[256];
+        sprintf(path, "/sys/devices/system/node/node%d/cpulist", node);
+
+        std::vector<int> cpus;
+        read_sysfs_index_list(path, cpus);
+
+        for (size_t j = 0; j < cpus.size(); j++)
+        {
+            g_numa_node_affinity_masks[node].enable(cpus[j]);
+        }
+    }
+#endif // defined __ANDROID__ || defined __linux__
+
+    if (g_numa_node_affinity_masks.empty())
+    {
+        g_numa_node_affinity_masks.push_back(get_cpu_thread_affinity_mask(0));
+        g_numa_online_nodes.assign(1, 0);
+    }
+
+    return (int)g_numa_node_affinity_masks.size();
+}
+
+static int g_numa_node_count = setup_numa_node_affinity_masks();
+
+int get_numa_node_count()
+{
+    return g_numa_node_count;
+}
+
+const CpuSet& get_numa_node_affinity_mask(int numa_node)
+{
+    if (numa_node < 0 || numa_node >= g_numa_node_count)
+    {
+        NCNN_LOGE("numa_node %d not supported", numa_node);
+
+        // fallback to all cores anyway
+        return get_cpu_thread_affinity_mask(0);
+    }
+
+    return g_numa_node_affinity_masks[numa_node];
+}
+
+#if defined __ANDROID__ || defined __linux__
+static int set_sched_mempolicy(int numa_node)
+{
+#ifdef __NR_set_mempolicy
+    // from linux/mempolicy.h
+    const int mpol_default = 0;
+    const int mpol_preferred = 1;
+    const int mpol_interleave = 3;
+
+    // up to 1024 nodes
+    unsigned long nodemask[1024 / (sizeof(unsigned long) * 8)];
+    memset(nodemask, 0, sizeof(nodemask));
+
+    const int bits_per_word = sizeof(unsigned long) * 8;
+
+    int mode = mpol_default;
+    if (numa_node == -2)
+    {
+        mode = mpol_interleave;
+        for (size_t i = 0; i < g_numa_online_nodes.size(); i++)
+        {
+            const int node = g_numa_online_nodes[i];
+            if (node < 1024)
+                nodemask[node / bits_per_word] |= 1ul << (node % bits_per_word);
+        }
+    }
+    else if (numa_node >= 0)
+    {
+        mode = mpol_preferred;
+        nodemask[numa_node / bits_per_word] |= 1ul << (numa_node % bits_per_word);
+    }
+
+    // the kernel reads maxnode - 1 bits
+    int syscallret = syscall(__NR_set_mempolicy, mode, mode == mpol_default ? NULL : nodemask, mode == mpol_default ? 0 : 1024 + 1);
+    if (syscallret)
+    {
+        NCNN_LOGE("syscall error %d", errno);
+        return -1;
+    }
+
+    return 0;
+#else
+    (void)numa_node;
+    return -1;
+#endif
+}
+#endif // defined __ANDROID__ || defined __linux__
+
+static ncnn::ThreadLocalStorage tls_numa_memory_policy;
+
+int get_numa_memory_policy()
+{
+    // stored with offset 1 so that the unset value is -1
+    return (int)reinterpret_cast<size_t>(tls_numa_memory_policy.get()) - 1;
+}
+
+int set_numa_memory_policy(int numa_node)
+{
+    if (numa_node < -2 || numa_node >= g_numa_node_count)
+    {
+        NCNN_LOGE("numa_node %d not supported", numa_node);
+        return -1;
+    }
+
+    if (numa_node == get_numa_memory_policy())
+        return 0;
+
+#if defined __ANDROID__ || defined __linux__
+    // the threads that may touch the memory, same as the team of set_cpu_thread_affinity
+    int num_threads = numa_node >= 0 ? g_numa_node_affinity_masks[numa_node].num_enabled() : g_cpucount;
+    num_threads = std::max(num_threads, 1);
+
+#ifdef _OPENMP
+    // set policy for each thread
+    std::vector<int> ssmrets(num_threads, 0);
+    #pragma omp parallel for num_threads(num_threads)
+    for (int i = 0; i < num_threads; i++)
+    {
+        ssmrets[i] = set_sched_mempolicy(numa_node);
+    }
+    for (int i = 0; i < num_threads; i++)
+    {
+        if (ssmrets[i] != 0)
+            return -1;
+    }
+#else
+    (void)num_threads;
+    int ssmret = set_sched_mempolicy(numa_node);
+    if (ssmret != 0)
+        return -1;
+#endif
+#endif // defined __ANDROID__ || defined __linux__
+
+    tls_numa_memory_policy.set(reinterpret_cast<void*>((size_t)(numa_node + 1)));
+    return 0;
+}
+
 int get_omp_num_threads()
 {
 #ifdef _OPENMP
@@ -54,6 +54,18 @@ NCNN_EXPORT int cpu_support_arm_asimdhp();
 // asimddp = aarch64 asimd dot product
 NCNN_EXPORT int cpu_support_arm_asimddp();
 
+// avx512 = x86_64 avx512f + avx512cd + avx512bw + avx512dq + avx512vl
+NCNN_EXPORT int cpu_support_x86_avx512();
+
+// avx512vnni = x86_64 avx512 + avx512 vector neural network instructions
+NCNN_EXPORT int cpu_support_x86_avx512_vnni();
+
+// avx512bf16 = x86_64 avx512 + bfloat16 conversion and dot product instructions
+NCNN_EXPORT int cpu_support_x86_avx512_bf16();
+
+// avxvnni = x86_64 avx2 + vex-encoded vector neural network instructions
+NCNN_EXPORT int cpu_support_x86_avx_vnni();
+
 // avx2 = x86_64 avx2 + fma + f16c
 NCNN_EXPORT int cpu_support_x86_avx2();
 
@@ -94,6 +106,25 @@ NCNN_EXPORT const CpuSet& get_cpu_thread_affinity_mask(int powersave);
 // set explicit thread affinity
 NCNN_EXPORT int set_cpu_thread_affinity(const CpuSet& thread_affinity_mask);
 
+// get the thread affinity of the calling thread
+// only implemented on linux and android at the moment
+NCNN_EXPORT int get_cpu_thread_affinity(CpuSet& thread_affinity_mask);
+
+// numa topology, one node holding all cores when unavailable
+// node indexes are the ones of the operating system, a node may have no cores
+// only implemented on linux and android at the moment
+NCNN_EXPORT int get_numa_node_count();
+NCNN_EXPORT const CpuSet& get_numa_node_affinity_mask(int numa_node);
+
+// place the pages first touched by the calling thread and its openmp threads
+// only implemented on linux and android at the moment
+// -1 = local node of the touching thread(default)
+// -2 = interleave over all nodes
+// 0 ~ N-1 = prefer that node
+// return 0 if success for setter function
+NCNN_EXPORT int get_numa_memory_policy();
+NCNN_EXPORT int set_numa_memory_policy(int numa_node);
+
 // misc function wrapper for openmp routines
 NCNN_EXPORT int get_omp_num_threads();
 NCNN_EXPORT void set_omp_num_threads(int num_threads);
@@ -16,6 +16,18 @@
 
 #include <string.h>
 
+#if NCNN_STDIO
+#if defined _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined __unix__ || defined __APPLE__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#endif // NCNN_STDIO
+
 namespace ncnn {
 
 DataReader::DataReader()
@@ -44,6 +56,130 @@ size_t DataReader::reference(size_t /*size*/, const void** /*buf*/) const
 }
 
 #if NCNN_STDIO
+class DataReaderFromMmapPrivate
+{
+public:
+    DataReaderFromMmapPrivate()
+        : mem(0), size(0), pos(0)
+    {
+#if defined _WIN32
+        mapping = 0;
+#endif
+    }
+    unsigned char* mem;
+    size_t size;
+    size_t pos;
+#if defined _WIN32
+    HANDLE mapping;
+#endif
+};
+
+DataReaderFromMmap::DataReaderFromMmap(const char* filepath)
+    : DataReader(), d(new DataReaderFromMmapPrivate)
+{
+#if defined _WIN32
+    HANDLE file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+
+    LARGE_INTEGER filesize;
+    if (!GetFileSizeEx(file, &filesize) || filesize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return;
+    }
+
+    // page protection copy-on-write, written pages become private
+    d->mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!d->mapping)
+        return;
+
+    void* mem = MapViewOfFile(d->mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (!mem)
+    {
+        CloseHandle(d->mapping);
+        d->mapping = 0;
+        return;
+    }
+
+    d->mem = (unsigned char*)mem;
+    d->size = (size_t)filesize.QuadPart;
+#elif defined __unix__ || defined __APPLE__
+    int fd = open(filepath, O_RDONLY);
+    if (fd == -1)
+        return;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return;
+    }
+
+    // private writable mapping, clean pages stay shared among processes
+    void* mem = mmap(0, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED)
+        return;
+
+    d->mem = (unsigned char*)mem;
+    d->size = (size_t)st.st_size;
+#else
+    (void)filepath;
+#endif
+}
+
+DataReaderFromMmap::~DataReaderFromMmap()
+{
+    if (d->mem)
+    {
+#if defined _WIN32
+        UnmapViewOfFile(d->mem);
+        CloseHandle(d->mapping);
+#elif defined __unix__ || defined __APPLE__
+        munmap(d->mem, d->size);
+#endif
+    }
+
+    delete d;
+}
+
+DataReaderFromMmap::DataReaderFromMmap(const DataReaderFromMmap&)
+    : d(0)
+{
+}
+
+DataReaderFromMmap& DataReaderFromMmap::operator=(const DataReaderFromMmap&)
+{
+    return *this;
+}
+
+bool DataReaderFromMmap::empty() const
+{
+    return d->mem == 0;
+}
+
+size_t DataReaderFromMmap::read(void* buf, size_t size) const
+{
+    if (size > d->size - d->pos)
+        size = d->size - d->pos;
+
+    memcpy(buf, d->mem + d->pos, size);
+    d->pos += size;
+    return size;
+}
+
+size_t DataReaderFromMmap::reference(size_t size, const void** buf) const
+{
+    if (size > d->size - d->pos)
+        return 0;
+
+    *buf = d->mem + d->pos;
+    d->pos += size;
+    return size;
+}
+
 class DataReaderFromStdioPrivate
 {
 public:
@@ -51,6 +51,29 @@ public:
 };
 
 #if NCNN_STDIO
+class DataReaderFromMmapPrivate;
+class NCNN_EXPORT DataReaderFromMmap : public DataReader
+{
+public:
+    // map the whole file copy-on-write
+    // the data referenced from it stays valid until the reader is destroyed
+    explicit DataReaderFromMmap(const char* filepath);
+    virtual ~DataReaderFromMmap();
+
+    // return true if the file could not be mapped
+    bool empty() const;
+
+    virtual size_t read(void* buf, size_t size) const;
+    virtual size_t reference(size_t size, const void** buf) const;
+
+private:
+    DataReaderFromMmap(const DataReaderFromMmap&);
+    DataReaderFromMmap& operator=(const DataReaderFromMmap&);
+
+private:
+    DataReaderFromMmapPrivate* const d;
+};
+
 class DataReaderFromStdioPrivate;
 class NCNN_EXPORT DataReaderFromStdio : public DataReader
 {
@@ -52,6 +52,8 @@ Layer::Layer()
 
     support_weight_fp16_storage = false;
 
+    support_avx512_pack16 = false;
+
     typeindex = -1;
 
 #if NCNN_VULKAN
@@ -123,6 +125,29 @@ int Layer::forward_inplace(Mat& /*bottom_top_blob*/, const Option& /*opt*/) cons
     return -1;
 }
 
+int Layer::forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    top_blobs.resize(bottom_blobs.size());
+    for (size_t i = 0; i < bottom_blobs.size(); i++)
+    {
+        int ret = forward(bottom_blobs[i], top_blobs[i], opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+int Layer::get_prepacked(std::vector<Mat>& /*weights*/) const
+{
+    return -1;
+}
+
+int Layer::set_prepacked(const std::vector<Mat>& /*weights*/)
+{
+    return -1;
+}
+
 #if NCNN_VULKAN
 int Layer::upload_model(VkTransfer& /*cmd*/, const Option& /*opt*/)
 {
@@ -232,6 +257,13 @@ Layer* create_layer(int index)
     // clang-format off
     // *INDENT-OFF*
     layer_creator_func layer_creator = 0;
+#if NCNN_RUNTIME_CPU && NCNN_AVX512
+    if (ncnn::cpu_support_x86_avx512())
+    {
+        layer_creator = layer_registry_avx512[index].creator;
+    }
+    else
+#endif// NCNN_RUNTIME_CPU && NCNN_AVX512
 #if NCNN_RUNTIME_CPU && NCNN_AVX2
     if (ncnn::cpu_support_x86_avx2())
     {
@@ -87,7 +87,9 @@ public:
     // TODO drop these fields
     bool support_weight_fp16_storage;
 
-    bool support_reserved_0;
+    // accept input blob with pack16 storage on avx512
+    bool support_avx512_pack16;
+
     bool support_reserved_1;
     bool support_reserved_2;
     bool support_reserved_3;
@@ -144,6 +146,25 @@ public:
     const VulkanDevice* vkdev;
 #endif // NCNN_VULKAN
 
+    // virtual functions added later are appended here to keep the vtable of existing custom layers
+
+public:
+    // implement batched inference for one_blob_only layer
+    // all samples in bottom_blobs share the same shape
+    // the default implementation calls forward() for each sample
+    // return 0 if success
+    virtual int forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+public:
+    // export weight data transformed in create_pipeline for caching
+    // return 0 if success, -1 if not supported
+    virtual int get_prepacked(std::vector<Mat>& weights) const;
+
+    // restore weight data exported by get_prepacked before create_pipeline
+    // create_pipeline skips the weight transform afterwards
+    // return 0 if success, -1 if not supported
+    virtual int set_prepacked(const std::vector<Mat>& weights);
+
 public:
     // custom user data
     void* userdata;
@@ -205,7 +205,8 @@ int DetectionOutput::forward(const std::vector<Mat>& bottom_blobs, std::vector<M
     all_class_bbox_scores.resize(num_class_copy);
 
     // start from 1 to ignore background class
-    #pragma omp parallel for num_threads(opt.num_threads)
+    // the candidate count varies a lot between classes, hand them out dynamically
+    #pragma omp parallel for schedule(dynamic) num_threads(opt.num_threads)
     for (int i = 1; i < num_class_copy; i++)
     {
         // filter by confidence_threshold
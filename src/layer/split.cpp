@@ -26,6 +26,7 @@ Split::Split()
     support_fp16_storage = cpu_support_arm_asimdhp() || cpu_support_riscv_zfh();
     support_bf16_storage = true;
     support_image_storage = true;
+    support_avx512_pack16 = true;
 }
 
 int Split::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& /*opt*/) const
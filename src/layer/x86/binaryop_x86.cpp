@@ -18,6 +18,9 @@
 #include "sse_mathfun.h"
 #if __AVX__
 #include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
 #endif // __AVX__
 #endif // __SSE2__
 
@@ -29,6 +32,9 @@ BinaryOp_x86::BinaryOp_x86()
 {
 #if __SSE2__
     support_packing = true;
+#if __AVX512F__
+    support_avx512_pack16 = true;
+#endif // __AVX512F__
 #endif // __SSE2__
 }
 
@@ -37,6 +43,202 @@ BinaryOp_x86::BinaryOp_x86()
 // broadcasting rule
 // https://github.com/Tencent/ncnn/wiki/binaryop-broadcasting
 
+#if __AVX512F__
+// pack16 covers the elementwise, per-channel and scalar cases,
+// other broadcasting patterns fall back to pack8
+static bool binary_op_pack16_supported(const Mat& a, const Mat& b)
+{
+    if (a.elempack == 16 && b.elempack == 16 && a.dims == b.dims && a.w == b.w && a.h == b.h && a.c == b.c)
+        return true;
+
+    if (a.elempack == 16 && a.dims == 3 && b.dims == 3 && b.elempack == 16 && b.w == 1 && b.h == 1 && b.c == a.c)
+        return true;
+
+    if (b.elempack == 16 && b.dims == 3 && a.dims == 3 && a.elempack == 16 && a.w == 1 && a.h == 1 && a.c == b.c)
+        return true;
+
+    if (a.elempack == 16 && b.dims == 1 && b.w == 1 && b.elempack == 1)
+        return true;
+
+    if (b.elempack == 16 && a.dims == 1 && a.w == 1 && a.elempack == 1)
+        return true;
+
+    return false;
+}
+
+template<typename Op>
+static int binary_op_pack16(const Mat& a, const Mat& b, Mat& c, const Option& opt)
+{
+    Op op;
+
+    const bool a_scalar = a.dims == 1 && a.w == 1 && a.elempack == 1;
+    const bool b_scalar = b.dims == 1 && b.w == 1 && b.elempack == 1;
+    const bool a_broadcast = a_scalar || (a.dims == 3 && a.w == 1 && a.h == 1 && (b.w != 1 || b.h != 1));
+    const Mat& big = a_broadcast ? b : a;
+
+    int w = big.w;
+    int h = big.h;
+    int channels = big.c;
+    int size = w * h;
+
+    c.create_like(big, opt.blob_allocator);
+    if (c.empty())
+        return -100;
+
+    if (big.dims != 3)
+    {
+        size = w * h * channels;
+        channels = 1;
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const float* ptr = big.channel(q);
+        float* outptr = c.channel(q);
+
+        if (a_broadcast)
+        {
+            __m512 _a0 = a_scalar ? _mm512_set1_ps(a[0]) : _mm512_loadu_ps((const float*)a.channel(q));
+            for (int i = 0; i < size; i++)
+            {
+                __m512 _p1 = _mm512_loadu_ps(ptr);
+                _mm512_storeu_ps(outptr, op(_a0, _p1));
+                ptr += 16;
+                outptr += 16;
+            }
+        }
+        else if (b_scalar || (b.w == 1 && b.h == 1 && (w != 1 || h != 1)))
+        {
+            __m512 _b0 = b_scalar ? _mm512_set1_ps(b[0]) : _mm512_loadu_ps((const float*)b.channel(q));
+            for (int i = 0; i < size; i++)
+            {
+                __m512 _p = _mm512_loadu_ps(ptr);
+                _mm512_storeu_ps(outptr, op(_p, _b0));
+                ptr += 16;
+                outptr += 16;
+            }
+        }
+        else
+        {
+            const float* ptr1 = big.dims == 3 ? (const float*)b.channel(q) : (const float*)b;
+            for (int i = 0; i < size; i++)
+            {
+                __m512 _p = _mm512_loadu_ps(ptr);
+                __m512 _p1 = _mm512_loadu_ps(ptr1);
+                _mm512_storeu_ps(outptr, op(_p, _p1));
+                ptr += 16;
+                ptr1 += 16;
+                outptr += 16;
+            }
+        }
+    }
+
+    return 0;
+}
+
+template<typename Op>
+static int binary_op_scalar_inplace_pack16(Mat& a, float b, const Option& opt)
+{
+    Op op;
+
+    int w = a.w;
+    int h = a.h;
+    int channels = a.c;
+    int size = w * h;
+
+    __m512 _b = _mm512_set1_ps(b);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        float* ptr = a.channel(q);
+
+        for (int i = 0; i < size; i++)
+        {
+            __m512 _p = _mm512_loadu_ps(ptr);
+            _p = op(_p, _b);
+            _mm512_storeu_ps(ptr, _p);
+            ptr += 16;
+        }
+    }
+
+    return 0;
+}
+
+struct binary_op_add_pack16
+{
+    __m512 operator()(const __m512& x, const __m512& y) const
+    {
+        return _mm512_add_ps(x, y);
+    }
+};
+
+struct binary_op_sub_pack16
+{
+    __m512 operator()(const __m512& x, const __m512& y) const
+    {
+        return _mm512_sub_ps(x, y);
+    }
+};
+
+struct binary_op_mul_pack16
+{
+    __m512 operator()(const __m512& x, const __m512& y) const
+    {
+        return _mm512_mul_ps(x, y);
+    }
+};
+
+struct binary_op_div_pack16
+{
+    __m512 operator()(const __m512& x, const __m512& y) const
+    {
+        return _mm512_div_ps(x, y);
+    }
+};
+
+struct binary_op_max_pack16
+{
+    __m512 operator()(const __m512& x, const __m512& y) const
+    {
+        return _mm512_max_ps(x, y);
+    }
+};
+
+struct binary_op_min_pack16
+{
+    __m512 operator()(const __m512& x, const __m512& y) const
+    {
+        return _mm512_min_ps(x, y);
+    }
+};
+
+struct binary_op_pow_pack16
+{
+    __m512 operator()(const __m512& x, const __m512& y) const
+    {
+        return exp512_ps(_mm512_mul_ps(y, log512_ps(x)));
+    }
+};
+
+struct binary_op_rsub_pack16
+{
+    __m512 operator()(const __m512& x, const __m512& y) const
+    {
+        return _mm512_sub_ps(y, x);
+    }
+};
+
+struct binary_op_rdiv_pack16
+{
+    __m512 operator()(const __m512& x, const __m512& y) const
+    {
+        return _mm512_div_ps(y, x);
+    }
+};
+#endif // __AVX512F__
+
 template<typename Op>
 static int binary_op_pack8(const Mat& a, const Mat& b, Mat& c, const Option& opt)
 {
@@ -1550,6 +1752,51 @@ int BinaryOp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>
     int elempack1 = bottom_blob1.elempack;
 
 #if __AVX__
+#if __AVX512F__
+    if (elempack == 16 || elempack1 == 16)
+    {
+        if (binary_op_pack16_supported(bottom_blob, bottom_blob1))
+        {
+            if (op_type == Operation_ADD)
+                return binary_op_pack16<binary_op_add_pack16>(bottom_blob, bottom_blob1, top_blob, opt);
+
+            if (op_type == Operation_SUB)
+                return binary_op_pack16<binary_op_sub_pack16>(bottom_blob, bottom_blob1, top_blob, opt);
+
+            if (op_type == Operation_MUL)
+                return binary_op_pack16<binary_op_mul_pack16>(bottom_blob, bottom_blob1, top_blob, opt);
+
+            if (op_type == Operation_DIV)
+                return binary_op_pack16<binary_op_div_pack16>(bottom_blob, bottom_blob1, top_blob, opt);
+
+            if (op_type == Operation_MAX)
+                return binary_op_pack16<binary_op_max_pack16>(bottom_blob, bottom_blob1, top_blob, opt);
+
+            if (op_type == Operation_MIN)
+                return binary_op_pack16<binary_op_min_pack16>(bottom_blob, bottom_blob1, top_blob, opt);
+
+            if (op_type == Operation_POW)
+                return binary_op_pack16<binary_op_pow_pack16>(bottom_blob, bottom_blob1, top_blob, opt);
+
+            if (op_type == Operation_RSUB)
+                return binary_op_pack16<binary_op_rsub_pack16>(bottom_blob, bottom_blob1, top_blob, opt);
+
+            if (op_type == Operation_RDIV)
+                return binary_op_pack16<binary_op_rdiv_pack16>(bottom_blob, bottom_blob1, top_blob, opt);
+        }
+
+        // unpack to pack8 for the remaining broadcasting patterns
+        Option opt_unpack = opt;
+        opt_unpack.blob_allocator = opt.workspace_allocator;
+
+        std::vector<Mat> bottom_blobs_unpacked(2);
+        convert_packing(bottom_blob, bottom_blobs_unpacked[0], elempack == 16 ? 8 : elempack, opt_unpack);
+        convert_packing(bottom_blob1, bottom_blobs_unpacked[1], elempack1 == 16 ? 8 : elempack1, opt_unpack);
+
+        return forward(bottom_blobs_unpacked, top_blobs, opt);
+    }
+#endif // __AVX512F__
+
     if (elempack == 8 || elempack1 == 8)
     {
         if (op_type == Operation_ADD)
@@ -1621,6 +1868,38 @@ int BinaryOp_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
     int elempack = bottom_top_blob.elempack;
 
 #if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        if (op_type == Operation_ADD)
+            return binary_op_scalar_inplace_pack16<binary_op_add_pack16>(bottom_top_blob, b, opt);
+
+        if (op_type == Operation_SUB)
+            return binary_op_scalar_inplace_pack16<binary_op_sub_pack16>(bottom_top_blob, b, opt);
+
+        if (op_type == Operation_MUL)
+            return binary_op_scalar_inplace_pack16<binary_op_mul_pack16>(bottom_top_blob, b, opt);
+
+        if (op_type == Operation_DIV)
+            return binary_op_scalar_inplace_pack16<binary_op_div_pack16>(bottom_top_blob, b, opt);
+
+        if (op_type == Operation_MAX)
+            return binary_op_scalar_inplace_pack16<binary_op_max_pack16>(bottom_top_blob, b, opt);
+
+        if (op_type == Operation_MIN)
+            return binary_op_scalar_inplace_pack16<binary_op_min_pack16>(bottom_top_blob, b, opt);
+
+        if (op_type == Operation_POW)
+            return binary_op_scalar_inplace_pack16<binary_op_pow_pack16>(bottom_top_blob, b, opt);
+
+        if (op_type == Operation_RSUB)
+            return binary_op_scalar_inplace_pack16<binary_op_rsub_pack16>(bottom_top_blob, b, opt);
+
+        if (op_type == Operation_RDIV)
+            return binary_op_scalar_inplace_pack16<binary_op_rdiv_pack16>(bottom_top_blob, b, opt);
+    }
+#endif // __AVX512F__
+
     if (elempack == 8)
     {
         if (op_type == Operation_ADD)
@@ -21,6 +21,10 @@
 #endif // __AVX__
 #endif // __SSE2__
 
+#include <math.h>
+
+#include "x86_usability.h"
+
 #if __AVX__
 #include <stdint.h>
 typedef union m128i
@@ -34,35 +38,6 @@ typedef union m256i
     __m256i vec;
     uint32_t m256i_u32[8];
 } m256;
-static inline __m256 bfloat2float_avx(__m128i v0)
-{
-    __m128i zero = _mm_set1_epi32(0);
-    __m128i a = _mm_slli_epi32(_mm_unpacklo_epi16(v0, zero), 16);
-    __m128i b = _mm_slli_epi32(_mm_unpackhi_epi16(v0, zero), 16);
-    __m256i ab = _mm256_set1_epi32(0);
-    ab = _mm256_insertf128_si256(ab, a, 0); // insert in low 128-bit lane
-    ab = _mm256_insertf128_si256(ab, b, 1); // insert in high 128-bit lane
-    return _mm256_castsi256_ps(ab);
-}
-#if __AVX2__
-
-static inline __m256i float2bfloat_avx(__m256 v0, __m256 v1)
-{
-    __m256i a = _mm256_castps_si256(v0);
-    a = _mm256_srli_epi32(a, 16);
-    __m256i b = _mm256_castps_si256(v1);
-    b = _mm256_srli_epi32(b, 16);
-    __m256i abab = _mm256_packus_epi32(a, b);
-    return _mm256_permutevar8x32_epi32(abab, _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7));
-}
-static inline __m128i float2bfloat_avx(__m256 v0)
-{
-    __m256i a = _mm256_castps_si256(v0);
-    a = _mm256_srli_epi32(a, 16);
-    __m256i aaaa = _mm256_packus_epi32(a, a);
-    return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(aaaa, _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7)));
-}
-#endif
 #endif // __AVX__
 
 namespace ncnn {
@@ -203,16 +178,22 @@ int Cast_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
             const unsigned short* ptr = bottom_blob.channel(q);
             float* outptr = top_blob.channel(q);
 
-            int nn = size >> 3;
-            int remain = size & 7;
-            for (; nn > 0; nn--)
+            int i = 0;
+#if __AVX512F__
+            for (; i + 15 < size; i += 16)
             {
-                _mm256_storeu_ps(outptr, bfloat2float_avx(_mm_lddqu_si128((__m128i const*)ptr)));
+                _mm512_storeu_ps(outptr, bfloat2float_avx512(_mm256_loadu_si256((const __m256i*)ptr)));
+                ptr += 16;
+                outptr += 16;
+            }
+#endif // __AVX512F__
+            for (; i + 7 < size; i += 8)
+            {
+                _mm256_storeu_ps(outptr, bfloat2float_avx(_mm_loadu_si128((const __m128i*)ptr)));
                 ptr += 8;
                 outptr += 8;
             }
-
-            for (; remain > 0; remain--)
+            for (; i < size; i++)
             {
                 *outptr = bfloat16_to_float32(*ptr);
                 outptr++;
@@ -227,22 +208,22 @@ int Cast_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
         {
             const float* ptr = bottom_blob.channel(q);
             unsigned short* outptr = top_blob.channel(q);
-            int nn = size >> 4;
-            int remain = size & 15;
-            for (; nn > 0; nn--)
+            int i = 0;
+#if __AVX512F__
+            for (; i + 15 < size; i += 16)
             {
-                _mm256_storeu_si256((__m256i*)outptr, float2bfloat_avx(_mm256_loadu_ps(ptr), _mm256_loadu_ps(ptr + 8)));
+                _mm256_storeu_si256((__m256i*)outptr, float2bfloat_avx512(_mm512_loadu_ps(ptr)));
                 ptr += 16;
                 outptr += 16;
             }
-            if (remain >= 8)
+#endif // __AVX512F__
+            for (; i + 7 < size; i += 8)
             {
-                remain -= 8;
-                _mm_store_si128((__m128i*)outptr, float2bfloat_avx(_mm256_loadu_ps(ptr)));
+                _mm_storeu_si128((__m128i*)outptr, float2bfloat_avx(_mm256_loadu_ps(ptr)));
                 ptr += 8;
                 outptr += 8;
             }
-            for (; remain > 0; remain--)
+            for (; i < size; i++)
             {
                 *outptr = float32_to_bfloat16(*ptr);
                 outptr++;
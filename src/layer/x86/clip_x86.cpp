@@ -28,6 +28,9 @@ Clip_x86::Clip_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if __AVX512F__
+    support_avx512_pack16 = true;
+#endif // __AVX512F__
 }
 
 int Clip_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
@@ -39,6 +42,31 @@ int Clip_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 #if __SSE2__
     int elempack = bottom_top_blob.elempack;
 
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            float* ptr = bottom_top_blob.channel(q);
+
+            __m512 _max = _mm512_set1_ps(max);
+            __m512 _min = _mm512_set1_ps(min);
+
+            for (int i = 0; i < size; i++)
+            {
+                __m512 _ptr = _mm512_loadu_ps(ptr);
+                _ptr = _mm512_max_ps(_ptr, _min);
+                _ptr = _mm512_min_ps(_ptr, _max);
+                _mm512_storeu_ps(ptr, _ptr);
+
+                ptr += 16;
+            }
+        }
+
+        return 0;
+    }
+#endif // __AVX512F__
 #if __AVX__
     if (elempack == 8)
     {
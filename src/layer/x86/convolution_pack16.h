@@ -0,0 +1,260 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+static void convolution_packnto16_avx512(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_packed, const Mat& bias_data, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, int activation_type, const Mat& activation_params, const Option& opt)
+{
+    // input elempack 1 / 4 / 8, output elempack 16
+    int w = bottom_blob.w;
+    int channels = bottom_blob.c;
+    int elempack = bottom_blob.elempack;
+
+    int outw = top_blob.w;
+    int outh = top_blob.h;
+    int outch = top_blob.c;
+
+    const int maxk = kernel_w * kernel_h;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap = w * dilation_h - kernel_w * dilation_w;
+        for (int i = 0; i < kernel_h; i++)
+        {
+            for (int j = 0; j < kernel_w; j++)
+            {
+                space_ofs[p1] = p2;
+                p1++;
+                p2 += dilation_w;
+            }
+            p2 += gap;
+        }
+    }
+
+    const float* bias_data_ptr = bias_data;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < outch; p++)
+    {
+        float* outptr = top_blob.channel(p);
+
+        for (int i = 0; i < outh; i++)
+        {
+            for (int j = 0; j < outw; j++)
+            {
+                __m512 _sum = bias_data_ptr ? _mm512_loadu_ps(bias_data_ptr + p * 16) : _mm512_setzero_ps();
+
+                const float* kptr = weight_data_packed.channel(p);
+
+                // channels
+                for (int q = 0; q < channels; q++)
+                {
+                    const Mat m = bottom_blob.channel(q);
+                    const float* sptr = m.row(i * stride_h) + j * stride_w * elempack;
+
+                    for (int k = 0; k < maxk; k++)
+                    {
+                        const float* slptr = sptr + space_ofs[k] * elempack;
+
+                        for (int l = 0; l < elempack; l++)
+                        {
+                            __m512 _val = _mm512_set1_ps(slptr[l]);
+                            __m512 _w = _mm512_loadu_ps(kptr);
+                            _sum = _mm512_fmadd_ps(_val, _w, _sum);
+
+                            kptr += 16;
+                        }
+                    }
+                }
+
+                _sum = activation_avx512(_sum, activation_type, activation_params);
+
+                _mm512_storeu_ps(outptr + j * 16, _sum);
+            }
+
+            outptr += outw * 16;
+        }
+    }
+}
+
+static void convolution_pack16ton_avx512(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_packed, const Mat& bias_data, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, int activation_type, const Mat& activation_params, const Option& opt)
+{
+    // input elempack 16, output elempack 1 / 4 / 8
+    int w = bottom_blob.w;
+    int channels = bottom_blob.c;
+
+    int outw = top_blob.w;
+    int outh = top_blob.h;
+    int outch = top_blob.c;
+    int out_elempack = top_blob.elempack;
+
+    const int maxk = kernel_w * kernel_h;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap = w * dilation_h - kernel_w * dilation_w;
+        for (int i = 0; i < kernel_h; i++)
+        {
+            for (int j = 0; j < kernel_w; j++)
+            {
+                space_ofs[p1] = p2;
+                p1++;
+                p2 += dilation_w;
+            }
+            p2 += gap;
+        }
+    }
+
+    const float* bias_data_ptr = bias_data;
+
+    if (out_elempack == 8)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < outch; p++)
+        {
+            float* outptr = top_blob.channel(p);
+
+            for (int i = 0; i < outh; i++)
+            {
+                for (int j = 0; j < outw; j++)
+                {
+                    __m256 _sum = bias_data_ptr ? _mm256_loadu_ps(bias_data_ptr + p * 8) : _mm256_setzero_ps();
+
+                    const float* kptr = weight_data_packed.channel(p);
+
+                    for (int q = 0; q < channels; q++)
+                    {
+                        const Mat m = bottom_blob.channel(q);
+                        const float* sptr = m.row(i * stride_h) + j * stride_w * 16;
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            const float* slptr = sptr + space_ofs[k] * 16;
+
+                            for (int l = 0; l < 16; l++)
+                            {
+                                __m256 _val = _mm256_set1_ps(slptr[l]);
+                                __m256 _w = _mm256_loadu_ps(kptr);
+                                _sum = _mm256_fmadd_ps(_val, _w, _sum);
+
+                                kptr += 8;
+                            }
+                        }
+                    }
+
+                    _sum = activation_avx(_sum, activation_type, activation_params);
+
+                    _mm256_storeu_ps(outptr + j * 8, _sum);
+                }
+
+                outptr += outw * 8;
+            }
+        }
+    }
+
+    if (out_elempack == 4)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < outch; p++)
+        {
+            float* outptr = top_blob.channel(p);
+
+            for (int i = 0; i < outh; i++)
+            {
+                for (int j = 0; j < outw; j++)
+                {
+                    __m128 _sum = bias_data_ptr ? _mm_loadu_ps(bias_data_ptr + p * 4) : _mm_setzero_ps();
+
+                    const float* kptr = weight_data_packed.channel(p);
+
+                    for (int q = 0; q < channels; q++)
+                    {
+                        const Mat m = bottom_blob.channel(q);
+                        const float* sptr = m.row(i * stride_h) + j * stride_w * 16;
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            const float* slptr = sptr + space_ofs[k] * 16;
+
+                            for (int l = 0; l < 16; l++)
+                            {
+                                __m128 _val = _mm_set1_ps(slptr[l]);
+                                __m128 _w = _mm_loadu_ps(kptr);
+                                _sum = _mm_fmadd_ps(_val, _w, _sum);
+
+                                kptr += 4;
+                            }
+                        }
+                    }
+
+                    _sum = activation_sse(_sum, activation_type, activation_params);
+
+                    _mm_storeu_ps(outptr + j * 4, _sum);
+                }
+
+                outptr += outw * 4;
+            }
+        }
+    }
+
+    if (out_elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < outch; p++)
+        {
+            float* outptr = top_blob.channel(p);
+
+            for (int i = 0; i < outh; i++)
+            {
+                for (int j = 0; j < outw; j++)
+                {
+                    __m512 _sum = _mm512_setzero_ps();
+
+                    const float* kptr = weight_data_packed.channel(p);
+
+                    for (int q = 0; q < channels; q++)
+                    {
+                        const Mat m = bottom_blob.channel(q);
+                        const float* sptr = m.row(i * stride_h) + j * stride_w * 16;
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            __m512 _val = _mm512_loadu_ps(sptr + space_ofs[k] * 16);
+                            __m512 _w = _mm512_loadu_ps(kptr);
+                            _sum = _mm512_fmadd_ps(_val, _w, _sum);
+
+                            kptr += 16;
+                        }
+                    }
+
+                    float sum = bias_data_ptr ? bias_data_ptr[p] : 0.f;
+
+                    sum += _mm512_comp_reduce_add_ps(_sum);
+
+                    sum = activation_ss(sum, activation_type, activation_params);
+
+                    outptr[j] = sum;
+                }
+
+                outptr += outw;
+            }
+        }
+    }
+}
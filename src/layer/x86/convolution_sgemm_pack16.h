@@ -0,0 +1,296 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+static void im2col_sgemm_pack16_avx512(const Mat& bottom_im2col, Mat& top_blob, const Mat& kernel, const Mat& _bias, int activation_type, const Mat& activation_params, const Option& opt)
+{
+    // bottom_im2col memory packed 16 x maxk x size, one channel per input block
+    const int size = top_blob.w * top_blob.h;
+    const int inch = bottom_im2col.c;
+    const int outch = top_blob.c;
+
+    // kernel = pb-pa-maxk-inch/pa-outch/pb
+    const int maxk = kernel.w;
+
+    const float* bias = _bias;
+
+    int nn_outch = outch >> 1;
+    int remain_outch_start = nn_outch << 1;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int pp = 0; pp < nn_outch; pp++)
+    {
+        int p = pp * 2;
+
+        float* outptr0 = top_blob.channel(p);
+        float* outptr1 = top_blob.channel(p + 1);
+
+        __m512 _bias0 = bias ? _mm512_loadu_ps(bias + p * 16) : _mm512_setzero_ps();
+        __m512 _bias1 = bias ? _mm512_loadu_ps(bias + (p + 1) * 16) : _mm512_setzero_ps();
+
+        int i = 0;
+        for (; i + 7 < size; i += 8)
+        {
+            const float* kptr0 = kernel.channel(p);
+            const float* kptr1 = kernel.channel(p + 1);
+
+            __m512 _sum00 = _bias0;
+            __m512 _sum01 = _bias0;
+            __m512 _sum02 = _bias0;
+            __m512 _sum03 = _bias0;
+            __m512 _sum04 = _bias0;
+            __m512 _sum05 = _bias0;
+            __m512 _sum06 = _bias0;
+            __m512 _sum07 = _bias0;
+            __m512 _sum10 = _bias1;
+            __m512 _sum11 = _bias1;
+            __m512 _sum12 = _bias1;
+            __m512 _sum13 = _bias1;
+            __m512 _sum14 = _bias1;
+            __m512 _sum15 = _bias1;
+            __m512 _sum16 = _bias1;
+            __m512 _sum17 = _bias1;
+
+            for (int q = 0; q < inch; q++)
+            {
+                for (int k = 0; k < maxk; k++)
+                {
+                    const float* r0 = (const float*)bottom_im2col.channel(q) + (k * size + i) * 16;
+
+                    for (int l = 0; l < 16; l++)
+                    {
+                        __m512 _w0 = _mm512_loadu_ps(kptr0);
+                        __m512 _w1 = _mm512_loadu_ps(kptr1);
+
+                        __m512 _val0 = _mm512_set1_ps(r0[l]);
+                        __m512 _val1 = _mm512_set1_ps(r0[16 + l]);
+                        _sum00 = _mm512_fmadd_ps(_val0, _w0, _sum00);
+                        _sum10 = _mm512_fmadd_ps(_val0, _w1, _sum10);
+                        _sum01 = _mm512_fmadd_ps(_val1, _w0, _sum01);
+                        _sum11 = _mm512_fmadd_ps(_val1, _w1, _sum11);
+                        __m512 _val2 = _mm512_set1_ps(r0[32 + l]);
+                        __m512 _val3 = _mm512_set1_ps(r0[48 + l]);
+                        _sum02 = _mm512_fmadd_ps(_val2, _w0, _sum02);
+                        _sum12 = _mm512_fmadd_ps(_val2, _w1, _sum12);
+                        _sum03 = _mm512_fmadd_ps(_val3, _w0, _sum03);
+                        _sum13 = _mm512_fmadd_ps(_val3, _w1, _sum13);
+                        __m512 _val4 = _mm512_set1_ps(r0[64 + l]);
+                        __m512 _val5 = _mm512_set1_ps(r0[80 + l]);
+                        _sum04 = _mm512_fmadd_ps(_val4, _w0, _sum04);
+                        _sum14 = _mm512_fmadd_ps(_val4, _w1, _sum14);
+                        _sum05 = _mm512_fmadd_ps(_val5, _w0, _sum05);
+                        _sum15 = _mm512_fmadd_ps(_val5, _w1, _sum15);
+                        __m512 _val6 = _mm512_set1_ps(r0[96 + l]);
+                        __m512 _val7 = _mm512_set1_ps(r0[112 + l]);
+                        _sum06 = _mm512_fmadd_ps(_val6, _w0, _sum06);
+                        _sum16 = _mm512_fmadd_ps(_val6, _w1, _sum16);
+                        _sum07 = _mm512_fmadd_ps(_val7, _w0, _sum07);
+                        _sum17 = _mm512_fmadd_ps(_val7, _w1, _sum17);
+
+                        kptr0 += 16;
+                        kptr1 += 16;
+                    }
+                }
+            }
+
+            _mm512_storeu_ps(outptr0, activation_avx512(_sum00, activation_type, activation_params));
+            _mm512_storeu_ps(outptr0 + 16, activation_avx512(_sum01, activation_type, activation_params));
+            _mm512_storeu_ps(outptr0 + 32, activation_avx512(_sum02, activation_type, activation_params));
+            _mm512_storeu_ps(outptr0 + 48, activation_avx512(_sum03, activation_type, activation_params));
+            _mm512_storeu_ps(outptr0 + 64, activation_avx512(_sum04, activation_type, activation_params));
+            _mm512_storeu_ps(outptr0 + 80, activation_avx512(_sum05, activation_type, activation_params));
+            _mm512_storeu_ps(outptr0 + 96, activation_avx512(_sum06, activation_type, activation_params));
+            _mm512_storeu_ps(outptr0 + 112, activation_avx512(_sum07, activation_type, activation_params));
+            _mm512_storeu_ps(outptr1, activation_avx512(_sum10, activation_type, activation_params));
+            _mm512_storeu_ps(outptr1 + 16, activation_avx512(_sum11, activation_type, activation_params));
+            _mm512_storeu_ps(outptr1 + 32, activation_avx512(_sum12, activation_type, activation_params));
+            _mm512_storeu_ps(outptr1 + 48, activation_avx512(_sum13, activation_type, activation_params));
+            _mm512_storeu_ps(outptr1 + 64, activation_avx512(_sum14, activation_type, activation_params));
+            _mm512_storeu_ps(outptr1 + 80, activation_avx512(_sum15, activation_type, activation_params));
+            _mm512_storeu_ps(outptr1 + 96, activation_avx512(_sum16, activation_type, activation_params));
+            _mm512_storeu_ps(outptr1 + 112, activation_avx512(_sum17, activation_type, activation_params));
+
+            outptr0 += 128;
+            outptr1 += 128;
+        }
+        for (; i < size; i++)
+        {
+            const float* kptr0 = kernel.channel(p);
+            const float* kptr1 = kernel.channel(p + 1);
+
+            __m512 _sum0 = _bias0;
+            __m512 _sum1 = _bias1;
+
+            for (int q = 0; q < inch; q++)
+            {
+                for (int k = 0; k < maxk; k++)
+                {
+                    const float* r0 = (const float*)bottom_im2col.channel(q) + (k * size + i) * 16;
+
+                    for (int l = 0; l < 16; l++)
+                    {
+                        __m512 _val = _mm512_set1_ps(r0[l]);
+                        _sum0 = _mm512_fmadd_ps(_val, _mm512_loadu_ps(kptr0), _sum0);
+                        _sum1 = _mm512_fmadd_ps(_val, _mm512_loadu_ps(kptr1), _sum1);
+
+                        kptr0 += 16;
+                        kptr1 += 16;
+                    }
+                }
+            }
+
+            _mm512_storeu_ps(outptr0, activation_avx512(_sum0, activation_type, activation_params));
+            _mm512_storeu_ps(outptr1, activation_avx512(_sum1, activation_type, activation_params));
+
+            outptr0 += 16;
+            outptr1 += 16;
+        }
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = remain_outch_start; p < outch; p++)
+    {
+        float* outptr0 = top_blob.channel(p);
+
+        __m512 _bias0 = bias ? _mm512_loadu_ps(bias + p * 16) : _mm512_setzero_ps();
+
+        int i = 0;
+        for (; i + 7 < size; i += 8)
+        {
+            const float* kptr0 = kernel.channel(p);
+
+            __m512 _sum0 = _bias0;
+            __m512 _sum1 = _bias0;
+            __m512 _sum2 = _bias0;
+            __m512 _sum3 = _bias0;
+            __m512 _sum4 = _bias0;
+            __m512 _sum5 = _bias0;
+            __m512 _sum6 = _bias0;
+            __m512 _sum7 = _bias0;
+
+            for (int q = 0; q < inch; q++)
+            {
+                for (int k = 0; k < maxk; k++)
+                {
+                    const float* r0 = (const float*)bottom_im2col.channel(q) + (k * size + i) * 16;
+
+                    for (int l = 0; l < 16; l++)
+                    {
+                        __m512 _w0 = _mm512_loadu_ps(kptr0);
+
+                        _sum0 = _mm512_fmadd_ps(_mm512_set1_ps(r0[l]), _w0, _sum0);
+                        _sum1 = _mm512_fmadd_ps(_mm512_set1_ps(r0[16 + l]), _w0, _sum1);
+                        _sum2 = _mm512_fmadd_ps(_mm512_set1_ps(r0[32 + l]), _w0, _sum2);
+                        _sum3 = _mm512_fmadd_ps(_mm512_set1_ps(r0[48 + l]), _w0, _sum3);
+                        _sum4 = _mm512_fmadd_ps(_mm512_set1_ps(r0[64 + l]), _w0, _sum4);
+                        _sum5 = _mm512_fmadd_ps(_mm512_set1_ps(r0[80 + l]), _w0, _sum5);
+                        _sum6 = _mm512_fmadd_ps(_mm512_set1_ps(r0[96 + l]), _w0, _sum6);
+                        _sum7 = _mm512_fmadd_ps(_mm512_set1_ps(r0[112 + l]), _w0, _sum7);
+
+                        kptr0 += 16;
+                    }
+                }
+            }
+
+            _mm512_storeu_ps(outptr0, activation_avx512(_sum0, activation_type, activation_params));
+            _mm512_storeu_ps(outptr0 + 16, activation_avx512(_sum1, activation_type, activation_params));
+            _mm512_storeu_ps(outptr0 + 32, activation_avx512(_sum2, activation_type, activation_params));
+            _mm512_storeu_ps(outptr0 + 48, activation_avx512(_sum3, activation_type, activation_params));
+            _mm512_storeu_ps(outptr0 + 64, activation_avx512(_sum4, activation_type, activation_params));
+            _mm512_storeu_ps(outptr0 + 80, activation_avx512(_sum5, activation_type, activation_params));
+            _mm512_storeu_ps(outptr0 + 96, activation_avx512(_sum6, activation_type, activation_params));
+            _mm512_storeu_ps(outptr0 + 112, activation_avx512(_sum7, activation_type, activation_params));
+
+            outptr0 += 128;
+        }
+        for (; i < size; i++)
+        {
+            const float* kptr0 = kernel.channel(p);
+
+            __m512 _sum0 = _bias0;
+
+            for (int q = 0; q < inch; q++)
+            {
+                for (int k = 0; k < maxk; k++)
+                {
+                    const float* r0 = (const float*)bottom_im2col.channel(q) + (k * size + i) * 16;
+
+                    for (int l = 0; l < 16; l++)
+                    {
+                        _sum0 = _mm512_fmadd_ps(_mm512_set1_ps(r0[l]), _mm512_loadu_ps(kptr0), _sum0);
+
+                        kptr0 += 16;
+                    }
+                }
+            }
+
+            _mm512_storeu_ps(outptr0, activation_avx512(_sum0, activation_type, activation_params));
+
+            outptr0 += 16;
+        }
+    }
+}
+
+static void conv1x1s1_sgemm_pack16_avx512(const Mat& bottom_blob, Mat& top_blob, const Mat& kernel, const Mat& _bias, int activation_type, const Mat& activation_params, const Option& opt)
+{
+    // the input channel is already laid out as 16 x size
+    im2col_sgemm_pack16_avx512(bottom_blob, top_blob, kernel, _bias, activation_type, activation_params, opt);
+}
+
+static void convolution_im2col_sgemm_pack16_avx512(const Mat& bottom_blob, Mat& top_blob, const Mat& kernel, const Mat& _bias, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, int activation_type, const Mat& activation_params, const Option& opt)
+{
+    int w = bottom_blob.w;
+    int inch = bottom_blob.c;
+
+    int outw = top_blob.w;
+    int outh = top_blob.h;
+    const int size = outw * outh;
+
+    const int maxk = kernel_w * kernel_h;
+
+    // im2col
+    Mat bottom_im2col(size, maxk, inch, 64u, 16, opt.workspace_allocator);
+    {
+        const int gap = (w * stride_h - outw * stride_w) * 16;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < inch; p++)
+        {
+            const Mat img = bottom_blob.channel(p);
+            float* ptr = bottom_im2col.channel(p);
+
+            for (int u = 0; u < kernel_h; u++)
+            {
+                for (int v = 0; v < kernel_w; v++)
+                {
+                    const float* sptr = img.row(dilation_h * u) + dilation_w * v * 16;
+
+                    for (int i = 0; i < outh; i++)
+                    {
+                        for (int j = 0; j < outw; j++)
+                        {
+                            _mm512_storeu_ps(ptr, _mm512_loadu_ps(sptr));
+
+                            sptr += stride_w * 16;
+                            ptr += 16;
+                        }
+
+                        sptr += gap;
+                    }
+                }
+            }
+        }
+    }
+
+    im2col_sgemm_pack16_avx512(bottom_im2col, top_blob, kernel, _bias, activation_type, activation_params, opt);
+}
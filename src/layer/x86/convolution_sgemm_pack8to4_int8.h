@@ -12,8 +12,32 @@
 // CONDITIONS OF ANY KIND, either express or implied. See the License for the
 // specific language governing permissions and limitations under the License.
 
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+void im2col_sgemm_pack8to4_int8_avx512vnni(const Mat& bottom_im2col, Mat& top_blob, const Mat& kernel, const Option& opt);
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVXVNNI && __AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+void im2col_sgemm_pack8to4_int8_avxvnni(const Mat& bottom_im2col, Mat& top_blob, const Mat& kernel, const Option& opt);
+#endif
+
 static void im2col_sgemm_pack8to4_int8_sse(const Mat& bottom_im2col, Mat& top_blob, const Mat& kernel, const Option& opt)
 {
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx512_vnni())
+    {
+        im2col_sgemm_pack8to4_int8_avx512vnni(bottom_im2col, top_blob, kernel, opt);
+        return;
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVXVNNI && __AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx_vnni())
+    {
+        im2col_sgemm_pack8to4_int8_avxvnni(bottom_im2col, top_blob, kernel, opt);
+        return;
+    }
+#endif
+
     // Mat bottom_im2col(size, maxk, inch, 8u, 8, opt.workspace_allocator);
 
     const int size = bottom_im2col.w;
@@ -46,6 +70,10 @@ static void im2col_sgemm_pack8to4_int8_sse(const Mat& bottom_im2col, Mat& top_bl
                 for (int k = 0; k < maxk; k++)
                 {
                     __m128i _v = _mm_loadu_si128((const __m128i*)img0);
+#if __AVX512VNNI__ || __AVXVNNI__
+                    // shift to unsigned for dpbusd
+                    _v = _mm_xor_si128(_v, _mm_set1_epi8(-128));
+#endif
                     _mm_storeu_si128((__m128i*)tmpptr, _v);
                     tmpptr += 2;
                     img0 += size;
@@ -66,7 +94,12 @@ static void im2col_sgemm_pack8to4_int8_sse(const Mat& bottom_im2col, Mat& top_bl
 
                 for (int k = 0; k < maxk; k++)
                 {
+#if __AVX512VNNI__ || __AVXVNNI__
+                    // shift to unsigned for dpbusd
+                    tmpptr[0] = img0[0] ^ (int64_t)0x8080808080808080ULL;
+#else
                     tmpptr[0] = img0[0];
+#endif
                     tmpptr += 1;
                     img0 += size;
                 }
@@ -74,6 +107,79 @@ static void im2col_sgemm_pack8to4_int8_sse(const Mat& bottom_im2col, Mat& top_bl
         }
     }
 
+#if __AVX512VNNI__ || __AVXVNNI__
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < outch; p++)
+    {
+        int* outptr0 = top_blob.channel(p);
+
+        const int nn = inch * maxk; // inch always > 0
+
+        // the input is biased by 128, take 128 * sum(w) off each output
+        // precomputed in the row after the interleaved weights
+        __m256i _w_shift = _mm256_loadu_si256((const __m256i*)kernel.channel(p).row<const int>(inch));
+
+        int i = 0;
+        for (; i + 1 < size; i += 2)
+        {
+            const signed char* tmpptr = tmp.channel(i / 2);
+            const signed char* kptr0 = kernel.channel(p);
+
+            // lane 2n and 2n+1 hold the two input halves of output n
+            __m256i _sum0 = _mm256_setzero_si256();
+            __m256i _sum1 = _mm256_setzero_si256();
+
+            for (int j = 0; j < nn; j++)
+            {
+                __m256i _val0 = _mm256_set1_epi64x(((const int64_t*)tmpptr)[0]);
+                __m256i _val1 = _mm256_set1_epi64x(((const int64_t*)tmpptr)[1]);
+                __m256i _w = _mm256_loadu_si256((const __m256i*)kptr0);
+
+                _sum0 = _mm256_comp_dpbusd_epi32(_sum0, _val0, _w);
+                _sum1 = _mm256_comp_dpbusd_epi32(_sum1, _val1, _w);
+
+                tmpptr += 16;
+                kptr0 += 32;
+            }
+
+            _sum0 = _mm256_sub_epi32(_sum0, _w_shift);
+            _sum1 = _mm256_sub_epi32(_sum1, _w_shift);
+
+            // 00 01 10 11 02 03 12 13 -> 00 01 02 03 10 11 12 13
+            __m256i _sum01 = _mm256_hadd_epi32(_sum0, _sum1);
+            _sum01 = _mm256_permute4x64_epi64(_sum01, _MM_SHUFFLE(3, 1, 2, 0));
+
+            _mm256_storeu_si256((__m256i*)outptr0, _sum01);
+            outptr0 += 8;
+        }
+        for (; i < size; i++)
+        {
+            const signed char* tmpptr = tmp.channel(i / 2 + i % 2);
+            const signed char* kptr0 = kernel.channel(p);
+
+            __m256i _sum0 = _mm256_setzero_si256();
+
+            for (int j = 0; j < nn; j++)
+            {
+                __m256i _val = _mm256_set1_epi64x(((const int64_t*)tmpptr)[0]);
+                __m256i _w = _mm256_loadu_si256((const __m256i*)kptr0);
+
+                _sum0 = _mm256_comp_dpbusd_epi32(_sum0, _val, _w);
+
+                tmpptr += 8;
+                kptr0 += 32;
+            }
+
+            _sum0 = _mm256_sub_epi32(_sum0, _w_shift);
+
+            __m256i _sum00 = _mm256_hadd_epi32(_sum0, _sum0);
+            _sum00 = _mm256_permute4x64_epi64(_sum00, _MM_SHUFFLE(3, 1, 2, 0));
+
+            _mm_storeu_si128((__m128i*)outptr0, _mm256_castsi256_si128(_sum00));
+            outptr0 += 4;
+        }
+    }
+#else  // __AVX512VNNI__ || __AVXVNNI__
     #pragma omp parallel for num_threads(opt.num_threads)
     for (int p = 0; p < outch; p++)
     {
@@ -262,6 +368,7 @@ static void im2col_sgemm_pack8to4_int8_sse(const Mat& bottom_im2col, Mat& top_bl
             outptr0 += 4;
         }
     }
+#endif // __AVX512VNNI__ || __AVXVNNI__
 }
 
 static void convolution_im2col_sgemm_transform_kernel_pack8to4_int8_sse(const Mat& _kernel, Mat& kernel_tm, int inch, int outch, int kernel_w, int kernel_h)
@@ -270,14 +377,21 @@ static void convolution_im2col_sgemm_transform_kernel_pack8to4_int8_sse(const Ma
 
     // interleave
     // src = maxk-inch-outch
-    // dst = 8a-4b-maxk-inch/8a-outch/4b
+    // dst = 8a-4b-maxk-inch/8a-outch/4b, then a row of 8 int32 w_shift
     Mat kernel = _kernel.reshape(maxk, inch, outch);
-    kernel_tm.create(32 * maxk, inch / 8, outch / 4, 1u);
+    kernel_tm.create(32 * maxk, inch / 8 + 1, outch / 4, 1u);
 
     for (int q = 0; q + 3 < outch; q += 4)
     {
         signed char* g00 = kernel_tm.channel(q / 4);
 
+        // vnni biases the input by 128, keep 128 * sum(w) of each dpbusd lane
+        int* w_shift = kernel_tm.channel(q / 4).row<int>(inch / 8);
+        for (int i = 0; i < 8; i++)
+        {
+            w_shift[i] = 0;
+        }
+
         for (int p = 0; p + 7 < inch; p += 8)
         {
             for (int k = 0; k < maxk; k++)
@@ -289,6 +403,7 @@ static void convolution_im2col_sgemm_transform_kernel_pack8to4_int8_sse(const Ma
                         const signed char* k00 = kernel.channel(q + i).row<const signed char>(p + j);
 
                         g00[0] = k00[k];
+                        w_shift[i * 2 + j / 4] += k00[k] * 128;
 
                         g00++;
                     }
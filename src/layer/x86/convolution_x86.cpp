@@ -24,6 +24,7 @@
 #include "x86_usability.h"
 
 #include "benchmark.h"
+#include "cpu.h"
 #include "layer_type.h"
 
 namespace ncnn {
@@ -62,6 +63,10 @@ namespace ncnn {
 #include "convolution_2x2_pack8_fp16.h"
 #include "convolution_1x1_pack8_fp16.h"
 #endif
+#if __AVX512F__
+#include "convolution_pack16.h"
+#include "convolution_sgemm_pack16.h"
+#endif // __AVX512F__
 #endif
 #endif // __SSE2__
 
@@ -72,16 +77,60 @@ Convolution_x86::Convolution_x86()
 #if __AVX2__
     support_weight_fp16_storage = true;
 #endif
+#if __AVX512F__
+    support_avx512_pack16 = true;
+#endif
 #endif // __SSE2__
 
     activation = 0;
     convolution_dilation1 = 0;
+    weight_prepacked = false;
 }
 
 int Convolution_x86::create_pipeline(const Option& opt)
 {
     activation = create_activation_layer(activation_type, activation_params, opt);
 
+#if NCNN_INT8
+    if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
+    {
+        // int8 kernels take pack8 input at most
+        support_avx512_pack16 = false;
+    }
+#endif
+
+#if __AVX512F__
+    {
+        // pack16 to packn is a plain direct loop, far behind the pack8 kernels
+        // packn to pack16 is a plain direct loop too, which only pays off for large kernels
+        // 3x3s1 winograd only has a pack8 kernel, which beats pack16 im2col sgemm by far
+        // unless the output is tiny and the larger transformed weights dominate
+        const int num_input = weight_data_size / (kernel_w * kernel_h) / num_output;
+        if (num_output % 16 != 0)
+        {
+            support_avx512_pack16 = false;
+        }
+        if (num_input % 16 != 0 && ((kernel_w == 1 && kernel_h == 1) || (kernel_w == 3 && kernel_h == 3)))
+        {
+            support_avx512_pack16 = false;
+        }
+        if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1 && num_input >= 16 && num_output >= 16)
+        {
+            const bool tiny_output = !top_shapes.empty() && top_shapes[0].dims == 3 && top_shapes[0].w * top_shapes[0].h < 100;
+            if (!tiny_output)
+            {
+                support_avx512_pack16 = false;
+            }
+        }
+    }
+#endif // __AVX512F__
+
+    if (weight_prepacked)
+    {
+        // transformed weight data is ready
+        return 0;
+    }
+
 #if NCNN_INT8
     if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
     {
@@ -140,7 +189,10 @@ int Convolution_x86::create_pipeline(const Option& opt)
 #if __SSE2__
     if (opt.use_packing_layout)
     {
-#if __AVX__
+#if __AVX512F__
+        elempack = support_avx512_pack16 && num_input % 16 == 0 ? 16 : num_input % 8 == 0 ? 8 : num_input % 4 == 0 ? 4 : 1;
+        out_elempack = support_avx512_pack16 && num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
         elempack = num_input % 8 == 0 ? 8 : num_input % 4 == 0 ? 4 : 1;
         out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
 #else
@@ -274,6 +326,48 @@ int Convolution_x86::destroy_pipeline(const Option& opt)
         convolution_dilation1 = 0;
     }
 
+    weight_prepacked = false;
+
+    return 0;
+}
+
+int Convolution_x86::get_prepacked(std::vector<Mat>& weights) const
+{
+    if (convolution_dilation1)
+    {
+        // the inner convolution holds the transformed weight data
+        return -1;
+    }
+
+    weights.resize(6);
+    weights[0] = weight_sgemm_data;
+    weights[1] = weight_3x3_winograd23_data;
+    weights[2] = weight_data_packed;
+    weights[3] = weight_3x3_winograd64_data_pack8;
+#if NCNN_INT8
+    weights[4] = weight_data_int8;
+    weights[5] = weight_3x3_winograd23_data_int8;
+#endif
+
+    return 0;
+}
+
+int Convolution_x86::set_prepacked(const std::vector<Mat>& weights)
+{
+    if (weights.size() != 6)
+        return -1;
+
+    weight_sgemm_data = weights[0];
+    weight_3x3_winograd23_data = weights[1];
+    weight_data_packed = weights[2];
+    weight_3x3_winograd64_data_pack8 = weights[3];
+#if NCNN_INT8
+    weight_data_int8 = weights[4];
+    weight_3x3_winograd23_data_int8 = weights[5];
+#endif
+
+    weight_prepacked = true;
+
     return 0;
 }
 
@@ -327,7 +421,9 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
 #if __SSE2__
     if (opt.use_packing_layout)
     {
-#if __AVX__
+#if __AVX512F__
+        out_elempack = support_avx512_pack16 && num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
         out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
 #else
         out_elempack = num_output % 4 == 0 ? 4 : 1;
@@ -373,6 +469,36 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
 
 #if __SSE2__
 #if __AVX__
+#if __AVX512F__
+    if (elempack == 16 && out_elempack == 16)
+    {
+        if (kernel_w == 1 && kernel_h == 1 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
+        {
+            conv1x1s1_sgemm_pack16_avx512(bottom_blob_bordered, top_blob, weight_data_packed, bias_data, activation_type, activation_params, opt);
+        }
+        else
+        {
+            convolution_im2col_sgemm_pack16_avx512(bottom_blob_bordered, top_blob, weight_data_packed, bias_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, activation_type, activation_params, opt);
+        }
+
+        return 0;
+    }
+
+    if (elempack != 16 && out_elempack == 16)
+    {
+        convolution_packnto16_avx512(bottom_blob_bordered, top_blob, weight_data_packed, bias_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, activation_type, activation_params, opt);
+
+        return 0;
+    }
+
+    if (elempack == 16 && out_elempack != 16)
+    {
+        convolution_pack16ton_avx512(bottom_blob_bordered, top_blob, weight_data_packed, bias_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, activation_type, activation_params, opt);
+
+        return 0;
+    }
+#endif // __AVX512F__
+
     if (elempack == 8 && out_elempack == 8)
     {
         if (kernel_w == 1 && kernel_h == 1 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
@@ -1064,6 +1190,91 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
     return 0;
 }
 
+int Convolution_x86::forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const int batch = (int)bottom_blobs.size();
+    if (batch < 2)
+        return Layer::forward_batch(bottom_blobs, top_blobs, opt);
+
+#if NCNN_INT8
+    if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
+    {
+        return Layer::forward_batch(bottom_blobs, top_blobs, opt);
+    }
+#endif
+
+    const Mat& bottom_blob0 = bottom_blobs[0];
+
+    // pointwise convolution does not mix pixels
+    // samples stacked along h share one sgemm call and one pass over the weights
+    const bool is_pointwise = kernel_w == 1 && kernel_h == 1 && stride_w == 1 && stride_h == 1 && pad_left == 0 && pad_right == 0 && pad_top == 0 && pad_bottom == 0;
+    if (!is_pointwise || bottom_blob0.dims != 3 || bottom_blob0.elembits() != 32)
+        return Layer::forward_batch(bottom_blobs, top_blobs, opt);
+
+    const int w = bottom_blob0.w;
+    const int h = bottom_blob0.h;
+    const int channels = bottom_blob0.c;
+    const size_t elemsize = bottom_blob0.elemsize;
+    const int elempack = bottom_blob0.elempack;
+
+    Option opt_ws = opt;
+    opt_ws.blob_allocator = opt.workspace_allocator;
+
+    Mat bottom_blob_stacked(w, h * batch, channels, elemsize, elempack, opt.workspace_allocator);
+    if (bottom_blob_stacked.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        Mat m = bottom_blob_stacked.channel(q);
+
+        for (int b = 0; b < batch; b++)
+        {
+            const unsigned char* ptr = bottom_blobs[b].channel(q);
+            unsigned char* outptr = m.row<unsigned char>(b * h);
+
+            memcpy(outptr, ptr, w * h * elemsize);
+        }
+    }
+
+    Mat top_blob_stacked;
+    int ret = forward(bottom_blob_stacked, top_blob_stacked, opt_ws);
+    if (ret != 0)
+        return ret;
+
+    const int outw = top_blob_stacked.w;
+    const int outh = top_blob_stacked.h / batch;
+    const int out_channels = top_blob_stacked.c;
+    const size_t out_elemsize = top_blob_stacked.elemsize;
+    const int out_elempack = top_blob_stacked.elempack;
+
+    top_blobs.resize(batch);
+    for (int b = 0; b < batch; b++)
+    {
+        Mat& top_blob = top_blobs[b];
+        top_blob.create(outw, outh, out_channels, out_elemsize, out_elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < out_channels; p++)
+    {
+        const Mat m = top_blob_stacked.channel(p);
+
+        for (int b = 0; b < batch; b++)
+        {
+            const unsigned char* ptr = m.row<const unsigned char>(b * outh);
+            unsigned char* outptr = top_blobs[b].channel(p);
+
+            memcpy(outptr, ptr, outw * outh * out_elemsize);
+        }
+    }
+
+    return 0;
+}
+
 #if NCNN_INT8
 int Convolution_x86::create_pipeline_int8_x86(const Option& opt)
 {
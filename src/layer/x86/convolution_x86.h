@@ -29,6 +29,11 @@ public:
 
     virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 
+    virtual int get_prepacked(std::vector<Mat>& weights) const;
+    virtual int set_prepacked(const std::vector<Mat>& weights);
+
+    virtual int forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
 protected:
 #if NCNN_INT8
     int create_pipeline_int8_x86(const Option& opt);
@@ -49,6 +54,9 @@ public:
 
     Mat weight_3x3_winograd64_data_pack8;
 
+    // transformed weight data restored by set_prepacked
+    bool weight_prepacked;
+
 #if NCNN_INT8
     // int8
     Mat weight_data_int8;
@@ -51,6 +51,9 @@ ConvolutionDepthWise_x86::ConvolutionDepthWise_x86()
 #if __AVX2__
     support_weight_fp16_storage = true;
 #endif
+#if __AVX512F__
+    support_avx512_pack16 = true;
+#endif
 #endif // __SSE2__
     activation = 0;
 }
@@ -62,6 +65,9 @@ int ConvolutionDepthWise_x86::create_pipeline(const Option& opt)
 #if NCNN_INT8
     if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
     {
+        // int8 kernels take pack8 input at most
+        support_avx512_pack16 = false;
+
         return create_pipeline_int8_x86(opt);
     }
 #endif
@@ -76,7 +82,9 @@ int ConvolutionDepthWise_x86::create_pipeline(const Option& opt)
 #if __SSE2__
         if (opt.use_packing_layout)
         {
-#if __AVX__
+#if __AVX512F__
+            elempack = channels % 16 == 0 ? 16 : channels % 8 == 0 ? 8 : channels % 4 == 0 ? 4 : 1;
+#elif __AVX__
             elempack = channels % 8 == 0 ? 8 : channels % 4 == 0 ? 4 : 1;
 #else
             elempack = channels % 4 == 0 ? 4 : 1;
@@ -86,6 +94,17 @@ int ConvolutionDepthWise_x86::create_pipeline(const Option& opt)
 
 #if __SSE2__
 #if __AVX__
+#if __AVX512F__
+        // pack16
+        if (elempack == 16)
+        {
+            Mat weight_data_r2 = weight_data.reshape(maxk, group);
+            convert_packing(weight_data_r2, weight_data_packed, 16);
+
+            return 0;
+        }
+#endif // __AVX512F__
+
         // pack8
         if (elempack == 8)
         {
@@ -141,6 +160,14 @@ int ConvolutionDepthWise_x86::create_pipeline(const Option& opt)
     // group convolution
     create_group_ops(opt);
 
+#if __AVX512F__
+    // follow the group convolutions when they keep to pack8
+    if (!group_ops.empty() && !group_ops[0]->support_avx512_pack16)
+    {
+        support_avx512_pack16 = false;
+    }
+#endif // __AVX512F__
+
     return 0;
 }
 
@@ -292,7 +319,9 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
 #if __SSE2__
     if (opt.use_packing_layout)
     {
-#if __AVX__
+#if __AVX512F__
+        out_elempack = support_avx512_pack16 && num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
         out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
 #else
         out_elempack = num_output % 4 == 0 ? 4 : 1;
@@ -312,6 +341,67 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
     {
 #if __SSE2__
 #if __AVX__
+#if __AVX512F__
+        if (elempack == 16)
+        {
+            const int maxk = kernel_w * kernel_h;
+
+            // kernel offsets
+            std::vector<int> _space_ofs(maxk);
+            int* space_ofs = &_space_ofs[0];
+            {
+                int p1 = 0;
+                int p2 = 0;
+                int gap = w * dilation_h - kernel_w * dilation_w;
+                for (int i = 0; i < kernel_h; i++)
+                {
+                    for (int j = 0; j < kernel_w; j++)
+                    {
+                        space_ofs[p1] = p2;
+                        p1++;
+                        p2 += dilation_w;
+                    }
+                    p2 += gap;
+                }
+            }
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int g = 0; g < channels; g++)
+            {
+                float* outptr = top_blob.channel(g);
+                const float* kptr = (const float*)weight_data_packed + maxk * g * 16;
+                const Mat m = bottom_blob_bordered.channel(g);
+
+                __m512 _bias = bias_term ? _mm512_loadu_ps((const float*)bias_data + g * 16) : _mm512_setzero_ps();
+
+                for (int i = 0; i < outh; i++)
+                {
+                    for (int j = 0; j < outw; j++)
+                    {
+                        __m512 _sum = _bias;
+
+                        const float* sptr = m.row(i * stride_h) + j * stride_w * 16;
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            __m512 _val = _mm512_loadu_ps(sptr + space_ofs[k] * 16);
+                            __m512 _w = _mm512_loadu_ps(kptr + k * 16);
+                            _sum = _mm512_fmadd_ps(_val, _w, _sum);
+                        }
+
+                        _sum = activation_avx512(_sum, activation_type, activation_params);
+
+                        _mm512_storeu_ps(outptr + j * 16, _sum);
+                    }
+
+                    outptr += outw * 16;
+                }
+            }
+
+            return 0;
+        }
+#endif // __AVX512F__
+
         if (elempack == 8)
         {
             if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
@@ -570,7 +660,10 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
 #if __SSE2__
     if (opt.use_packing_layout)
     {
-#if __AVX__
+#if __AVX512F__
+        g_elempack = support_avx512_pack16 && channels_g % 16 == 0 ? 16 : channels_g % 8 == 0 ? 8 : channels_g % 4 == 0 ? 4 : 1;
+        out_g_elempack = support_avx512_pack16 && num_output_g % 16 == 0 ? 16 : num_output_g % 8 == 0 ? 8 : num_output_g % 4 == 0 ? 4 : 1;
+#elif __AVX__
         g_elempack = channels_g % 8 == 0 ? 8 : channels_g % 4 == 0 ? 4 : 1;
         out_g_elempack = num_output_g % 8 == 0 ? 8 : num_output_g % 4 == 0 ? 4 : 1;
 #else
@@ -0,0 +1,195 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+static void deconvolution_im2col_sgemm_transform_kernel_sse(const Mat& weight_data, Mat& kernel_tm, int num_input, int num_output, int maxk, int out_elempack)
+{
+    // src = kw-kh-inch-outch
+    // dst = pb-inch-kw-kh-outch/pb
+    // the input channel order is the same for every input elempack
+    Mat weight_data_r2 = weight_data.reshape(maxk, num_input, num_output);
+
+    kernel_tm.create(num_input, maxk, num_output / out_elempack, (size_t)4u * out_elempack, out_elempack);
+
+    for (int q = 0; q + (out_elempack - 1) < num_output; q += out_elempack)
+    {
+        Mat g0 = kernel_tm.channel(q / out_elempack);
+
+        for (int k = 0; k < maxk; k++)
+        {
+            float* g00 = g0.row(k);
+
+            for (int p = 0; p < num_input; p++)
+            {
+                for (int j = 0; j < out_elempack; j++)
+                {
+                    const float* k00 = weight_data_r2.channel(q + j).row(p);
+
+                    g00[0] = k00[k];
+
+                    g00++;
+                }
+            }
+        }
+    }
+}
+
+static void deconvolution_im2col_sgemm_sse(const Mat& bottom_blob, Mat& top_col, const Mat& kernel_tm, const Mat& _bias, const Option& opt)
+{
+    // bottom_blob = pa-size-inch/pa
+    // top_col = size-maxk-outch
+    const int size = bottom_blob.w * bottom_blob.h;
+    const int inch = bottom_blob.c;
+    const int elempack = bottom_blob.elempack;
+    const int maxk = top_col.h;
+    const int outch = top_col.c;
+
+    const float* bias = _bias;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int pk = 0; pk < outch * maxk; pk++)
+    {
+        const int p = pk / maxk;
+        const int k = pk % maxk;
+
+        float* outptr = top_col.channel(p).row(k);
+        const float* kptr0 = kernel_tm.channel(p).row(k);
+
+        const float bias0 = bias ? bias[p] : 0.f;
+
+        int i = 0;
+        if (elempack == 1)
+        {
+#if __SSE2__
+#if __AVX__
+            for (; i + 7 < size; i += 8)
+            {
+                __m256 _sum = _mm256_set1_ps(bias0);
+
+                for (int q = 0; q < inch; q++)
+                {
+                    __m256 _val = _mm256_loadu_ps((const float*)bottom_blob.channel(q) + i);
+                    _sum = _mm256_comp_fmadd_ps(_val, _mm256_set1_ps(kptr0[q]), _sum);
+                }
+
+                _mm256_storeu_ps(outptr + i, _sum);
+            }
+#endif // __AVX__
+            for (; i + 3 < size; i += 4)
+            {
+                __m128 _sum = _mm_set1_ps(bias0);
+
+                for (int q = 0; q < inch; q++)
+                {
+                    __m128 _val = _mm_loadu_ps((const float*)bottom_blob.channel(q) + i);
+                    _sum = _mm_comp_fmadd_ps(_val, _mm_set1_ps(kptr0[q]), _sum);
+                }
+
+                _mm_storeu_ps(outptr + i, _sum);
+            }
+#endif // __SSE2__
+        }
+        for (; i < size; i++)
+        {
+            // dot product over the packed lanes of each input channel block
+            const float* kptr = kptr0;
+
+            float sum = bias0;
+
+#if __SSE2__
+            __m128 _sum = _mm_setzero_ps();
+#endif // __SSE2__
+
+            for (int q = 0; q < inch; q++)
+            {
+                const float* r0 = (const float*)bottom_blob.channel(q) + i * elempack;
+
+                int l = 0;
+#if __SSE2__
+                for (; l + 3 < elempack; l += 4)
+                {
+                    __m128 _val = _mm_loadu_ps(r0 + l);
+                    __m128 _w = _mm_loadu_ps(kptr + l);
+                    _sum = _mm_comp_fmadd_ps(_val, _w, _sum);
+                }
+#endif // __SSE2__
+                for (; l < elempack; l++)
+                {
+                    sum += r0[l] * kptr[l];
+                }
+
+                kptr += elempack;
+            }
+
+#if __SSE2__
+            sum += _mm_reduce_add_ps(_sum);
+#endif // __SSE2__
+
+            outptr[i] = sum;
+        }
+    }
+}
+
+static void deconvolution_col2im_sse(const Mat& top_col, Mat& top_blob, const Mat& _bias, int w, int h, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, const Option& opt)
+{
+    // scatter-add each kernel tap of the gemm result into the output map
+    const int outch = top_blob.c;
+
+    const float* bias = _bias;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < outch; p++)
+    {
+        Mat out = top_blob.channel(p);
+
+        out.fill(bias ? bias[p] : 0.f);
+
+        const Mat col = top_col.channel(p);
+
+        for (int u = 0; u < kernel_h; u++)
+        {
+            for (int v = 0; v < kernel_w; v++)
+            {
+                const float* colptr = col.row(u * kernel_w + v);
+
+                for (int i = 0; i < h; i++)
+                {
+                    float* outptr = out.row(i * stride_h + u * dilation_h) + v * dilation_w;
+
+                    int j = 0;
+#if __SSE2__
+                    if (stride_w == 1)
+                    {
+                        for (; j + 3 < w; j += 4)
+                        {
+                            __m128 _out = _mm_loadu_ps(outptr);
+                            __m128 _val = _mm_loadu_ps(colptr);
+                            _mm_storeu_ps(outptr, _mm_add_ps(_out, _val));
+
+                            outptr += 4;
+                            colptr += 4;
+                        }
+                    }
+#endif // __SSE2__
+                    for (; j < w; j++)
+                    {
+                        outptr[0] += colptr[0];
+
+                        outptr += stride_w;
+                        colptr += 1;
+                    }
+                }
+            }
+        }
+    }
+}
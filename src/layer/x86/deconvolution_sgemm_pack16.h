@@ -0,0 +1,157 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+static void deconvolution_im2col_sgemm_pack16_avx512(const Mat& bottom_blob, Mat& top_col, const Mat& kernel_tm, const Mat& _bias, const Option& opt)
+{
+    // bottom_blob = pa-size-inch/pa
+    // top_col = 16-size-maxk-outch/16
+    const int size = bottom_blob.w * bottom_blob.h;
+    const int inch = bottom_blob.c;
+    const int elempack = bottom_blob.elempack;
+    const int maxk = top_col.h;
+    const int outch = top_col.c;
+
+    const float* bias = _bias;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int pk = 0; pk < outch * maxk; pk++)
+    {
+        const int p = pk / maxk;
+        const int k = pk % maxk;
+
+        float* outptr = top_col.channel(p).row(k);
+        const float* kptr0 = kernel_tm.channel(p).row(k);
+
+        __m512 _bias0 = bias ? _mm512_loadu_ps(bias + p * 16) : _mm512_setzero_ps();
+
+        int i = 0;
+        for (; i + 7 < size; i += 8)
+        {
+            const float* kptr = kptr0;
+
+            __m512 _sum0 = _bias0;
+            __m512 _sum1 = _bias0;
+            __m512 _sum2 = _bias0;
+            __m512 _sum3 = _bias0;
+            __m512 _sum4 = _bias0;
+            __m512 _sum5 = _bias0;
+            __m512 _sum6 = _bias0;
+            __m512 _sum7 = _bias0;
+
+            for (int q = 0; q < inch; q++)
+            {
+                const float* r0 = (const float*)bottom_blob.channel(q) + i * elempack;
+
+                for (int l = 0; l < elempack; l++)
+                {
+                    __m512 _w = _mm512_loadu_ps(kptr);
+
+                    _sum0 = _mm512_fmadd_ps(_mm512_set1_ps(r0[l]), _w, _sum0);
+                    _sum1 = _mm512_fmadd_ps(_mm512_set1_ps(r0[elempack + l]), _w, _sum1);
+                    _sum2 = _mm512_fmadd_ps(_mm512_set1_ps(r0[elempack * 2 + l]), _w, _sum2);
+                    _sum3 = _mm512_fmadd_ps(_mm512_set1_ps(r0[elempack * 3 + l]), _w, _sum3);
+                    _sum4 = _mm512_fmadd_ps(_mm512_set1_ps(r0[elempack * 4 + l]), _w, _sum4);
+                    _sum5 = _mm512_fmadd_ps(_mm512_set1_ps(r0[elempack * 5 + l]), _w, _sum5);
+                    _sum6 = _mm512_fmadd_ps(_mm512_set1_ps(r0[elempack * 6 + l]), _w, _sum6);
+                    _sum7 = _mm512_fmadd_ps(_mm512_set1_ps(r0[elempack * 7 + l]), _w, _sum7);
+
+                    kptr += 16;
+                }
+            }
+
+            _mm512_storeu_ps(outptr, _sum0);
+            _mm512_storeu_ps(outptr + 16, _sum1);
+            _mm512_storeu_ps(outptr + 32, _sum2);
+            _mm512_storeu_ps(outptr + 48, _sum3);
+            _mm512_storeu_ps(outptr + 64, _sum4);
+            _mm512_storeu_ps(outptr + 80, _sum5);
+            _mm512_storeu_ps(outptr + 96, _sum6);
+            _mm512_storeu_ps(outptr + 112, _sum7);
+
+            outptr += 128;
+        }
+        for (; i < size; i++)
+        {
+            const float* kptr = kptr0;
+
+            __m512 _sum = _bias0;
+
+            for (int q = 0; q < inch; q++)
+            {
+                const float* r0 = (const float*)bottom_blob.channel(q) + i * elempack;
+
+                for (int l = 0; l < elempack; l++)
+                {
+                    __m512 _w = _mm512_loadu_ps(kptr);
+                    _sum = _mm512_fmadd_ps(_mm512_set1_ps(r0[l]), _w, _sum);
+
+                    kptr += 16;
+                }
+            }
+
+            _mm512_storeu_ps(outptr, _sum);
+
+            outptr += 16;
+        }
+    }
+}
+
+static void deconvolution_col2im_pack16_avx512(const Mat& top_col, Mat& top_blob, const Mat& _bias, int w, int h, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, const Option& opt)
+{
+    const int outw = top_blob.w;
+    const int outh = top_blob.h;
+    const int outch = top_blob.c;
+
+    const float* bias = _bias;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < outch; p++)
+    {
+        Mat out = top_blob.channel(p);
+
+        __m512 _bias0 = bias ? _mm512_loadu_ps(bias + p * 16) : _mm512_setzero_ps();
+
+        float* ptr = out;
+        for (int i = 0; i < outw * outh; i++)
+        {
+            _mm512_storeu_ps(ptr, _bias0);
+            ptr += 16;
+        }
+
+        const Mat col = top_col.channel(p);
+
+        for (int u = 0; u < kernel_h; u++)
+        {
+            for (int v = 0; v < kernel_w; v++)
+            {
+                const float* colptr = col.row(u * kernel_w + v);
+
+                for (int i = 0; i < h; i++)
+                {
+                    float* outptr = out.row(i * stride_h + u * dilation_h) + v * dilation_w * 16;
+
+                    for (int j = 0; j < w; j++)
+                    {
+                        __m512 _out = _mm512_loadu_ps(outptr);
+                        __m512 _val = _mm512_loadu_ps(colptr);
+                        _mm512_storeu_ps(outptr, _mm512_add_ps(_out, _val));
+
+                        outptr += stride_w * 16;
+                        colptr += 16;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,244 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "deconvolution_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+#include "layer_type.h"
+
+namespace ncnn {
+
+#include "deconvolution_sgemm.h"
+
+#if __SSE2__
+#include "deconvolution_sgemm_pack4.h"
+#if __AVX__
+#include "deconvolution_sgemm_pack8.h"
+#if __AVX512F__
+#include "deconvolution_sgemm_pack16.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+Deconvolution_x86::Deconvolution_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#if __AVX512F__
+    support_avx512_pack16 = true;
+#endif
+#endif // __SSE2__
+
+    activation = 0;
+    weight_prepacked = false;
+}
+
+int Deconvolution_x86::create_pipeline(const Option& opt)
+{
+    activation = create_activation_layer(activation_type, activation_params, opt);
+
+    if (weight_prepacked)
+    {
+        // transformed weight data is ready
+        return 0;
+    }
+
+    const int maxk = kernel_w * kernel_h;
+    int num_input = weight_data_size / maxk / num_output;
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    // the gemm consumes any input elempack, only the output packing shapes the kernel
+    deconvolution_im2col_sgemm_transform_kernel_sse(weight_data, weight_sgemm_data, num_input, num_output, maxk, out_elempack);
+
+    return 0;
+}
+
+int Deconvolution_x86::destroy_pipeline(const Option& opt)
+{
+    if (activation)
+    {
+        activation->destroy_pipeline(opt);
+        delete activation;
+        activation = 0;
+    }
+
+    weight_prepacked = false;
+
+    return 0;
+}
+
+int Deconvolution_x86::get_prepacked(std::vector<Mat>& weights) const
+{
+    weights.resize(1);
+    weights[0] = weight_sgemm_data;
+
+    return 0;
+}
+
+int Deconvolution_x86::set_prepacked(const std::vector<Mat>& weights)
+{
+    if (weights.size() != 1)
+        return -1;
+
+    weight_sgemm_data = weights[0];
+
+    weight_prepacked = true;
+
+    return 0;
+}
+
+int Deconvolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // deconvolv with NxN kernel
+    // value = value + bias
+
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+
+    int outw = (w - 1) * stride_w + kernel_extent_w + output_pad_right;
+    int outh = (h - 1) * stride_h + kernel_extent_h + output_pad_bottom;
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+    size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    Mat top_blob_bordered;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0 || (output_w > 0 && output_h > 0))
+    {
+        top_blob_bordered.create(outw, outh, num_output / out_elempack, out_elemsize, out_elempack, opt.workspace_allocator);
+    }
+    else
+    {
+        top_blob_bordered = top_blob;
+        top_blob_bordered.create(outw, outh, num_output / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    }
+    if (top_blob_bordered.empty())
+        return -100;
+
+    const int maxk = kernel_w * kernel_h;
+
+    // gemm computes every kernel tap of every input pixel, col2im scatters the taps into the output
+    // 1x1s1 maps input pixels to output pixels one to one, so the gemm writes the output directly
+    const bool direct = maxk == 1 && stride_w == 1 && stride_h == 1 && outw == w && outh == h;
+
+    Mat top_col;
+    if (direct)
+    {
+        top_col = top_blob_bordered.reshape(w * h, 1, num_output / out_elempack);
+    }
+    else
+    {
+        top_col.create(w * h, maxk, num_output / out_elempack, out_elemsize, out_elempack, opt.workspace_allocator);
+    }
+    if (top_col.empty())
+        return -100;
+
+    const Mat& gemm_bias = direct ? bias_data : Mat();
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (out_elempack == 16)
+    {
+        deconvolution_im2col_sgemm_pack16_avx512(bottom_blob, top_col, weight_sgemm_data, gemm_bias, opt);
+
+        if (!direct)
+        {
+            deconvolution_col2im_pack16_avx512(top_col, top_blob_bordered, bias_data, w, h, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, opt);
+        }
+    }
+#endif // __AVX512F__
+
+    if (out_elempack == 8)
+    {
+        deconvolution_im2col_sgemm_pack8_avx(bottom_blob, top_col, weight_sgemm_data, gemm_bias, opt);
+
+        if (!direct)
+        {
+            deconvolution_col2im_pack8_avx(top_col, top_blob_bordered, bias_data, w, h, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, opt);
+        }
+    }
+#endif // __AVX__
+
+    if (out_elempack == 4)
+    {
+        deconvolution_im2col_sgemm_pack4_sse(bottom_blob, top_col, weight_sgemm_data, gemm_bias, opt);
+
+        if (!direct)
+        {
+            deconvolution_col2im_pack4_sse(top_col, top_blob_bordered, bias_data, w, h, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, opt);
+        }
+    }
+#endif // __SSE2__
+
+    if (out_elempack == 1)
+    {
+        deconvolution_im2col_sgemm_sse(bottom_blob, top_col, weight_sgemm_data, gemm_bias, opt);
+
+        if (!direct)
+        {
+            deconvolution_col2im_sse(top_col, top_blob_bordered, bias_data, w, h, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, opt);
+        }
+    }
+
+    cut_padding(top_blob_bordered, top_blob, opt);
+    if (top_blob.empty())
+        return -100;
+
+    if (activation)
+    {
+        activation->forward_inplace(top_blob, opt);
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,484 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "deconvolutiondepthwise_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+#include "layer_type.h"
+
+namespace ncnn {
+
+DeconvolutionDepthWise_x86::DeconvolutionDepthWise_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#if __AVX512F__
+    support_avx512_pack16 = true;
+#endif
+#endif // __SSE2__
+
+    activation = 0;
+}
+
+int DeconvolutionDepthWise_x86::create_pipeline(const Option& opt)
+{
+    activation = create_activation_layer(activation_type, activation_params, opt);
+
+    const int maxk = kernel_w * kernel_h;
+    int channels = (weight_data_size / group) / maxk / (num_output / group) * group;
+
+    // depth-wise
+    if (channels == group && group == num_output)
+    {
+        int elempack = 1;
+#if __SSE2__
+        if (opt.use_packing_layout)
+        {
+#if __AVX512F__
+            elempack = channels % 16 == 0 ? 16 : channels % 8 == 0 ? 8 : channels % 4 == 0 ? 4 : 1;
+#elif __AVX__
+            elempack = channels % 8 == 0 ? 8 : channels % 4 == 0 ? 4 : 1;
+#else
+            elempack = channels % 4 == 0 ? 4 : 1;
+#endif
+        }
+#endif // __SSE2__
+
+        // src = kw-kh-group
+        // dst = pa-kw-kh-group/pa
+        Mat weight_data_r2 = weight_data.reshape(maxk, group);
+        convert_packing(weight_data_r2, weight_data_packed, elempack);
+
+        return 0;
+    }
+
+    // group deconvolution
+    create_group_ops(opt);
+
+    return 0;
+}
+
+int DeconvolutionDepthWise_x86::create_group_ops(const Option& opt)
+{
+    // create Deconvolution op for each group
+    const int maxk = kernel_w * kernel_h;
+    int channels = (weight_data_size / group) / maxk / (num_output / group) * group;
+
+    for (int i = 0; i < (int)group_ops.size(); i++)
+        delete group_ops[i];
+
+    group_ops.clear();
+
+    const int channels_g = channels / group;
+    const int num_output_g = num_output / group;
+
+    group_ops.resize(group);
+
+    for (int g = 0; g < group; g++)
+    {
+        Mat weight_data_g = weight_data.range(maxk * channels_g * num_output_g * g, maxk * channels_g * num_output_g);
+        Mat bias_data_g;
+        if (bias_term)
+            bias_data_g = bias_data.range(num_output_g * g, num_output_g);
+
+        ncnn::Layer* op = ncnn::create_layer(ncnn::LayerType::Deconvolution);
+
+        // set param
+        ncnn::ParamDict pd;
+        pd.set(0, num_output_g); // num_output
+        pd.set(1, kernel_w);
+        pd.set(11, kernel_h);
+        pd.set(2, dilation_w);
+        pd.set(12, dilation_h);
+        pd.set(3, stride_w);
+        pd.set(13, stride_h);
+        pd.set(4, 0);  // pad_w
+        pd.set(14, 0); // pad_h
+        pd.set(18, output_pad_right);
+        pd.set(19, output_pad_bottom);
+        pd.set(5, bias_term);
+        pd.set(6, maxk * channels_g * num_output_g); // weight_data_size
+        pd.set(9, activation_type);
+        pd.set(10, activation_params);
+
+        op->load_param(pd);
+
+        // set weights
+        if (bias_term)
+        {
+            ncnn::Mat weights[2];
+            weights[0] = weight_data_g;
+            weights[1] = bias_data_g;
+
+            op->load_model(ModelBinFromMatArray(weights));
+        }
+        else
+        {
+            ncnn::Mat weights[1];
+            weights[0] = weight_data_g;
+
+            op->load_model(ModelBinFromMatArray(weights));
+        }
+
+        op->create_pipeline(opt);
+
+        group_ops[g] = op;
+    }
+
+    return 0;
+}
+
+int DeconvolutionDepthWise_x86::destroy_pipeline(const Option& opt)
+{
+    if (activation)
+    {
+        activation->destroy_pipeline(opt);
+        delete activation;
+        activation = 0;
+    }
+
+    for (int i = 0; i < (int)group_ops.size(); i++)
+    {
+        group_ops[i]->destroy_pipeline(opt);
+        delete group_ops[i];
+    }
+    group_ops.clear();
+
+    return 0;
+}
+
+int DeconvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // deconvolv with NxN kernel
+    // value = value + bias
+
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int channels = bottom_blob.c;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+
+    int outw = (w - 1) * stride_w + kernel_extent_w + output_pad_right;
+    int outh = (h - 1) * stride_h + kernel_extent_h + output_pad_bottom;
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+    size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    Mat top_blob_bordered;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0 || (output_w > 0 && output_h > 0))
+    {
+        top_blob_bordered.create(outw, outh, num_output / out_elempack, out_elemsize, out_elempack, opt.workspace_allocator);
+    }
+    else
+    {
+        top_blob_bordered = top_blob;
+        top_blob_bordered.create(outw, outh, num_output / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    }
+    if (top_blob_bordered.empty())
+        return -100;
+
+    const int maxk = kernel_w * kernel_h;
+
+    // depth-wise
+    if (channels * elempack == group && group == num_output)
+    {
+        // scatter-add every input pixel into the output window of each kernel tap
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        if (elempack == 16)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int g = 0; g < channels; g++)
+            {
+                Mat out = top_blob_bordered.channel(g);
+                const float* kptr = (const float*)weight_data_packed + maxk * g * 16;
+                const Mat m = bottom_blob.channel(g);
+
+                __m512 _bias = bias_term ? _mm512_loadu_ps((const float*)bias_data + g * 16) : _mm512_setzero_ps();
+                out.fill(_bias);
+
+                for (int y = 0; y < kernel_h; y++)
+                {
+                    for (int x = 0; x < kernel_w; x++)
+                    {
+                        __m512 _w = _mm512_loadu_ps(kptr + (y * kernel_w + x) * 16);
+
+                        for (int i = 0; i < h; i++)
+                        {
+                            const float* sptr = m.row(i);
+                            float* outptr = out.row(i * stride_h + y * dilation_h) + x * dilation_w * 16;
+
+                            for (int j = 0; j < w; j++)
+                            {
+                                __m512 _val = _mm512_loadu_ps(sptr);
+                                __m512 _out = _mm512_loadu_ps(outptr);
+                                _out = _mm512_fmadd_ps(_val, _w, _out);
+                                _mm512_storeu_ps(outptr, _out);
+
+                                sptr += 16;
+                                outptr += stride_w * 16;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+#endif // __AVX512F__
+
+        if (elempack == 8)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int g = 0; g < channels; g++)
+            {
+                Mat out = top_blob_bordered.channel(g);
+                const float* kptr = (const float*)weight_data_packed + maxk * g * 8;
+                const Mat m = bottom_blob.channel(g);
+
+                __m256 _bias = bias_term ? _mm256_loadu_ps((const float*)bias_data + g * 8) : _mm256_setzero_ps();
+                out.fill(_bias);
+
+                for (int y = 0; y < kernel_h; y++)
+                {
+                    for (int x = 0; x < kernel_w; x++)
+                    {
+                        __m256 _w = _mm256_loadu_ps(kptr + (y * kernel_w + x) * 8);
+
+                        for (int i = 0; i < h; i++)
+                        {
+                            const float* sptr = m.row(i);
+                            float* outptr = out.row(i * stride_h + y * dilation_h) + x * dilation_w * 8;
+
+                            for (int j = 0; j < w; j++)
+                            {
+                                __m256 _val = _mm256_loadu_ps(sptr);
+                                __m256 _out = _mm256_loadu_ps(outptr);
+                                _out = _mm256_comp_fmadd_ps(_val, _w, _out);
+                                _mm256_storeu_ps(outptr, _out);
+
+                                sptr += 8;
+                                outptr += stride_w * 8;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+#endif // __AVX__
+
+        if (elempack == 4)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int g = 0; g < channels; g++)
+            {
+                Mat out = top_blob_bordered.channel(g);
+                const float* kptr = (const float*)weight_data_packed + maxk * g * 4;
+                const Mat m = bottom_blob.channel(g);
+
+                __m128 _bias = bias_term ? _mm_loadu_ps((const float*)bias_data + g * 4) : _mm_setzero_ps();
+                {
+                    float* outptr = out;
+                    for (int i = 0; i < outw * outh; i++)
+                    {
+                        _mm_storeu_ps(outptr, _bias);
+                        outptr += 4;
+                    }
+                }
+
+                for (int y = 0; y < kernel_h; y++)
+                {
+                    for (int x = 0; x < kernel_w; x++)
+                    {
+                        __m128 _w = _mm_loadu_ps(kptr + (y * kernel_w + x) * 4);
+
+                        for (int i = 0; i < h; i++)
+                        {
+                            const float* sptr = m.row(i);
+                            float* outptr = out.row(i * stride_h + y * dilation_h) + x * dilation_w * 4;
+
+                            for (int j = 0; j < w; j++)
+                            {
+                                __m128 _val = _mm_loadu_ps(sptr);
+                                __m128 _out = _mm_loadu_ps(outptr);
+                                _out = _mm_comp_fmadd_ps(_val, _w, _out);
+                                _mm_storeu_ps(outptr, _out);
+
+                                sptr += 4;
+                                outptr += stride_w * 4;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+#endif // __SSE2__
+
+        if (elempack == 1)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int g = 0; g < channels; g++)
+            {
+                Mat out = top_blob_bordered.channel(g);
+                const float* kptr = (const float*)weight_data_packed + maxk * g;
+                const Mat m = bottom_blob.channel(g);
+
+                out.fill(bias_term ? bias_data[g] : 0.f);
+
+                for (int y = 0; y < kernel_h; y++)
+                {
+                    for (int x = 0; x < kernel_w; x++)
+                    {
+                        const float w0 = kptr[y * kernel_w + x];
+
+                        for (int i = 0; i < h; i++)
+                        {
+                            const float* sptr = m.row(i);
+                            float* outptr = out.row(i * stride_h + y * dilation_h) + x * dilation_w;
+
+                            int j = 0;
+#if __SSE2__
+                            if (stride_w == 1)
+                            {
+                                __m128 _w = _mm_set1_ps(w0);
+                                for (; j + 3 < w; j += 4)
+                                {
+                                    __m128 _val = _mm_loadu_ps(sptr);
+                                    __m128 _out = _mm_loadu_ps(outptr);
+                                    _out = _mm_comp_fmadd_ps(_val, _w, _out);
+                                    _mm_storeu_ps(outptr, _out);
+
+                                    sptr += 4;
+                                    outptr += 4;
+                                }
+                            }
+#endif // __SSE2__
+                            for (; j < w; j++)
+                            {
+                                outptr[0] += sptr[0] * w0;
+
+                                sptr += 1;
+                                outptr += stride_w;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        cut_padding(top_blob_bordered, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+
+        if (activation)
+        {
+            activation->forward_inplace(top_blob, opt);
+        }
+
+        return 0;
+    }
+
+    // group deconvolution
+    const int channels_g = channels * elempack / group;
+    const int num_output_g = num_output / group;
+
+    int g_elempack = 1;
+    int out_g_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        g_elempack = channels_g % 16 == 0 ? 16 : channels_g % 8 == 0 ? 8 : channels_g % 4 == 0 ? 4 : 1;
+        out_g_elempack = num_output_g % 16 == 0 ? 16 : num_output_g % 8 == 0 ? 8 : num_output_g % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        g_elempack = channels_g % 8 == 0 ? 8 : channels_g % 4 == 0 ? 4 : 1;
+        out_g_elempack = num_output_g % 8 == 0 ? 8 : num_output_g % 4 == 0 ? 4 : 1;
+#else
+        g_elempack = channels_g % 4 == 0 ? 4 : 1;
+        out_g_elempack = num_output_g % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    // unpacking
+    Mat bottom_blob_unpacked = bottom_blob;
+    if (elempack > g_elempack)
+    {
+        Option opt_p = opt;
+        opt_p.blob_allocator = opt.workspace_allocator;
+        convert_packing(bottom_blob, bottom_blob_unpacked, g_elempack, opt_p);
+    }
+
+    Mat top_blob_bordered_unpacked = top_blob_bordered;
+    if (out_g_elempack < out_elempack)
+    {
+        top_blob_bordered_unpacked.create(outw, outh, num_output / out_g_elempack, out_elemsize / out_elempack * out_g_elempack, out_g_elempack, opt.workspace_allocator);
+        if (top_blob_bordered_unpacked.empty())
+            return -100;
+    }
+
+    for (int g = 0; g < group; g++)
+    {
+        const Mat bottom_blob_g = bottom_blob_unpacked.channel_range(channels_g * g / g_elempack, channels_g / g_elempack);
+        Mat top_blob_bordered_g = top_blob_bordered_unpacked.channel_range(num_output_g * g / out_g_elempack, num_output_g / out_g_elempack);
+
+        const ncnn::Layer* op = group_ops[g];
+
+        Option opt_g = opt;
+        opt_g.blob_allocator = top_blob_bordered_unpacked.allocator;
+
+        // forward
+        op->forward(bottom_blob_g, top_blob_bordered_g, opt_g);
+    }
+
+    // packing
+    if (out_g_elempack < out_elempack)
+    {
+        convert_packing(top_blob_bordered_unpacked, top_blob_bordered, out_elempack, opt);
+    }
+    else
+    {
+        top_blob_bordered = top_blob_bordered_unpacked;
+    }
+
+    cut_padding(top_blob_bordered, top_blob, opt);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -29,6 +29,9 @@ Eltwise_x86::Eltwise_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if __AVX512F__
+    support_avx512_pack16 = true;
+#endif // __AVX512F__
 }
 
 int Eltwise_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
@@ -46,6 +49,204 @@ int Eltwise_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
         return -100;
 
 #if __SSE2__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        if (op_type == Operation_PROD)
+        {
+            // first blob
+            const Mat& bottom_blob1 = bottom_blobs[1];
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < channels; q++)
+            {
+                const float* ptr = bottom_blob.channel(q);
+                const float* ptr1 = bottom_blob1.channel(q);
+                float* outptr = top_blob.channel(q);
+
+                for (int i = 0; i < size; i++)
+                {
+                    __m512 _p = _mm512_loadu_ps(ptr);
+                    __m512 _p1 = _mm512_loadu_ps(ptr1);
+                    _p = _mm512_mul_ps(_p, _p1);
+                    _mm512_storeu_ps(outptr, _p);
+
+                    ptr += 16;
+                    ptr1 += 16;
+                    outptr += 16;
+                }
+            }
+
+            for (size_t b = 2; b < bottom_blobs.size(); b++)
+            {
+                const Mat& bottom_blob2 = bottom_blobs[b];
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < channels; q++)
+                {
+                    const float* ptr = bottom_blob2.channel(q);
+                    float* outptr = top_blob.channel(q);
+
+                    for (int i = 0; i < size; i++)
+                    {
+                        __m512 _p = _mm512_loadu_ps(outptr);
+                        __m512 _p1 = _mm512_loadu_ps(ptr);
+                        _p = _mm512_mul_ps(_p, _p1);
+                        _mm512_storeu_ps(outptr, _p);
+
+                        ptr += 16;
+                        outptr += 16;
+                    }
+                }
+            }
+        }
+        if (op_type == Operation_SUM)
+        {
+            if (coeffs.w == 0)
+            {
+                // first blob
+                const Mat& bottom_blob1 = bottom_blobs[1];
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < channels; q++)
+                {
+                    const float* ptr = bottom_blob.channel(q);
+                    const float* ptr1 = bottom_blob1.channel(q);
+                    float* outptr = top_blob.channel(q);
+
+                    for (int i = 0; i < size; i++)
+                    {
+                        __m512 _p = _mm512_loadu_ps(ptr);
+                        __m512 _p1 = _mm512_loadu_ps(ptr1);
+                        _p = _mm512_add_ps(_p, _p1);
+                        _mm512_storeu_ps(outptr, _p);
+
+                        ptr += 16;
+                        ptr1 += 16;
+                        outptr += 16;
+                    }
+                }
+
+                for (size_t b = 2; b < bottom_blobs.size(); b++)
+                {
+                    const Mat& bottom_blob2 = bottom_blobs[b];
+                    #pragma omp parallel for num_threads(opt.num_threads)
+                    for (int q = 0; q < channels; q++)
+                    {
+                        const float* ptr = bottom_blob2.channel(q);
+                        float* outptr = top_blob.channel(q);
+
+                        for (int i = 0; i < size; i++)
+                        {
+                            __m512 _p = _mm512_loadu_ps(outptr);
+                            __m512 _p1 = _mm512_loadu_ps(ptr);
+                            _p = _mm512_add_ps(_p, _p1);
+                            _mm512_storeu_ps(outptr, _p);
+
+                            ptr += 16;
+                            outptr += 16;
+                        }
+                    }
+                }
+            }
+            else
+            {
+                // first blob
+                const Mat& bottom_blob1 = bottom_blobs[1];
+                __m512 _coeff0 = _mm512_set1_ps(coeffs[0]);
+                __m512 _coeff1 = _mm512_set1_ps(coeffs[1]);
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < channels; q++)
+                {
+                    const float* ptr = bottom_blob.channel(q);
+                    const float* ptr1 = bottom_blob1.channel(q);
+                    float* outptr = top_blob.channel(q);
+
+                    for (int i = 0; i < size; i++)
+                    {
+                        __m512 _p = _mm512_loadu_ps(ptr);
+                        __m512 _p1 = _mm512_loadu_ps(ptr1);
+                        _p = _mm512_mul_ps(_p, _coeff0);
+                        _p = _mm512_fmadd_ps(_p1, _coeff1, _p);
+                        _mm512_storeu_ps(outptr, _p);
+
+                        ptr += 16;
+                        ptr1 += 16;
+                        outptr += 16;
+                    }
+                }
+
+                for (size_t b = 2; b < bottom_blobs.size(); b++)
+                {
+                    const Mat& bottom_blob2 = bottom_blobs[b];
+                    __m512 _coeff = _mm512_set1_ps(coeffs[b]);
+                    #pragma omp parallel for num_threads(opt.num_threads)
+                    for (int q = 0; q < channels; q++)
+                    {
+                        const float* ptr = bottom_blob2.channel(q);
+                        float* outptr = top_blob.channel(q);
+
+                        for (int i = 0; i < size; i++)
+                        {
+                            __m512 _p = _mm512_loadu_ps(outptr);
+                            __m512 _p1 = _mm512_loadu_ps(ptr);
+                            _p = _mm512_fmadd_ps(_p1, _coeff, _p);
+                            _mm512_storeu_ps(outptr, _p);
+
+                            ptr += 16;
+                            outptr += 16;
+                        }
+                    }
+                }
+            }
+        }
+        if (op_type == Operation_MAX)
+        {
+            // first blob
+            const Mat& bottom_blob1 = bottom_blobs[1];
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < channels; q++)
+            {
+                const float* ptr = bottom_blob.channel(q);
+                const float* ptr1 = bottom_blob1.channel(q);
+                float* outptr = top_blob.channel(q);
+
+                for (int i = 0; i < size; i++)
+                {
+                    __m512 _p = _mm512_loadu_ps(ptr);
+                    __m512 _p1 = _mm512_loadu_ps(ptr1);
+                    _p = _mm512_max_ps(_p, _p1);
+                    _mm512_storeu_ps(outptr, _p);
+
+                    ptr += 16;
+                    ptr1 += 16;
+                    outptr += 16;
+                }
+            }
+
+            for (size_t b = 2; b < bottom_blobs.size(); b++)
+            {
+                const Mat& bottom_blob2 = bottom_blobs[b];
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < channels; q++)
+                {
+                    const float* ptr = bottom_blob2.channel(q);
+                    float* outptr = top_blob.channel(q);
+
+                    for (int i = 0; i < size; i++)
+                    {
+                        __m512 _p = _mm512_loadu_ps(outptr);
+                        __m512 _p1 = _mm512_loadu_ps(ptr);
+                        _p = _mm512_max_ps(_p, _p1);
+                        _mm512_storeu_ps(outptr, _p);
+
+                        ptr += 16;
+                        outptr += 16;
+                    }
+                }
+            }
+        }
+
+        return 0;
+    }
+#endif // __AVX512F__
 #if __AVX__
     if (elempack == 8)
     {
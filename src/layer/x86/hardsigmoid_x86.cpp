@@ -30,6 +30,9 @@ HardSigmoid_x86::HardSigmoid_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if __AVX512F__
+    support_avx512_pack16 = true;
+#endif // __AVX512F__
 }
 
 int HardSigmoid_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
@@ -41,6 +44,32 @@ int HardSigmoid_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) co
 #if __SSE2__
     int elempack = bottom_top_blob.elempack;
 
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            float* ptr = bottom_top_blob.channel(q);
+
+            __m512 _zero = _mm512_set1_ps(0.f);
+            __m512 _one = _mm512_set1_ps(1.f);
+            for (int i = 0; i < size; i++)
+            {
+                __m512 _p = _mm512_loadu_ps(ptr);
+                __m512 _ans = _mm512_set1_ps(beta);
+                _ans = _mm512_fmadd_ps(_p, _mm512_set1_ps(alpha), _ans);
+                _ans = _mm512_max_ps(_ans, _zero);
+                _ans = _mm512_min_ps(_ans, _one);
+                _mm512_storeu_ps(ptr, _ans);
+
+                ptr += 16;
+            }
+        }
+
+        return 0;
+    }
+#endif // __AVX512F__
 #if __AVX__
     if (elempack == 8)
     {
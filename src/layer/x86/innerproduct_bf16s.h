@@ -0,0 +1,320 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX512BF16 && __AVX512F__ && !__AVX512BF16__
+void innerproduct_bf16s_avx512bf16(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_bf16, const Mat& bias_data, int activation_type, const Mat& activation_params, const Option& opt);
+#endif
+
+static void innerproduct_transform_kernel_bf16s_sse(const Mat& weight_data, Mat& weight_data_bf16, int num_input, int num_output, int out_elempack)
+{
+    // src = inch-outch
+    // dst = 2a-pb-inch/2a-outch/pb, remain inch as pb-inch
+    Mat weight_data_r2 = weight_data.reshape(num_input, num_output);
+
+    weight_data_bf16.create(num_input, num_output / out_elempack, (size_t)2u * out_elempack, out_elempack);
+
+    for (int q = 0; q + (out_elempack - 1) < num_output; q += out_elempack)
+    {
+        unsigned short* g0 = weight_data_bf16.row<unsigned short>(q / out_elempack);
+
+        int p = 0;
+        for (; p + 1 < num_input; p += 2)
+        {
+            for (int j = 0; j < out_elempack; j++)
+            {
+                const float* k0 = weight_data_r2.row(q + j);
+
+                g0[0] = float32_to_bfloat16(k0[p]);
+                g0[1] = float32_to_bfloat16(k0[p + 1]);
+                g0 += 2;
+            }
+        }
+        for (; p < num_input; p++)
+        {
+            for (int j = 0; j < out_elempack; j++)
+            {
+                *g0++ = float32_to_bfloat16(weight_data_r2.row(q + j)[p]);
+            }
+        }
+    }
+}
+
+static void innerproduct_bf16s_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_bf16, const Mat& bias_data, int activation_type, const Mat& activation_params, const Option& opt)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512BF16 && __AVX512F__ && !__AVX512BF16__
+    if (ncnn::cpu_support_x86_avx512_bf16())
+    {
+        innerproduct_bf16s_avx512bf16(bottom_blob, top_blob, weight_data_bf16, bias_data, activation_type, activation_params, opt);
+        return;
+    }
+#endif
+
+    const int num_input = bottom_blob.w;
+    const int out_elempack = top_blob.elempack;
+    const int num_output = top_blob.w * out_elempack;
+
+    const float* bias_data_ptr = bias_data;
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (out_elempack == 16)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < num_output / 16; p++)
+        {
+            const unsigned short* kptr = weight_data_bf16.row<const unsigned short>(p);
+            const unsigned short* sptr = bottom_blob;
+
+            __m512 _sum0 = _mm512_setzero_ps();
+            __m512 _sum1 = _mm512_setzero_ps();
+
+            if (bias_data_ptr)
+            {
+                _sum0 = _mm512_loadu_ps(bias_data_ptr + p * 16);
+            }
+
+            int i = 0;
+            for (; i + 1 < num_input; i += 2)
+            {
+#if __AVX512BF16__
+                __m512i _val = _mm512_set1_epi32(((const int*)sptr)[0]);
+                __m512i _w = _mm512_loadu_si512((const __m512i*)kptr);
+                _sum0 = _mm512_dpbf16_ps(_sum0, (__m512bh)_val, (__m512bh)_w);
+#else
+                // even bf16 lanes hold input i, odd lanes hold input i + 1
+                __m512i _w = _mm512_loadu_si512((const __m512i*)kptr);
+                __m512 _w0 = _mm512_castsi512_ps(_mm512_slli_epi32(_w, 16));
+                __m512 _w1 = _mm512_castsi512_ps(_mm512_and_si512(_w, _mm512_set1_epi32(0xffff0000)));
+                __m512 _val0 = _mm512_set1_ps(bfloat16_to_float32(sptr[0]));
+                __m512 _val1 = _mm512_set1_ps(bfloat16_to_float32(sptr[1]));
+                _sum0 = _mm512_fmadd_ps(_val0, _w0, _sum0);
+                _sum1 = _mm512_fmadd_ps(_val1, _w1, _sum1);
+#endif // __AVX512BF16__
+
+                sptr += 2;
+                kptr += 32;
+            }
+            for (; i < num_input; i++)
+            {
+                __m512 _val = _mm512_set1_ps(bfloat16_to_float32(sptr[0]));
+                __m512 _w = bfloat2float_avx512(_mm256_loadu_si256((const __m256i*)kptr));
+                _sum0 = _mm512_fmadd_ps(_val, _w, _sum0);
+
+                sptr += 1;
+                kptr += 16;
+            }
+
+            _sum0 = _mm512_add_ps(_sum0, _sum1);
+
+            _sum0 = activation_avx512(_sum0, activation_type, activation_params);
+
+            unsigned short* outptr = (unsigned short*)top_blob + p * 16;
+            _mm256_storeu_si256((__m256i*)outptr, float2bfloat_avx512(_sum0));
+        }
+    }
+#endif // __AVX512F__
+
+    if (out_elempack == 8)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < num_output / 8; p++)
+        {
+            const unsigned short* kptr = weight_data_bf16.row<const unsigned short>(p);
+            const unsigned short* sptr = bottom_blob;
+
+            __m256 _sum0 = _mm256_setzero_ps();
+            __m256 _sum1 = _mm256_setzero_ps();
+
+            if (bias_data_ptr)
+            {
+                _sum0 = _mm256_loadu_ps(bias_data_ptr + p * 8);
+            }
+
+            int i = 0;
+            for (; i + 1 < num_input; i += 2)
+            {
+#if __AVX512BF16__
+                __m256i _val = _mm256_set1_epi32(((const int*)sptr)[0]);
+                __m256i _w = _mm256_loadu_si256((const __m256i*)kptr);
+                _sum0 = _mm256_dpbf16_ps(_sum0, (__m256bh)_val, (__m256bh)_w);
+#else
+                // even bf16 lanes hold input i, odd lanes hold input i + 1
+#if __AVX2__
+                __m256i _w = _mm256_loadu_si256((const __m256i*)kptr);
+                __m256 _w0 = _mm256_castsi256_ps(_mm256_slli_epi32(_w, 16));
+                __m256 _w1 = _mm256_castsi256_ps(_mm256_and_si256(_w, _mm256_set1_epi32(0xffff0000)));
+#else
+                __m128i _wl = _mm_loadu_si128((const __m128i*)kptr);
+                __m128i _wh = _mm_loadu_si128((const __m128i*)(kptr + 8));
+                __m128i _mask = _mm_set1_epi32(0xffff0000);
+                __m256 _w0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_castsi128_ps(_mm_slli_epi32(_wl, 16))), _mm_castsi128_ps(_mm_slli_epi32(_wh, 16)), 1);
+                __m256 _w1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_castsi128_ps(_mm_and_si128(_wl, _mask))), _mm_castsi128_ps(_mm_and_si128(_wh, _mask)), 1);
+#endif // __AVX2__
+                __m256 _val0 = _mm256_set1_ps(bfloat16_to_float32(sptr[0]));
+                __m256 _val1 = _mm256_set1_ps(bfloat16_to_float32(sptr[1]));
+                _sum0 = _mm256_comp_fmadd_ps(_val0, _w0, _sum0);
+                _sum1 = _mm256_comp_fmadd_ps(_val1, _w1, _sum1);
+#endif // __AVX512BF16__
+
+                sptr += 2;
+                kptr += 16;
+            }
+            for (; i < num_input; i++)
+            {
+                __m256 _val = _mm256_set1_ps(bfloat16_to_float32(sptr[0]));
+                __m256 _w = bfloat2float_avx(_mm_loadu_si128((const __m128i*)kptr));
+                _sum0 = _mm256_comp_fmadd_ps(_val, _w, _sum0);
+
+                sptr += 1;
+                kptr += 8;
+            }
+
+            _sum0 = _mm256_add_ps(_sum0, _sum1);
+
+            _sum0 = activation_avx(_sum0, activation_type, activation_params);
+
+            unsigned short* outptr = (unsigned short*)top_blob + p * 8;
+            _mm_storeu_si128((__m128i*)outptr, float2bfloat_avx(_sum0));
+        }
+    }
+#endif // __AVX__
+
+    if (out_elempack == 4)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < num_output / 4; p++)
+        {
+            const unsigned short* kptr = weight_data_bf16.row<const unsigned short>(p);
+            const unsigned short* sptr = bottom_blob;
+
+            __m128 _sum0 = _mm_setzero_ps();
+            __m128 _sum1 = _mm_setzero_ps();
+
+            if (bias_data_ptr)
+            {
+                _sum0 = _mm_loadu_ps(bias_data_ptr + p * 4);
+            }
+
+            int i = 0;
+            for (; i + 1 < num_input; i += 2)
+            {
+#if __AVX512BF16__
+                __m128i _val = _mm_set1_epi32(((const int*)sptr)[0]);
+                __m128i _w = _mm_loadu_si128((const __m128i*)kptr);
+                _sum0 = _mm_dpbf16_ps(_sum0, (__m128bh)_val, (__m128bh)_w);
+#else
+                // even bf16 lanes hold input i, odd lanes hold input i + 1
+                __m128i _w = _mm_loadu_si128((const __m128i*)kptr);
+                __m128 _w0 = _mm_castsi128_ps(_mm_slli_epi32(_w, 16));
+                __m128 _w1 = _mm_castsi128_ps(_mm_and_si128(_w, _mm_set1_epi32(0xffff0000)));
+                __m128 _val0 = _mm_set1_ps(bfloat16_to_float32(sptr[0]));
+                __m128 _val1 = _mm_set1_ps(bfloat16_to_float32(sptr[1]));
+                _sum0 = _mm_comp_fmadd_ps(_val0, _w0, _sum0);
+                _sum1 = _mm_comp_fmadd_ps(_val1, _w1, _sum1);
+#endif // __AVX512BF16__
+
+                sptr += 2;
+                kptr += 8;
+            }
+            for (; i < num_input; i++)
+            {
+                __m128 _val = _mm_set1_ps(bfloat16_to_float32(sptr[0]));
+                __m128 _w = bfloat2float_sse(_mm_loadl_epi64((const __m128i*)kptr));
+                _sum0 = _mm_comp_fmadd_ps(_val, _w, _sum0);
+
+                sptr += 1;
+                kptr += 4;
+            }
+
+            _sum0 = _mm_add_ps(_sum0, _sum1);
+
+            _sum0 = activation_sse(_sum0, activation_type, activation_params);
+
+            unsigned short* outptr = (unsigned short*)top_blob + p * 4;
+            _mm_storel_epi64((__m128i*)outptr, float2bfloat_sse(_sum0));
+        }
+    }
+#endif // __SSE2__
+
+    if (out_elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < num_output; p++)
+        {
+            const unsigned short* kptr = weight_data_bf16.row<const unsigned short>(p);
+            const unsigned short* sptr = bottom_blob;
+
+            float sum = 0.f;
+
+            if (bias_data_ptr)
+            {
+                sum = bias_data_ptr[p];
+            }
+
+            int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+            __m512 _sum16 = _mm512_setzero_ps();
+            for (; i + 15 < num_input; i += 16)
+            {
+                __m512 _val = bfloat2float_avx512(_mm256_loadu_si256((const __m256i*)sptr));
+                __m512 _w = bfloat2float_avx512(_mm256_loadu_si256((const __m256i*)kptr));
+                _sum16 = _mm512_fmadd_ps(_val, _w, _sum16);
+
+                sptr += 16;
+                kptr += 16;
+            }
+            sum += _mm512_comp_reduce_add_ps(_sum16);
+#endif // __AVX512F__
+            __m256 _sum8 = _mm256_setzero_ps();
+            for (; i + 7 < num_input; i += 8)
+            {
+                __m256 _val = bfloat2float_avx(_mm_loadu_si128((const __m128i*)sptr));
+                __m256 _w = bfloat2float_avx(_mm_loadu_si128((const __m128i*)kptr));
+                _sum8 = _mm256_comp_fmadd_ps(_val, _w, _sum8);
+
+                sptr += 8;
+                kptr += 8;
+            }
+            sum += _mm256_reduce_add_ps(_sum8);
+#endif // __AVX__
+            __m128 _sum4 = _mm_setzero_ps();
+            for (; i + 3 < num_input; i += 4)
+            {
+                __m128 _val = bfloat2float_sse(_mm_loadl_epi64((const __m128i*)sptr));
+                __m128 _w = bfloat2float_sse(_mm_loadl_epi64((const __m128i*)kptr));
+                _sum4 = _mm_comp_fmadd_ps(_val, _w, _sum4);
+
+                sptr += 4;
+                kptr += 4;
+            }
+            sum += _mm_reduce_add_ps(_sum4);
+#endif // __SSE2__
+            for (; i < num_input; i++)
+            {
+                sum += bfloat16_to_float32(sptr[0]) * bfloat16_to_float32(kptr[0]);
+
+                sptr += 1;
+                kptr += 1;
+            }
+
+            sum = activation_ss(sum, activation_type, activation_params);
+
+            unsigned short* outptr = (unsigned short*)top_blob;
+            outptr[p] = float32_to_bfloat16(sum);
+        }
+    }
+}
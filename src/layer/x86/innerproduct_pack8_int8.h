@@ -0,0 +1,198 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+void innerproduct_pack8_int8_avx512vnni(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_int8, const Option& opt);
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVXVNNI && __AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+void innerproduct_pack8_int8_avxvnni(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_int8, const Option& opt);
+#endif
+
+static void innerproduct_transform_kernel_pack8_int8_sse(const Mat& weight_data, Mat& weight_data_int8, int num_input, int num_output)
+{
+    // src = inch-outch
+    // dst = 4a-8b-inch/4a-outch/8b, remain inch as 8b-inch, then 8 int32 w_shift
+    Mat weight_data_r2 = weight_data.reshape(num_input, num_output);
+
+    weight_data_int8.create(num_input + 4, num_output / 8, (size_t)8u, 8);
+
+    for (int q = 0; q + 7 < num_output; q += 8)
+    {
+        signed char* g0 = weight_data_int8.row<signed char>(q / 8);
+
+        int p = 0;
+        for (; p + 3 < num_input; p += 4)
+        {
+            for (int j = 0; j < 8; j++)
+            {
+                const signed char* k0 = weight_data_r2.row<const signed char>(q + j);
+
+                g0[0] = k0[p];
+                g0[1] = k0[p + 1];
+                g0[2] = k0[p + 2];
+                g0[3] = k0[p + 3];
+                g0 += 4;
+            }
+        }
+        for (; p < num_input; p++)
+        {
+            for (int j = 0; j < 8; j++)
+            {
+                *g0++ = weight_data_r2.row<const signed char>(q + j)[p];
+            }
+        }
+
+        // vnni biases the input by 128, keep 128 * sum(w) of the 4a part for each output
+        int* w_shift = (int*)g0;
+        for (int j = 0; j < 8; j++)
+        {
+            const signed char* k0 = weight_data_r2.row<const signed char>(q + j);
+
+            int sum = 0;
+            for (p = 0; p + 3 < num_input; p += 4)
+            {
+                sum += k0[p] + k0[p + 1] + k0[p + 2] + k0[p + 3];
+            }
+
+            w_shift[j] = sum * 128;
+        }
+    }
+}
+
+static void innerproduct_pack8_int8_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_int8, const Option& opt)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx512_vnni())
+    {
+        innerproduct_pack8_int8_avx512vnni(bottom_blob, top_blob, weight_data_int8, opt);
+        return;
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVXVNNI && __AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx_vnni())
+    {
+        innerproduct_pack8_int8_avxvnni(bottom_blob, top_blob, weight_data_int8, opt);
+        return;
+    }
+#endif
+
+    const int num_input = bottom_blob.w * bottom_blob.elempack;
+    const int num_output = top_blob.w * top_blob.elempack;
+
+    // num_output
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < num_output / 8; p++)
+    {
+        const signed char* kptr = weight_data_int8.row<const signed char>(p);
+        const signed char* sptr = bottom_blob;
+
+        __m128i _sum0 = _mm_setzero_si128();
+        __m128i _sum1 = _mm_setzero_si128();
+
+        int i = 0;
+#if __AVX512VNNI__ || __AVXVNNI__
+        {
+            const __m256i _v128 = _mm256_set1_epi8(-128);
+
+            __m256i _sum = _mm256_setzero_si256();
+
+            for (; i + 3 < num_input; i += 4)
+            {
+                // shift to unsigned for dpbusd
+                __m256i _val = _mm256_set1_epi32(((const int*)sptr)[0]);
+                _val = _mm256_xor_si256(_val, _v128);
+
+                __m256i _w = _mm256_loadu_si256((const __m256i*)kptr);
+
+                _sum = _mm256_comp_dpbusd_epi32(_sum, _val, _w);
+
+                sptr += 4;
+                kptr += 32;
+            }
+
+            // take off 128 * sum(w) precomputed at the end of the row
+            __m256i _w_shift = _mm256_loadu_si256((const __m256i*)(weight_data_int8.row<const signed char>(p) + num_input * 8));
+            _sum = _mm256_sub_epi32(_sum, _w_shift);
+
+            _sum0 = _mm256_castsi256_si128(_sum);
+            _sum1 = _mm256_extracti128_si256(_sum, 1);
+        }
+#else  // __AVX512VNNI__ || __AVXVNNI__
+        {
+            // lane 2n and 2n+1 hold the two input pairs of output n
+            __m128i _sum01 = _mm_setzero_si128();
+            __m128i _sum23 = _mm_setzero_si128();
+            __m128i _sum45 = _mm_setzero_si128();
+            __m128i _sum67 = _mm_setzero_si128();
+
+            for (; i + 3 < num_input; i += 4)
+            {
+                // TODO use _mm_cvtepi8_epi16 on sse4.1
+                __m128i _val = _mm_castps_si128(_mm_load1_ps((const float*)sptr));
+                _val = _mm_unpacklo_epi8(_val, _mm_cmpgt_epi8(_mm_setzero_si128(), _val));
+
+                __m128i _w0123 = _mm_loadu_si128((const __m128i*)kptr);
+                __m128i _w4567 = _mm_loadu_si128((const __m128i*)(kptr + 16));
+                __m128i _extw0123 = _mm_cmpgt_epi8(_mm_setzero_si128(), _w0123);
+                __m128i _extw4567 = _mm_cmpgt_epi8(_mm_setzero_si128(), _w4567);
+                __m128i _w01 = _mm_unpacklo_epi8(_w0123, _extw0123);
+                __m128i _w23 = _mm_unpackhi_epi8(_w0123, _extw0123);
+                __m128i _w45 = _mm_unpacklo_epi8(_w4567, _extw4567);
+                __m128i _w67 = _mm_unpackhi_epi8(_w4567, _extw4567);
+
+                _sum01 = _mm_add_epi32(_sum01, _mm_madd_epi16(_val, _w01));
+                _sum23 = _mm_add_epi32(_sum23, _mm_madd_epi16(_val, _w23));
+                _sum45 = _mm_add_epi32(_sum45, _mm_madd_epi16(_val, _w45));
+                _sum67 = _mm_add_epi32(_sum67, _mm_madd_epi16(_val, _w67));
+
+                sptr += 4;
+                kptr += 32;
+            }
+
+            // 00 01 10 11 + 20 21 30 31 -> 0 1 2 3
+            __m128 _s0 = _mm_shuffle_ps(_mm_castsi128_ps(_sum01), _mm_castsi128_ps(_sum23), _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 _s1 = _mm_shuffle_ps(_mm_castsi128_ps(_sum01), _mm_castsi128_ps(_sum23), _MM_SHUFFLE(3, 1, 3, 1));
+            __m128 _s2 = _mm_shuffle_ps(_mm_castsi128_ps(_sum45), _mm_castsi128_ps(_sum67), _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 _s3 = _mm_shuffle_ps(_mm_castsi128_ps(_sum45), _mm_castsi128_ps(_sum67), _MM_SHUFFLE(3, 1, 3, 1));
+            _sum0 = _mm_add_epi32(_mm_castps_si128(_s0), _mm_castps_si128(_s1));
+            _sum1 = _mm_add_epi32(_mm_castps_si128(_s2), _mm_castps_si128(_s3));
+        }
+#endif // __AVX512VNNI__ || __AVXVNNI__
+        for (; i < num_input; i++)
+        {
+            __m128i _val = _mm_set1_epi16((short)sptr[0]);
+
+            // TODO use _mm_cvtepi8_epi16 on sse4.1
+            __m128i _w = _mm_loadl_epi64((const __m128i*)kptr);
+            _w = _mm_unpacklo_epi8(_w, _mm_cmpgt_epi8(_mm_setzero_si128(), _w));
+
+            __m128i _sl = _mm_mullo_epi16(_val, _w);
+            __m128i _sh = _mm_mulhi_epi16(_val, _w);
+            __m128i _s0 = _mm_unpacklo_epi16(_sl, _sh);
+            __m128i _s1 = _mm_unpackhi_epi16(_sl, _sh);
+
+            _sum0 = _mm_add_epi32(_sum0, _s0);
+            _sum1 = _mm_add_epi32(_sum1, _s1);
+
+            sptr += 1;
+            kptr += 8;
+        }
+
+        int* outptr = (int*)top_blob;
+        _mm_storeu_si128((__m128i*)(outptr + p * 8), _sum0);
+        _mm_storeu_si128((__m128i*)(outptr + p * 8 + 4), _sum1);
+    }
+}
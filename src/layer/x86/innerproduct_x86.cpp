@@ -24,10 +24,21 @@
 #include "x86_activation.h"
 #include "x86_usability.h"
 
+#include "cpu.h"
 #include "layer_type.h"
 
 namespace ncnn {
 
+#if __SSE2__
+#if NCNN_INT8
+#include "innerproduct_pack8_int8.h"
+#endif // NCNN_INT8
+#endif // __SSE2__
+
+#if NCNN_BF16
+#include "innerproduct_bf16s.h"
+#endif // NCNN_BF16
+
 InnerProduct_x86::InnerProduct_x86()
 {
 #if __SSE2__
@@ -37,8 +48,13 @@ InnerProduct_x86::InnerProduct_x86()
 #endif
 #endif // __SSE2__
 
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+
     flatten = 0;
     activation = 0;
+    weight_prepacked = false;
 }
 
 int InnerProduct_x86::create_pipeline(const Option& opt)
@@ -61,6 +77,19 @@ int InnerProduct_x86::create_pipeline(const Option& opt)
     }
 #endif
 
+    if (weight_prepacked)
+    {
+        // transformed weight data is ready
+        return 0;
+    }
+
+#if NCNN_BF16
+    if (opt.use_bf16_storage)
+    {
+        return create_pipeline_bf16s(opt);
+    }
+#endif
+
     const int num_input = weight_data_size / num_output;
 
     int out_elempack = 1;
@@ -121,6 +150,38 @@ int InnerProduct_x86::destroy_pipeline(const Option& opt)
         flatten = 0;
     }
 
+    weight_prepacked = false;
+
+    return 0;
+}
+
+int InnerProduct_x86::get_prepacked(std::vector<Mat>& weights) const
+{
+    weights.resize(4);
+    weights[0] = weight_data_packed;
+    weights[1] = weight_data_fp16;
+#if NCNN_INT8
+    weights[2] = weight_data_int8;
+#endif
+    weights[3] = weight_data_bf16;
+
+    return 0;
+}
+
+int InnerProduct_x86::set_prepacked(const std::vector<Mat>& weights)
+{
+    if (weights.size() != 4)
+        return -1;
+
+    weight_data_packed = weights[0];
+    weight_data_fp16 = weights[1];
+#if NCNN_INT8
+    weight_data_int8 = weights[2];
+#endif
+    weight_data_bf16 = weights[3];
+
+    weight_prepacked = true;
+
     return 0;
 }
 
@@ -133,6 +194,34 @@ int InnerProduct_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Optio
     }
 #endif
 
+#if NCNN_BF16
+    if (opt.use_bf16_storage)
+    {
+        if (bottom_blob.elembits() == 16)
+            return forward_bf16s(bottom_blob, top_blob, opt);
+
+        // fp32 blob from a caller outside the net, such as Convolution on a flattened blob
+        Option opt_ws = opt;
+        opt_ws.blob_allocator = opt.workspace_allocator;
+
+        Mat bottom_blob_bf16;
+        cast_float32_to_bfloat16(bottom_blob, bottom_blob_bf16, opt_ws);
+        if (bottom_blob_bf16.empty())
+            return -100;
+
+        Mat top_blob_bf16;
+        int ret = forward_bf16s(bottom_blob_bf16, top_blob_bf16, opt_ws);
+        if (ret != 0)
+            return ret;
+
+        cast_bfloat16_to_float32(top_blob_bf16, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+#endif
+
     const int num_input = weight_data_size / num_output;
 
     if (bottom_blob.dims == 2 && bottom_blob.w == num_input && bottom_blob.h * bottom_blob.elempack > 1)
@@ -910,6 +999,39 @@ int InnerProduct_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Optio
             const float* sptr = bottom_blob_flattened;
 
             int i = 0;
+#if __AVX512F__
+            {
+                // two inputs per fma, their pack8 weights are adjacent
+                const __m512i _idx01 = _mm512_set_epi32(1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0);
+                const __m512i _idx23 = _mm512_set_epi32(3, 3, 3, 3, 3, 3, 3, 3, 2, 2, 2, 2, 2, 2, 2, 2);
+                const __m512i _idx45 = _mm512_set_epi32(5, 5, 5, 5, 5, 5, 5, 5, 4, 4, 4, 4, 4, 4, 4, 4);
+                const __m512i _idx67 = _mm512_set_epi32(7, 7, 7, 7, 7, 7, 7, 7, 6, 6, 6, 6, 6, 6, 6, 6);
+
+                __m512 _sum01 = _mm512_setzero_ps();
+                __m512 _sum23 = _mm512_setzero_ps();
+                __m512 _sum45 = _mm512_setzero_ps();
+                __m512 _sum67 = _mm512_setzero_ps();
+
+                for (; i + 7 < num_input; i += 8)
+                {
+                    __m512 _val = _mm512_castps256_ps512(_mm256_loadu_ps(sptr));
+
+                    _sum01 = _mm512_fmadd_ps(_mm512_permutexvar_ps(_idx01, _val), _mm512_loadu_ps(kptr), _sum01);
+                    _sum23 = _mm512_fmadd_ps(_mm512_permutexvar_ps(_idx23, _val), _mm512_loadu_ps(kptr + 16), _sum23);
+                    _sum45 = _mm512_fmadd_ps(_mm512_permutexvar_ps(_idx45, _val), _mm512_loadu_ps(kptr + 32), _sum45);
+                    _sum67 = _mm512_fmadd_ps(_mm512_permutexvar_ps(_idx67, _val), _mm512_loadu_ps(kptr + 48), _sum67);
+
+                    sptr += 8;
+                    kptr += 64;
+                }
+
+                _sum01 = _mm512_add_ps(_sum01, _sum23);
+                _sum45 = _mm512_add_ps(_sum45, _sum67);
+                _sum01 = _mm512_add_ps(_sum01, _sum45);
+                _sum0 = _mm256_add_ps(_sum0, _mm512_castps512_ps256(_sum01));
+                _sum1 = _mm512_extractf32x8_ps(_sum01, 1);
+            }
+#endif // __AVX512F__
             for (; i + 7 < num_input; i += 8)
             {
                 __m256 _val0 = _mm256_broadcast_ss(sptr);
@@ -1377,6 +1499,106 @@ int InnerProduct_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Optio
 
     return 0;
 }
+
+int InnerProduct_x86::forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const int batch = (int)bottom_blobs.size();
+    if (batch < 2)
+        return Layer::forward_batch(bottom_blobs, top_blobs, opt);
+
+#if NCNN_INT8
+    if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
+    {
+        return Layer::forward_batch(bottom_blobs, top_blobs, opt);
+    }
+#endif
+
+    const int num_input = weight_data_size / num_output;
+
+    const Mat& bottom_blob0 = bottom_blobs[0];
+    if (bottom_blob0.elembits() != 32 || bottom_blob0.w * bottom_blob0.h * bottom_blob0.c * bottom_blob0.elempack != num_input)
+        return Layer::forward_batch(bottom_blobs, top_blobs, opt);
+
+    Option opt_ws = opt;
+    opt_ws.blob_allocator = opt.workspace_allocator;
+
+    // stack flattened samples as the rows of one matrix and run the gemm path
+    // so that each weight row is read once for the whole batch
+    Mat bottom_blob_stacked(num_input, batch, (size_t)4u, 1, opt.workspace_allocator);
+    if (bottom_blob_stacked.empty())
+        return -100;
+
+    for (int b = 0; b < batch; b++)
+    {
+        Mat bottom_blob_flattened = bottom_blobs[b];
+        if (bottom_blob_flattened.dims != 1)
+        {
+            flatten->forward(bottom_blobs[b], bottom_blob_flattened, opt_ws);
+            if (bottom_blob_flattened.empty())
+                return -100;
+        }
+
+        memcpy(bottom_blob_stacked.row(b), bottom_blob_flattened, num_input * sizeof(float));
+    }
+
+    int elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX__
+        elempack = batch % 8 == 0 ? 8 : batch % 4 == 0 ? 4 : 1;
+#else
+        elempack = batch % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    if (elempack != 1)
+    {
+        Mat bottom_blob_stacked_packed;
+        convert_packing(bottom_blob_stacked, bottom_blob_stacked_packed, elempack, opt_ws);
+        bottom_blob_stacked = bottom_blob_stacked_packed;
+    }
+
+    Mat top_blob_stacked;
+    int ret = forward(bottom_blob_stacked, top_blob_stacked, opt_ws);
+    if (ret != 0)
+        return ret;
+
+    if (top_blob_stacked.elempack != 1)
+    {
+        Mat top_blob_stacked_unpacked;
+        convert_packing(top_blob_stacked, top_blob_stacked_unpacked, 1, opt_ws);
+        top_blob_stacked = top_blob_stacked_unpacked;
+    }
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    // packed 1d blob shares the memory order of the unpacked one
+    top_blobs.resize(batch);
+    for (int b = 0; b < batch; b++)
+    {
+        Mat& top_blob = top_blobs[b];
+        top_blob.create(num_output / out_elempack, (size_t)4u * out_elempack, out_elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        memcpy(top_blob, top_blob_stacked.row(b), num_output * sizeof(float));
+    }
+
+    return 0;
+}
+
 #if __AVX2__
 
 int InnerProduct_x86::forward_fp16(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
@@ -1698,11 +1920,104 @@ int InnerProduct_x86::forward_fp16(const Mat& bottom_blob, Mat& top_blob, const
 }
 #endif // __AVX2__
 
+#if NCNN_BF16
+int InnerProduct_x86::create_pipeline_bf16s(const Option& opt)
+{
+    const int num_input = weight_data_size / num_output;
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    innerproduct_transform_kernel_bf16s_sse(weight_data, weight_data_bf16, num_input, num_output, out_elempack);
+
+    return 0;
+}
+
+int InnerProduct_x86::forward_bf16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int num_input = weight_data_size / num_output;
+
+    const int out_elempack = weight_data_bf16.elempack;
+
+    Option opt_ws = opt;
+    opt_ws.blob_allocator = opt.workspace_allocator;
+
+    Mat bottom_blob_unpacked = bottom_blob;
+    if (bottom_blob.elempack != 1)
+    {
+        convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_ws);
+        if (bottom_blob_unpacked.empty())
+            return -100;
+    }
+
+    if (bottom_blob_unpacked.dims == 2 && bottom_blob_unpacked.w == num_input && bottom_blob_unpacked.h > 1)
+    {
+        // gemm
+        int h = bottom_blob_unpacked.h;
+
+        top_blob.create(num_output, h, 2u, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        // one gemv per row, the packed output of a row is contiguous
+        for (int j = 0; j < h; j++)
+        {
+            const Mat bottom_row(num_input, (void*)bottom_blob_unpacked.row<const unsigned short>(j), 2u);
+            Mat top_row(num_output / out_elempack, top_blob.row<unsigned short>(j), 2u * out_elempack, out_elempack);
+
+            innerproduct_bf16s_sse(bottom_row, top_row, weight_data_bf16, bias_data, activation_type, activation_params, opt);
+        }
+
+        return 0;
+    }
+
+    // flatten
+    Mat bottom_blob_flattened = bottom_blob_unpacked;
+    if (bottom_blob_unpacked.dims != 1)
+    {
+        Option opt_flatten = opt_ws;
+        opt_flatten.use_packing_layout = false;
+
+        flatten->forward(bottom_blob_unpacked, bottom_blob_flattened, opt_flatten);
+        if (bottom_blob_flattened.empty())
+            return -100;
+    }
+
+    top_blob.create(num_output / out_elempack, 2u * out_elempack, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    innerproduct_bf16s_sse(bottom_blob_flattened, top_blob, weight_data_bf16, bias_data, activation_type, activation_params, opt);
+
+    return 0;
+}
+#endif // NCNN_BF16
+
 #if NCNN_INT8
 int InnerProduct_x86::create_pipeline_int8_x86(const Option& opt)
 {
+    // the quantize step consumes fp32 input
+    support_bf16_storage = false;
+
     activation = create_activation_layer(activation_type, activation_params, opt);
 
+    if (weight_prepacked)
+    {
+        // transformed weight data is ready
+        return 0;
+    }
+
     const int num_input = weight_data_size / num_output;
 
     int out_elempack = 1;
@@ -1713,6 +2028,15 @@ int InnerProduct_x86::create_pipeline_int8_x86(const Option& opt)
     }
 #endif // __SSE2__
 
+#if __SSE2__
+    if (out_elempack == 8)
+    {
+        innerproduct_transform_kernel_pack8_int8_sse(weight_data, weight_data_int8, num_input, num_output);
+
+        return 0;
+    }
+#endif // __SSE2__
+
     // src = inch-outch
     // dst = pb-inch-outch/pb
     {
@@ -1793,41 +2117,7 @@ int InnerProduct_x86::forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, co
 #if __SSE2__
     if (out_elempack == 8)
     {
-// num_output
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int p = 0; p < num_output / out_elempack; p++)
-        {
-            __m128i _sum0 = _mm_setzero_si128();
-            __m128i _sum1 = _mm_setzero_si128();
-
-            const signed char* kptr = weight_data_int8.row<const signed char>(p);
-            const signed char* sptr = bottom_blob_int8_flattened;
-
-            int i = 0;
-            for (; i < num_input; i++)
-            {
-                __m128i _val = _mm_set1_epi16((short)sptr[0]);
-
-                // TODO use _mm_cvtepi8_epi16 on sse4.1
-                __m128i _w = _mm_loadl_epi64((const __m128i*)kptr);
-                _w = _mm_unpacklo_epi8(_w, _mm_cmpgt_epi8(_mm_setzero_si128(), _w));
-
-                __m128i _sl = _mm_mullo_epi16(_val, _w);
-                __m128i _sh = _mm_mulhi_epi16(_val, _w);
-                __m128i _s0 = _mm_unpacklo_epi16(_sl, _sh);
-                __m128i _s1 = _mm_unpackhi_epi16(_sl, _sh);
-
-                _sum0 = _mm_add_epi32(_sum0, _s0);
-                _sum1 = _mm_add_epi32(_sum1, _s1);
-
-                sptr += 1;
-                kptr += 8;
-            }
-
-            int* outptr = (int*)top_blob_int32;
-            _mm_storeu_si128((__m128i*)(outptr + p * 8), _sum0);
-            _mm_storeu_si128((__m128i*)(outptr + p * 8 + 4), _sum1);
-        }
+        innerproduct_pack8_int8_sse(bottom_blob_int8_flattened, top_blob_int32, weight_data_int8, opt);
     }
 #endif // __SSE2__
 
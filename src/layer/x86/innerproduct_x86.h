@@ -32,8 +32,17 @@ public:
 
     virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 
+    virtual int forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+    virtual int get_prepacked(std::vector<Mat>& weights) const;
+    virtual int set_prepacked(const std::vector<Mat>& weights);
+
 protected:
     int forward_fp16(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+#if NCNN_BF16
+    int create_pipeline_bf16s(const Option& opt);
+    int forward_bf16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+#endif
 #if NCNN_INT8
     int create_pipeline_int8_x86(const Option& opt);
     int forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
@@ -48,11 +57,17 @@ public:
     // fp16 weight data
     Mat weight_data_fp16;
 
+    // bf16 weight data
+    Mat weight_data_bf16;
+
 #if NCNN_INT8
     // int8
     Mat weight_data_int8;
     Mat scales_in;
 #endif
+
+    // transformed weight data restored by set_prepacked
+    bool weight_prepacked;
 };
 
 } // namespace ncnn
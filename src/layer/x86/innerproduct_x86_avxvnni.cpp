@@ -0,0 +1,34 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <math.h>
+
+#include "mat.h"
+#include "option.h"
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+#if NCNN_INT8
+#include "innerproduct_pack8_int8.h"
+
+// runtime dispatched from the non-vnni layer variants
+void innerproduct_pack8_int8_avxvnni(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_int8, const Option& opt)
+{
+    innerproduct_pack8_int8_sse(bottom_blob, top_blob, weight_data_int8, opt);
+}
+#endif // NCNN_INT8
+
+} // namespace ncnn
@@ -25,6 +25,9 @@ Mish_x86::Mish_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if __AVX512F__
+    support_avx512_pack16 = true;
+#endif // __AVX512F__
 }
 
 int Mish_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
@@ -36,6 +39,25 @@ int Mish_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 #if __SSE2__
     int elempack = bottom_top_blob.elempack;
 
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            float* ptr = bottom_top_blob.channel(q);
+            for (int i = 0; i < size; i++)
+            {
+                __m512 _p = _mm512_loadu_ps(ptr);
+                _p = mish_avx512(_p);
+                _mm512_storeu_ps(ptr, _p);
+                ptr += 16;
+            }
+        }
+
+        return 0;
+    }
+#endif // __AVX512F__
 #if __AVX__
     if (elempack == 8)
     {
@@ -35,6 +35,9 @@ int Packing_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
         return Packing::forward(bottom_blob, top_blob, opt);
     }
 
+    if (elembits == 16)
+        return forward_bf16s(bottom_blob, top_blob, opt);
+
     if (elembits != 32)
     {
         // non-fp32 type
@@ -57,6 +60,13 @@ int Packing_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
     bool pack4to8 = elempack == 4 && out_elempack == 8;
     bool pack8to4 = elempack == 8 && out_elempack == 4;
 
+#if __AVX512F__
+    if (bottom_blob.dims == 3 && (elempack == 16 || out_elempack == 16))
+    {
+        return forward_pack16(bottom_blob, top_blob, opt);
+    }
+#endif // __AVX512F__
+
     if (!pack1to4 && !pack4to1 && !pack1to8 && !pack8to1 && !pack4to8 && !pack8to4)
     {
         return Packing::forward(bottom_blob, top_blob, opt);
@@ -602,6 +612,186 @@ int Packing_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
     return 0;
 }
 
+#if __AVX512F__
+int Packing_x86::forward_pack16(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    bool pack1to16 = elempack == 1 && out_elempack == 16;
+    bool pack16to1 = elempack == 16 && out_elempack == 1;
+    bool pack8to16 = elempack == 8 && out_elempack == 16;
+    bool pack16to8 = elempack == 16 && out_elempack == 8;
+
+    if (!pack1to16 && !pack16to1 && !pack8to16 && !pack16to8)
+    {
+        return Packing::forward(bottom_blob, top_blob, opt);
+    }
+
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int channels = bottom_blob.c;
+
+    if (channels * elempack % out_elempack != 0)
+    {
+        // identity if use_padding not allowed
+        top_blob = bottom_blob;
+        return 0;
+    }
+
+    int size = w * h;
+    int outc = channels * elempack / out_elempack;
+    size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    top_blob.create(w, h, outc, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    if (pack1to16)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < outc; q++)
+        {
+            const float* r[16];
+            for (int k = 0; k < 16; k++)
+            {
+                r[k] = bottom_blob.channel(q * 16 + k);
+            }
+
+            float* outptr = top_blob.channel(q);
+
+            for (int i = 0; i < size; i++)
+            {
+                for (int k = 0; k < 16; k++)
+                {
+                    outptr[k] = r[k][i];
+                }
+
+                outptr += 16;
+            }
+        }
+    }
+    if (pack16to1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const float* r0 = bottom_blob.channel(q);
+
+            float* outptr[16];
+            for (int k = 0; k < 16; k++)
+            {
+                outptr[k] = top_blob.channel(q * 16 + k);
+            }
+
+            for (int i = 0; i < size; i++)
+            {
+                for (int k = 0; k < 16; k++)
+                {
+                    outptr[k][i] = r0[k];
+                }
+
+                r0 += 16;
+            }
+        }
+    }
+    if (pack8to16)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < outc; q++)
+        {
+            const float* r0 = bottom_blob.channel(q * 2);
+            const float* r1 = bottom_blob.channel(q * 2 + 1);
+
+            float* outptr = top_blob.channel(q);
+
+            for (int i = 0; i < size; i++)
+            {
+                _mm256_storeu_ps(outptr, _mm256_loadu_ps(r0));
+                _mm256_storeu_ps(outptr + 8, _mm256_loadu_ps(r1));
+
+                r0 += 8;
+                r1 += 8;
+                outptr += 16;
+            }
+        }
+    }
+    if (pack16to8)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const float* r0 = bottom_blob.channel(q);
+
+            float* outptr0 = top_blob.channel(q * 2);
+            float* outptr1 = top_blob.channel(q * 2 + 1);
+
+            for (int i = 0; i < size; i++)
+            {
+                _mm256_storeu_ps(outptr0, _mm256_loadu_ps(r0));
+                _mm256_storeu_ps(outptr1, _mm256_loadu_ps(r0 + 8));
+
+                r0 += 16;
+                outptr0 += 8;
+                outptr1 += 8;
+            }
+        }
+    }
+
+    return 0;
+}
+#endif // __AVX512F__
+
+int Packing_x86::forward_bf16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    if (bottom_blob.dims != 3 || elempack == out_elempack)
+    {
+        return Packing::forward(bottom_blob, top_blob, opt);
+    }
+
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int channels = bottom_blob.c;
+
+    if (channels * elempack % out_elempack != 0)
+    {
+        // identity if use_padding not allowed
+        top_blob = bottom_blob;
+        return 0;
+    }
+
+    int size = w * h;
+    int outc = channels * elempack / out_elempack;
+    size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    top_blob.create(w, h, outc, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // any of 1 4 8 16 to any, every output lane reads one input channel lane
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < outc; q++)
+    {
+        unsigned short* outptr = top_blob.channel(q);
+
+        for (int k = 0; k < out_elempack; k++)
+        {
+            const int p = q * out_elempack + k;
+            const unsigned short* ptr = (const unsigned short*)bottom_blob.channel(p / elempack) + p % elempack;
+
+            for (int i = 0; i < size; i++)
+            {
+                outptr[i * out_elempack + k] = ptr[i * elempack];
+            }
+        }
+    }
+
+    return 0;
+}
+
 int Packing_x86::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     if (use_padding)
@@ -28,6 +28,8 @@ public:
 
 protected:
     int forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+    int forward_pack16(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+    int forward_bf16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 };
 
 } // namespace ncnn
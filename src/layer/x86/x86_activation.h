@@ -219,6 +219,91 @@ static NCNN_FORCEINLINE __m256 activation_avx(__m256 _v, int activation_type, co
 
     return _v;
 }
+
+#if __AVX512F__
+#include "avx512_mathfun.h"
+
+static NCNN_FORCEINLINE __m512 sigmoid_avx512(__m512 inputs)
+{
+    const __m512 one = _mm512_set1_ps(1.0f);
+    return _mm512_div_ps(one, _mm512_add_ps(one, exp512_ps(_mm512_sub_ps(_mm512_setzero_ps(), inputs))));
+}
+
+static NCNN_FORCEINLINE __m512 tanh_avx512(__m512 inputs)
+{
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const __m512 two = _mm512_set1_ps(2.0f);
+    return _mm512_fmsub_ps(sigmoid_avx512(_mm512_mul_ps(inputs, two)), two, one);
+}
+
+static NCNN_FORCEINLINE __m512 mish_avx512(__m512 inputs)
+{
+    return _mm512_mul_ps(inputs, tanh_avx512(log512_ps(_mm512_add_ps(exp512_ps(inputs), _mm512_set1_ps(1.f)))));
+}
+
+static NCNN_FORCEINLINE __m512 swish_avx512(__m512 inputs)
+{
+    return _mm512_mul_ps(inputs, sigmoid_avx512(inputs));
+}
+
+static NCNN_FORCEINLINE __m512 hardswish_avx512(__m512 inputs, __m512 a, __m512 b)
+{
+    const __m512 one = _mm512_set1_ps(1.0f);
+    b = _mm512_fmadd_ps(inputs, a, b);
+    b = _mm512_max_ps(b, _mm512_setzero_ps());
+    b = _mm512_min_ps(b, one);
+    return _mm512_mul_ps(b, inputs);
+}
+
+static NCNN_FORCEINLINE __m512 lrelu_avx512(__m512 inputs, float slope)
+{
+    __m512 pos = _mm512_max_ps(_mm512_setzero_ps(), inputs);
+    __m512 neg = _mm512_min_ps(_mm512_setzero_ps(), inputs);
+    return _mm512_fmadd_ps(_mm512_set1_ps(slope), neg, pos);
+}
+
+static NCNN_FORCEINLINE __m512 activation_avx512(__m512 _v, int activation_type, const ncnn::Mat& activation_params)
+{
+    // Process fused activations
+    switch (activation_type)
+    {
+    case 1:
+    {
+        // Relu
+        return _mm512_max_ps(_v, _mm512_setzero_ps());
+    }
+    case 2:
+    {
+        // Leaky relu
+        return lrelu_avx512(_v, activation_params[0]);
+    }
+    case 3:
+    {
+        // min max clip
+        __m512 min = _mm512_set1_ps(activation_params[0]);
+        __m512 max = _mm512_set1_ps(activation_params[1]);
+        return _mm512_min_ps(_mm512_max_ps(_v, min), max);
+    }
+    case 4:
+    {
+        // Sigmoid
+        return sigmoid_avx512(_v);
+    }
+    case 5:
+    {
+        return mish_avx512(_v);
+    }
+    case 6:
+    {
+        __m512 _a = _mm512_set1_ps(activation_params[0]);
+        __m512 _b = _mm512_set1_ps(activation_params[1]);
+        return hardswish_avx512(_v, _a, _b);
+    }
+    }
+
+    return _v;
+}
+#endif // __AVX512F__
 #endif // __AVX__
 #endif // __SSE2__
 
@@ -125,8 +125,35 @@ static NCNN_FORCEINLINE __m128 _mm_comp_fmadd_ps(__m128 _a, const __m128 _b, con
 }
 #endif
 #endif
+
+// bf16 is the high half of fp32, the conversion truncates like float32_to_bfloat16
+static NCNN_FORCEINLINE __m128 bfloat2float_sse(__m128i v0)
+{
+    // the low 4 bf16 of v0
+    return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), v0));
+}
+static NCNN_FORCEINLINE __m128i float2bfloat_sse(__m128 v0, __m128 v1)
+{
+    __m128i a = _mm_srai_epi32(_mm_castps_si128(v0), 16);
+    __m128i b = _mm_srai_epi32(_mm_castps_si128(v1), 16);
+    return _mm_packs_epi32(a, b);
+}
+static NCNN_FORCEINLINE __m128i float2bfloat_sse(__m128 v0)
+{
+    // the low 4 bf16 of the result
+    __m128i a = _mm_srai_epi32(_mm_castps_si128(v0), 16);
+    return _mm_packs_epi32(a, a);
+}
 #if __AVX__
+#if defined(__GNUC__) && !defined(__clang__) && __AVX512F__
+// gcc reports the _mm512_undefined_*() placeholders inside the avx512 intrinsics as maybe-uninitialized
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
 #include <immintrin.h>
+#if defined(__GNUC__) && !defined(__clang__) && __AVX512F__
+#pragma GCC diagnostic pop
+#endif
 #ifndef __AVX2__
 static NCNN_FORCEINLINE __m256 _mm256_comp_fmadd_ps(__m256 _a, const __m256 _b, const __m256 _c)
 {
@@ -148,7 +175,24 @@ static NCNN_FORCEINLINE __m256 _mm256_comp_fmadd_ps(__m256 _a, const __m256 _b,
     return _mm256_fmadd_ps(_a, _b, _c);
 }
 #endif
+static NCNN_FORCEINLINE __m256 bfloat2float_avx(__m128i v0)
+{
+    __m128i a = _mm_unpacklo_epi16(_mm_setzero_si128(), v0);
+    __m128i b = _mm_unpackhi_epi16(_mm_setzero_si128(), v0);
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_castsi128_ps(a)), _mm_castsi128_ps(b), 1);
+}
+static NCNN_FORCEINLINE __m128i float2bfloat_avx(__m256 v0)
+{
+    return float2bfloat_sse(_mm256_castps256_ps128(v0), _mm256_extractf128_ps(v0, 1));
+}
 #if __AVX2__
+static NCNN_FORCEINLINE __m256i float2bfloat_avx(__m256 v0, __m256 v1)
+{
+    __m256i a = _mm256_srai_epi32(_mm256_castps_si256(v0), 16);
+    __m256i b = _mm256_srai_epi32(_mm256_castps_si256(v1), 16);
+    __m256i abab = _mm256_packs_epi32(a, b);
+    return _mm256_permute4x64_epi64(abab, _MM_SHUFFLE(3, 1, 2, 0));
+}
 
 static NCNN_FORCEINLINE __m256 loadfp16(const unsigned short* ptr)
 {
@@ -315,6 +359,34 @@ static NCNN_FORCEINLINE void _mm256_comp_fmadd_ps8(__m256& _sum,
     _mm256_comp_fmadd_ps4(_sum, _w4, _w5, _w6, _w7, _v4, _v5, _v6, _v7);
 }
 
+#if __AVX512F__
+static NCNN_FORCEINLINE float _mm512_comp_reduce_add_ps(__m512 x)
+{
+    const __m256 x256 = _mm256_add_ps(_mm512_castps512_ps256(x), _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(x), 1)));
+    return _mm256_reduce_add_ps(x256);
+}
+
+static NCNN_FORCEINLINE __m512 bfloat2float_avx512(__m256i v0)
+{
+    return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(v0), 16));
+}
+static NCNN_FORCEINLINE __m256i float2bfloat_avx512(__m512 v0)
+{
+    return _mm512_cvtepi32_epi16(_mm512_srli_epi32(_mm512_castps_si512(v0), 16));
+}
+#endif // __AVX512F__
+
+#if __AVX512VNNI__ || __AVXVNNI__
+// u8 x s8 dot product of 4 adjacent bytes accumulated into each int32 lane
+static NCNN_FORCEINLINE __m256i _mm256_comp_dpbusd_epi32(__m256i src, __m256i a, __m256i b)
+{
+#if __AVX512VNNI__
+    return _mm256_dpbusd_epi32(src, a, b);
+#else
+    return _mm256_dpbusd_avx_epi32(src, a, b);
+#endif
+}
+#endif // __AVX512VNNI__ || __AVXVNNI__
 #endif // __AVX__
 #endif // __SSE2__
 
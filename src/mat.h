@@ -21,7 +21,15 @@
 #include <arm_neon.h>
 #endif
 #if __AVX__
+#if defined(__GNUC__) && !defined(__clang__) && __AVX512F__
+// gcc reports the _mm512_undefined_*() placeholders inside the avx512 intrinsics as maybe-uninitialized
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
 #include <immintrin.h>
+#if defined(__GNUC__) && !defined(__clang__) && __AVX512F__
+#pragma GCC diagnostic pop
+#endif
 #endif
 #if __mips_msa
 #include <msa.h>
@@ -111,6 +119,9 @@ public:
 #if __AVX__
     void fill(__m256 _v);
     void fill(__m128i _v);
+#if __AVX512F__
+    void fill(__m512 _v);
+#endif // __AVX512F__
 #endif // __AVX__
 #if __mips_msa
     void fill(v4f32 _v);
@@ -209,6 +220,11 @@ public:
         PIXEL_GRAY = 3,
         PIXEL_RGBA = 4,
         PIXEL_BGRA = 5,
+        // yuv420 frames with even width and height, the chroma plane follows the luma plane
+        // nv21 and nv12 chroma rows share the luma stride, i420 u and v planes use half of it
+        PIXEL_NV21 = 6,
+        PIXEL_NV12 = 7,
+        PIXEL_I420 = 8,
 
         PIXEL_RGB2BGR = PIXEL_RGB | (PIXEL_BGR << PIXEL_CONVERT_SHIFT),
         PIXEL_RGB2GRAY = PIXEL_RGB | (PIXEL_GRAY << PIXEL_CONVERT_SHIFT),
@@ -234,11 +250,24 @@ public:
         PIXEL_BGRA2BGR = PIXEL_BGRA | (PIXEL_BGR << PIXEL_CONVERT_SHIFT),
         PIXEL_BGRA2GRAY = PIXEL_BGRA | (PIXEL_GRAY << PIXEL_CONVERT_SHIFT),
         PIXEL_BGRA2RGBA = PIXEL_BGRA | (PIXEL_RGBA << PIXEL_CONVERT_SHIFT),
+
+        PIXEL_NV212RGB = PIXEL_NV21 | (PIXEL_RGB << PIXEL_CONVERT_SHIFT),
+        PIXEL_NV212BGR = PIXEL_NV21 | (PIXEL_BGR << PIXEL_CONVERT_SHIFT),
+
+        PIXEL_NV122RGB = PIXEL_NV12 | (PIXEL_RGB << PIXEL_CONVERT_SHIFT),
+        PIXEL_NV122BGR = PIXEL_NV12 | (PIXEL_BGR << PIXEL_CONVERT_SHIFT),
+
+        PIXEL_I4202RGB = PIXEL_I420 | (PIXEL_RGB << PIXEL_CONVERT_SHIFT),
+        PIXEL_I4202BGR = PIXEL_I420 | (PIXEL_BGR << PIXEL_CONVERT_SHIFT),
     };
     // convenient construct from pixel data
     static Mat from_pixels(const unsigned char* pixels, int type, int w, int h, Allocator* allocator = 0);
     // convenient construct from pixel data with stride(bytes-per-row) parameter
     static Mat from_pixels(const unsigned char* pixels, int type, int w, int h, int stride, Allocator* allocator = 0);
+    // convenient construct from pixel data, rows split across opt.num_threads, allocated from opt.blob_allocator
+    static Mat from_pixels(const unsigned char* pixels, int type, int w, int h, const Option& opt);
+    // convenient construct from pixel data with stride(bytes-per-row) parameter, rows split across opt.num_threads
+    static Mat from_pixels(const unsigned char* pixels, int type, int w, int h, int stride, const Option& opt);
     // convenient construct from pixel data and resize to specific size
     static Mat from_pixels_resize(const unsigned char* pixels, int type, int w, int h, int target_width, int target_height, Allocator* allocator = 0);
     // convenient construct from pixel data and resize to specific size with stride(bytes-per-row) parameter
@@ -247,15 +276,27 @@ public:
     static Mat from_pixels_roi(const unsigned char* pixels, int type, int w, int h, int roix, int roiy, int roiw, int roih, Allocator* allocator = 0);
     // convenient construct from pixel data roi with stride(bytes-per-row) parameter
     static Mat from_pixels_roi(const unsigned char* pixels, int type, int w, int h, int stride, int roix, int roiy, int roiw, int roih, Allocator* allocator = 0);
+    // convenient construct from pixel data roi, rows split across opt.num_threads
+    static Mat from_pixels_roi(const unsigned char* pixels, int type, int w, int h, int roix, int roiy, int roiw, int roih, const Option& opt);
+    // convenient construct from pixel data roi with stride(bytes-per-row) parameter, rows split across opt.num_threads
+    static Mat from_pixels_roi(const unsigned char* pixels, int type, int w, int h, int stride, int roix, int roiy, int roiw, int roih, const Option& opt);
     // convenient construct from pixel data roi and resize to specific size
     static Mat from_pixels_roi_resize(const unsigned char* pixels, int type, int w, int h, int roix, int roiy, int roiw, int roih, int target_width, int target_height, Allocator* allocator = 0);
     // convenient construct from pixel data roi and resize to specific size with stride(bytes-per-row) parameter
     static Mat from_pixels_roi_resize(const unsigned char* pixels, int type, int w, int h, int stride, int roix, int roiy, int roiw, int roih, int target_width, int target_height, Allocator* allocator = 0);
+    // convenient construct from pixel data, resize to specific size, substract mean, normalize and pack to elempack in one pass
+    static Mat from_pixels_resize_normalize(const unsigned char* pixels, int type, int w, int h, int stride, int target_width, int target_height, const float* mean_vals, const float* norm_vals, int elempack, const Option& opt = Option());
+    // convenient construct from pixel data roi, resize to specific size, substract mean, normalize and pack to elempack in one pass
+    static Mat from_pixels_roi_resize_normalize(const unsigned char* pixels, int type, int w, int h, int stride, int roix, int roiy, int roiw, int roih, int target_width, int target_height, const float* mean_vals, const float* norm_vals, int elempack, const Option& opt = Option());
 
     // convenient export to pixel data
     void to_pixels(unsigned char* pixels, int type) const;
     // convenient export to pixel data with stride(bytes-per-row) parameter
     void to_pixels(unsigned char* pixels, int type, int stride) const;
+    // convenient export to pixel data, rows split across opt.num_threads
+    void to_pixels(unsigned char* pixels, int type, const Option& opt) const;
+    // convenient export to pixel data with stride(bytes-per-row) parameter, rows split across opt.num_threads
+    void to_pixels(unsigned char* pixels, int type, int stride, const Option& opt) const;
     // convenient export to pixel data and resize to specific size
     void to_pixels_resize(unsigned char* pixels, int type, int target_width, int target_height) const;
     // convenient export to pixel data and resize to specific size with stride(bytes-per-row) parameter
@@ -575,8 +616,28 @@ NCNN_EXPORT void resize_bilinear_c1(const unsigned char* src, int srcw, int srch
 NCNN_EXPORT void resize_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride);
 NCNN_EXPORT void resize_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride);
 NCNN_EXPORT void resize_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride);
+// image pixel bilinear resize with stride(bytes-per-row) parameter, rows are split across opt.num_threads
+NCNN_EXPORT void resize_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt);
+NCNN_EXPORT void resize_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt);
+NCNN_EXPORT void resize_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt);
+NCNN_EXPORT void resize_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt);
 // image pixel bilinear resize, convenient wrapper for yuv420sp(nv21/nv12)
 NCNN_EXPORT void resize_bilinear_yuv420sp(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h);
+// image pixel area resize, averages the covered source pixels like cv::INTER_AREA, falls back to bilinear when enlarging
+NCNN_EXPORT void resize_area_c1(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h);
+NCNN_EXPORT void resize_area_c2(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h);
+NCNN_EXPORT void resize_area_c3(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h);
+NCNN_EXPORT void resize_area_c4(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h);
+// image pixel area resize with stride(bytes-per-row) parameter
+NCNN_EXPORT void resize_area_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride);
+NCNN_EXPORT void resize_area_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride);
+NCNN_EXPORT void resize_area_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride);
+NCNN_EXPORT void resize_area_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride);
+// image pixel area resize with stride(bytes-per-row) parameter, rows are split across opt.num_threads
+NCNN_EXPORT void resize_area_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt);
+NCNN_EXPORT void resize_area_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt);
+NCNN_EXPORT void resize_area_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt);
+NCNN_EXPORT void resize_area_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt);
 #endif // NCNN_PIXEL
 #if NCNN_PIXEL_ROTATE
 // type is the from type, 6 means rotating from 6 to 1
@@ -620,8 +681,20 @@ NCNN_EXPORT void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int
 NCNN_EXPORT void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type = 0, unsigned int v = 0);
 NCNN_EXPORT void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type = 0, unsigned int v = 0);
 NCNN_EXPORT void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type = 0, unsigned int v = 0);
+// image pixel bilinear warpaffine inverse transform with stride(bytes-per-row) parameter, rows are split across opt.num_threads
+NCNN_EXPORT void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt);
+NCNN_EXPORT void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt);
+NCNN_EXPORT void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt);
+NCNN_EXPORT void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt);
+// image pixel bilinear warpaffine of count regions from one source image in a single parallel call
+// dsts[i] receives the w x h region sampled through the inverse transform tms + i * 6
+NCNN_EXPORT void warpaffine_bilinear_batch_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* const* dsts, int w, int h, int stride, const float* tms, int count, int type, unsigned int v, const Option& opt);
+NCNN_EXPORT void warpaffine_bilinear_batch_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* const* dsts, int w, int h, int stride, const float* tms, int count, int type, unsigned int v, const Option& opt);
+NCNN_EXPORT void warpaffine_bilinear_batch_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* const* dsts, int w, int h, int stride, const float* tms, int count, int type, unsigned int v, const Option& opt);
+NCNN_EXPORT void warpaffine_bilinear_batch_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* const* dsts, int w, int h, int stride, const float* tms, int count, int type, unsigned int v, const Option& opt);
 // image pixel bilinear warpaffine, convenient wrapper for yuv420sp(nv21/nv12), set -233 for transparent border color, the color YUV_ is little-endian encoded
 NCNN_EXPORT void warpaffine_bilinear_yuv420sp(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type = 0, unsigned int v = 0);
+NCNN_EXPORT void warpaffine_bilinear_yuv420sp(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type, unsigned int v, const Option& opt);
 #endif // NCNN_PIXEL_AFFINE
 #if NCNN_PIXEL_DRAWING
 // draw rectangle, set thickness -1 for filled rectangle, the color RGBA is little-endian encoded
@@ -1021,6 +1094,18 @@ inline void Mat::fill(__m128i _v)
         ptr += 8;
     }
 }
+#if __AVX512F__
+inline void Mat::fill(__m512 _v)
+{
+    int size = (int)total();
+    float* ptr = (float*)data;
+    for (int i = 0; i < size; i++)
+    {
+        _mm512_storeu_ps(ptr, _v);
+        ptr += 16;
+    }
+}
+#endif // __AVX512F__
 #endif // __AVX__
 
 #if __mips_msa
@@ -19,11 +19,201 @@
 #if __ARM_NEON
 #include <arm_neon.h>
 #endif // __ARM_NEON
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
 #include "platform.h"
 
 namespace ncnn {
 
 #if NCNN_PIXEL
+#if __SSE2__
+static NCNN_FORCEINLINE void unpack_u8x16_ps(__m128i _u8, __m128 _v[4])
+{
+    __m128i _u16l = _mm_unpacklo_epi8(_u8, _mm_setzero_si128());
+    __m128i _u16h = _mm_unpackhi_epi8(_u8, _mm_setzero_si128());
+    _v[0] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_u16l, _mm_setzero_si128()));
+    _v[1] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(_u16l, _mm_setzero_si128()));
+    _v[2] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_u16h, _mm_setzero_si128()));
+    _v[3] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(_u16h, _mm_setzero_si128()));
+}
+
+static NCNN_FORCEINLINE void load_u8x16_ps(const unsigned char* p, __m128 _v[4])
+{
+    unpack_u8x16_ps(_mm_loadu_si128((const __m128i*)p), _v);
+}
+
+static NCNN_FORCEINLINE void store_ps_u8x16(unsigned char* p, const __m128 _v[4])
+{
+    // truncate and saturate, same as SATURATE_CAST_UCHAR
+    __m128i _s16l = _mm_packs_epi32(_mm_cvttps_epi32(_v[0]), _mm_cvttps_epi32(_v[1]));
+    __m128i _s16h = _mm_packs_epi32(_mm_cvttps_epi32(_v[2]), _mm_cvttps_epi32(_v[3]));
+    _mm_storeu_si128((__m128i*)p, _mm_packus_epi16(_s16l, _s16h));
+}
+
+static NCNN_FORCEINLINE void load_ps_x4(const float* p, __m128 _v[4])
+{
+    _v[0] = _mm_loadu_ps(p);
+    _v[1] = _mm_loadu_ps(p + 4);
+    _v[2] = _mm_loadu_ps(p + 8);
+    _v[3] = _mm_loadu_ps(p + 12);
+}
+
+static NCNN_FORCEINLINE void store_ps_x4(float* p, const __m128 _v[4])
+{
+    _mm_storeu_ps(p, _v[0]);
+    _mm_storeu_ps(p + 4, _v[1]);
+    _mm_storeu_ps(p + 8, _v[2]);
+    _mm_storeu_ps(p + 12, _v[3]);
+}
+
+static NCNN_FORCEINLINE void load_deinterleave_c3_u8x16_ps(const unsigned char* p, __m128 _c0[4], __m128 _c1[4], __m128 _c2[4])
+{
+    __m128 _v0[4];
+    __m128 _v1[4];
+    __m128 _v2[4];
+    load_u8x16_ps(p, _v0);
+    load_u8x16_ps(p + 16, _v1);
+    load_u8x16_ps(p + 32, _v2);
+
+    // 48 values as 12 float4, every three float4 hold four pixels
+    const __m128 _v[12] = {_v0[0], _v0[1], _v0[2], _v0[3], _v1[0], _v1[1], _v1[2], _v1[3], _v2[0], _v2[1], _v2[2], _v2[3]};
+    for (int k = 0; k < 4; k++)
+    {
+        // a = c0 c1 c2 c0  b = c1 c2 c0 c1  c = c2 c0 c1 c2
+        __m128 _a = _v[k * 3];
+        __m128 _b = _v[k * 3 + 1];
+        __m128 _c = _v[k * 3 + 2];
+        _c0[k] = _mm_shuffle_ps(_mm_shuffle_ps(_a, _a, _MM_SHUFFLE(3, 3, 0, 0)), _mm_shuffle_ps(_b, _c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+        _c1[k] = _mm_shuffle_ps(_mm_shuffle_ps(_a, _b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(_b, _c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        _c2[k] = _mm_shuffle_ps(_mm_shuffle_ps(_a, _b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(_c, _c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+    }
+}
+
+static NCNN_FORCEINLINE void store_interleave_c3_ps_u8x16(unsigned char* p, const __m128 _c0[4], const __m128 _c1[4], const __m128 _c2[4])
+{
+    __m128 _v[12];
+    for (int k = 0; k < 4; k++)
+    {
+        _v[k * 3] = _mm_shuffle_ps(_mm_unpacklo_ps(_c0[k], _c1[k]), _mm_shuffle_ps(_c2[k], _c0[k], _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+        _v[k * 3 + 1] = _mm_shuffle_ps(_mm_shuffle_ps(_c1[k], _c2[k], _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(_c0[k], _c1[k], _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+        _v[k * 3 + 2] = _mm_shuffle_ps(_mm_shuffle_ps(_c2[k], _c0[k], _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(_c1[k], _c2[k], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    }
+
+    store_ps_u8x16(p, _v);
+    store_ps_u8x16(p + 16, _v + 4);
+    store_ps_u8x16(p + 32, _v + 8);
+}
+
+static NCNN_FORCEINLINE void load_deinterleave_c4_u8x16_ps(const unsigned char* p, __m128 _c0[4], __m128 _c1[4], __m128 _c2[4], __m128 _c3[4])
+{
+    for (int k = 0; k < 4; k++)
+    {
+        __m128 _v[4];
+        load_u8x16_ps(p + k * 16, _v);
+        _MM_TRANSPOSE4_PS(_v[0], _v[1], _v[2], _v[3]);
+        _c0[k] = _v[0];
+        _c1[k] = _v[1];
+        _c2[k] = _v[2];
+        _c3[k] = _v[3];
+    }
+}
+
+static NCNN_FORCEINLINE void store_interleave_c4_ps_u8x16(unsigned char* p, const __m128 _c0[4], const __m128 _c1[4], const __m128 _c2[4], const __m128 _c3[4])
+{
+    for (int k = 0; k < 4; k++)
+    {
+        __m128 _v[4] = {_c0[k], _c1[k], _c2[k], _c3[k]};
+        _MM_TRANSPOSE4_PS(_v[0], _v[1], _v[2], _v[3]);
+        store_ps_u8x16(p + k * 16, _v);
+    }
+}
+
+static NCNN_FORCEINLINE void rgb2gray_ps(const __m128 _r[4], const __m128 _g[4], const __m128 _b[4], __m128 _gray[4], int R2Y, int G2Y, int B2Y, int Y_shift)
+{
+    // the weighted sum is exact in fp32, truncation after scaling matches the integer shift
+    const __m128 _R2Y = _mm_set1_ps((float)R2Y);
+    const __m128 _G2Y = _mm_set1_ps((float)G2Y);
+    const __m128 _B2Y = _mm_set1_ps((float)B2Y);
+    const __m128 _scale = _mm_set1_ps(1.f / (1 << Y_shift));
+    for (int k = 0; k < 4; k++)
+    {
+        __m128 _y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_r[k], _R2Y), _mm_mul_ps(_g[k], _G2Y)), _mm_mul_ps(_b[k], _B2Y));
+        _gray[k] = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(_y, _scale)));
+    }
+}
+
+static NCNN_FORCEINLINE void store_interleave_c3_u8x16(unsigned char* p, __m128i _c0, __m128i _c1, __m128i _c2)
+{
+    const __m128i _zero = _mm_setzero_si128();
+    __m128i _c01l = _mm_unpacklo_epi8(_c0, _c1);
+    __m128i _c01h = _mm_unpackhi_epi8(_c0, _c1);
+    __m128i _c2l = _mm_unpacklo_epi8(_c2, _zero);
+    __m128i _c2h = _mm_unpackhi_epi8(_c2, _zero);
+
+    // four pixels as c0 c1 c2 x per register, then squeeze out x to 12 bytes
+    __m128i _v[4] = {_mm_unpacklo_epi16(_c01l, _c2l), _mm_unpackhi_epi16(_c01l, _c2l), _mm_unpacklo_epi16(_c01h, _c2h), _mm_unpackhi_epi16(_c01h, _c2h)};
+
+    const __m128i _mask_even = _mm_set_epi32(0, 0x00ffffff, 0, 0x00ffffff);
+    const __m128i _mask_odd = _mm_set_epi32(0x00ffffff, 0, 0x00ffffff, 0);
+    const __m128i _mask_lo = _mm_set_epi32(0, 0, 0x0000ffff, 0xffffffff);
+    const __m128i _mask_hi = _mm_set_epi32(0x0000ffff, 0xffffffff, 0, 0);
+    for (int k = 0; k < 4; k++)
+    {
+        __m128i _t = _mm_or_si128(_mm_and_si128(_v[k], _mask_even), _mm_srli_epi64(_mm_and_si128(_v[k], _mask_odd), 8));
+        _v[k] = _mm_or_si128(_mm_and_si128(_t, _mask_lo), _mm_srli_si128(_mm_and_si128(_t, _mask_hi), 2));
+    }
+
+    _mm_storeu_si128((__m128i*)p, _mm_or_si128(_v[0], _mm_slli_si128(_v[1], 12)));
+    _mm_storeu_si128((__m128i*)(p + 16), _mm_or_si128(_mm_srli_si128(_v[1], 4), _mm_slli_si128(_v[2], 8)));
+    _mm_storeu_si128((__m128i*)(p + 32), _mm_or_si128(_mm_srli_si128(_v[2], 8), _mm_slli_si128(_v[3], 4)));
+}
+
+static NCNN_FORCEINLINE void yuv2rgb_uv_epi16(__m128i _vu, bool nv12, __m128i& _ruv, __m128i& _guv, __m128i& _buv)
+{
+    // 8 interleaved chroma pairs, vu for nv21 and uv for nv12
+    const __m128i _v128 = _mm_set1_epi16(128);
+    __m128i _even = _mm_sub_epi16(_mm_and_si128(_vu, _mm_set1_epi16(0xff)), _v128);
+    __m128i _odd = _mm_sub_epi16(_mm_srli_epi16(_vu, 8), _v128);
+    __m128i _v = nv12 ? _odd : _even;
+    __m128i _u = nv12 ? _even : _odd;
+
+    // same fixed point terms as the scalar path, all fit in int16
+    _ruv = _mm_mullo_epi16(_v, _mm_set1_epi16(90));
+    _guv = _mm_add_epi16(_mm_mullo_epi16(_v, _mm_set1_epi16(-46)), _mm_mullo_epi16(_u, _mm_set1_epi16(-22)));
+    _buv = _mm_mullo_epi16(_u, _mm_set1_epi16(113));
+}
+
+static NCNN_FORCEINLINE void yuv2rgb_u8x16(const unsigned char* yptr, __m128i _ruv, __m128i _guv, __m128i _buv, __m128i& _r, __m128i& _g, __m128i& _b)
+{
+    __m128i _y = _mm_loadu_si128((const __m128i*)yptr);
+    __m128i _yl = _mm_slli_epi16(_mm_unpacklo_epi8(_y, _mm_setzero_si128()), 6);
+    __m128i _yh = _mm_slli_epi16(_mm_unpackhi_epi8(_y, _mm_setzero_si128()), 6);
+
+    // each chroma sample covers two neighbouring pixels
+    _r = _mm_packus_epi16(_mm_srai_epi16(_mm_add_epi16(_yl, _mm_unpacklo_epi16(_ruv, _ruv)), 6), _mm_srai_epi16(_mm_add_epi16(_yh, _mm_unpackhi_epi16(_ruv, _ruv)), 6));
+    _g = _mm_packus_epi16(_mm_srai_epi16(_mm_add_epi16(_yl, _mm_unpacklo_epi16(_guv, _guv)), 6), _mm_srai_epi16(_mm_add_epi16(_yh, _mm_unpackhi_epi16(_guv, _guv)), 6));
+    _b = _mm_packus_epi16(_mm_srai_epi16(_mm_add_epi16(_yl, _mm_unpacklo_epi16(_buv, _buv)), 6), _mm_srai_epi16(_mm_add_epi16(_yh, _mm_unpackhi_epi16(_buv, _buv)), 6));
+}
+
+static NCNN_FORCEINLINE void yuv420sp2rgb_u8x16(const unsigned char* yptr0, const unsigned char* yptr1, const unsigned char* chroma, unsigned char* rgb0, unsigned char* rgb1, bool nv12)
+{
+    __m128i _ruv;
+    __m128i _guv;
+    __m128i _buv;
+    yuv2rgb_uv_epi16(_mm_loadu_si128((const __m128i*)chroma), nv12, _ruv, _guv, _buv);
+
+    __m128i _r;
+    __m128i _g;
+    __m128i _b;
+    yuv2rgb_u8x16(yptr0, _ruv, _guv, _buv, _r, _g, _b);
+    store_interleave_c3_u8x16(rgb0, _r, _g, _b);
+
+    yuv2rgb_u8x16(yptr1, _ruv, _guv, _buv, _r, _g, _b);
+    store_interleave_c3_u8x16(rgb1, _r, _g, _b);
+}
+#endif // __SSE2__
+
 static int from_rgb(const unsigned char* rgb, int w, int h, int stride, Mat& m, Allocator* allocator)
 {
     m.create(w, h, 3, 4u, allocator);
@@ -46,6 +236,9 @@ static int from_rgb(const unsigned char* rgb, int w, int h, int stride, Mat& m,
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -119,6 +312,22 @@ static int from_rgb(const unsigned char* rgb, int w, int h, int stride, Mat& m,
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _r[4], _g[4], _b[4];
+            load_deinterleave_c3_u8x16_ps(rgb, _r, _g, _b);
+            store_ps_x4(ptr0, _r);
+            store_ps_x4(ptr1, _g);
+            store_ps_x4(ptr2, _b);
+
+            rgb += 3 * 16;
+            ptr0 += 16;
+            ptr1 += 16;
+            ptr2 += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             *ptr0 = rgb[0];
@@ -160,6 +369,9 @@ static void to_rgb(const Mat& m, unsigned char* rgb, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -191,6 +403,22 @@ static void to_rgb(const Mat& m, unsigned char* rgb, int stride)
             ptr2 += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _r[4], _g[4], _b[4];
+            load_ps_x4(ptr0, _r);
+            load_ps_x4(ptr1, _g);
+            load_ps_x4(ptr2, _b);
+            store_interleave_c3_ps_u8x16(rgb, _r, _g, _b);
+
+            rgb += 3 * 16;
+            ptr0 += 16;
+            ptr1 += 16;
+            ptr2 += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             rgb[0] = SATURATE_CAST_UCHAR(*ptr0);
@@ -228,6 +456,9 @@ static int from_gray(const unsigned char* gray, int w, int h, int stride, Mat& m
 #if __ARM_NEON
         int nn = w >> 4;
         int remain = w - (nn << 4);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -284,6 +515,18 @@ static int from_gray(const unsigned char* gray, int w, int h, int stride, Mat& m
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _gray[4];
+            load_u8x16_ps(gray, _gray);
+            store_ps_x4(ptr, _gray);
+
+            gray += 16;
+            ptr += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             *ptr = *gray;
@@ -319,6 +562,9 @@ static void to_gray(const Mat& m, unsigned char* gray, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -339,6 +585,18 @@ static void to_gray(const Mat& m, unsigned char* gray, int stride)
             ptr += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _gray[4];
+            load_ps_x4(ptr, _gray);
+            store_ps_u8x16(gray, _gray);
+
+            gray += 16;
+            ptr += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             *gray = SATURATE_CAST_UCHAR(*ptr);
@@ -375,6 +633,9 @@ static int from_rgba(const unsigned char* rgba, int w, int h, int stride, Mat& m
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -462,6 +723,24 @@ static int from_rgba(const unsigned char* rgba, int w, int h, int stride, Mat& m
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _r[4], _g[4], _b[4], _a[4];
+            load_deinterleave_c4_u8x16_ps(rgba, _r, _g, _b, _a);
+            store_ps_x4(ptr0, _r);
+            store_ps_x4(ptr1, _g);
+            store_ps_x4(ptr2, _b);
+            store_ps_x4(ptr3, _a);
+
+            rgba += 4 * 16;
+            ptr0 += 16;
+            ptr1 += 16;
+            ptr2 += 16;
+            ptr3 += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             *ptr0 = rgba[0];
@@ -506,6 +785,9 @@ static void to_rgba(const Mat& m, unsigned char* rgba, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -542,6 +824,24 @@ static void to_rgba(const Mat& m, unsigned char* rgba, int stride)
             ptr3 += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _r[4], _g[4], _b[4], _a[4];
+            load_ps_x4(ptr0, _r);
+            load_ps_x4(ptr1, _g);
+            load_ps_x4(ptr2, _b);
+            load_ps_x4(ptr3, _a);
+            store_interleave_c4_ps_u8x16(rgba, _r, _g, _b, _a);
+
+            rgba += 4 * 16;
+            ptr0 += 16;
+            ptr1 += 16;
+            ptr2 += 16;
+            ptr3 += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             rgba[0] = SATURATE_CAST_UCHAR(*ptr0);
@@ -583,6 +883,9 @@ static int from_rgb2bgr(const unsigned char* rgb, int w, int h, int stride, Mat&
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -656,6 +959,22 @@ static int from_rgb2bgr(const unsigned char* rgb, int w, int h, int stride, Mat&
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _r[4], _g[4], _b[4];
+            load_deinterleave_c3_u8x16_ps(rgb, _r, _g, _b);
+            store_ps_x4(ptr0, _b);
+            store_ps_x4(ptr1, _g);
+            store_ps_x4(ptr2, _r);
+
+            rgb += 3 * 16;
+            ptr0 += 16;
+            ptr1 += 16;
+            ptr2 += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             *ptr0 = rgb[2];
@@ -697,6 +1016,9 @@ static void to_bgr2rgb(const Mat& m, unsigned char* rgb, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -728,6 +1050,22 @@ static void to_bgr2rgb(const Mat& m, unsigned char* rgb, int stride)
             ptr2 += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _b[4], _g[4], _r[4];
+            load_ps_x4(ptr0, _b);
+            load_ps_x4(ptr1, _g);
+            load_ps_x4(ptr2, _r);
+            store_interleave_c3_ps_u8x16(rgb, _r, _g, _b);
+
+            rgb += 3 * 16;
+            ptr0 += 16;
+            ptr1 += 16;
+            ptr2 += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             rgb[2] = SATURATE_CAST_UCHAR(*ptr0);
@@ -771,6 +1109,9 @@ static int from_rgb2gray(const unsigned char* rgb, int w, int h, int stride, Mat
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -832,6 +1173,19 @@ static int from_rgb2gray(const unsigned char* rgb, int w, int h, int stride, Mat
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _r[4], _g[4], _b[4], _gray[4];
+            load_deinterleave_c3_u8x16_ps(rgb, _r, _g, _b);
+            rgb2gray_ps(_r, _g, _b, _gray, R2Y, G2Y, B2Y, Y_shift);
+            store_ps_x4(ptr, _gray);
+
+            rgb += 3 * 16;
+            ptr += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             *ptr = static_cast<float>((rgb[0] * R2Y + rgb[1] * G2Y + rgb[2] * B2Y) >> Y_shift);
@@ -853,6 +1207,7 @@ static int from_rgb2rgba(const unsigned char* rgb, int w, int h, int stride, Mat
         return -100;
 
     Mat rgb_channels = m.channel_range(0, 3);
+    rgb_channels.cstep = m.cstep;
     from_rgb(rgb, w, h, stride, rgb_channels, allocator);
 
     Mat alpha_channel = m.channel(3);
@@ -884,6 +1239,9 @@ static void to_rgb2rgba(const Mat& m, unsigned char* rgba, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -917,6 +1275,23 @@ static void to_rgb2rgba(const Mat& m, unsigned char* rgba, int stride)
             ptr2 += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _r[4], _g[4], _b[4];
+            load_ps_x4(ptr0, _r);
+            load_ps_x4(ptr1, _g);
+            load_ps_x4(ptr2, _b);
+            const __m128 _a[4] = {_mm_set1_ps(255.f), _mm_set1_ps(255.f), _mm_set1_ps(255.f), _mm_set1_ps(255.f)};
+            store_interleave_c4_ps_u8x16(rgba, _r, _g, _b, _a);
+
+            rgba += 4 * 16;
+            ptr0 += 16;
+            ptr1 += 16;
+            ptr2 += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             rgba[0] = SATURATE_CAST_UCHAR(*ptr0);
@@ -961,6 +1336,9 @@ static int from_bgr2gray(const unsigned char* bgr, int w, int h, int stride, Mat
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1022,6 +1400,19 @@ static int from_bgr2gray(const unsigned char* bgr, int w, int h, int stride, Mat
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _b[4], _g[4], _r[4], _gray[4];
+            load_deinterleave_c3_u8x16_ps(bgr, _b, _g, _r);
+            rgb2gray_ps(_r, _g, _b, _gray, R2Y, G2Y, B2Y, Y_shift);
+            store_ps_x4(ptr, _gray);
+
+            bgr += 3 * 16;
+            ptr += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             *ptr = static_cast<float>((bgr[2] * R2Y + bgr[1] * G2Y + bgr[0] * B2Y) >> Y_shift);
@@ -1043,6 +1434,7 @@ static int from_bgr2rgba(const unsigned char* bgr, int w, int h, int stride, Mat
         return -100;
 
     Mat rgb_channels = m.channel_range(0, 3);
+    rgb_channels.cstep = m.cstep;
     from_rgb2bgr(bgr, w, h, stride, rgb_channels, allocator);
 
     Mat alpha_channel = m.channel(3);
@@ -1074,6 +1466,9 @@ static void to_bgr2rgba(const Mat& m, unsigned char* rgba, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1107,6 +1502,23 @@ static void to_bgr2rgba(const Mat& m, unsigned char* rgba, int stride)
             ptr2 += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _b[4], _g[4], _r[4];
+            load_ps_x4(ptr0, _b);
+            load_ps_x4(ptr1, _g);
+            load_ps_x4(ptr2, _r);
+            const __m128 _a[4] = {_mm_set1_ps(255.f), _mm_set1_ps(255.f), _mm_set1_ps(255.f), _mm_set1_ps(255.f)};
+            store_interleave_c4_ps_u8x16(rgba, _r, _g, _b, _a);
+
+            rgba += 4 * 16;
+            ptr0 += 16;
+            ptr1 += 16;
+            ptr2 += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             rgba[0] = SATURATE_CAST_UCHAR(*ptr2);
@@ -1147,6 +1559,9 @@ static int from_gray2rgb(const unsigned char* gray, int w, int h, int stride, Ma
 #if __ARM_NEON
         int nn = w >> 4;
         int remain = w - (nn << 4);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1223,6 +1638,22 @@ static int from_gray2rgb(const unsigned char* gray, int w, int h, int stride, Ma
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _gray[4];
+            load_u8x16_ps(gray, _gray);
+            store_ps_x4(ptr0, _gray);
+            store_ps_x4(ptr1, _gray);
+            store_ps_x4(ptr2, _gray);
+
+            gray += 16;
+            ptr0 += 16;
+            ptr1 += 16;
+            ptr2 += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             *ptr0 = *gray;
@@ -1248,6 +1679,7 @@ static int from_gray2rgba(const unsigned char* gray, int w, int h, int stride, M
         return -100;
 
     Mat rgb_channels = m.channel_range(0, 3);
+    rgb_channels.cstep = m.cstep;
     from_gray2rgb(gray, w, h, stride, rgb_channels, allocator);
 
     Mat alpha_channel = m.channel(3);
@@ -1277,6 +1709,9 @@ static void to_gray2rgba(const Mat& m, unsigned char* rgba, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1304,6 +1739,19 @@ static void to_gray2rgba(const Mat& m, unsigned char* rgba, int stride)
             ptr += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _gray[4];
+            load_ps_x4(ptr, _gray);
+            const __m128 _a[4] = {_mm_set1_ps(255.f), _mm_set1_ps(255.f), _mm_set1_ps(255.f), _mm_set1_ps(255.f)};
+            store_interleave_c4_ps_u8x16(rgba, _gray, _gray, _gray, _a);
+
+            rgba += 4 * 16;
+            ptr += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             unsigned char gray = SATURATE_CAST_UCHAR(*ptr);
@@ -1343,6 +1791,9 @@ static int from_rgba2rgb(const unsigned char* rgba, int w, int h, int stride, Ma
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1416,6 +1867,22 @@ static int from_rgba2rgb(const unsigned char* rgba, int w, int h, int stride, Ma
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _r[4], _g[4], _b[4], _a[4];
+            load_deinterleave_c4_u8x16_ps(rgba, _r, _g, _b, _a);
+            store_ps_x4(ptr0, _r);
+            store_ps_x4(ptr1, _g);
+            store_ps_x4(ptr2, _b);
+
+            rgba += 4 * 16;
+            ptr0 += 16;
+            ptr1 += 16;
+            ptr2 += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             *ptr0 = rgba[0];
@@ -1456,6 +1923,9 @@ static int from_rgba2bgr(const unsigned char* rgba, int w, int h, int stride, Ma
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1529,6 +1999,22 @@ static int from_rgba2bgr(const unsigned char* rgba, int w, int h, int stride, Ma
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _r[4], _g[4], _b[4], _a[4];
+            load_deinterleave_c4_u8x16_ps(rgba, _r, _g, _b, _a);
+            store_ps_x4(ptr0, _b);
+            store_ps_x4(ptr1, _g);
+            store_ps_x4(ptr2, _r);
+
+            rgba += 4 * 16;
+            ptr0 += 16;
+            ptr1 += 16;
+            ptr2 += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             *ptr0 = rgba[2];
@@ -1573,6 +2059,9 @@ static int from_rgba2gray(const unsigned char* rgba, int w, int h, int stride, M
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1634,6 +2123,19 @@ static int from_rgba2gray(const unsigned char* rgba, int w, int h, int stride, M
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _r[4], _g[4], _b[4], _a[4], _gray[4];
+            load_deinterleave_c4_u8x16_ps(rgba, _r, _g, _b, _a);
+            rgb2gray_ps(_r, _g, _b, _gray, R2Y, G2Y, B2Y, Y_shift);
+            store_ps_x4(ptr, _gray);
+
+            rgba += 4 * 16;
+            ptr += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             *ptr = static_cast<float>((rgba[0] * R2Y + rgba[1] * G2Y + rgba[2] * B2Y) >> Y_shift);
@@ -1671,6 +2173,9 @@ static int from_rgba2bgra(const unsigned char* rgba, int w, int h, int stride, M
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1758,6 +2263,24 @@ static int from_rgba2bgra(const unsigned char* rgba, int w, int h, int stride, M
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _r[4], _g[4], _b[4], _a[4];
+            load_deinterleave_c4_u8x16_ps(rgba, _r, _g, _b, _a);
+            store_ps_x4(ptr0, _b);
+            store_ps_x4(ptr1, _g);
+            store_ps_x4(ptr2, _r);
+            store_ps_x4(ptr3, _a);
+
+            rgba += 4 * 16;
+            ptr0 += 16;
+            ptr1 += 16;
+            ptr2 += 16;
+            ptr3 += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             *ptr0 = rgba[2];
@@ -1802,6 +2325,9 @@ static void to_rgba2bgra(const Mat& m, unsigned char* bgra, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1838,6 +2364,24 @@ static void to_rgba2bgra(const Mat& m, unsigned char* bgra, int stride)
             ptr3 += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _r[4], _g[4], _b[4], _a[4];
+            load_ps_x4(ptr0, _r);
+            load_ps_x4(ptr1, _g);
+            load_ps_x4(ptr2, _b);
+            load_ps_x4(ptr3, _a);
+            store_interleave_c4_ps_u8x16(bgra, _b, _g, _r, _a);
+
+            bgra += 4 * 16;
+            ptr0 += 16;
+            ptr1 += 16;
+            ptr2 += 16;
+            ptr3 += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             bgra[0] = SATURATE_CAST_UCHAR(*ptr2);
@@ -1883,6 +2427,9 @@ static int from_bgra2gray(const unsigned char* bgra, int w, int h, int stride, M
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1944,6 +2491,19 @@ static int from_bgra2gray(const unsigned char* bgra, int w, int h, int stride, M
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128 _b[4], _g[4], _r[4], _a[4], _gray[4];
+            load_deinterleave_c4_u8x16_ps(bgra, _b, _g, _r, _a);
+            rgb2gray_ps(_r, _g, _b, _gray, R2Y, G2Y, B2Y, Y_shift);
+            store_ps_x4(ptr, _gray);
+
+            bgra += 4 * 16;
+            ptr += 16;
+        }
+#endif // __SSE2__
+
         for (; remain > 0; remain--)
         {
             *ptr = static_cast<float>((bgra[2] * R2Y + bgra[1] * G2Y + bgra[0] * B2Y) >> Y_shift);
@@ -1981,6 +2541,9 @@ void yuv420sp2rgb(const unsigned char* yuv420sp, int w, int h, unsigned char* rg
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -2085,6 +2648,18 @@ void yuv420sp2rgb(const unsigned char* yuv420sp, int w, int h, unsigned char* rg
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            yuv420sp2rgb_u8x16(yptr0, yptr1, vuptr, rgb0, rgb1, false);
+
+            yptr0 += 16;
+            yptr1 += 16;
+            vuptr += 16;
+            rgb0 += 48;
+            rgb1 += 48;
+        }
+#endif // __SSE2__
 
 #define SATURATE_CAST_UCHAR(X) (unsigned char)::std::min(::std::max((int)(X), 0), 255);
         for (; remain > 0; remain -= 2)
@@ -2172,6 +2747,9 @@ void yuv420sp2rgb_nv12(const unsigned char* yuv420sp, int w, int h, unsigned cha
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -2276,6 +2854,18 @@ void yuv420sp2rgb_nv12(const unsigned char* yuv420sp, int w, int h, unsigned cha
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        for (; nn > 0; nn--)
+        {
+            yuv420sp2rgb_u8x16(yptr0, yptr1, uvptr, rgb0, rgb1, true);
+
+            yptr0 += 16;
+            yptr1 += 16;
+            uvptr += 16;
+            rgb0 += 48;
+            rgb1 += 48;
+        }
+#endif // __SSE2__
 
 #define SATURATE_CAST_UCHAR(X) (unsigned char)::std::min(::std::max((int)(X), 0), 255);
         for (; remain > 0; remain -= 2)
@@ -2453,64 +3043,168 @@ Mat Mat::from_pixels(const unsigned char* pixels, int type, int w, int h, Alloca
     {
         return Mat::from_pixels(pixels, type, w, h, w * 4, allocator);
     }
+    else if (type_from == PIXEL_NV21 || type_from == PIXEL_NV12 || type_from == PIXEL_I420)
+    {
+        return Mat::from_pixels(pixels, type, w, h, w * 1, allocator);
+    }
 
     // unknown convert type
     NCNN_LOGE("unknown convert type %d", type);
     return Mat();
 }
 
-Mat Mat::from_pixels(const unsigned char* pixels, int type, int w, int h, int stride, Allocator* allocator)
+static int from_yuv420(const unsigned char* yptr, int ystride, const unsigned char* uptr, const unsigned char* vptr, int uvstride, int uvstep, int w, int h, bool bgr, Mat& m, Allocator* allocator)
 {
-    Mat m;
+    // chroma is subsampled 2x2, uvstep 2 for interleaved nv21 nv12 and 1 for planar i420
+    m.create(w, h, 3, 4u, allocator);
+    if (m.empty())
+        return -100;
 
-    if (type & PIXEL_CONVERT_MASK)
+    float* rptr = m.channel(bgr ? 2 : 0);
+    float* gptr = m.channel(1);
+    float* bptr = m.channel(bgr ? 0 : 2);
+
+    for (int y = 0; y < h; y++)
+    {
+        const unsigned char* yptr0 = yptr + (size_t)ystride * y;
+        const unsigned char* uptr0 = uptr + (size_t)uvstride * (y / 2);
+        const unsigned char* vptr0 = vptr + (size_t)uvstride * (y / 2);
+
+        int x = 0;
+#if __SSE2__
+        for (; x + 15 < w; x += 16)
+        {
+            __m128i _vu;
+            bool nv12 = false;
+            if (uvstep == 2)
+            {
+                nv12 = uptr0 < vptr0;
+                _vu = _mm_loadu_si128((const __m128i*)((nv12 ? uptr0 : vptr0) + x));
+            }
+            else
+            {
+                __m128i _u = _mm_loadl_epi64((const __m128i*)(uptr0 + x / 2));
+                __m128i _v = _mm_loadl_epi64((const __m128i*)(vptr0 + x / 2));
+                _vu = _mm_unpacklo_epi8(_v, _u);
+            }
+
+            __m128i _ruv;
+            __m128i _guv;
+            __m128i _buv;
+            yuv2rgb_uv_epi16(_vu, nv12, _ruv, _guv, _buv);
+
+            __m128i _r;
+            __m128i _g;
+            __m128i _b;
+            yuv2rgb_u8x16(yptr0 + x, _ruv, _guv, _buv, _r, _g, _b);
+
+            __m128 _v[4];
+            unpack_u8x16_ps(_r, _v);
+            store_ps_x4(rptr, _v);
+            unpack_u8x16_ps(_g, _v);
+            store_ps_x4(gptr, _v);
+            unpack_u8x16_ps(_b, _v);
+            store_ps_x4(bptr, _v);
+
+            rptr += 16;
+            gptr += 16;
+            bptr += 16;
+        }
+#endif // __SSE2__
+
+#define SATURATE_CAST_UCHAR(X) (unsigned char)::std::min(::std::max((int)(X), 0), 255);
+        for (; x < w; x++)
+        {
+            // same fixed point as yuv420sp2rgb
+            int u = uptr0[x / 2 * uvstep] - 128;
+            int v = vptr0[x / 2 * uvstep] - 128;
+
+            int yy = yptr0[x] << 6;
+            *rptr++ = SATURATE_CAST_UCHAR((yy + 90 * v) >> 6);
+            *gptr++ = SATURATE_CAST_UCHAR((yy - 46 * v - 22 * u) >> 6);
+            *bptr++ = SATURATE_CAST_UCHAR((yy + 113 * u) >> 6);
+        }
+#undef SATURATE_CAST_UCHAR
+    }
+
+    return 0;
+}
+
+static int from_yuv420(const unsigned char* yuv, int type_from, int w, int h, int stride, bool bgr, Mat& m, Allocator* allocator)
+{
+    // the chroma plane follows h rows of luma, i420 chroma rows use half the luma stride
+    const unsigned char* yptr = yuv;
+    const unsigned char* uvptr = yuv + (size_t)stride * h;
+
+    if (type_from == Mat::PIXEL_NV21)
+        return from_yuv420(yptr, stride, uvptr + 1, uvptr, stride, 2, w, h, bgr, m, allocator);
+
+    if (type_from == Mat::PIXEL_NV12)
+        return from_yuv420(yptr, stride, uvptr, uvptr + 1, stride, 2, w, h, bgr, m, allocator);
+
+    return from_yuv420(yptr, stride, uvptr, uvptr + (size_t)stride / 2 * (h / 2), stride / 2, 1, w, h, bgr, m, allocator);
+}
+
+static void from_pixels_convert(const unsigned char* pixels, int type, int w, int h, int stride, Mat& m, Allocator* allocator)
+{
+    if (type & Mat::PIXEL_CONVERT_MASK)
     {
         switch (type)
         {
-        case PIXEL_RGB2BGR:
-        case PIXEL_BGR2RGB:
+        case Mat::PIXEL_RGB2BGR:
+        case Mat::PIXEL_BGR2RGB:
             from_rgb2bgr(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_RGB2GRAY:
+        case Mat::PIXEL_RGB2GRAY:
             from_rgb2gray(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_RGB2RGBA:
-        case PIXEL_BGR2BGRA:
+        case Mat::PIXEL_RGB2RGBA:
+        case Mat::PIXEL_BGR2BGRA:
             from_rgb2rgba(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_BGR2GRAY:
+        case Mat::PIXEL_BGR2GRAY:
             from_bgr2gray(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_BGR2RGBA:
-        case PIXEL_RGB2BGRA:
+        case Mat::PIXEL_BGR2RGBA:
+        case Mat::PIXEL_RGB2BGRA:
             from_bgr2rgba(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_GRAY2RGB:
-        case PIXEL_GRAY2BGR:
+        case Mat::PIXEL_GRAY2RGB:
+        case Mat::PIXEL_GRAY2BGR:
             from_gray2rgb(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_GRAY2RGBA:
-        case PIXEL_GRAY2BGRA:
+        case Mat::PIXEL_GRAY2RGBA:
+        case Mat::PIXEL_GRAY2BGRA:
             from_gray2rgba(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_RGBA2RGB:
-        case PIXEL_BGRA2BGR:
+        case Mat::PIXEL_RGBA2RGB:
+        case Mat::PIXEL_BGRA2BGR:
             from_rgba2rgb(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_RGBA2BGR:
-        case PIXEL_BGRA2RGB:
+        case Mat::PIXEL_RGBA2BGR:
+        case Mat::PIXEL_BGRA2RGB:
             from_rgba2bgr(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_RGBA2GRAY:
+        case Mat::PIXEL_RGBA2GRAY:
             from_rgba2gray(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_RGBA2BGRA:
-        case PIXEL_BGRA2RGBA:
+        case Mat::PIXEL_RGBA2BGRA:
+        case Mat::PIXEL_BGRA2RGBA:
             from_rgba2bgra(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_BGRA2GRAY:
+        case Mat::PIXEL_BGRA2GRAY:
             from_bgra2gray(pixels, w, h, stride, m, allocator);
             break;
+        case Mat::PIXEL_NV212RGB:
+        case Mat::PIXEL_NV122RGB:
+        case Mat::PIXEL_I4202RGB:
+            from_yuv420(pixels, type & Mat::PIXEL_FORMAT_MASK, w, h, stride, false, m, allocator);
+            break;
+        case Mat::PIXEL_NV212BGR:
+        case Mat::PIXEL_NV122BGR:
+        case Mat::PIXEL_I4202BGR:
+            from_yuv420(pixels, type & Mat::PIXEL_FORMAT_MASK, w, h, stride, true, m, allocator);
+            break;
         default:
             // unimplemented convert type
             NCNN_LOGE("unimplemented convert type %d", type);
@@ -2519,14 +3213,105 @@ Mat Mat::from_pixels(const unsigned char* pixels, int type, int w, int h, int st
     }
     else
     {
-        if (type == PIXEL_RGB || type == PIXEL_BGR)
+        if (type == Mat::PIXEL_RGB || type == Mat::PIXEL_BGR)
             from_rgb(pixels, w, h, stride, m, allocator);
 
-        if (type == PIXEL_GRAY)
+        if (type == Mat::PIXEL_GRAY)
             from_gray(pixels, w, h, stride, m, allocator);
 
-        if (type == PIXEL_RGBA || type == PIXEL_BGRA)
+        if (type == Mat::PIXEL_RGBA || type == Mat::PIXEL_BGRA)
             from_rgba(pixels, w, h, stride, m, allocator);
+
+        if (type == Mat::PIXEL_NV21 || type == Mat::PIXEL_NV12 || type == Mat::PIXEL_I420)
+        {
+            // yuv420 is always converted, the caller picks rgb or bgr
+            NCNN_LOGE("yuv420 type %d needs a convert target, use PIXEL_NV212RGB and the like", type);
+        }
+    }
+}
+
+static int pixel_channels(int type)
+{
+    int type_to = (type & Mat::PIXEL_CONVERT_MASK) ? (type >> Mat::PIXEL_CONVERT_SHIFT) : (type & Mat::PIXEL_FORMAT_MASK);
+
+    if (type_to == Mat::PIXEL_RGB || type_to == Mat::PIXEL_BGR)
+        return 3;
+
+    if (type_to == Mat::PIXEL_GRAY)
+        return 1;
+
+    if (type_to == Mat::PIXEL_RGBA || type_to == Mat::PIXEL_BGRA)
+        return 4;
+
+    return 0;
+}
+
+Mat Mat::from_pixels(const unsigned char* pixels, int type, int w, int h, int stride, Allocator* allocator)
+{
+    Mat m;
+    from_pixels_convert(pixels, type, w, h, stride, m, allocator);
+    return m;
+}
+
+Mat Mat::from_pixels(const unsigned char* pixels, int type, int w, int h, const Option& opt)
+{
+    int type_from = type & PIXEL_FORMAT_MASK;
+
+    if (type_from == PIXEL_RGB || type_from == PIXEL_BGR)
+    {
+        return Mat::from_pixels(pixels, type, w, h, w * 3, opt);
+    }
+    else if (type_from == PIXEL_GRAY)
+    {
+        return Mat::from_pixels(pixels, type, w, h, w * 1, opt);
+    }
+    else if (type_from == PIXEL_RGBA || type_from == PIXEL_BGRA)
+    {
+        return Mat::from_pixels(pixels, type, w, h, w * 4, opt);
+    }
+    else if (type_from == PIXEL_NV21 || type_from == PIXEL_NV12 || type_from == PIXEL_I420)
+    {
+        return Mat::from_pixels(pixels, type, w, h, w * 1, opt);
+    }
+
+    // unknown convert type
+    NCNN_LOGE("unknown convert type %d", type);
+    return Mat();
+}
+
+Mat Mat::from_pixels(const unsigned char* pixels, int type, int w, int h, int stride, const Option& opt)
+{
+    const int type_from = type & PIXEL_FORMAT_MASK;
+
+    // yuv420 chroma rows are shared by row pairs, convert in one pass
+    const int nn_band = type_from == PIXEL_NV21 || type_from == PIXEL_NV12 || type_from == PIXEL_I420 ? 1 : std::min(opt.num_threads, h);
+    if (nn_band <= 1)
+        return Mat::from_pixels(pixels, type, w, h, stride, opt.blob_allocator);
+
+    const int channels = pixel_channels(type);
+    if (channels == 0)
+    {
+        // unknown convert type
+        NCNN_LOGE("unknown convert type %d", type);
+        return Mat();
+    }
+
+    Mat m;
+    m.create(w, h, channels, 4u, opt.blob_allocator);
+    if (m.empty())
+        return m;
+
+    // each thread converts a band of rows into a view sharing the channel step of m
+    #pragma omp parallel for num_threads(nn_band)
+    for (int i = 0; i < nn_band; i++)
+    {
+        const int y0 = h * i / nn_band;
+        const int y1 = h * (i + 1) / nn_band;
+
+        Mat m_band(w, y1 - y0, channels, (unsigned char*)m.data + (size_t)w * y0 * m.elemsize, m.elemsize, m.allocator);
+        m_band.cstep = m.cstep;
+
+        from_pixels_convert(pixels + (size_t)y0 * stride, type, w, y1 - y0, stride, m_band, m.allocator);
     }
 
     return m;
@@ -2548,6 +3333,10 @@ Mat Mat::from_pixels_resize(const unsigned char* pixels, int type, int w, int h,
     {
         return Mat::from_pixels_resize(pixels, type, w, h, w * 4, target_width, target_height, allocator);
     }
+    else if (type_from == PIXEL_NV21 || type_from == PIXEL_NV12 || type_from == PIXEL_I420)
+    {
+        return Mat::from_pixels_resize(pixels, type, w, h, w * 1, target_width, target_height, allocator);
+    }
 
     // unknown convert type
     NCNN_LOGE("unknown convert type %d", type);
@@ -2582,12 +3371,92 @@ Mat Mat::from_pixels_resize(const unsigned char* pixels, int type, int w, int h,
 
         return Mat::from_pixels(dst, type, target_width, target_height, allocator);
     }
+    else if (type_from == PIXEL_NV21 || type_from == PIXEL_NV12 || type_from == PIXEL_I420)
+    {
+        const int type_to = type >> PIXEL_CONVERT_SHIFT;
+        if (type_to != PIXEL_RGB && type_to != PIXEL_BGR)
+        {
+            NCNN_LOGE("unimplemented convert type %d", type);
+            return Mat();
+        }
+
+        // resize luma and the subsampled chroma planes separately, then convert straight into the planar float mat
+        const int target_uvw = (target_width + 1) / 2;
+        const int target_uvh = (target_height + 1) / 2;
+
+        Mat ydst(target_width, target_height, (size_t)1u, 1);
+        resize_bilinear_c1(pixels, w, h, stride, ydst, target_width, target_height, target_width);
+
+        const unsigned char* uvptr = pixels + (size_t)stride * h;
+
+        Mat m;
+        if (type_from == PIXEL_I420)
+        {
+            Mat udst(target_uvw, target_uvh, (size_t)1u, 1);
+            Mat vdst(target_uvw, target_uvh, (size_t)1u, 1);
+            resize_bilinear_c1(uvptr, w / 2, h / 2, stride / 2, udst, target_uvw, target_uvh, target_uvw);
+            resize_bilinear_c1(uvptr + (size_t)stride / 2 * (h / 2), w / 2, h / 2, stride / 2, vdst, target_uvw, target_uvh, target_uvw);
+
+            from_yuv420(ydst, target_width, udst, vdst, target_uvw, 1, target_width, target_height, type_to == PIXEL_BGR, m, allocator);
+        }
+        else
+        {
+            Mat uvdst(target_uvw, target_uvh, (size_t)2u, 2);
+            resize_bilinear_c2(uvptr, w / 2, h / 2, stride, uvdst, target_uvw, target_uvh, target_uvw * 2);
+
+            const unsigned char* uptr = (const unsigned char*)uvdst + (type_from == PIXEL_NV21 ? 1 : 0);
+            const unsigned char* vptr = (const unsigned char*)uvdst + (type_from == PIXEL_NV21 ? 0 : 1);
+            from_yuv420(ydst, target_width, uptr, vptr, target_uvw * 2, 2, target_width, target_height, type_to == PIXEL_BGR, m, allocator);
+        }
+
+        return m;
+    }
 
     // unknown convert type
     NCNN_LOGE("unknown convert type %d", type);
     return Mat();
 }
 
+static Mat from_yuv420_roi(const unsigned char* pixels, int type, int h, int stride, int roix, int roiy, int roiw, int roih, Allocator* allocator)
+{
+    const int type_from = type & Mat::PIXEL_FORMAT_MASK;
+    const int type_to = type >> Mat::PIXEL_CONVERT_SHIFT;
+    if (type_to != Mat::PIXEL_RGB && type_to != Mat::PIXEL_BGR)
+    {
+        NCNN_LOGE("yuv420 type %d needs a convert target, use PIXEL_NV212RGB and the like", type);
+        return Mat();
+    }
+
+    // chroma is subsampled 2x2, the roi must not split a chroma sample
+    if (roix % 2 != 0 || roiy % 2 != 0)
+    {
+        NCNN_LOGE("yuv420 roi %d %d must start on even coordinates", roix, roiy);
+        return Mat();
+    }
+
+    // the chroma plane follows the whole luma plane, not the roi
+    const unsigned char* yptr = pixels + (size_t)roiy * stride + roix;
+    const unsigned char* uvptr = pixels + (size_t)stride * h;
+
+    Mat m;
+    if (type_from == Mat::PIXEL_I420)
+    {
+        const int uvstride = stride / 2;
+        const unsigned char* uptr = uvptr + (size_t)(roiy / 2) * uvstride + roix / 2;
+        const unsigned char* vptr = uptr + (size_t)uvstride * (h / 2);
+        from_yuv420(yptr, stride, uptr, vptr, uvstride, 1, roiw, roih, type_to == Mat::PIXEL_BGR, m, allocator);
+    }
+    else
+    {
+        const unsigned char* uvroi = uvptr + (size_t)(roiy / 2) * stride + roix;
+        const unsigned char* uptr = uvroi + (type_from == Mat::PIXEL_NV21 ? 1 : 0);
+        const unsigned char* vptr = uvroi + (type_from == Mat::PIXEL_NV21 ? 0 : 1);
+        from_yuv420(yptr, stride, uptr, vptr, stride, 2, roiw, roih, type_to == Mat::PIXEL_BGR, m, allocator);
+    }
+
+    return m;
+}
+
 Mat Mat::from_pixels_roi(const unsigned char* pixels, int type, int w, int h, int roix, int roiy, int roiw, int roih, Allocator* allocator)
 {
     if (roix < 0 || roiy < 0 || roiw <= 0 || roih <= 0 || roix + roiw > w || roiy + roih > h)
@@ -2610,6 +3479,10 @@ Mat Mat::from_pixels_roi(const unsigned char* pixels, int type, int w, int h, in
     {
         return from_pixels(pixels + (roiy * w + roix) * 4, type, roiw, roih, w * 4, allocator);
     }
+    else if (type_from == PIXEL_NV21 || type_from == PIXEL_NV12 || type_from == PIXEL_I420)
+    {
+        return from_yuv420_roi(pixels, type, h, w, roix, roiy, roiw, roih, allocator);
+    }
 
     // unknown convert type
     NCNN_LOGE("unknown convert type %d", type);
@@ -2638,6 +3511,74 @@ Mat Mat::from_pixels_roi(const unsigned char* pixels, int type, int w, int h, in
     {
         return from_pixels(pixels + roiy * stride + roix * 4, type, roiw, roih, stride, allocator);
     }
+    else if (type_from == PIXEL_NV21 || type_from == PIXEL_NV12 || type_from == PIXEL_I420)
+    {
+        return from_yuv420_roi(pixels, type, h, stride, roix, roiy, roiw, roih, allocator);
+    }
+
+    // unknown convert type
+    NCNN_LOGE("unknown convert type %d", type);
+    return Mat();
+}
+
+Mat Mat::from_pixels_roi(const unsigned char* pixels, int type, int w, int h, int roix, int roiy, int roiw, int roih, const Option& opt)
+{
+    if (roix < 0 || roiy < 0 || roiw <= 0 || roih <= 0 || roix + roiw > w || roiy + roih > h)
+    {
+        NCNN_LOGE("roi %d %d %d %d out of image %d %d", roix, roiy, roiw, roih, w, h);
+        return Mat();
+    }
+
+    int type_from = type & PIXEL_FORMAT_MASK;
+
+    if (type_from == PIXEL_RGB || type_from == PIXEL_BGR)
+    {
+        return from_pixels(pixels + (roiy * w + roix) * 3, type, roiw, roih, w * 3, opt);
+    }
+    else if (type_from == PIXEL_GRAY)
+    {
+        return from_pixels(pixels + (roiy * w + roix) * 1, type, roiw, roih, w * 1, opt);
+    }
+    else if (type_from == PIXEL_RGBA || type_from == PIXEL_BGRA)
+    {
+        return from_pixels(pixels + (roiy * w + roix) * 4, type, roiw, roih, w * 4, opt);
+    }
+    else if (type_from == PIXEL_NV21 || type_from == PIXEL_NV12 || type_from == PIXEL_I420)
+    {
+        return from_yuv420_roi(pixels, type, h, w, roix, roiy, roiw, roih, opt.blob_allocator);
+    }
+
+    // unknown convert type
+    NCNN_LOGE("unknown convert type %d", type);
+    return Mat();
+}
+
+Mat Mat::from_pixels_roi(const unsigned char* pixels, int type, int w, int h, int stride, int roix, int roiy, int roiw, int roih, const Option& opt)
+{
+    if (roix < 0 || roiy < 0 || roiw <= 0 || roih <= 0 || roix + roiw > w || roiy + roih > h)
+    {
+        NCNN_LOGE("roi %d %d %d %d out of image %d %d", roix, roiy, roiw, roih, w, h);
+        return Mat();
+    }
+
+    int type_from = type & PIXEL_FORMAT_MASK;
+
+    if (type_from == PIXEL_RGB || type_from == PIXEL_BGR)
+    {
+        return from_pixels(pixels + roiy * stride + roix * 3, type, roiw, roih, stride, opt);
+    }
+    else if (type_from == PIXEL_GRAY)
+    {
+        return from_pixels(pixels + roiy * stride + roix * 1, type, roiw, roih, stride, opt);
+    }
+    else if (type_from == PIXEL_RGBA || type_from == PIXEL_BGRA)
+    {
+        return from_pixels(pixels + roiy * stride + roix * 4, type, roiw, roih, stride, opt);
+    }
+    else if (type_from == PIXEL_NV21 || type_from == PIXEL_NV12 || type_from == PIXEL_I420)
+    {
+        return from_yuv420_roi(pixels, type, h, stride, roix, roiy, roiw, roih, opt.blob_allocator);
+    }
 
     // unknown convert type
     NCNN_LOGE("unknown convert type %d", type);
@@ -2666,6 +3607,12 @@ Mat Mat::from_pixels_roi_resize(const unsigned char* pixels, int type, int w, in
     {
         return from_pixels_resize(pixels + (roiy * w + roix) * 4, type, roiw, roih, w * 4, target_width, target_height, allocator);
     }
+    else if (type_from == PIXEL_NV21 || type_from == PIXEL_NV12 || type_from == PIXEL_I420)
+    {
+        // the chroma plane of the roi is not contiguous with its luma rows
+        NCNN_LOGE("yuv420 type %d is not supported in roi resize, crop with from_pixels_roi first", type);
+        return Mat();
+    }
 
     // unknown convert type
     NCNN_LOGE("unknown convert type %d", type);
@@ -2694,6 +3641,12 @@ Mat Mat::from_pixels_roi_resize(const unsigned char* pixels, int type, int w, in
     {
         return from_pixels_resize(pixels + roiy * stride + roix * 4, type, roiw, roih, stride, target_width, target_height, allocator);
     }
+    else if (type_from == PIXEL_NV21 || type_from == PIXEL_NV12 || type_from == PIXEL_I420)
+    {
+        // the chroma plane of the roi is not contiguous with its luma rows
+        NCNN_LOGE("yuv420 type %d is not supported in roi resize, crop with from_pixels_roi first", type);
+        return Mat();
+    }
 
     // unknown convert type
     NCNN_LOGE("unknown convert type %d", type);
@@ -2763,6 +3716,37 @@ void Mat::to_pixels(unsigned char* pixels, int type, int stride) const
     }
 }
 
+void Mat::to_pixels(unsigned char* pixels, int type, const Option& opt) const
+{
+    const int channels = pixel_channels(type);
+    if (channels == 0)
+        return;
+
+    to_pixels(pixels, type, w * channels, opt);
+}
+
+void Mat::to_pixels(unsigned char* pixels, int type, int stride, const Option& opt) const
+{
+    const int nn_band = std::min(opt.num_threads, h);
+    if (nn_band <= 1)
+    {
+        to_pixels(pixels, type, stride);
+        return;
+    }
+
+    #pragma omp parallel for num_threads(nn_band)
+    for (int i = 0; i < nn_band; i++)
+    {
+        const int y0 = h * i / nn_band;
+        const int y1 = h * (i + 1) / nn_band;
+
+        Mat m_band(w, y1 - y0, c, (unsigned char*)data + (size_t)w * y0 * elemsize, elemsize, allocator);
+        m_band.cstep = cstep;
+
+        m_band.to_pixels(pixels + (size_t)y0 * stride, type, stride);
+    }
+}
+
 void Mat::to_pixels_resize(unsigned char* pixels, int type, int target_width, int target_height) const
 {
     int type_to = (type & PIXEL_CONVERT_MASK) ? (type >> PIXEL_CONVERT_SHIFT) : (type & PIXEL_FORMAT_MASK);
@@ -16,6 +16,9 @@
 #if __ARM_NEON
 #include <arm_neon.h>
 #endif // __ARM_NEON
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
 #include <limits.h>
 #include <math.h>
 #include "platform.h"
@@ -151,6 +154,34 @@ void invert_affine_transform(const float* tm, float* tm_inv)
     tm_inv[5] = b2;
 }
 
+#if __SSE2__
+static inline unsigned int load_u32(const unsigned char* p)
+{
+    unsigned int v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline void store_u32(unsigned char* p, unsigned int v)
+{
+    memcpy(p, &v, 4);
+}
+
+// 1-fx and fx packed as the int16 pair consumed by _mm_madd_epi16
+static inline int warpaffine_weight_pair(int fx)
+{
+    return (fx << 16) | ((1 << 10) - fx);
+}
+
+// four lanes of a0a1 and b0b1 int16 pairs blended with the same fixed point rounding as the scalar path
+static inline __m128i warpaffine_bilinear_sse2(__m128i _a0a1, __m128i _b0b1, __m128i _alpha01, __m128i _beta01)
+{
+    __m128i _a = _mm_srai_epi32(_mm_madd_epi16(_a0a1, _alpha01), 5);
+    __m128i _b = _mm_srai_epi32(_mm_madd_epi16(_b0b1, _alpha01), 5);
+    return _mm_srai_epi32(_mm_madd_epi16(_mm_or_si128(_a, _mm_slli_epi32(_b, 16)), _beta01), 15);
+}
+#endif // __SSE2__
+
 void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type, unsigned int v)
 {
     return warpaffine_bilinear_c1(src, srcw, srch, srcw, dst, w, h, w, tm, type, v);
@@ -172,12 +203,17 @@ void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, unsign
 }
 
 void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+{
+    Option opt;
+    opt.num_threads = 1;
+    warpaffine_bilinear_c1(src, srcw, srch, srcstride, dst, w, h, stride, tm, type, v, opt);
+}
+
+void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt)
 {
     const unsigned char* border_color = (const unsigned char*)&v;
-    const int wgap = stride - w;
 
     const unsigned char* src0 = src;
-    unsigned char* dst0 = dst;
 
 #define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X), SHRT_MIN), SHRT_MAX)
 #define SATURATE_CAST_INT(X)   (int)::std::min(::std::max((int)((X) + ((X) >= 0.f ? 0.5f : -0.5f)), INT_MIN), INT_MAX)
@@ -190,9 +226,11 @@ void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int sr
         bdelta[x] = SATURATE_CAST_INT(tm[3] * x * (1 << 10));
     }
 
-    int y = 0;
-    for (; y < h; y++)
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int y = 0; y < h; y++)
     {
+        unsigned char* dst0 = dst + stride * y;
+
         int X0 = SATURATE_CAST_INT((tm[1] * y + tm[2]) * (1 << 10));
         int Y0 = SATURATE_CAST_INT((tm[4] * y + tm[5]) * (1 << 10));
 
@@ -298,6 +336,44 @@ void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int sr
 
                 vst1_u8(dst0, _dst);
 
+                dst0 += 8;
+#elif __SSE2__
+                __m128i _Xl = _mm_add_epi32(_mm_set1_epi32(X0), _mm_loadu_si128((const __m128i*)(adelta.data() + x)));
+                __m128i _Xh = _mm_add_epi32(_mm_set1_epi32(X0), _mm_loadu_si128((const __m128i*)(adelta.data() + x + 4)));
+                __m128i _Yl = _mm_add_epi32(_mm_set1_epi32(Y0), _mm_loadu_si128((const __m128i*)(bdelta.data() + x)));
+                __m128i _Yh = _mm_add_epi32(_mm_set1_epi32(Y0), _mm_loadu_si128((const __m128i*)(bdelta.data() + x + 4)));
+
+                __m128i _v1024m1 = _mm_set1_epi32((1 << 10) - 1);
+                __m128i _fx = _mm_packs_epi32(_mm_and_si128(_Xl, _v1024m1), _mm_and_si128(_Xh, _v1024m1));
+                __m128i _fy = _mm_packs_epi32(_mm_and_si128(_Yl, _v1024m1), _mm_and_si128(_Yh, _v1024m1));
+
+                __m128i _alpha0 = _mm_sub_epi16(_mm_set1_epi16(1 << 10), _fx);
+                __m128i _beta0 = _mm_sub_epi16(_mm_set1_epi16(1 << 10), _fy);
+
+                unsigned short a0a1[8];
+                unsigned short b0b1[8];
+                for (int xi = 0; xi < 8; xi++)
+                {
+                    int X = X0 + adelta[x + xi];
+                    int Y = Y0 + bdelta[x + xi];
+
+                    const unsigned char* a0 = src0 + srcstride * (Y >> 10) + (X >> 10);
+                    const unsigned char* b0 = a0 + srcstride;
+
+                    a0a1[xi] = a0[0] | (a0[1] << 8);
+                    b0b1[xi] = b0[0] | (b0[1] << 8);
+                }
+
+                __m128i _a0a1 = _mm_loadu_si128((const __m128i*)a0a1);
+                __m128i _b0b1 = _mm_loadu_si128((const __m128i*)b0b1);
+
+                __m128i _zero = _mm_setzero_si128();
+                __m128i _dstl = warpaffine_bilinear_sse2(_mm_unpacklo_epi8(_a0a1, _zero), _mm_unpacklo_epi8(_b0b1, _zero), _mm_unpacklo_epi16(_alpha0, _fx), _mm_unpacklo_epi16(_beta0, _fy));
+                __m128i _dsth = warpaffine_bilinear_sse2(_mm_unpackhi_epi8(_a0a1, _zero), _mm_unpackhi_epi8(_b0b1, _zero), _mm_unpackhi_epi16(_alpha0, _fx), _mm_unpackhi_epi16(_beta0, _fy));
+                __m128i _dst = _mm_packs_epi32(_dstl, _dsth);
+
+                _mm_storel_epi64((__m128i*)dst0, _mm_packus_epi16(_dst, _dst));
+
                 dst0 += 8;
 #else
                 for (int xi = 0; xi < 8; xi++)
@@ -468,8 +544,6 @@ void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int sr
 
             dst0 += 1;
         }
-
-        dst0 += wgap;
     }
 
 #undef SATURATE_CAST_SHORT
@@ -477,12 +551,17 @@ void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int sr
 }
 
 void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+{
+    Option opt;
+    opt.num_threads = 1;
+    warpaffine_bilinear_c2(src, srcw, srch, srcstride, dst, w, h, stride, tm, type, v, opt);
+}
+
+void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt)
 {
     const unsigned char* border_color = (const unsigned char*)&v;
-    const int wgap = stride - w * 2;
 
     const unsigned char* src0 = src;
-    unsigned char* dst0 = dst;
 
 #define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X), SHRT_MIN), SHRT_MAX)
 #define SATURATE_CAST_INT(X)   (int)::std::min(::std::max((int)((X) + ((X) >= 0.f ? 0.5f : -0.5f)), INT_MIN), INT_MAX)
@@ -495,9 +574,11 @@ void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int sr
         bdelta[x] = SATURATE_CAST_INT(tm[3] * x * (1 << 10));
     }
 
-    int y = 0;
-    for (; y < h; y++)
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int y = 0; y < h; y++)
     {
+        unsigned char* dst0 = dst + stride * y;
+
         int X0 = SATURATE_CAST_INT((tm[1] * y + tm[2]) * (1 << 10));
         int Y0 = SATURATE_CAST_INT((tm[4] * y + tm[5]) * (1 << 10));
 
@@ -617,6 +698,38 @@ void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int sr
                 vst2_u8(dst0, _dst);
 
                 dst0 += 2 * 8;
+#elif __SSE2__
+                __m128i _zero = _mm_setzero_si128();
+                for (int xi = 0; xi < 8; xi += 2)
+                {
+                    // two pixels per register, each as a0a1 pairs of both channels
+                    int X_0 = X0 + adelta[x + xi];
+                    int Y_0 = Y0 + bdelta[x + xi];
+                    int X_1 = X0 + adelta[x + xi + 1];
+                    int Y_1 = Y0 + bdelta[x + xi + 1];
+
+                    const unsigned char* a0_0 = src0 + srcstride * (Y_0 >> 10) + (X_0 >> 10) * 2;
+                    const unsigned char* a0_1 = src0 + srcstride * (Y_1 >> 10) + (X_1 >> 10) * 2;
+
+                    __m128i _a = _mm_unpacklo_epi32(_mm_cvtsi32_si128(load_u32(a0_0)), _mm_cvtsi32_si128(load_u32(a0_1)));
+                    __m128i _b = _mm_unpacklo_epi32(_mm_cvtsi32_si128(load_u32(a0_0 + srcstride)), _mm_cvtsi32_si128(load_u32(a0_1 + srcstride)));
+                    _a = _mm_unpacklo_epi8(_a, _zero);
+                    _b = _mm_unpacklo_epi8(_b, _zero);
+                    _a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(_a, _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0));
+                    _b = _mm_shufflehi_epi16(_mm_shufflelo_epi16(_b, _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0));
+
+                    int alpha_0 = warpaffine_weight_pair(X_0 & ((1 << 10) - 1));
+                    int alpha_1 = warpaffine_weight_pair(X_1 & ((1 << 10) - 1));
+                    int beta_0 = warpaffine_weight_pair(Y_0 & ((1 << 10) - 1));
+                    int beta_1 = warpaffine_weight_pair(Y_1 & ((1 << 10) - 1));
+
+                    __m128i _dst = warpaffine_bilinear_sse2(_a, _b, _mm_setr_epi32(alpha_0, alpha_0, alpha_1, alpha_1), _mm_setr_epi32(beta_0, beta_0, beta_1, beta_1));
+                    _dst = _mm_packs_epi32(_dst, _dst);
+
+                    store_u32(dst0, _mm_cvtsi128_si32(_mm_packus_epi16(_dst, _dst)));
+
+                    dst0 += 4;
+                }
 #else
                 for (int xi = 0; xi < 8; xi++)
                 {
@@ -795,8 +908,6 @@ void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int sr
 
             dst0 += 2;
         }
-
-        dst0 += wgap;
     }
 
 #undef SATURATE_CAST_SHORT
@@ -804,12 +915,17 @@ void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int sr
 }
 
 void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+{
+    Option opt;
+    opt.num_threads = 1;
+    warpaffine_bilinear_c3(src, srcw, srch, srcstride, dst, w, h, stride, tm, type, v, opt);
+}
+
+void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt)
 {
     const unsigned char* border_color = (const unsigned char*)&v;
-    const int wgap = stride - w * 3;
 
     const unsigned char* src0 = src;
-    unsigned char* dst0 = dst;
 
 #define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X), SHRT_MIN), SHRT_MAX)
 #define SATURATE_CAST_INT(X)   (int)::std::min(::std::max((int)((X) + ((X) >= 0.f ? 0.5f : -0.5f)), INT_MIN), INT_MAX)
@@ -822,9 +938,11 @@ void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int sr
         bdelta[x] = SATURATE_CAST_INT(tm[3] * x * (1 << 10));
     }
 
-    int y = 0;
-    for (; y < h; y++)
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int y = 0; y < h; y++)
     {
+        unsigned char* dst0 = dst + stride * y;
+
         int X0 = SATURATE_CAST_INT((tm[1] * y + tm[2]) * (1 << 10));
         int Y0 = SATURATE_CAST_INT((tm[4] * y + tm[5]) * (1 << 10));
 
@@ -977,6 +1095,37 @@ void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int sr
                 vst3_u8(dst0, _dst);
 
                 dst0 += 3 * 8;
+#elif __SSE2__
+                __m128i _zero = _mm_setzero_si128();
+                for (int xi = 0; xi < 8; xi++)
+                {
+                    int X = X0 + adelta[x + xi];
+                    int Y = Y0 + bdelta[x + xi];
+
+                    const unsigned char* a0 = src0 + srcstride * (Y >> 10) + (X >> 10) * 3;
+                    const unsigned char* b0 = a0 + srcstride;
+
+                    // a1 is loaded one byte early so that nothing past the right neighbour is touched
+                    __m128i _a = _mm_unpacklo_epi32(_mm_cvtsi32_si128(load_u32(a0)), _mm_cvtsi32_si128(load_u32(a0 + 2) >> 8));
+                    __m128i _b = _mm_unpacklo_epi32(_mm_cvtsi32_si128(load_u32(b0)), _mm_cvtsi32_si128(load_u32(b0 + 2) >> 8));
+                    _a = _mm_unpacklo_epi8(_a, _zero);
+                    _b = _mm_unpacklo_epi8(_b, _zero);
+                    _a = _mm_unpacklo_epi16(_a, _mm_srli_si128(_a, 8));
+                    _b = _mm_unpacklo_epi16(_b, _mm_srli_si128(_b, 8));
+
+                    __m128i _alpha01 = _mm_set1_epi32(warpaffine_weight_pair(X & ((1 << 10) - 1)));
+                    __m128i _beta01 = _mm_set1_epi32(warpaffine_weight_pair(Y & ((1 << 10) - 1)));
+
+                    __m128i _dst = warpaffine_bilinear_sse2(_a, _b, _alpha01, _beta01);
+                    _dst = _mm_packs_epi32(_dst, _dst);
+
+                    unsigned int d = _mm_cvtsi128_si32(_mm_packus_epi16(_dst, _dst));
+                    dst0[0] = (unsigned char)d;
+                    dst0[1] = (unsigned char)(d >> 8);
+                    dst0[2] = (unsigned char)(d >> 16);
+
+                    dst0 += 3;
+                }
 #else
                 for (int xi = 0; xi < 8; xi++)
                 {
@@ -1162,8 +1311,6 @@ void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int sr
 
             dst0 += 3;
         }
-
-        dst0 += wgap;
     }
 
 #undef SATURATE_CAST_SHORT
@@ -1171,12 +1318,17 @@ void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int sr
 }
 
 void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+{
+    Option opt;
+    opt.num_threads = 1;
+    warpaffine_bilinear_c4(src, srcw, srch, srcstride, dst, w, h, stride, tm, type, v, opt);
+}
+
+void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt)
 {
     const unsigned char* border_color = (const unsigned char*)&v;
-    const int wgap = stride - w * 4;
 
     const unsigned char* src0 = src;
-    unsigned char* dst0 = dst;
 
 #define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X), SHRT_MIN), SHRT_MAX)
 #define SATURATE_CAST_INT(X)   (int)::std::min(::std::max((int)((X) + ((X) >= 0.f ? 0.5f : -0.5f)), INT_MIN), INT_MAX)
@@ -1189,9 +1341,11 @@ void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int sr
         bdelta[x] = SATURATE_CAST_INT(tm[3] * x * (1 << 10));
     }
 
-    int y = 0;
-    for (; y < h; y++)
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int y = 0; y < h; y++)
     {
+        unsigned char* dst0 = dst + stride * y;
+
         int X0 = SATURATE_CAST_INT((tm[1] * y + tm[2]) * (1 << 10));
         int Y0 = SATURATE_CAST_INT((tm[4] * y + tm[5]) * (1 << 10));
 
@@ -1379,6 +1533,31 @@ void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int sr
                 vst4_u8(dst0, _dst);
 
                 dst0 += 4 * 8;
+#elif __SSE2__
+                __m128i _zero = _mm_setzero_si128();
+                for (int xi = 0; xi < 8; xi++)
+                {
+                    int X = X0 + adelta[x + xi];
+                    int Y = Y0 + bdelta[x + xi];
+
+                    const unsigned char* a0 = src0 + srcstride * (Y >> 10) + (X >> 10) * 4;
+                    const unsigned char* b0 = a0 + srcstride;
+
+                    __m128i _a = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)a0), _zero);
+                    __m128i _b = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)b0), _zero);
+                    _a = _mm_unpacklo_epi16(_a, _mm_srli_si128(_a, 8));
+                    _b = _mm_unpacklo_epi16(_b, _mm_srli_si128(_b, 8));
+
+                    __m128i _alpha01 = _mm_set1_epi32(warpaffine_weight_pair(X & ((1 << 10) - 1)));
+                    __m128i _beta01 = _mm_set1_epi32(warpaffine_weight_pair(Y & ((1 << 10) - 1)));
+
+                    __m128i _dst = warpaffine_bilinear_sse2(_a, _b, _alpha01, _beta01);
+                    _dst = _mm_packs_epi32(_dst, _dst);
+
+                    store_u32(dst0, _mm_cvtsi128_si32(_mm_packus_epi16(_dst, _dst)));
+
+                    dst0 += 4;
+                }
 #else
                 for (int xi = 0; xi < 8; xi++)
                 {
@@ -1571,8 +1750,6 @@ void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int sr
 
             dst0 += 4;
         }
-
-        dst0 += wgap;
     }
 
 #undef SATURATE_CAST_SHORT
@@ -1580,6 +1757,13 @@ void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int sr
 }
 
 void warpaffine_bilinear_yuv420sp(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type, unsigned int v)
+{
+    Option opt;
+    opt.num_threads = 1;
+    warpaffine_bilinear_yuv420sp(src, srcw, srch, dst, w, h, tm, type, v, opt);
+}
+
+void warpaffine_bilinear_yuv420sp(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type, unsigned int v, const Option& opt)
 {
     // assert srcw % 2 == 0
     // assert srch % 2 == 0
@@ -1598,7 +1782,7 @@ void warpaffine_bilinear_yuv420sp(const unsigned char* src, int srcw, int srch,
 
     const unsigned char* srcY = src;
     unsigned char* dstY = dst;
-    warpaffine_bilinear_c1(srcY, srcw, srch, dstY, w, h, tm, type, v_y);
+    warpaffine_bilinear_c1(srcY, srcw, srch, srcw, dstY, w, h, w, tm, type, v_y, opt);
 
     const float tm_uv[6] = {
         tm[0],
@@ -1611,7 +1795,53 @@ void warpaffine_bilinear_yuv420sp(const unsigned char* src, int srcw, int srch,
 
     const unsigned char* srcUV = src + srcw * srch;
     unsigned char* dstUV = dst + w * h;
-    warpaffine_bilinear_c2(srcUV, srcw / 2, srch / 2, dstUV, w / 2, h / 2, tm_uv, type, v_uv);
+    warpaffine_bilinear_c2(srcUV, srcw / 2, srch / 2, srcw, dstUV, w / 2, h / 2, w, tm_uv, type, v_uv, opt);
+}
+
+typedef void (*warpaffine_bilinear_func)(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt);
+
+static void warpaffine_bilinear_batch(warpaffine_bilinear_func warpaffine, const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* const* dsts, int w, int h, int stride, const float* tms, int count, int type, unsigned int v, const Option& opt)
+{
+    if (count >= opt.num_threads)
+    {
+        // one region per thread at a time, no nested parallel region inside
+        Option opt1 = opt;
+        opt1.num_threads = 1;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 0; i < count; i++)
+        {
+            warpaffine(src, srcw, srch, srcstride, dsts[i], w, h, stride, tms + i * 6, type, v, opt1);
+        }
+    }
+    else
+    {
+        // too few regions to keep every thread busy, spread the rows of each instead
+        for (int i = 0; i < count; i++)
+        {
+            warpaffine(src, srcw, srch, srcstride, dsts[i], w, h, stride, tms + i * 6, type, v, opt);
+        }
+    }
+}
+
+void warpaffine_bilinear_batch_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* const* dsts, int w, int h, int stride, const float* tms, int count, int type, unsigned int v, const Option& opt)
+{
+    warpaffine_bilinear_batch(warpaffine_bilinear_c1, src, srcw, srch, srcstride, dsts, w, h, stride, tms, count, type, v, opt);
+}
+
+void warpaffine_bilinear_batch_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* const* dsts, int w, int h, int stride, const float* tms, int count, int type, unsigned int v, const Option& opt)
+{
+    warpaffine_bilinear_batch(warpaffine_bilinear_c2, src, srcw, srch, srcstride, dsts, w, h, stride, tms, count, type, v, opt);
+}
+
+void warpaffine_bilinear_batch_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* const* dsts, int w, int h, int stride, const float* tms, int count, int type, unsigned int v, const Option& opt)
+{
+    warpaffine_bilinear_batch(warpaffine_bilinear_c3, src, srcw, srch, srcstride, dsts, w, h, stride, tms, count, type, v, opt);
+}
+
+void warpaffine_bilinear_batch_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* const* dsts, int w, int h, int stride, const float* tms, int count, int type, unsigned int v, const Option& opt)
+{
+    warpaffine_bilinear_batch(warpaffine_bilinear_c4, src, srcw, srch, srcstride, dsts, w, h, stride, tms, count, type, v, opt);
 }
 #endif // NCNN_PIXEL_AFFINE
 
@@ -0,0 +1,510 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "mat.h"
+
+#include <math.h>
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+#include "platform.h"
+
+namespace ncnn {
+
+#if NCNN_PIXEL
+// source channel feeding each destination channel
+enum
+{
+    PIXEL_SOURCE_ALPHA = -1, // constant 255
+    PIXEL_SOURCE_GRAY = -2   // weighted r g b from gray_index
+};
+
+struct pixel_convert_map
+{
+    int src_channels;
+    int dst_channels;
+    int source[4];
+    int gray_index[3];
+};
+
+static int get_pixel_convert_map(int type, pixel_convert_map& cm)
+{
+    const int A = PIXEL_SOURCE_ALPHA;
+    const int Y = PIXEL_SOURCE_GRAY;
+
+    cm.gray_index[0] = 0;
+    cm.gray_index[1] = 1;
+    cm.gray_index[2] = 2;
+
+    int src_channels = 0;
+    int dst_channels = 0;
+    int source[4] = {0, 1, 2, 3};
+
+    switch (type)
+    {
+    case Mat::PIXEL_GRAY:
+        src_channels = 1;
+        dst_channels = 1;
+        break;
+    case Mat::PIXEL_RGB:
+    case Mat::PIXEL_BGR:
+        src_channels = 3;
+        dst_channels = 3;
+        break;
+    case Mat::PIXEL_RGBA:
+    case Mat::PIXEL_BGRA:
+        src_channels = 4;
+        dst_channels = 4;
+        break;
+    case Mat::PIXEL_RGB2BGR:
+    case Mat::PIXEL_BGR2RGB:
+        src_channels = 3;
+        dst_channels = 3;
+        source[0] = 2;
+        source[2] = 0;
+        break;
+    case Mat::PIXEL_RGB2GRAY:
+    case Mat::PIXEL_BGR2GRAY:
+        src_channels = 3;
+        dst_channels = 1;
+        source[0] = Y;
+        break;
+    case Mat::PIXEL_RGB2RGBA:
+    case Mat::PIXEL_BGR2BGRA:
+        src_channels = 3;
+        dst_channels = 4;
+        source[3] = A;
+        break;
+    case Mat::PIXEL_BGR2RGBA:
+    case Mat::PIXEL_RGB2BGRA:
+        src_channels = 3;
+        dst_channels = 4;
+        source[0] = 2;
+        source[2] = 0;
+        source[3] = A;
+        break;
+    case Mat::PIXEL_GRAY2RGB:
+    case Mat::PIXEL_GRAY2BGR:
+        src_channels = 1;
+        dst_channels = 3;
+        source[1] = 0;
+        source[2] = 0;
+        break;
+    case Mat::PIXEL_GRAY2RGBA:
+    case Mat::PIXEL_GRAY2BGRA:
+        src_channels = 1;
+        dst_channels = 4;
+        source[1] = 0;
+        source[2] = 0;
+        source[3] = A;
+        break;
+    case Mat::PIXEL_RGBA2RGB:
+    case Mat::PIXEL_BGRA2BGR:
+        src_channels = 4;
+        dst_channels = 3;
+        break;
+    case Mat::PIXEL_RGBA2BGR:
+    case Mat::PIXEL_BGRA2RGB:
+        src_channels = 4;
+        dst_channels = 3;
+        source[0] = 2;
+        source[2] = 0;
+        break;
+    case Mat::PIXEL_RGBA2GRAY:
+    case Mat::PIXEL_BGRA2GRAY:
+        src_channels = 4;
+        dst_channels = 1;
+        source[0] = Y;
+        break;
+    case Mat::PIXEL_RGBA2BGRA:
+    case Mat::PIXEL_BGRA2RGBA:
+        src_channels = 4;
+        dst_channels = 4;
+        source[0] = 2;
+        source[2] = 0;
+        break;
+    default:
+        return -1;
+    }
+
+    if (type == Mat::PIXEL_BGR2GRAY || type == Mat::PIXEL_BGRA2GRAY)
+    {
+        cm.gray_index[0] = 2;
+        cm.gray_index[2] = 0;
+    }
+
+    cm.src_channels = src_channels;
+    cm.dst_channels = dst_channels;
+    for (int q = 0; q < 4; q++)
+    {
+        cm.source[q] = source[q];
+    }
+
+    return 0;
+}
+
+// interpolate one source row horizontally into one planar float row per source channel
+template<int src_channels>
+static void hresize_row(const unsigned char* S, float* rows, int rows_cstep, const int* xofs, const float* alpha, int w)
+{
+    for (int dx = 0; dx < w; dx++)
+    {
+        const unsigned char* S0p = S + xofs[dx * 2];
+        const unsigned char* S1p = S + xofs[dx * 2 + 1];
+        const float a0 = alpha[dx * 2];
+        const float a1 = alpha[dx * 2 + 1];
+
+        for (int k = 0; k < src_channels; k++)
+        {
+            rows[rows_cstep * k + dx] = S0p[k] * a0 + S1p[k] * a1;
+        }
+    }
+}
+
+static void hresize_row(const unsigned char* S, float* rows, int rows_cstep, const int* xofs, const float* alpha, int w, int src_channels)
+{
+    if (src_channels == 1)
+        hresize_row<1>(S, rows, rows_cstep, xofs, alpha, w);
+    if (src_channels == 3)
+        hresize_row<3>(S, rows, rows_cstep, xofs, alpha, w);
+    if (src_channels == 4)
+        hresize_row<4>(S, rows, rows_cstep, xofs, alpha, w);
+}
+
+// outptr = rows0 * b0 * norm + rows1 * b1 * norm - mean * norm
+static void vresize_normalize_row(const float* rows0, const float* rows1, float b0, float b1, float mean, float norm, float* outptr, int w)
+{
+    const float s0 = b0 * norm;
+    const float s1 = b1 * norm;
+    const float bias = -mean * norm;
+
+    int dx = 0;
+#if __ARM_NEON
+    float32x4_t _s0 = vdupq_n_f32(s0);
+    float32x4_t _s1 = vdupq_n_f32(s1);
+    float32x4_t _bias = vdupq_n_f32(bias);
+    for (; dx + 3 < w; dx += 4)
+    {
+        float32x4_t _r0 = vld1q_f32(rows0 + dx);
+        float32x4_t _r1 = vld1q_f32(rows1 + dx);
+        float32x4_t _out = vmlaq_f32(vmlaq_f32(_bias, _r0, _s0), _r1, _s1);
+        vst1q_f32(outptr + dx, _out);
+    }
+#elif __SSE2__
+    __m128 _s0 = _mm_set1_ps(s0);
+    __m128 _s1 = _mm_set1_ps(s1);
+    __m128 _bias = _mm_set1_ps(bias);
+    for (; dx + 3 < w; dx += 4)
+    {
+        __m128 _r0 = _mm_loadu_ps(rows0 + dx);
+        __m128 _r1 = _mm_loadu_ps(rows1 + dx);
+        __m128 _out = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_r0, _s0), _mm_mul_ps(_r1, _s1)), _bias);
+        _mm_storeu_ps(outptr + dx, _out);
+    }
+#endif // __ARM_NEON
+    for (; dx < w; dx++)
+    {
+        outptr[dx] = rows0[dx] * s0 + rows1[dx] * s1 + bias;
+    }
+}
+
+// outptr += rows0 * s0 + rows1 * s1
+static void vresize_accumulate_row(const float* rows0, const float* rows1, float s0, float s1, float* outptr, int w)
+{
+    int dx = 0;
+#if __ARM_NEON
+    float32x4_t _s0 = vdupq_n_f32(s0);
+    float32x4_t _s1 = vdupq_n_f32(s1);
+    for (; dx + 3 < w; dx += 4)
+    {
+        float32x4_t _r0 = vld1q_f32(rows0 + dx);
+        float32x4_t _r1 = vld1q_f32(rows1 + dx);
+        float32x4_t _out = vld1q_f32(outptr + dx);
+        _out = vmlaq_f32(vmlaq_f32(_out, _r0, _s0), _r1, _s1);
+        vst1q_f32(outptr + dx, _out);
+    }
+#elif __SSE2__
+    __m128 _s0 = _mm_set1_ps(s0);
+    __m128 _s1 = _mm_set1_ps(s1);
+    for (; dx + 3 < w; dx += 4)
+    {
+        __m128 _r0 = _mm_loadu_ps(rows0 + dx);
+        __m128 _r1 = _mm_loadu_ps(rows1 + dx);
+        __m128 _out = _mm_loadu_ps(outptr + dx);
+        _out = _mm_add_ps(_out, _mm_add_ps(_mm_mul_ps(_r0, _s0), _mm_mul_ps(_r1, _s1)));
+        _mm_storeu_ps(outptr + dx, _out);
+    }
+#endif // __ARM_NEON
+    for (; dx < w; dx++)
+    {
+        outptr[dx] += rows0[dx] * s0 + rows1[dx] * s1;
+    }
+}
+
+static void pack4_row(const float* r0, const float* r1, const float* r2, const float* r3, float* outptr, int w)
+{
+    int dx = 0;
+#if __ARM_NEON
+    for (; dx + 3 < w; dx += 4)
+    {
+        float32x4x4_t _p;
+        _p.val[0] = vld1q_f32(r0 + dx);
+        _p.val[1] = vld1q_f32(r1 + dx);
+        _p.val[2] = vld1q_f32(r2 + dx);
+        _p.val[3] = vld1q_f32(r3 + dx);
+        vst4q_f32(outptr + dx * 4, _p);
+    }
+#elif __SSE2__
+    for (; dx + 3 < w; dx += 4)
+    {
+        __m128 _p0 = _mm_loadu_ps(r0 + dx);
+        __m128 _p1 = _mm_loadu_ps(r1 + dx);
+        __m128 _p2 = _mm_loadu_ps(r2 + dx);
+        __m128 _p3 = _mm_loadu_ps(r3 + dx);
+        _MM_TRANSPOSE4_PS(_p0, _p1, _p2, _p3);
+        _mm_storeu_ps(outptr + dx * 4, _p0);
+        _mm_storeu_ps(outptr + dx * 4 + 4, _p1);
+        _mm_storeu_ps(outptr + dx * 4 + 8, _p2);
+        _mm_storeu_ps(outptr + dx * 4 + 12, _p3);
+    }
+#endif // __ARM_NEON
+    for (; dx < w; dx++)
+    {
+        outptr[dx * 4] = r0[dx];
+        outptr[dx * 4 + 1] = r1[dx];
+        outptr[dx * 4 + 2] = r2[dx];
+        outptr[dx * 4 + 3] = r3[dx];
+    }
+}
+
+Mat Mat::from_pixels_resize_normalize(const unsigned char* pixels, int type, int w, int h, int stride, int target_width, int target_height, const float* mean_vals, const float* norm_vals, int elempack, const Option& opt)
+{
+    return Mat::from_pixels_roi_resize_normalize(pixels, type, w, h, stride, 0, 0, w, h, target_width, target_height, mean_vals, norm_vals, elempack, opt);
+}
+
+Mat Mat::from_pixels_roi_resize_normalize(const unsigned char* pixels, int type, int w, int h, int stride, int roix, int roiy, int roiw, int roih, int target_width, int target_height, const float* mean_vals, const float* norm_vals, int elempack, const Option& opt)
+{
+    if (roix < 0 || roiy < 0 || roiw <= 0 || roih <= 0 || roix + roiw > w || roiy + roih > h)
+    {
+        NCNN_LOGE("roi %d %d %d %d out of image %d %d", roix, roiy, roiw, roih, w, h);
+        return Mat();
+    }
+
+    pixel_convert_map cm;
+    if (get_pixel_convert_map(type, cm) != 0)
+    {
+        // unimplemented convert type
+        NCNN_LOGE("unimplemented convert type %d", type);
+        return Mat();
+    }
+
+    const int channels = cm.dst_channels;
+    if (elempack != 1 && elempack != 4)
+    {
+        NCNN_LOGE("unsupported elempack %d", elempack);
+        return Mat();
+    }
+    if (channels % elempack != 0)
+    {
+        NCNN_LOGE("elempack %d does not divide %d channels", elempack, channels);
+        return Mat();
+    }
+
+    const int src_channels = cm.src_channels;
+    const unsigned char* src = pixels + roiy * stride + roix * src_channels;
+
+    Mat m;
+    m.create(target_width, target_height, channels / elempack, 4u * elempack, elempack, opt.blob_allocator);
+    if (m.empty())
+        return m;
+
+    // the same sampling positions as resize_bilinear_c1..c4, kept in float
+    double scale_x = (double)roiw / target_width;
+    double scale_y = (double)roih / target_height;
+
+    Mat xbuf(target_width * 2, (size_t)4u, opt.workspace_allocator);
+    Mat ybuf(target_height * 2, (size_t)4u, opt.workspace_allocator);
+    Mat alphabuf(target_width * 2, (size_t)4u, opt.workspace_allocator);
+    Mat betabuf(target_height * 2, (size_t)4u, opt.workspace_allocator);
+    if (xbuf.empty() || ybuf.empty() || alphabuf.empty() || betabuf.empty())
+        return Mat();
+
+    int* xofs = xbuf;
+    int* yofs = ybuf;
+    float* alpha = alphabuf;
+    float* beta = betabuf;
+
+    for (int dx = 0; dx < target_width; dx++)
+    {
+        float fx = (float)((dx + 0.5) * scale_x - 0.5);
+        int sx = (int)floor(fx);
+        fx -= sx;
+
+        if (sx < 0)
+        {
+            sx = 0;
+            fx = 0.f;
+        }
+        if (sx >= roiw - 1)
+        {
+            sx = roiw - 1;
+            fx = 0.f;
+        }
+
+        const int sx1 = sx + 1 < roiw ? sx + 1 : sx;
+
+        xofs[dx * 2] = sx * src_channels;
+        xofs[dx * 2 + 1] = sx1 * src_channels;
+        alpha[dx * 2] = 1.f - fx;
+        alpha[dx * 2 + 1] = fx;
+    }
+
+    for (int dy = 0; dy < target_height; dy++)
+    {
+        float fy = (float)((dy + 0.5) * scale_y - 0.5);
+        int sy = (int)floor(fy);
+        fy -= sy;
+
+        if (sy < 0)
+        {
+            sy = 0;
+            fy = 0.f;
+        }
+        if (sy >= roih - 1)
+        {
+            sy = roih - 1;
+            fy = 0.f;
+        }
+
+        const int sy1 = sy + 1 < roih ? sy + 1 : sy;
+
+        yofs[dy * 2] = sy;
+        yofs[dy * 2 + 1] = sy1;
+        beta[dy * 2] = 1.f - fy;
+        beta[dy * 2 + 1] = fy;
+    }
+
+    float mean[4] = {0.f, 0.f, 0.f, 0.f};
+    float norm[4] = {1.f, 1.f, 1.f, 1.f};
+    for (int q = 0; q < channels; q++)
+    {
+        if (mean_vals)
+            mean[q] = mean_vals[q];
+        if (norm_vals)
+            norm[q] = norm_vals[q];
+    }
+
+    // each thread resizes a band of output rows and keeps the source rows it can reuse
+    const int nn_band = std::max(std::min(opt.num_threads, target_height), 1);
+
+    #pragma omp parallel for num_threads(nn_band)
+    for (int i = 0; i < nn_band; i++)
+    {
+        const int dy0 = target_height * i / nn_band;
+        const int dy1 = target_height * (i + 1) / nn_band;
+
+        // rows0 rows1 with one plane per source channel, then the normalized output with one plane per destination channel
+        Mat rowsbuf(target_width, src_channels * 2 + channels, (size_t)4u, opt.workspace_allocator);
+        float* rows0 = rowsbuf.row(0);
+        float* rows1 = rowsbuf.row(src_channels);
+        float* outrows = rowsbuf.row(src_channels * 2);
+        const int rows_cstep = target_width;
+
+        int prev_sy0 = -2;
+        int prev_sy1 = -2;
+
+        for (int dy = dy0; dy < dy1; dy++)
+        {
+            const int sy0 = yofs[dy * 2];
+            const int sy1 = yofs[dy * 2 + 1];
+
+            if (sy0 == prev_sy0 && sy1 == prev_sy1)
+            {
+                // reuse all rows
+            }
+            else if (sy0 == prev_sy1)
+            {
+                // hresize one row
+                float* rows0_old = rows0;
+                rows0 = rows1;
+                rows1 = rows0_old;
+                hresize_row(src + stride * sy1, rows1, rows_cstep, xofs, alpha, target_width, src_channels);
+            }
+            else
+            {
+                // hresize two rows
+                hresize_row(src + stride * sy0, rows0, rows_cstep, xofs, alpha, target_width, src_channels);
+                hresize_row(src + stride * sy1, rows1, rows_cstep, xofs, alpha, target_width, src_channels);
+            }
+
+            prev_sy0 = sy0;
+            prev_sy1 = sy1;
+
+            const float b0 = beta[dy * 2];
+            const float b1 = beta[dy * 2 + 1];
+
+            for (int q = 0; q < channels; q++)
+            {
+                float* outptr = elempack == 1 ? m.channel(q).row(dy) : outrows + rows_cstep * q;
+
+                const int source = cm.source[q];
+                if (source == PIXEL_SOURCE_ALPHA)
+                {
+                    const float v = (255.f - mean[q]) * norm[q];
+                    for (int dx = 0; dx < target_width; dx++)
+                    {
+                        outptr[dx] = v;
+                    }
+                    continue;
+                }
+
+                if (source == PIXEL_SOURCE_GRAY)
+                {
+                    // same weights as the integer gray conversion, without the truncation
+                    const float R2Y = 77 / 256.f;
+                    const float G2Y = 150 / 256.f;
+                    const float B2Y = 29 / 256.f;
+
+                    const int ri = cm.gray_index[0];
+                    const int gi = cm.gray_index[1];
+                    const int bi = cm.gray_index[2];
+
+                    vresize_normalize_row(rows0 + rows_cstep * ri, rows1 + rows_cstep * ri, b0 * R2Y, b1 * R2Y, mean[q], norm[q], outptr, target_width);
+                    vresize_accumulate_row(rows0 + rows_cstep * gi, rows1 + rows_cstep * gi, b0 * G2Y * norm[q], b1 * G2Y * norm[q], outptr, target_width);
+                    vresize_accumulate_row(rows0 + rows_cstep * bi, rows1 + rows_cstep * bi, b0 * B2Y * norm[q], b1 * B2Y * norm[q], outptr, target_width);
+                    continue;
+                }
+
+                vresize_normalize_row(rows0 + rows_cstep * source, rows1 + rows_cstep * source, b0, b1, mean[q], norm[q], outptr, target_width);
+            }
+
+            if (elempack == 4)
+            {
+                for (int q = 0; q + 3 < channels; q += 4)
+                {
+                    const float* r0 = outrows + rows_cstep * q;
+                    pack4_row(r0, r0 + rows_cstep, r0 + rows_cstep * 2, r0 + rows_cstep * 3, m.channel(q / 4).row(dy), target_width);
+                }
+            }
+        }
+    }
+
+    return m;
+}
+#endif // NCNN_PIXEL
+
+} // namespace ncnn
@@ -14,11 +14,15 @@
 
 #include "mat.h"
 
+#include <algorithm>
 #include <limits.h>
 #include <math.h>
 #if __ARM_NEON
 #include <arm_neon.h>
 #endif // __ARM_NEON
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
 #include "platform.h"
 
 namespace ncnn {
@@ -45,6 +49,13 @@ void resize_bilinear_c4(const unsigned char* src, int srcw, int srch, unsigned c
 }
 
 void resize_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    Option opt;
+    opt.num_threads = 1;
+    resize_bilinear_c1(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+}
+
+void resize_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
 {
     const int INTER_RESIZE_COEF_BITS = 11;
     const int INTER_RESIZE_COEF_SCALE = 1 << INTER_RESIZE_COEF_BITS;
@@ -123,182 +134,215 @@ void resize_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstr
 #undef SATURATE_CAST_SHORT
 
     // loop body
-    Mat rowsbuf0(w, (size_t)2u);
-    Mat rowsbuf1(w, (size_t)2u);
-    short* rows0 = (short*)rowsbuf0.data;
-    short* rows1 = (short*)rowsbuf1.data;
+    const int nn_band = std::max(std::min(opt.num_threads, h), 1);
 
-    int prev_sy1 = -2;
-
-    for (int dy = 0; dy < h; dy++)
+    #pragma omp parallel for num_threads(nn_band)
+    for (int band = 0; band < nn_band; band++)
     {
-        sy = yofs[dy];
+        const int dy0 = h * band / nn_band;
+        const int dy1 = h * (band + 1) / nn_band;
 
-        if (sy == prev_sy1)
-        {
-            // reuse all rows
-        }
-        else if (sy == prev_sy1 + 1)
-        {
-            // hresize one row
-            short* rows0_old = rows0;
-            rows0 = rows1;
-            rows1 = rows0_old;
-            const unsigned char* S1 = src + srcstride * (sy + 1);
+        Mat rowsbuf0(w, (size_t)2u);
+        Mat rowsbuf1(w, (size_t)2u);
+        short* rows0 = (short*)rowsbuf0.data;
+        short* rows1 = (short*)rowsbuf1.data;
 
-            const short* ialphap = ialpha;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
-            {
-                sx = xofs[dx];
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
+        int prev_sy1 = -2;
 
-                const unsigned char* S1p = S1 + sx;
-                rows1p[dx] = (S1p[0] * a0 + S1p[1] * a1) >> 4;
-
-                ialphap += 2;
-            }
-        }
-        else
+        for (int dy = dy0; dy < dy1; dy++)
         {
-            // hresize two rows
-            const unsigned char* S0 = src + srcstride * (sy);
-            const unsigned char* S1 = src + srcstride * (sy + 1);
+            int sy = yofs[dy];
 
-            const short* ialphap = ialpha;
-            short* rows0p = rows0;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
+            if (sy == prev_sy1)
             {
-                sx = xofs[dx];
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
-
-                const unsigned char* S0p = S0 + sx;
-                const unsigned char* S1p = S1 + sx;
-                rows0p[dx] = (S0p[0] * a0 + S0p[1] * a1) >> 4;
-                rows1p[dx] = (S1p[0] * a0 + S1p[1] * a1) >> 4;
-
-                ialphap += 2;
+                // reuse all rows
+            }
+            else if (sy == prev_sy1 + 1)
+            {
+                // hresize one row
+                short* rows0_old = rows0;
+                rows0 = rows1;
+                rows1 = rows0_old;
+                const unsigned char* S1 = src + srcstride * (sy + 1);
+
+                const short* ialphap = ialpha;
+                short* rows1p = rows1;
+                for (int dx = 0; dx < w; dx++)
+                {
+                    int sx = xofs[dx];
+                    short a0 = ialphap[0];
+                    short a1 = ialphap[1];
+
+                    const unsigned char* S1p = S1 + sx;
+                    rows1p[dx] = (S1p[0] * a0 + S1p[1] * a1) >> 4;
+
+                    ialphap += 2;
+                }
+            }
+            else
+            {
+                // hresize two rows
+                const unsigned char* S0 = src + srcstride * (sy);
+                const unsigned char* S1 = src + srcstride * (sy + 1);
+
+                const short* ialphap = ialpha;
+                short* rows0p = rows0;
+                short* rows1p = rows1;
+                for (int dx = 0; dx < w; dx++)
+                {
+                    int sx = xofs[dx];
+                    short a0 = ialphap[0];
+                    short a1 = ialphap[1];
+
+                    const unsigned char* S0p = S0 + sx;
+                    const unsigned char* S1p = S1 + sx;
+                    rows0p[dx] = (S0p[0] * a0 + S0p[1] * a1) >> 4;
+                    rows1p[dx] = (S1p[0] * a0 + S1p[1] * a1) >> 4;
+
+                    ialphap += 2;
+                }
             }
-        }
 
-        prev_sy1 = sy;
+            prev_sy1 = sy;
 
-        // vresize
-        short b0 = ibeta[0];
-        short b1 = ibeta[1];
+            // vresize
+            short b0 = ibeta[dy * 2];
+            short b1 = ibeta[dy * 2 + 1];
 
-        short* rows0p = rows0;
-        short* rows1p = rows1;
-        unsigned char* Dp = dst + stride * (dy);
+            short* rows0p = rows0;
+            short* rows1p = rows1;
+            unsigned char* Dp = dst + stride * (dy);
 
-#if __ARM_NEON
-        int nn = w >> 3;
+#if __ARM_NEON || __SSE2__
+            int nn = w >> 3;
 #else
-        int nn = 0;
+            int nn = 0;
 #endif
-        int remain = w - (nn << 3);
+            int remain = w - (nn << 3);
 
 #if __ARM_NEON
 #if __aarch64__
-        int16x4_t _b0 = vdup_n_s16(b0);
-        int16x4_t _b1 = vdup_n_s16(b1);
-        int32x4_t _v2 = vdupq_n_s32(2);
-        for (; nn > 0; nn--)
-        {
-            int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
-            int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
-            int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
-            int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
+            int16x4_t _b0 = vdup_n_s16(b0);
+            int16x4_t _b1 = vdup_n_s16(b1);
+            int32x4_t _v2 = vdupq_n_s32(2);
+            for (; nn > 0; nn--)
+            {
+                int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
+                int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
+                int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
+                int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
 
-            int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
-            int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
-            int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
-            int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
+                int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
+                int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
+                int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
+                int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
 
-            int32x4_t _acc = _v2;
-            _acc = vsraq_n_s32(_acc, _rows0p_sr4_mb0, 16);
-            _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
+                int32x4_t _acc = _v2;
+                _acc = vsraq_n_s32(_acc, _rows0p_sr4_mb0, 16);
+                _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
 
-            int32x4_t _acc_1 = _v2;
-            _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
-            _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
+                int32x4_t _acc_1 = _v2;
+                _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
+                _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
 
-            int16x4_t _acc16 = vshrn_n_s32(_acc, 2);
-            int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
+                int16x4_t _acc16 = vshrn_n_s32(_acc, 2);
+                int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
 
-            uint8x8_t _D = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
+                uint8x8_t _D = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
 
-            vst1_u8(Dp, _D);
+                vst1_u8(Dp, _D);
 
-            Dp += 8;
-            rows0p += 8;
-            rows1p += 8;
-        }
+                Dp += 8;
+                rows0p += 8;
+                rows1p += 8;
+            }
 #else
-        if (nn > 0)
-        {
-            asm volatile(
-                "vdup.s16   d16, %8         \n"
-                "mov        r4, #2          \n"
-                "vdup.s16   d17, %9         \n"
-                "vdup.s32   q12, r4         \n"
-                "pld        [%0, #128]      \n"
-                "vld1.s16   {d2-d3}, [%0 :128]!\n"
-                "pld        [%1, #128]      \n"
-                "vld1.s16   {d6-d7}, [%1 :128]!\n"
-                "0:                         \n"
-                "vmull.s16  q0, d2, d16     \n"
-                "vmull.s16  q1, d3, d16     \n"
-                "vorr.s32   q10, q12, q12   \n"
-                "vorr.s32   q11, q12, q12   \n"
-                "vmull.s16  q2, d6, d17     \n"
-                "vmull.s16  q3, d7, d17     \n"
-                "vsra.s32   q10, q0, #16    \n"
-                "vsra.s32   q11, q1, #16    \n"
-                "pld        [%0, #128]      \n"
-                "vld1.s16   {d2-d3}, [%0 :128]!\n"
-                "vsra.s32   q10, q2, #16    \n"
-                "vsra.s32   q11, q3, #16    \n"
-                "pld        [%1, #128]      \n"
-                "vld1.s16   {d6-d7}, [%1 :128]!\n"
-                "vshrn.s32  d20, q10, #2    \n"
-                "vshrn.s32  d21, q11, #2    \n"
-                "vqmovun.s16 d20, q10        \n"
-                "vst1.8     {d20}, [%2]!    \n"
-                "subs       %3, #1          \n"
-                "bne        0b              \n"
-                "sub        %0, #16         \n"
-                "sub        %1, #16         \n"
-                : "=r"(rows0p), // %0
-                "=r"(rows1p), // %1
-                "=r"(Dp),     // %2
-                "=r"(nn)      // %3
-                : "0"(rows0p),
-                "1"(rows1p),
-                "2"(Dp),
-                "3"(nn),
-                "r"(b0), // %8
-                "r"(b1)  // %9
-                : "cc", "memory", "r4", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11", "q12");
-        }
+            if (nn > 0)
+            {
+                asm volatile(
+                    "vdup.s16   d16, %8         \n"
+                    "mov        r4, #2          \n"
+                    "vdup.s16   d17, %9         \n"
+                    "vdup.s32   q12, r4         \n"
+                    "pld        [%0, #128]      \n"
+                    "vld1.s16   {d2-d3}, [%0 :128]!\n"
+                    "pld        [%1, #128]      \n"
+                    "vld1.s16   {d6-d7}, [%1 :128]!\n"
+                    "0:                         \n"
+                    "vmull.s16  q0, d2, d16     \n"
+                    "vmull.s16  q1, d3, d16     \n"
+                    "vorr.s32   q10, q12, q12   \n"
+                    "vorr.s32   q11, q12, q12   \n"
+                    "vmull.s16  q2, d6, d17     \n"
+                    "vmull.s16  q3, d7, d17     \n"
+                    "vsra.s32   q10, q0, #16    \n"
+                    "vsra.s32   q11, q1, #16    \n"
+                    "pld        [%0, #128]      \n"
+                    "vld1.s16   {d2-d3}, [%0 :128]!\n"
+                    "vsra.s32   q10, q2, #16    \n"
+                    "vsra.s32   q11, q3, #16    \n"
+                    "pld        [%1, #128]      \n"
+                    "vld1.s16   {d6-d7}, [%1 :128]!\n"
+                    "vshrn.s32  d20, q10, #2    \n"
+                    "vshrn.s32  d21, q11, #2    \n"
+                    "vqmovun.s16 d20, q10        \n"
+                    "vst1.8     {d20}, [%2]!    \n"
+                    "subs       %3, #1          \n"
+                    "bne        0b              \n"
+                    "sub        %0, #16         \n"
+                    "sub        %1, #16         \n"
+                    : "=r"(rows0p), // %0
+                    "=r"(rows1p), // %1
+                    "=r"(Dp),     // %2
+                    "=r"(nn)      // %3
+                    : "0"(rows0p),
+                    "1"(rows1p),
+                    "2"(Dp),
+                    "3"(nn),
+                    "r"(b0), // %8
+                    "r"(b1)  // %9
+                    : "cc", "memory", "r4", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11", "q12");
+            }
 #endif // __aarch64__
 #endif // __ARM_NEON
-        for (; remain; --remain)
-        {
-            //             D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
-            *Dp++ = (unsigned char)(((short)((b0 * (short)(*rows0p++)) >> 16) + (short)((b1 * (short)(*rows1p++)) >> 16) + 2) >> 2);
-        }
+#if __SSE2__
+            __m128i _b0 = _mm_set1_epi16(b0);
+            __m128i _b1 = _mm_set1_epi16(b1);
+            __m128i _v2 = _mm_set1_epi16(2);
+            for (; nn > 0; nn--)
+            {
+                __m128i _rows0 = _mm_loadu_si128((const __m128i*)rows0p);
+                __m128i _rows1 = _mm_loadu_si128((const __m128i*)rows1p);
+
+                __m128i _acc = _mm_add_epi16(_mm_mulhi_epi16(_rows0, _b0), _mm_mulhi_epi16(_rows1, _b1));
+                _acc = _mm_srai_epi16(_mm_add_epi16(_acc, _v2), 2);
 
-        ibeta += 2;
+                _mm_storel_epi64((__m128i*)Dp, _mm_packus_epi16(_acc, _acc));
+
+                Dp += 8;
+                rows0p += 8;
+                rows1p += 8;
+            }
+#endif // __SSE2__
+            for (; remain; --remain)
+            {
+                //             D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
+                *Dp++ = (unsigned char)(((short)((b0 * (short)(*rows0p++)) >> 16) + (short)((b1 * (short)(*rows1p++)) >> 16) + 2) >> 2);
+            }
+        }
     }
 
     delete[] buf;
 }
 
 void resize_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    Option opt;
+    opt.num_threads = 1;
+    resize_bilinear_c2(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+}
+
+void resize_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
 {
     const int INTER_RESIZE_COEF_BITS = 11;
     const int INTER_RESIZE_COEF_SCALE = 1 << INTER_RESIZE_COEF_BITS;
@@ -377,237 +421,270 @@ void resize_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstr
 #undef SATURATE_CAST_SHORT
 
     // loop body
-    Mat rowsbuf0(w * 2 + 2, (size_t)2u);
-    Mat rowsbuf1(w * 2 + 2, (size_t)2u);
-    short* rows0 = (short*)rowsbuf0.data;
-    short* rows1 = (short*)rowsbuf1.data;
+    const int nn_band = std::max(std::min(opt.num_threads, h), 1);
 
-    int prev_sy1 = -2;
-
-    for (int dy = 0; dy < h; dy++)
+    #pragma omp parallel for num_threads(nn_band)
+    for (int band = 0; band < nn_band; band++)
     {
-        sy = yofs[dy];
+        const int dy0 = h * band / nn_band;
+        const int dy1 = h * (band + 1) / nn_band;
 
-        if (sy == prev_sy1)
-        {
-            // reuse all rows
-        }
-        else if (sy == prev_sy1 + 1)
+        Mat rowsbuf0(w * 2 + 2, (size_t)2u);
+        Mat rowsbuf1(w * 2 + 2, (size_t)2u);
+        short* rows0 = (short*)rowsbuf0.data;
+        short* rows1 = (short*)rowsbuf1.data;
+
+        int prev_sy1 = -2;
+
+        for (int dy = dy0; dy < dy1; dy++)
         {
-            // hresize one row
-            short* rows0_old = rows0;
-            rows0 = rows1;
-            rows1 = rows0_old;
-            const unsigned char* S1 = src + srcstride * (sy + 1);
+            int sy = yofs[dy];
 
-            const short* ialphap = ialpha;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
+            if (sy == prev_sy1)
             {
-                sx = xofs[dx];
-
-                const unsigned char* S1p = S1 + sx;
+                // reuse all rows
+            }
+            else if (sy == prev_sy1 + 1)
+            {
+                // hresize one row
+                short* rows0_old = rows0;
+                rows0 = rows1;
+                rows1 = rows0_old;
+                const unsigned char* S1 = src + srcstride * (sy + 1);
+
+                const short* ialphap = ialpha;
+                short* rows1p = rows1;
+                for (int dx = 0; dx < w; dx++)
+                {
+                    int sx = xofs[dx];
+
+                    const unsigned char* S1p = S1 + sx;
 #if __ARM_NEON
-                int16x4_t _a0a1XX = vld1_s16(ialphap);
-                int16x4_t _a0a0a1a1 = vzip_s16(_a0a1XX, _a0a1XX).val[0];
-                uint8x8_t _S1 = uint8x8_t();
-
-                _S1 = vld1_lane_u8(S1p, _S1, 0);
-                _S1 = vld1_lane_u8(S1p + 1, _S1, 1);
-                _S1 = vld1_lane_u8(S1p + 2, _S1, 2);
-                _S1 = vld1_lane_u8(S1p + 3, _S1, 3);
-
-                int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
-                int16x4_t _S1lowhigh = vget_low_s16(_S116);
-                int32x4_t _S1ma0a1 = vmull_s16(_S1lowhigh, _a0a0a1a1);
-                int32x2_t _rows1low = vadd_s32(vget_low_s32(_S1ma0a1), vget_high_s32(_S1ma0a1));
-                int32x4_t _rows1 = vcombine_s32(_rows1low, vget_high_s32(_S1ma0a1));
-                int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
-                vst1_s16(rows1p, _rows1_sr4);
+                    int16x4_t _a0a1XX = vld1_s16(ialphap);
+                    int16x4_t _a0a0a1a1 = vzip_s16(_a0a1XX, _a0a1XX).val[0];
+                    uint8x8_t _S1 = uint8x8_t();
+
+                    _S1 = vld1_lane_u8(S1p, _S1, 0);
+                    _S1 = vld1_lane_u8(S1p + 1, _S1, 1);
+                    _S1 = vld1_lane_u8(S1p + 2, _S1, 2);
+                    _S1 = vld1_lane_u8(S1p + 3, _S1, 3);
+
+                    int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
+                    int16x4_t _S1lowhigh = vget_low_s16(_S116);
+                    int32x4_t _S1ma0a1 = vmull_s16(_S1lowhigh, _a0a0a1a1);
+                    int32x2_t _rows1low = vadd_s32(vget_low_s32(_S1ma0a1), vget_high_s32(_S1ma0a1));
+                    int32x4_t _rows1 = vcombine_s32(_rows1low, vget_high_s32(_S1ma0a1));
+                    int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
+                    vst1_s16(rows1p, _rows1_sr4);
 #else
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
+                    short a0 = ialphap[0];
+                    short a1 = ialphap[1];
 
-                rows1p[0] = (S1p[0] * a0 + S1p[2] * a1) >> 4;
-                rows1p[1] = (S1p[1] * a0 + S1p[3] * a1) >> 4;
+                    rows1p[0] = (S1p[0] * a0 + S1p[2] * a1) >> 4;
+                    rows1p[1] = (S1p[1] * a0 + S1p[3] * a1) >> 4;
 #endif // __ARM_NEON
 
-                ialphap += 2;
-                rows1p += 2;
+                    ialphap += 2;
+                    rows1p += 2;
+                }
             }
-        }
-        else
-        {
-            // hresize two rows
-            const unsigned char* S0 = src + srcstride * (sy);
-            const unsigned char* S1 = src + srcstride * (sy + 1);
-
-            const short* ialphap = ialpha;
-            short* rows0p = rows0;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
+            else
             {
-                sx = xofs[dx];
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
-
-                const unsigned char* S0p = S0 + sx;
-                const unsigned char* S1p = S1 + sx;
+                // hresize two rows
+                const unsigned char* S0 = src + srcstride * (sy);
+                const unsigned char* S1 = src + srcstride * (sy + 1);
+
+                const short* ialphap = ialpha;
+                short* rows0p = rows0;
+                short* rows1p = rows1;
+                for (int dx = 0; dx < w; dx++)
+                {
+                    int sx = xofs[dx];
+                    short a0 = ialphap[0];
+                    short a1 = ialphap[1];
+
+                    const unsigned char* S0p = S0 + sx;
+                    const unsigned char* S1p = S1 + sx;
 #if __ARM_NEON
-                int16x4_t _a0 = vdup_n_s16(a0);
-                int16x4_t _a1 = vdup_n_s16(a1);
-                uint8x8_t _S0 = uint8x8_t();
-                uint8x8_t _S1 = uint8x8_t();
-
-                _S0 = vld1_lane_u8(S0p, _S0, 0);
-                _S0 = vld1_lane_u8(S0p + 1, _S0, 1);
-                _S0 = vld1_lane_u8(S0p + 2, _S0, 2);
-                _S0 = vld1_lane_u8(S0p + 3, _S0, 3);
-
-                _S1 = vld1_lane_u8(S1p, _S1, 0);
-                _S1 = vld1_lane_u8(S1p + 1, _S1, 1);
-                _S1 = vld1_lane_u8(S1p + 2, _S1, 2);
-                _S1 = vld1_lane_u8(S1p + 3, _S1, 3);
-
-                int16x8_t _S016 = vreinterpretq_s16_u16(vmovl_u8(_S0));
-                int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
-                int16x4_t _S0lowhigh = vget_low_s16(_S016);
-                int16x4_t _S1lowhigh = vget_low_s16(_S116);
-                int32x2x2_t _S0S1low_S0S1high = vtrn_s32(vreinterpret_s32_s16(_S0lowhigh), vreinterpret_s32_s16(_S1lowhigh));
-                int32x4_t _rows01 = vmull_s16(vreinterpret_s16_s32(_S0S1low_S0S1high.val[0]), _a0);
-                _rows01 = vmlal_s16(_rows01, vreinterpret_s16_s32(_S0S1low_S0S1high.val[1]), _a1);
-                int16x4_t _rows01_sr4 = vshrn_n_s32(_rows01, 4);
-                int16x4_t _rows1_sr4 = vext_s16(_rows01_sr4, _rows01_sr4, 2);
-                vst1_s16(rows0p, _rows01_sr4);
-                vst1_s16(rows1p, _rows1_sr4);
+                    int16x4_t _a0 = vdup_n_s16(a0);
+                    int16x4_t _a1 = vdup_n_s16(a1);
+                    uint8x8_t _S0 = uint8x8_t();
+                    uint8x8_t _S1 = uint8x8_t();
+
+                    _S0 = vld1_lane_u8(S0p, _S0, 0);
+                    _S0 = vld1_lane_u8(S0p + 1, _S0, 1);
+                    _S0 = vld1_lane_u8(S0p + 2, _S0, 2);
+                    _S0 = vld1_lane_u8(S0p + 3, _S0, 3);
+
+                    _S1 = vld1_lane_u8(S1p, _S1, 0);
+                    _S1 = vld1_lane_u8(S1p + 1, _S1, 1);
+                    _S1 = vld1_lane_u8(S1p + 2, _S1, 2);
+                    _S1 = vld1_lane_u8(S1p + 3, _S1, 3);
+
+                    int16x8_t _S016 = vreinterpretq_s16_u16(vmovl_u8(_S0));
+                    int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
+                    int16x4_t _S0lowhigh = vget_low_s16(_S016);
+                    int16x4_t _S1lowhigh = vget_low_s16(_S116);
+                    int32x2x2_t _S0S1low_S0S1high = vtrn_s32(vreinterpret_s32_s16(_S0lowhigh), vreinterpret_s32_s16(_S1lowhigh));
+                    int32x4_t _rows01 = vmull_s16(vreinterpret_s16_s32(_S0S1low_S0S1high.val[0]), _a0);
+                    _rows01 = vmlal_s16(_rows01, vreinterpret_s16_s32(_S0S1low_S0S1high.val[1]), _a1);
+                    int16x4_t _rows01_sr4 = vshrn_n_s32(_rows01, 4);
+                    int16x4_t _rows1_sr4 = vext_s16(_rows01_sr4, _rows01_sr4, 2);
+                    vst1_s16(rows0p, _rows01_sr4);
+                    vst1_s16(rows1p, _rows1_sr4);
 #else
-                rows0p[0] = (S0p[0] * a0 + S0p[2] * a1) >> 4;
-                rows0p[1] = (S0p[1] * a0 + S0p[3] * a1) >> 4;
-                rows1p[0] = (S1p[0] * a0 + S1p[2] * a1) >> 4;
-                rows1p[1] = (S1p[1] * a0 + S1p[3] * a1) >> 4;
+                    rows0p[0] = (S0p[0] * a0 + S0p[2] * a1) >> 4;
+                    rows0p[1] = (S0p[1] * a0 + S0p[3] * a1) >> 4;
+                    rows1p[0] = (S1p[0] * a0 + S1p[2] * a1) >> 4;
+                    rows1p[1] = (S1p[1] * a0 + S1p[3] * a1) >> 4;
 #endif // __ARM_NEON
 
-                ialphap += 2;
-                rows0p += 2;
-                rows1p += 2;
+                    ialphap += 2;
+                    rows0p += 2;
+                    rows1p += 2;
+                }
             }
-        }
 
-        prev_sy1 = sy;
+            prev_sy1 = sy;
 
-        // vresize
-        short b0 = ibeta[0];
-        short b1 = ibeta[1];
+            // vresize
+            short b0 = ibeta[dy * 2];
+            short b1 = ibeta[dy * 2 + 1];
 
-        short* rows0p = rows0;
-        short* rows1p = rows1;
-        unsigned char* Dp = dst + stride * (dy);
+            short* rows0p = rows0;
+            short* rows1p = rows1;
+            unsigned char* Dp = dst + stride * (dy);
 
-#if __ARM_NEON
-        int nn = (w * 2) >> 3;
+#if __ARM_NEON || __SSE2__
+            int nn = (w * 2) >> 3;
 #else
-        int nn = 0;
+            int nn = 0;
 #endif
-        int remain = (w * 2) - (nn << 3);
+            int remain = (w * 2) - (nn << 3);
 
 #if __ARM_NEON
 #if __aarch64__
-        int16x4_t _b0 = vdup_n_s16(b0);
-        int16x4_t _b1 = vdup_n_s16(b1);
-        int32x4_t _v2 = vdupq_n_s32(2);
-        for (; nn > 0; nn--)
-        {
-            int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
-            int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
-            int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
-            int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
+            int16x4_t _b0 = vdup_n_s16(b0);
+            int16x4_t _b1 = vdup_n_s16(b1);
+            int32x4_t _v2 = vdupq_n_s32(2);
+            for (; nn > 0; nn--)
+            {
+                int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
+                int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
+                int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
+                int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
 
-            int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
-            int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
-            int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
-            int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
+                int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
+                int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
+                int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
+                int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
 
-            int32x4_t _acc = _v2;
-            _acc = vsraq_n_s32(_acc, _rows0p_sr4_mb0, 16);
-            _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
+                int32x4_t _acc = _v2;
+                _acc = vsraq_n_s32(_acc, _rows0p_sr4_mb0, 16);
+                _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
 
-            int32x4_t _acc_1 = _v2;
-            _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
-            _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
+                int32x4_t _acc_1 = _v2;
+                _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
+                _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
 
-            int16x4_t _acc16 = vshrn_n_s32(_acc, 2);
-            int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
+                int16x4_t _acc16 = vshrn_n_s32(_acc, 2);
+                int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
 
-            uint8x8_t _D = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
+                uint8x8_t _D = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
 
-            vst1_u8(Dp, _D);
+                vst1_u8(Dp, _D);
 
-            Dp += 8;
-            rows0p += 8;
-            rows1p += 8;
-        }
+                Dp += 8;
+                rows0p += 8;
+                rows1p += 8;
+            }
 #else
-        if (nn > 0)
-        {
-            asm volatile(
-                "vdup.s16   d16, %8         \n"
-                "mov        r4, #2          \n"
-                "vdup.s16   d17, %9         \n"
-                "vdup.s32   q12, r4         \n"
-                "pld        [%0, #128]      \n"
-                "vld1.s16   {d2-d3}, [%0 :128]!\n"
-                "pld        [%1, #128]      \n"
-                "vld1.s16   {d6-d7}, [%1 :128]!\n"
-                "0:                         \n"
-                "vmull.s16  q0, d2, d16     \n"
-                "vmull.s16  q1, d3, d16     \n"
-                "vorr.s32   q10, q12, q12   \n"
-                "vorr.s32   q11, q12, q12   \n"
-                "vmull.s16  q2, d6, d17     \n"
-                "vmull.s16  q3, d7, d17     \n"
-                "vsra.s32   q10, q0, #16    \n"
-                "vsra.s32   q11, q1, #16    \n"
-                "pld        [%0, #128]      \n"
-                "vld1.s16   {d2-d3}, [%0 :128]!\n"
-                "vsra.s32   q10, q2, #16    \n"
-                "vsra.s32   q11, q3, #16    \n"
-                "pld        [%1, #128]      \n"
-                "vld1.s16   {d6-d7}, [%1 :128]!\n"
-                "vshrn.s32  d20, q10, #2    \n"
-                "vshrn.s32  d21, q11, #2    \n"
-                "vqmovun.s16 d20, q10        \n"
-                "vst1.8     {d20}, [%2]!    \n"
-                "subs       %3, #1          \n"
-                "bne        0b              \n"
-                "sub        %0, #16         \n"
-                "sub        %1, #16         \n"
-                : "=r"(rows0p), // %0
-                "=r"(rows1p), // %1
-                "=r"(Dp),     // %2
-                "=r"(nn)      // %3
-                : "0"(rows0p),
-                "1"(rows1p),
-                "2"(Dp),
-                "3"(nn),
-                "r"(b0), // %8
-                "r"(b1)  // %9
-                : "cc", "memory", "r4", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11", "q12");
-        }
+            if (nn > 0)
+            {
+                asm volatile(
+                    "vdup.s16   d16, %8         \n"
+                    "mov        r4, #2          \n"
+                    "vdup.s16   d17, %9         \n"
+                    "vdup.s32   q12, r4         \n"
+                    "pld        [%0, #128]      \n"
+                    "vld1.s16   {d2-d3}, [%0 :128]!\n"
+                    "pld        [%1, #128]      \n"
+                    "vld1.s16   {d6-d7}, [%1 :128]!\n"
+                    "0:                         \n"
+                    "vmull.s16  q0, d2, d16     \n"
+                    "vmull.s16  q1, d3, d16     \n"
+                    "vorr.s32   q10, q12, q12   \n"
+                    "vorr.s32   q11, q12, q12   \n"
+                    "vmull.s16  q2, d6, d17     \n"
+                    "vmull.s16  q3, d7, d17     \n"
+                    "vsra.s32   q10, q0, #16    \n"
+                    "vsra.s32   q11, q1, #16    \n"
+                    "pld        [%0, #128]      \n"
+                    "vld1.s16   {d2-d3}, [%0 :128]!\n"
+                    "vsra.s32   q10, q2, #16    \n"
+                    "vsra.s32   q11, q3, #16    \n"
+                    "pld        [%1, #128]      \n"
+                    "vld1.s16   {d6-d7}, [%1 :128]!\n"
+                    "vshrn.s32  d20, q10, #2    \n"
+                    "vshrn.s32  d21, q11, #2    \n"
+                    "vqmovun.s16 d20, q10        \n"
+                    "vst1.8     {d20}, [%2]!    \n"
+                    "subs       %3, #1          \n"
+                    "bne        0b              \n"
+                    "sub        %0, #16         \n"
+                    "sub        %1, #16         \n"
+                    : "=r"(rows0p), // %0
+                    "=r"(rows1p), // %1
+                    "=r"(Dp),     // %2
+                    "=r"(nn)      // %3
+                    : "0"(rows0p),
+                    "1"(rows1p),
+                    "2"(Dp),
+                    "3"(nn),
+                    "r"(b0), // %8
+                    "r"(b1)  // %9
+                    : "cc", "memory", "r4", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11", "q12");
+            }
 #endif // __aarch64__
 #endif // __ARM_NEON
-        for (; remain; --remain)
-        {
-            //             D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
-            *Dp++ = (unsigned char)(((short)((b0 * (short)(*rows0p++)) >> 16) + (short)((b1 * (short)(*rows1p++)) >> 16) + 2) >> 2);
-        }
+#if __SSE2__
+            __m128i _b0 = _mm_set1_epi16(b0);
+            __m128i _b1 = _mm_set1_epi16(b1);
+            __m128i _v2 = _mm_set1_epi16(2);
+            for (; nn > 0; nn--)
+            {
+                __m128i _rows0 = _mm_loadu_si128((const __m128i*)rows0p);
+                __m128i _rows1 = _mm_loadu_si128((const __m128i*)rows1p);
+
+                __m128i _acc = _mm_add_epi16(_mm_mulhi_epi16(_rows0, _b0), _mm_mulhi_epi16(_rows1, _b1));
+                _acc = _mm_srai_epi16(_mm_add_epi16(_acc, _v2), 2);
+
+                _mm_storel_epi64((__m128i*)Dp, _mm_packus_epi16(_acc, _acc));
 
-        ibeta += 2;
+                Dp += 8;
+                rows0p += 8;
+                rows1p += 8;
+            }
+#endif // __SSE2__
+            for (; remain; --remain)
+            {
+                //             D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
+                *Dp++ = (unsigned char)(((short)((b0 * (short)(*rows0p++)) >> 16) + (short)((b1 * (short)(*rows1p++)) >> 16) + 2) >> 2);
+            }
+        }
     }
 
     delete[] buf;
 }
 
 void resize_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    Option opt;
+    opt.num_threads = 1;
+    resize_bilinear_c3(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+}
+
+void resize_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
 {
     const int INTER_RESIZE_COEF_BITS = 11;
     const int INTER_RESIZE_COEF_SCALE = 1 << INTER_RESIZE_COEF_BITS;
@@ -686,248 +763,292 @@ void resize_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstr
 #undef SATURATE_CAST_SHORT
 
     // loop body
-    Mat rowsbuf0(w * 3 + 1, (size_t)2u);
-    Mat rowsbuf1(w * 3 + 1, (size_t)2u);
-    short* rows0 = (short*)rowsbuf0.data;
-    short* rows1 = (short*)rowsbuf1.data;
-
-    int prev_sy1 = -2;
+    const int nn_band = std::max(std::min(opt.num_threads, h), 1);
 
-    for (int dy = 0; dy < h; dy++)
+    #pragma omp parallel for num_threads(nn_band)
+    for (int band = 0; band < nn_band; band++)
     {
-        sy = yofs[dy];
+        const int dy0 = h * band / nn_band;
+        const int dy1 = h * (band + 1) / nn_band;
 
-        if (sy == prev_sy1)
-        {
-            // reuse all rows
-        }
-        else if (sy == prev_sy1 + 1)
+        Mat rowsbuf0(w * 3 + 1, (size_t)2u);
+        Mat rowsbuf1(w * 3 + 1, (size_t)2u);
+        short* rows0 = (short*)rowsbuf0.data;
+        short* rows1 = (short*)rowsbuf1.data;
+
+        int prev_sy1 = -2;
+
+        for (int dy = dy0; dy < dy1; dy++)
         {
-            // hresize one row
-            short* rows0_old = rows0;
-            rows0 = rows1;
-            rows1 = rows0_old;
-            const unsigned char* S1 = src + srcstride * (sy + 1);
+            int sy = yofs[dy];
 
-            const short* ialphap = ialpha;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
+            if (sy == prev_sy1)
             {
-                sx = xofs[dx];
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
-
-                const unsigned char* S1p = S1 + sx;
+                // reuse all rows
+            }
+            else if (sy == prev_sy1 + 1)
+            {
+                // hresize one row
+                short* rows0_old = rows0;
+                rows0 = rows1;
+                rows1 = rows0_old;
+                const unsigned char* S1 = src + srcstride * (sy + 1);
+
+                const short* ialphap = ialpha;
+                short* rows1p = rows1;
+                for (int dx = 0; dx < w; dx++)
+                {
+                    int sx = xofs[dx];
+                    short a0 = ialphap[0];
+                    short a1 = ialphap[1];
+
+                    const unsigned char* S1p = S1 + sx;
 #if __ARM_NEON
-                int16x4_t _a0 = vdup_n_s16(a0);
-                int16x4_t _a1 = vdup_n_s16(a1);
-                uint8x8_t _S1 = uint8x8_t();
-
-                _S1 = vld1_lane_u8(S1p, _S1, 0);
-                _S1 = vld1_lane_u8(S1p + 1, _S1, 1);
-                _S1 = vld1_lane_u8(S1p + 2, _S1, 2);
-                _S1 = vld1_lane_u8(S1p + 3, _S1, 3);
-                _S1 = vld1_lane_u8(S1p + 4, _S1, 4);
-                _S1 = vld1_lane_u8(S1p + 5, _S1, 5);
-
-                int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
-                int16x4_t _S1low = vget_low_s16(_S116);
-                int16x4_t _S1high = vext_s16(_S1low, vget_high_s16(_S116), 3);
-                int32x4_t _rows1 = vmull_s16(_S1low, _a0);
-                _rows1 = vmlal_s16(_rows1, _S1high, _a1);
-                int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
-                vst1_s16(rows1p, _rows1_sr4);
+                    int16x4_t _a0 = vdup_n_s16(a0);
+                    int16x4_t _a1 = vdup_n_s16(a1);
+                    uint8x8_t _S1 = uint8x8_t();
+
+                    _S1 = vld1_lane_u8(S1p, _S1, 0);
+                    _S1 = vld1_lane_u8(S1p + 1, _S1, 1);
+                    _S1 = vld1_lane_u8(S1p + 2, _S1, 2);
+                    _S1 = vld1_lane_u8(S1p + 3, _S1, 3);
+                    _S1 = vld1_lane_u8(S1p + 4, _S1, 4);
+                    _S1 = vld1_lane_u8(S1p + 5, _S1, 5);
+
+                    int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
+                    int16x4_t _S1low = vget_low_s16(_S116);
+                    int16x4_t _S1high = vext_s16(_S1low, vget_high_s16(_S116), 3);
+                    int32x4_t _rows1 = vmull_s16(_S1low, _a0);
+                    _rows1 = vmlal_s16(_rows1, _S1high, _a1);
+                    int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
+                    vst1_s16(rows1p, _rows1_sr4);
 #else
-                rows1p[0] = (S1p[0] * a0 + S1p[3] * a1) >> 4;
-                rows1p[1] = (S1p[1] * a0 + S1p[4] * a1) >> 4;
-                rows1p[2] = (S1p[2] * a0 + S1p[5] * a1) >> 4;
+                    rows1p[0] = (S1p[0] * a0 + S1p[3] * a1) >> 4;
+                    rows1p[1] = (S1p[1] * a0 + S1p[4] * a1) >> 4;
+                    rows1p[2] = (S1p[2] * a0 + S1p[5] * a1) >> 4;
 #endif // __ARM_NEON
 
-                ialphap += 2;
-                rows1p += 3;
+                    ialphap += 2;
+                    rows1p += 3;
+                }
             }
-        }
-        else
-        {
-            // hresize two rows
-            const unsigned char* S0 = src + srcstride * (sy);
-            const unsigned char* S1 = src + srcstride * (sy + 1);
-
-            const short* ialphap = ialpha;
-            short* rows0p = rows0;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
+            else
             {
-                sx = xofs[dx];
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
-
-                const unsigned char* S0p = S0 + sx;
-                const unsigned char* S1p = S1 + sx;
+                // hresize two rows
+                const unsigned char* S0 = src + srcstride * (sy);
+                const unsigned char* S1 = src + srcstride * (sy + 1);
+
+                const short* ialphap = ialpha;
+                short* rows0p = rows0;
+                short* rows1p = rows1;
+                for (int dx = 0; dx < w; dx++)
+                {
+                    int sx = xofs[dx];
+                    short a0 = ialphap[0];
+                    short a1 = ialphap[1];
+
+                    const unsigned char* S0p = S0 + sx;
+                    const unsigned char* S1p = S1 + sx;
 #if __ARM_NEON
-                int16x4_t _a0 = vdup_n_s16(a0);
-                int16x4_t _a1 = vdup_n_s16(a1);
-                uint8x8_t _S0 = uint8x8_t();
-                uint8x8_t _S1 = uint8x8_t();
-
-                _S0 = vld1_lane_u8(S0p, _S0, 0);
-                _S0 = vld1_lane_u8(S0p + 1, _S0, 1);
-                _S0 = vld1_lane_u8(S0p + 2, _S0, 2);
-                _S0 = vld1_lane_u8(S0p + 3, _S0, 3);
-                _S0 = vld1_lane_u8(S0p + 4, _S0, 4);
-                _S0 = vld1_lane_u8(S0p + 5, _S0, 5);
-
-                _S1 = vld1_lane_u8(S1p, _S1, 0);
-                _S1 = vld1_lane_u8(S1p + 1, _S1, 1);
-                _S1 = vld1_lane_u8(S1p + 2, _S1, 2);
-                _S1 = vld1_lane_u8(S1p + 3, _S1, 3);
-                _S1 = vld1_lane_u8(S1p + 4, _S1, 4);
-                _S1 = vld1_lane_u8(S1p + 5, _S1, 5);
-
-                int16x8_t _S016 = vreinterpretq_s16_u16(vmovl_u8(_S0));
-                int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
-                int16x4_t _S0low = vget_low_s16(_S016);
-                int16x4_t _S1low = vget_low_s16(_S116);
-                int16x4_t _S0high = vext_s16(_S0low, vget_high_s16(_S016), 3);
-                int16x4_t _S1high = vext_s16(_S1low, vget_high_s16(_S116), 3);
-                int32x4_t _rows0 = vmull_s16(_S0low, _a0);
-                int32x4_t _rows1 = vmull_s16(_S1low, _a0);
-                _rows0 = vmlal_s16(_rows0, _S0high, _a1);
-                _rows1 = vmlal_s16(_rows1, _S1high, _a1);
-                int16x4_t _rows0_sr4 = vshrn_n_s32(_rows0, 4);
-                int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
-                vst1_s16(rows0p, _rows0_sr4);
-                vst1_s16(rows1p, _rows1_sr4);
+                    int16x4_t _a0 = vdup_n_s16(a0);
+                    int16x4_t _a1 = vdup_n_s16(a1);
+                    uint8x8_t _S0 = uint8x8_t();
+                    uint8x8_t _S1 = uint8x8_t();
+
+                    _S0 = vld1_lane_u8(S0p, _S0, 0);
+                    _S0 = vld1_lane_u8(S0p + 1, _S0, 1);
+                    _S0 = vld1_lane_u8(S0p + 2, _S0, 2);
+                    _S0 = vld1_lane_u8(S0p + 3, _S0, 3);
+                    _S0 = vld1_lane_u8(S0p + 4, _S0, 4);
+                    _S0 = vld1_lane_u8(S0p + 5, _S0, 5);
+
+                    _S1 = vld1_lane_u8(S1p, _S1, 0);
+                    _S1 = vld1_lane_u8(S1p + 1, _S1, 1);
+                    _S1 = vld1_lane_u8(S1p + 2, _S1, 2);
+                    _S1 = vld1_lane_u8(S1p + 3, _S1, 3);
+                    _S1 = vld1_lane_u8(S1p + 4, _S1, 4);
+                    _S1 = vld1_lane_u8(S1p + 5, _S1, 5);
+
+                    int16x8_t _S016 = vreinterpretq_s16_u16(vmovl_u8(_S0));
+                    int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
+                    int16x4_t _S0low = vget_low_s16(_S016);
+                    int16x4_t _S1low = vget_low_s16(_S116);
+                    int16x4_t _S0high = vext_s16(_S0low, vget_high_s16(_S016), 3);
+                    int16x4_t _S1high = vext_s16(_S1low, vget_high_s16(_S116), 3);
+                    int32x4_t _rows0 = vmull_s16(_S0low, _a0);
+                    int32x4_t _rows1 = vmull_s16(_S1low, _a0);
+                    _rows0 = vmlal_s16(_rows0, _S0high, _a1);
+                    _rows1 = vmlal_s16(_rows1, _S1high, _a1);
+                    int16x4_t _rows0_sr4 = vshrn_n_s32(_rows0, 4);
+                    int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
+                    vst1_s16(rows0p, _rows0_sr4);
+                    vst1_s16(rows1p, _rows1_sr4);
 #else
-                rows0p[0] = (S0p[0] * a0 + S0p[3] * a1) >> 4;
-                rows0p[1] = (S0p[1] * a0 + S0p[4] * a1) >> 4;
-                rows0p[2] = (S0p[2] * a0 + S0p[5] * a1) >> 4;
-                rows1p[0] = (S1p[0] * a0 + S1p[3] * a1) >> 4;
-                rows1p[1] = (S1p[1] * a0 + S1p[4] * a1) >> 4;
-                rows1p[2] = (S1p[2] * a0 + S1p[5] * a1) >> 4;
+                    rows0p[0] = (S0p[0] * a0 + S0p[3] * a1) >> 4;
+                    rows0p[1] = (S0p[1] * a0 + S0p[4] * a1) >> 4;
+                    rows0p[2] = (S0p[2] * a0 + S0p[5] * a1) >> 4;
+                    rows1p[0] = (S1p[0] * a0 + S1p[3] * a1) >> 4;
+                    rows1p[1] = (S1p[1] * a0 + S1p[4] * a1) >> 4;
+                    rows1p[2] = (S1p[2] * a0 + S1p[5] * a1) >> 4;
 #endif // __ARM_NEON
 
-                ialphap += 2;
-                rows0p += 3;
-                rows1p += 3;
+                    ialphap += 2;
+                    rows0p += 3;
+                    rows1p += 3;
+                }
             }
-        }
 
-        prev_sy1 = sy;
+            prev_sy1 = sy;
 
-        // vresize
-        short b0 = ibeta[0];
-        short b1 = ibeta[1];
+            // vresize
+            short b0 = ibeta[dy * 2];
+            short b1 = ibeta[dy * 2 + 1];
 
-        short* rows0p = rows0;
-        short* rows1p = rows1;
-        unsigned char* Dp = dst + stride * (dy);
+            short* rows0p = rows0;
+            short* rows1p = rows1;
+            unsigned char* Dp = dst + stride * (dy);
 
-#if __ARM_NEON
-        int nn = (w * 3) >> 3;
+#if __ARM_NEON || __SSE2__
+            int nn = (w * 3) >> 3;
 #else
-        int nn = 0;
+            int nn = 0;
 #endif
-        int remain = (w * 3) - (nn << 3);
+            int remain = (w * 3) - (nn << 3);
 
 #if __ARM_NEON
 #if __aarch64__
-        int16x4_t _b0 = vdup_n_s16(b0);
-        int16x4_t _b1 = vdup_n_s16(b1);
-        int32x4_t _v2 = vdupq_n_s32(2);
-        for (; nn > 0; nn--)
-        {
-            int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
-            int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
-            int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
-            int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
+            int16x4_t _b0 = vdup_n_s16(b0);
+            int16x4_t _b1 = vdup_n_s16(b1);
+            int32x4_t _v2 = vdupq_n_s32(2);
+            for (; nn > 0; nn--)
+            {
+                int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
+                int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
+                int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
+                int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
 
-            int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
-            int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
-            int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
-            int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
+                int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
+                int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
+                int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
+                int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
 
-            int32x4_t _acc = _v2;
-            _acc = vsraq_n_s32(_acc, _rows0p_sr4_mb0, 16);
-            _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
+                int32x4_t _acc = _v2;
+                _acc = vsraq_n_s32(_acc, _rows0p_sr4_mb0, 16);
+                _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
 
-            int32x4_t _acc_1 = _v2;
-            _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
-            _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
+                int32x4_t _acc_1 = _v2;
+                _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
+                _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
 
-            int16x4_t _acc16 = vshrn_n_s32(_acc, 2);
-            int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
+                int16x4_t _acc16 = vshrn_n_s32(_acc, 2);
+                int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
 
-            uint8x8_t _D = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
+                uint8x8_t _D = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
 
-            vst1_u8(Dp, _D);
+                vst1_u8(Dp, _D);
 
-            Dp += 8;
-            rows0p += 8;
-            rows1p += 8;
-        }
+                Dp += 8;
+                rows0p += 8;
+                rows1p += 8;
+            }
 #else
-        if (nn > 0)
-        {
-            asm volatile(
-                "vdup.s16   d16, %8         \n"
-                "mov        r4, #2          \n"
-                "vdup.s16   d17, %9         \n"
-                "vdup.s32   q12, r4         \n"
-                "pld        [%0, #128]      \n"
-                "vld1.s16   {d2-d3}, [%0 :128]!\n"
-                "pld        [%1, #128]      \n"
-                "vld1.s16   {d6-d7}, [%1 :128]!\n"
-                "0:                         \n"
-                "vmull.s16  q0, d2, d16     \n"
-                "vmull.s16  q1, d3, d16     \n"
-                "vorr.s32   q10, q12, q12   \n"
-                "vorr.s32   q11, q12, q12   \n"
-                "vmull.s16  q2, d6, d17     \n"
-                "vmull.s16  q3, d7, d17     \n"
-                "vsra.s32   q10, q0, #16    \n"
-                "vsra.s32   q11, q1, #16    \n"
-                "pld        [%0, #128]      \n"
-                "vld1.s16   {d2-d3}, [%0 :128]!\n"
-                "vsra.s32   q10, q2, #16    \n"
-                "vsra.s32   q11, q3, #16    \n"
-                "pld        [%1, #128]      \n"
-                "vld1.s16   {d6-d7}, [%1 :128]!\n"
-                "vshrn.s32  d20, q10, #2    \n"
-                "vshrn.s32  d21, q11, #2    \n"
-                "vqmovun.s16 d20, q10        \n"
-                "vst1.8     {d20}, [%2]!    \n"
-                "subs       %3, #1          \n"
-                "bne        0b              \n"
-                "sub        %0, #16         \n"
-                "sub        %1, #16         \n"
-                : "=r"(rows0p), // %0
-                "=r"(rows1p), // %1
-                "=r"(Dp),     // %2
-                "=r"(nn)      // %3
-                : "0"(rows0p),
-                "1"(rows1p),
-                "2"(Dp),
-                "3"(nn),
-                "r"(b0), // %8
-                "r"(b1)  // %9
-                : "cc", "memory", "r4", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11", "q12");
-        }
+            if (nn > 0)
+            {
+                asm volatile(
+                    "vdup.s16   d16, %8         \n"
+                    "mov        r4, #2          \n"
+                    "vdup.s16   d17, %9         \n"
+                    "vdup.s32   q12, r4         \n"
+                    "pld        [%0, #128]      \n"
+                    "vld1.s16   {d2-d3}, [%0 :128]!\n"
+                    "pld        [%1, #128]      \n"
+                    "vld1.s16   {d6-d7}, [%1 :128]!\n"
+                    "0:                         \n"
+                    "vmull.s16  q0, d2, d16     \n"
+                    "vmull.s16  q1, d3, d16     \n"
+                    "vorr.s32   q10, q12, q12   \n"
+                    "vorr.s32   q11, q12, q12   \n"
+                    "vmull.s16  q2, d6, d17     \n"
+                    "vmull.s16  q3, d7, d17     \n"
+                    "vsra.s32   q10, q0, #16    \n"
+                    "vsra.s32   q11, q1, #16    \n"
+                    "pld        [%0, #128]      \n"
+                    "vld1.s16   {d2-d3}, [%0 :128]!\n"
+                    "vsra.s32   q10, q2, #16    \n"
+                    "vsra.s32   q11, q3, #16    \n"
+                    "pld        [%1, #128]      \n"
+                    "vld1.s16   {d6-d7}, [%1 :128]!\n"
+                    "vshrn.s32  d20, q10, #2    \n"
+                    "vshrn.s32  d21, q11, #2    \n"
+                    "vqmovun.s16 d20, q10        \n"
+                    "vst1.8     {d20}, [%2]!    \n"
+                    "subs       %3, #1          \n"
+                    "bne        0b              \n"
+                    "sub        %0, #16         \n"
+                    "sub        %1, #16         \n"
+                    : "=r"(rows0p), // %0
+                    "=r"(rows1p), // %1
+                    "=r"(Dp),     // %2
+                    "=r"(nn)      // %3
+                    : "0"(rows0p),
+                    "1"(rows1p),
+                    "2"(Dp),
+                    "3"(nn),
+                    "r"(b0), // %8
+                    "r"(b1)  // %9
+                    : "cc", "memory", "r4", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11", "q12");
+            }
 #endif // __aarch64__
 #endif // __ARM_NEON
-        for (; remain; --remain)
-        {
-            //             D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
-            *Dp++ = (unsigned char)(((short)((b0 * (short)(*rows0p++)) >> 16) + (short)((b1 * (short)(*rows1p++)) >> 16) + 2) >> 2);
-        }
+#if __SSE2__
+            __m128i _b0 = _mm_set1_epi16(b0);
+            __m128i _b1 = _mm_set1_epi16(b1);
+            __m128i _v2 = _mm_set1_epi16(2);
+            for (; nn > 0; nn--)
+            {
+                __m128i _rows0 = _mm_loadu_si128((const __m128i*)rows0p);
+                __m128i _rows1 = _mm_loadu_si128((const __m128i*)rows1p);
+
+                __m128i _acc = _mm_add_epi16(_mm_mulhi_epi16(_rows0, _b0), _mm_mulhi_epi16(_rows1, _b1));
+                _acc = _mm_srai_epi16(_mm_add_epi16(_acc, _v2), 2);
+
+                _mm_storel_epi64((__m128i*)Dp, _mm_packus_epi16(_acc, _acc));
 
-        ibeta += 2;
+                Dp += 8;
+                rows0p += 8;
+                rows1p += 8;
+            }
+#endif // __SSE2__
+            for (; remain; --remain)
+            {
+                //             D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
+                *Dp++ = (unsigned char)(((short)((b0 * (short)(*rows0p++)) >> 16) + (short)((b1 * (short)(*rows1p++)) >> 16) + 2) >> 2);
+            }
+        }
     }
 
     delete[] buf;
 }
 
 void resize_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    Option opt;
+    opt.num_threads = 1;
+    resize_bilinear_c4(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+}
+
+#if __SSE2__
+// interpolate the two neighbouring rgba pixels at p with the a0 a1 pair packed in each 32bit lane
+static inline __m128i hresize_c4_sse2(const unsigned char* p, __m128i _a01)
+{
+    __m128i _p = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)p), _mm_setzero_si128());
+    _p = _mm_unpacklo_epi16(_p, _mm_srli_si128(_p, 8));
+    __m128i _rows = _mm_srai_epi32(_mm_madd_epi16(_p, _a01), 4);
+    return _mm_packs_epi32(_rows, _rows);
+}
+#endif // __SSE2__
+
+void resize_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
 {
     const int INTER_RESIZE_COEF_BITS = 11;
     const int INTER_RESIZE_COEF_SCALE = 1 << INTER_RESIZE_COEF_BITS;
@@ -1006,222 +1127,255 @@ void resize_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstr
 #undef SATURATE_CAST_SHORT
 
     // loop body
-    Mat rowsbuf0(w * 4, (size_t)2u);
-    Mat rowsbuf1(w * 4, (size_t)2u);
-    short* rows0 = (short*)rowsbuf0.data;
-    short* rows1 = (short*)rowsbuf1.data;
-
-    int prev_sy1 = -2;
+    const int nn_band = std::max(std::min(opt.num_threads, h), 1);
 
-    for (int dy = 0; dy < h; dy++)
+    #pragma omp parallel for num_threads(nn_band)
+    for (int band = 0; band < nn_band; band++)
     {
-        sy = yofs[dy];
+        const int dy0 = h * band / nn_band;
+        const int dy1 = h * (band + 1) / nn_band;
 
-        if (sy == prev_sy1)
-        {
-            // reuse all rows
-        }
-        else if (sy == prev_sy1 + 1)
+        Mat rowsbuf0(w * 4, (size_t)2u);
+        Mat rowsbuf1(w * 4, (size_t)2u);
+        short* rows0 = (short*)rowsbuf0.data;
+        short* rows1 = (short*)rowsbuf1.data;
+
+        int prev_sy1 = -2;
+
+        for (int dy = dy0; dy < dy1; dy++)
         {
-            // hresize one row
-            short* rows0_old = rows0;
-            rows0 = rows1;
-            rows1 = rows0_old;
-            const unsigned char* S1 = src + srcstride * (sy + 1);
+            int sy = yofs[dy];
 
-            const short* ialphap = ialpha;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
+            if (sy == prev_sy1)
             {
-                sx = xofs[dx];
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
-
-                const unsigned char* S1p = S1 + sx;
+                // reuse all rows
+            }
+            else if (sy == prev_sy1 + 1)
+            {
+                // hresize one row
+                short* rows0_old = rows0;
+                rows0 = rows1;
+                rows1 = rows0_old;
+                const unsigned char* S1 = src + srcstride * (sy + 1);
+
+                const short* ialphap = ialpha;
+                short* rows1p = rows1;
+                for (int dx = 0; dx < w; dx++)
+                {
+                    int sx = xofs[dx];
+                    short a0 = ialphap[0];
+                    short a1 = ialphap[1];
+
+                    const unsigned char* S1p = S1 + sx;
 #if __ARM_NEON
-                int16x4_t _a0 = vdup_n_s16(a0);
-                int16x4_t _a1 = vdup_n_s16(a1);
-                uint8x8_t _S1 = vld1_u8(S1p);
-                int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
-                int16x4_t _S1low = vget_low_s16(_S116);
-                int16x4_t _S1high = vget_high_s16(_S116);
-                int32x4_t _rows1 = vmull_s16(_S1low, _a0);
-                _rows1 = vmlal_s16(_rows1, _S1high, _a1);
-                int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
-                vst1_s16(rows1p, _rows1_sr4);
+                    int16x4_t _a0 = vdup_n_s16(a0);
+                    int16x4_t _a1 = vdup_n_s16(a1);
+                    uint8x8_t _S1 = vld1_u8(S1p);
+                    int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
+                    int16x4_t _S1low = vget_low_s16(_S116);
+                    int16x4_t _S1high = vget_high_s16(_S116);
+                    int32x4_t _rows1 = vmull_s16(_S1low, _a0);
+                    _rows1 = vmlal_s16(_rows1, _S1high, _a1);
+                    int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
+                    vst1_s16(rows1p, _rows1_sr4);
+#elif __SSE2__
+                    __m128i _a01 = _mm_set1_epi32((a1 << 16) | (unsigned short)a0);
+                    _mm_storel_epi64((__m128i*)rows1p, hresize_c4_sse2(S1p, _a01));
 #else
-                rows1p[0] = (S1p[0] * a0 + S1p[4] * a1) >> 4;
-                rows1p[1] = (S1p[1] * a0 + S1p[5] * a1) >> 4;
-                rows1p[2] = (S1p[2] * a0 + S1p[6] * a1) >> 4;
-                rows1p[3] = (S1p[3] * a0 + S1p[7] * a1) >> 4;
+                    rows1p[0] = (S1p[0] * a0 + S1p[4] * a1) >> 4;
+                    rows1p[1] = (S1p[1] * a0 + S1p[5] * a1) >> 4;
+                    rows1p[2] = (S1p[2] * a0 + S1p[6] * a1) >> 4;
+                    rows1p[3] = (S1p[3] * a0 + S1p[7] * a1) >> 4;
 #endif // __ARM_NEON
 
-                ialphap += 2;
-                rows1p += 4;
+                    ialphap += 2;
+                    rows1p += 4;
+                }
             }
-        }
-        else
-        {
-            // hresize two rows
-            const unsigned char* S0 = src + srcstride * (sy);
-            const unsigned char* S1 = src + srcstride * (sy + 1);
-
-            const short* ialphap = ialpha;
-            short* rows0p = rows0;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
+            else
             {
-                sx = xofs[dx];
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
-
-                const unsigned char* S0p = S0 + sx;
-                const unsigned char* S1p = S1 + sx;
+                // hresize two rows
+                const unsigned char* S0 = src + srcstride * (sy);
+                const unsigned char* S1 = src + srcstride * (sy + 1);
+
+                const short* ialphap = ialpha;
+                short* rows0p = rows0;
+                short* rows1p = rows1;
+                for (int dx = 0; dx < w; dx++)
+                {
+                    int sx = xofs[dx];
+                    short a0 = ialphap[0];
+                    short a1 = ialphap[1];
+
+                    const unsigned char* S0p = S0 + sx;
+                    const unsigned char* S1p = S1 + sx;
 #if __ARM_NEON
-                int16x4_t _a0 = vdup_n_s16(a0);
-                int16x4_t _a1 = vdup_n_s16(a1);
-                uint8x8_t _S0 = vld1_u8(S0p);
-                uint8x8_t _S1 = vld1_u8(S1p);
-                int16x8_t _S016 = vreinterpretq_s16_u16(vmovl_u8(_S0));
-                int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
-                int16x4_t _S0low = vget_low_s16(_S016);
-                int16x4_t _S1low = vget_low_s16(_S116);
-                int16x4_t _S0high = vget_high_s16(_S016);
-                int16x4_t _S1high = vget_high_s16(_S116);
-                int32x4_t _rows0 = vmull_s16(_S0low, _a0);
-                int32x4_t _rows1 = vmull_s16(_S1low, _a0);
-                _rows0 = vmlal_s16(_rows0, _S0high, _a1);
-                _rows1 = vmlal_s16(_rows1, _S1high, _a1);
-                int16x4_t _rows0_sr4 = vshrn_n_s32(_rows0, 4);
-                int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
-                vst1_s16(rows0p, _rows0_sr4);
-                vst1_s16(rows1p, _rows1_sr4);
+                    int16x4_t _a0 = vdup_n_s16(a0);
+                    int16x4_t _a1 = vdup_n_s16(a1);
+                    uint8x8_t _S0 = vld1_u8(S0p);
+                    uint8x8_t _S1 = vld1_u8(S1p);
+                    int16x8_t _S016 = vreinterpretq_s16_u16(vmovl_u8(_S0));
+                    int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
+                    int16x4_t _S0low = vget_low_s16(_S016);
+                    int16x4_t _S1low = vget_low_s16(_S116);
+                    int16x4_t _S0high = vget_high_s16(_S016);
+                    int16x4_t _S1high = vget_high_s16(_S116);
+                    int32x4_t _rows0 = vmull_s16(_S0low, _a0);
+                    int32x4_t _rows1 = vmull_s16(_S1low, _a0);
+                    _rows0 = vmlal_s16(_rows0, _S0high, _a1);
+                    _rows1 = vmlal_s16(_rows1, _S1high, _a1);
+                    int16x4_t _rows0_sr4 = vshrn_n_s32(_rows0, 4);
+                    int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
+                    vst1_s16(rows0p, _rows0_sr4);
+                    vst1_s16(rows1p, _rows1_sr4);
+#elif __SSE2__
+                    __m128i _a01 = _mm_set1_epi32((a1 << 16) | (unsigned short)a0);
+                    _mm_storel_epi64((__m128i*)rows0p, hresize_c4_sse2(S0p, _a01));
+                    _mm_storel_epi64((__m128i*)rows1p, hresize_c4_sse2(S1p, _a01));
 #else
-                rows0p[0] = (S0p[0] * a0 + S0p[4] * a1) >> 4;
-                rows0p[1] = (S0p[1] * a0 + S0p[5] * a1) >> 4;
-                rows0p[2] = (S0p[2] * a0 + S0p[6] * a1) >> 4;
-                rows0p[3] = (S0p[3] * a0 + S0p[7] * a1) >> 4;
-                rows1p[0] = (S1p[0] * a0 + S1p[4] * a1) >> 4;
-                rows1p[1] = (S1p[1] * a0 + S1p[5] * a1) >> 4;
-                rows1p[2] = (S1p[2] * a0 + S1p[6] * a1) >> 4;
-                rows1p[3] = (S1p[3] * a0 + S1p[7] * a1) >> 4;
+                    rows0p[0] = (S0p[0] * a0 + S0p[4] * a1) >> 4;
+                    rows0p[1] = (S0p[1] * a0 + S0p[5] * a1) >> 4;
+                    rows0p[2] = (S0p[2] * a0 + S0p[6] * a1) >> 4;
+                    rows0p[3] = (S0p[3] * a0 + S0p[7] * a1) >> 4;
+                    rows1p[0] = (S1p[0] * a0 + S1p[4] * a1) >> 4;
+                    rows1p[1] = (S1p[1] * a0 + S1p[5] * a1) >> 4;
+                    rows1p[2] = (S1p[2] * a0 + S1p[6] * a1) >> 4;
+                    rows1p[3] = (S1p[3] * a0 + S1p[7] * a1) >> 4;
 #endif // __ARM_NEON
 
-                ialphap += 2;
-                rows0p += 4;
-                rows1p += 4;
+                    ialphap += 2;
+                    rows0p += 4;
+                    rows1p += 4;
+                }
             }
-        }
 
-        prev_sy1 = sy;
+            prev_sy1 = sy;
 
-        // vresize
-        short b0 = ibeta[0];
-        short b1 = ibeta[1];
+            // vresize
+            short b0 = ibeta[dy * 2];
+            short b1 = ibeta[dy * 2 + 1];
 
-        short* rows0p = rows0;
-        short* rows1p = rows1;
-        unsigned char* Dp = dst + stride * (dy);
+            short* rows0p = rows0;
+            short* rows1p = rows1;
+            unsigned char* Dp = dst + stride * (dy);
 
-#if __ARM_NEON
-        int nn = (w * 4) >> 3;
+#if __ARM_NEON || __SSE2__
+            int nn = (w * 4) >> 3;
 #else
-        int nn = 0;
+            int nn = 0;
 #endif
-        int remain = (w * 4) - (nn << 3);
+            int remain = (w * 4) - (nn << 3);
 
 #if __ARM_NEON
 #if __aarch64__
-        int16x4_t _b0 = vdup_n_s16(b0);
-        int16x4_t _b1 = vdup_n_s16(b1);
-        int32x4_t _v2 = vdupq_n_s32(2);
-        for (; nn > 0; nn--)
-        {
-            int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
-            int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
-            int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
-            int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
+            int16x4_t _b0 = vdup_n_s16(b0);
+            int16x4_t _b1 = vdup_n_s16(b1);
+            int32x4_t _v2 = vdupq_n_s32(2);
+            for (; nn > 0; nn--)
+            {
+                int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
+                int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
+                int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
+                int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
 
-            int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
-            int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
-            int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
-            int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
+                int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
+                int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
+                int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
+                int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
 
-            int32x4_t _acc = _v2;
-            _acc = vsraq_n_s32(_acc, _rows0p_sr4_mb0, 16);
-            _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
+                int32x4_t _acc = _v2;
+                _acc = vsraq_n_s32(_acc, _rows0p_sr4_mb0, 16);
+                _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
 
-            int32x4_t _acc_1 = _v2;
-            _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
-            _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
+                int32x4_t _acc_1 = _v2;
+                _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
+                _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
 
-            int16x4_t _acc16 = vshrn_n_s32(_acc, 2);
-            int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
+                int16x4_t _acc16 = vshrn_n_s32(_acc, 2);
+                int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
 
-            uint8x8_t _D = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
+                uint8x8_t _D = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
 
-            vst1_u8(Dp, _D);
+                vst1_u8(Dp, _D);
 
-            Dp += 8;
-            rows0p += 8;
-            rows1p += 8;
-        }
+                Dp += 8;
+                rows0p += 8;
+                rows1p += 8;
+            }
 #else
-        if (nn > 0)
-        {
-            asm volatile(
-                "vdup.s16   d16, %8         \n"
-                "mov        r4, #2          \n"
-                "vdup.s16   d17, %9         \n"
-                "vdup.s32   q12, r4         \n"
-                "pld        [%0, #128]      \n"
-                "vld1.s16   {d2-d3}, [%0 :128]!\n"
-                "pld        [%1, #128]      \n"
-                "vld1.s16   {d6-d7}, [%1 :128]!\n"
-                "0:                         \n"
-                "vmull.s16  q0, d2, d16     \n"
-                "vmull.s16  q1, d3, d16     \n"
-                "vorr.s32   q10, q12, q12   \n"
-                "vorr.s32   q11, q12, q12   \n"
-                "vmull.s16  q2, d6, d17     \n"
-                "vmull.s16  q3, d7, d17     \n"
-                "vsra.s32   q10, q0, #16    \n"
-                "vsra.s32   q11, q1, #16    \n"
-                "pld        [%0, #128]      \n"
-                "vld1.s16   {d2-d3}, [%0 :128]!\n"
-                "vsra.s32   q10, q2, #16    \n"
-                "vsra.s32   q11, q3, #16    \n"
-                "pld        [%1, #128]      \n"
-                "vld1.s16   {d6-d7}, [%1 :128]!\n"
-                "vshrn.s32  d20, q10, #2    \n"
-                "vshrn.s32  d21, q11, #2    \n"
-                "vqmovun.s16 d20, q10        \n"
-                "vst1.8     {d20}, [%2]!    \n"
-                "subs       %3, #1          \n"
-                "bne        0b              \n"
-                "sub        %0, #16         \n"
-                "sub        %1, #16         \n"
-                : "=r"(rows0p), // %0
-                "=r"(rows1p), // %1
-                "=r"(Dp),     // %2
-                "=r"(nn)      // %3
-                : "0"(rows0p),
-                "1"(rows1p),
-                "2"(Dp),
-                "3"(nn),
-                "r"(b0), // %8
-                "r"(b1)  // %9
-                : "cc", "memory", "r4", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11", "q12");
-        }
+            if (nn > 0)
+            {
+                asm volatile(
+                    "vdup.s16   d16, %8         \n"
+                    "mov        r4, #2          \n"
+                    "vdup.s16   d17, %9         \n"
+                    "vdup.s32   q12, r4         \n"
+                    "pld        [%0, #128]      \n"
+                    "vld1.s16   {d2-d3}, [%0 :128]!\n"
+                    "pld        [%1, #128]      \n"
+                    "vld1.s16   {d6-d7}, [%1 :128]!\n"
+                    "0:                         \n"
+                    "vmull.s16  q0, d2, d16     \n"
+                    "vmull.s16  q1, d3, d16     \n"
+                    "vorr.s32   q10, q12, q12   \n"
+                    "vorr.s32   q11, q12, q12   \n"
+                    "vmull.s16  q2, d6, d17     \n"
+                    "vmull.s16  q3, d7, d17     \n"
+                    "vsra.s32   q10, q0, #16    \n"
+                    "vsra.s32   q11, q1, #16    \n"
+                    "pld        [%0, #128]      \n"
+                    "vld1.s16   {d2-d3}, [%0 :128]!\n"
+                    "vsra.s32   q10, q2, #16    \n"
+                    "vsra.s32   q11, q3, #16    \n"
+                    "pld        [%1, #128]      \n"
+                    "vld1.s16   {d6-d7}, [%1 :128]!\n"
+                    "vshrn.s32  d20, q10, #2    \n"
+                    "vshrn.s32  d21, q11, #2    \n"
+                    "vqmovun.s16 d20, q10        \n"
+                    "vst1.8     {d20}, [%2]!    \n"
+                    "subs       %3, #1          \n"
+                    "bne        0b              \n"
+                    "sub        %0, #16         \n"
+                    "sub        %1, #16         \n"
+                    : "=r"(rows0p), // %0
+                    "=r"(rows1p), // %1
+                    "=r"(Dp),     // %2
+                    "=r"(nn)      // %3
+                    : "0"(rows0p),
+                    "1"(rows1p),
+                    "2"(Dp),
+                    "3"(nn),
+                    "r"(b0), // %8
+                    "r"(b1)  // %9
+                    : "cc", "memory", "r4", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11", "q12");
+            }
 #endif // __aarch64__
 #endif // __ARM_NEON
-        for (; remain; --remain)
-        {
-            //             D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
-            *Dp++ = (unsigned char)(((short)((b0 * (short)(*rows0p++)) >> 16) + (short)((b1 * (short)(*rows1p++)) >> 16) + 2) >> 2);
-        }
+#if __SSE2__
+            __m128i _b0 = _mm_set1_epi16(b0);
+            __m128i _b1 = _mm_set1_epi16(b1);
+            __m128i _v2 = _mm_set1_epi16(2);
+            for (; nn > 0; nn--)
+            {
+                __m128i _rows0 = _mm_loadu_si128((const __m128i*)rows0p);
+                __m128i _rows1 = _mm_loadu_si128((const __m128i*)rows1p);
+
+                __m128i _acc = _mm_add_epi16(_mm_mulhi_epi16(_rows0, _b0), _mm_mulhi_epi16(_rows1, _b1));
+                _acc = _mm_srai_epi16(_mm_add_epi16(_acc, _v2), 2);
+
+                _mm_storel_epi64((__m128i*)Dp, _mm_packus_epi16(_acc, _acc));
 
-        ibeta += 2;
+                Dp += 8;
+                rows0p += 8;
+                rows1p += 8;
+            }
+#endif // __SSE2__
+            for (; remain; --remain)
+            {
+                //             D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
+                *Dp++ = (unsigned char)(((short)((b0 * (short)(*rows0p++)) >> 16) + (short)((b1 * (short)(*rows1p++)) >> 16) + 2) >> 2);
+            }
+        }
     }
 
     delete[] buf;
@@ -1242,6 +1396,304 @@ void resize_bilinear_yuv420sp(const unsigned char* src, int srcw, int srch, unsi
     unsigned char* dstUV = dst + w * h;
     resize_bilinear_c2(srcUV, srcw / 2, srch / 2, dstUV, w / 2, h / 2);
 }
+
+// fractional source span of each destination pixel along one axis, the INTER_AREA weight table
+static int compute_resize_area_tab(int srcsize, int dstsize, int cn, int* ofs, float* weights, int* start)
+{
+    const double scale = (double)srcsize / dstsize;
+
+    int k = 0;
+    for (int d = 0; d < dstsize; d++)
+    {
+        start[d] = k;
+
+        double fs1 = d * scale;
+        double fs2 = fs1 + scale;
+        double cellsize = std::min(scale, srcsize - fs1);
+
+        int s1 = (int)ceil(fs1);
+        int s2 = (int)floor(fs2);
+
+        s2 = std::min(s2, srcsize - 1);
+        s1 = std::min(s1, s2);
+
+        if (s1 - fs1 > 1e-3)
+        {
+            ofs[k] = (s1 - 1) * cn;
+            weights[k] = (float)((s1 - fs1) / cellsize);
+            k++;
+        }
+
+        for (int s = s1; s < s2; s++)
+        {
+            ofs[k] = s * cn;
+            weights[k] = (float)(1.0 / cellsize);
+            k++;
+        }
+
+        if (fs2 - s2 > 1e-3)
+        {
+            ofs[k] = s2 * cn;
+            weights[k] = (float)(std::min(std::min(fs2 - s2, 1.0), cellsize) / cellsize);
+            k++;
+        }
+    }
+
+    start[dstsize] = k;
+
+    return k;
+}
+
+// sum += S * beta over a row of n bytes
+static void resize_area_vaccumulate(const unsigned char* S, float* sum, int n, float beta, bool first)
+{
+    int i = 0;
+#if __ARM_NEON
+    float32x4_t _beta = vdupq_n_f32(beta);
+    for (; i + 15 < n; i += 16)
+    {
+        uint8x16_t _S = vld1q_u8(S + i);
+        uint16x8_t _S01 = vmovl_u8(vget_low_u8(_S));
+        uint16x8_t _S23 = vmovl_u8(vget_high_u8(_S));
+        float32x4_t _p0 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(_S01)));
+        float32x4_t _p1 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(_S01)));
+        float32x4_t _p2 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(_S23)));
+        float32x4_t _p3 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(_S23)));
+        if (first)
+        {
+            vst1q_f32(sum + i, vmulq_f32(_p0, _beta));
+            vst1q_f32(sum + i + 4, vmulq_f32(_p1, _beta));
+            vst1q_f32(sum + i + 8, vmulq_f32(_p2, _beta));
+            vst1q_f32(sum + i + 12, vmulq_f32(_p3, _beta));
+        }
+        else
+        {
+            vst1q_f32(sum + i, vmlaq_f32(vld1q_f32(sum + i), _p0, _beta));
+            vst1q_f32(sum + i + 4, vmlaq_f32(vld1q_f32(sum + i + 4), _p1, _beta));
+            vst1q_f32(sum + i + 8, vmlaq_f32(vld1q_f32(sum + i + 8), _p2, _beta));
+            vst1q_f32(sum + i + 12, vmlaq_f32(vld1q_f32(sum + i + 12), _p3, _beta));
+        }
+    }
+#elif __SSE2__
+    __m128 _beta = _mm_set1_ps(beta);
+    __m128i _zero = _mm_setzero_si128();
+    for (; i + 15 < n; i += 16)
+    {
+        __m128i _S = _mm_loadu_si128((const __m128i*)(S + i));
+        __m128i _S01 = _mm_unpacklo_epi8(_S, _zero);
+        __m128i _S23 = _mm_unpackhi_epi8(_S, _zero);
+        __m128 _p0 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(_S01, _zero)), _beta);
+        __m128 _p1 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(_S01, _zero)), _beta);
+        __m128 _p2 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(_S23, _zero)), _beta);
+        __m128 _p3 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(_S23, _zero)), _beta);
+        if (!first)
+        {
+            _p0 = _mm_add_ps(_mm_loadu_ps(sum + i), _p0);
+            _p1 = _mm_add_ps(_mm_loadu_ps(sum + i + 4), _p1);
+            _p2 = _mm_add_ps(_mm_loadu_ps(sum + i + 8), _p2);
+            _p3 = _mm_add_ps(_mm_loadu_ps(sum + i + 12), _p3);
+        }
+        _mm_storeu_ps(sum + i, _p0);
+        _mm_storeu_ps(sum + i + 4, _p1);
+        _mm_storeu_ps(sum + i + 8, _p2);
+        _mm_storeu_ps(sum + i + 12, _p3);
+    }
+#endif // __ARM_NEON
+    for (; i < n; i++)
+    {
+        sum[i] = first ? S[i] * beta : sum[i] + S[i] * beta;
+    }
+}
+
+static inline unsigned char resize_area_round(float v)
+{
+    int x = (int)(v + 0.5f);
+    return (unsigned char)std::min(std::max(x, 0), 255);
+}
+
+template<int cn>
+static void resize_area_hresize(const float* sum, unsigned char* Dp, int w, const int* xofs, const float* alpha, const int* xstart)
+{
+    for (int dx = 0; dx < w; dx++)
+    {
+        float D[cn] = {0.f};
+        for (int k = xstart[dx]; k < xstart[dx + 1]; k++)
+        {
+            const float* Sp = sum + xofs[k];
+            const float a = alpha[k];
+            for (int c = 0; c < cn; c++)
+            {
+                D[c] += Sp[c] * a;
+            }
+        }
+
+        for (int c = 0; c < cn; c++)
+        {
+            Dp[c] = resize_area_round(D[c]);
+        }
+
+        Dp += cn;
+    }
+}
+
+#if __ARM_NEON || __SSE2__
+template<>
+void resize_area_hresize<4>(const float* sum, unsigned char* Dp, int w, const int* xofs, const float* alpha, const int* xstart)
+{
+    for (int dx = 0; dx < w; dx++)
+    {
+#if __ARM_NEON
+        float32x4_t _D = vdupq_n_f32(0.f);
+        for (int k = xstart[dx]; k < xstart[dx + 1]; k++)
+        {
+            _D = vmlaq_n_f32(_D, vld1q_f32(sum + xofs[k]), alpha[k]);
+        }
+
+        uint16x4_t _D16 = vqmovn_u32(vcvtq_u32_f32(vaddq_f32(_D, vdupq_n_f32(0.5f))));
+        uint8x8_t _D8 = vqmovn_u16(vcombine_u16(_D16, _D16));
+        vst1_lane_u32((uint32_t*)Dp, vreinterpret_u32_u8(_D8), 0);
+#else
+        __m128 _D = _mm_setzero_ps();
+        for (int k = xstart[dx]; k < xstart[dx + 1]; k++)
+        {
+            _D = _mm_add_ps(_D, _mm_mul_ps(_mm_loadu_ps(sum + xofs[k]), _mm_set1_ps(alpha[k])));
+        }
+
+        __m128i _D32 = _mm_cvttps_epi32(_mm_add_ps(_D, _mm_set1_ps(0.5f)));
+        __m128i _D16 = _mm_packs_epi32(_D32, _D32);
+        int v = _mm_cvtsi128_si32(_mm_packus_epi16(_D16, _D16));
+        memcpy(Dp, &v, 4);
+#endif // __ARM_NEON
+
+        Dp += 4;
+    }
+}
+#endif // __ARM_NEON || __SSE2__
+
+template<int cn>
+static void resize_area(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    // each destination pixel spans at most two partial source pixels besides the inner ones
+    int* buf = new int[srcw * 4 + w + 1 + srch * 4 + h + 1];
+
+    int* xofs = buf;
+    float* alpha = (float*)(buf + srcw * 2);
+    int* xstart = buf + srcw * 4;
+    int* yofs = xstart + w + 1;
+    float* beta = (float*)(yofs + srch * 2);
+    int* ystart = yofs + srch * 4;
+
+    compute_resize_area_tab(srcw, w, cn, xofs, alpha, xstart);
+    compute_resize_area_tab(srch, h, 1, yofs, beta, ystart);
+
+    // loop body
+    const int nn_band = std::max(std::min(opt.num_threads, h), 1);
+
+    #pragma omp parallel for num_threads(nn_band)
+    for (int band = 0; band < nn_band; band++)
+    {
+        const int dy0 = h * band / nn_band;
+        const int dy1 = h * (band + 1) / nn_band;
+
+        Mat sumbuf(srcw * cn, (size_t)4u);
+        float* sum = sumbuf;
+
+        for (int dy = dy0; dy < dy1; dy++)
+        {
+            // vresize into one float row
+            for (int k = ystart[dy]; k < ystart[dy + 1]; k++)
+            {
+                resize_area_vaccumulate(src + srcstride * yofs[k], sum, srcw * cn, beta[k], k == ystart[dy]);
+            }
+
+            // hresize
+            resize_area_hresize<cn>(sum, dst + stride * dy, w, xofs, alpha, xstart);
+        }
+    }
+
+    delete[] buf;
+}
+
+void resize_area_c1(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h)
+{
+    return resize_area_c1(src, srcw, srch, srcw, dst, w, h, w);
+}
+
+void resize_area_c2(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h)
+{
+    return resize_area_c2(src, srcw, srch, srcw * 2, dst, w, h, w * 2);
+}
+
+void resize_area_c3(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h)
+{
+    return resize_area_c3(src, srcw, srch, srcw * 3, dst, w, h, w * 3);
+}
+
+void resize_area_c4(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h)
+{
+    return resize_area_c4(src, srcw, srch, srcw * 4, dst, w, h, w * 4);
+}
+
+void resize_area_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    Option opt;
+    opt.num_threads = 1;
+    resize_area_c1(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+}
+
+void resize_area_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    Option opt;
+    opt.num_threads = 1;
+    resize_area_c2(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+}
+
+void resize_area_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    Option opt;
+    opt.num_threads = 1;
+    resize_area_c3(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+}
+
+void resize_area_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    Option opt;
+    opt.num_threads = 1;
+    resize_area_c4(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+}
+
+void resize_area_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    // area averaging is only meaningful for shrinking, enlarge with bilinear
+    if (w > srcw || h > srch)
+        return resize_bilinear_c1(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+
+    resize_area<1>(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+}
+
+void resize_area_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    if (w > srcw || h > srch)
+        return resize_bilinear_c2(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+
+    resize_area<2>(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+}
+
+void resize_area_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    if (w > srcw || h > srch)
+        return resize_bilinear_c3(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+
+    resize_area<3>(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+}
+
+void resize_area_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    if (w > srcw || h > srch)
+        return resize_bilinear_c4(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+
+    resize_area<4>(src, srcw, srch, srcstride, dst, w, h, stride, opt);
+}
 #endif // NCNN_PIXEL
 
 } // namespace ncnn
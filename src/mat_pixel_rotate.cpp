@@ -16,6 +16,10 @@
 #if __ARM_NEON
 #include <arm_neon.h>
 #endif // __ARM_NEON
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+#include <stddef.h>
 #include "platform.h"
 
 namespace ncnn {
@@ -5929,6 +5933,192 @@ static void kanna_rotate_8_c4(const unsigned char* src, int srcw, int srch, int
     }
 }
 
+#if !__ARM_NEON
+#if __SSE2__
+// transpose a block of 8 source rows by 8 pixels, destination row i starts at outptr + i * outstep
+template<int cn>
+static void kanna_rotate_transpose_8x8(const unsigned char* const* rows, int offset, unsigned char* outptr, ptrdiff_t outstep)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        for (int k = 0; k < 8; k++)
+        {
+            for (int c = 0; c < cn; c++)
+            {
+                outptr[k * cn + c] = rows[k][offset + i * cn + c];
+            }
+        }
+
+        outptr += outstep;
+    }
+}
+
+template<>
+void kanna_rotate_transpose_8x8<1>(const unsigned char* const* rows, int offset, unsigned char* outptr, ptrdiff_t outstep)
+{
+    __m128i _r0 = _mm_loadl_epi64((const __m128i*)(rows[0] + offset));
+    __m128i _r1 = _mm_loadl_epi64((const __m128i*)(rows[1] + offset));
+    __m128i _r2 = _mm_loadl_epi64((const __m128i*)(rows[2] + offset));
+    __m128i _r3 = _mm_loadl_epi64((const __m128i*)(rows[3] + offset));
+    __m128i _r4 = _mm_loadl_epi64((const __m128i*)(rows[4] + offset));
+    __m128i _r5 = _mm_loadl_epi64((const __m128i*)(rows[5] + offset));
+    __m128i _r6 = _mm_loadl_epi64((const __m128i*)(rows[6] + offset));
+    __m128i _r7 = _mm_loadl_epi64((const __m128i*)(rows[7] + offset));
+
+    __m128i _t0 = _mm_unpacklo_epi8(_r0, _r1);
+    __m128i _t1 = _mm_unpacklo_epi8(_r2, _r3);
+    __m128i _t2 = _mm_unpacklo_epi8(_r4, _r5);
+    __m128i _t3 = _mm_unpacklo_epi8(_r6, _r7);
+
+    __m128i _u0 = _mm_unpacklo_epi16(_t0, _t1);
+    __m128i _u1 = _mm_unpackhi_epi16(_t0, _t1);
+    __m128i _u2 = _mm_unpacklo_epi16(_t2, _t3);
+    __m128i _u3 = _mm_unpackhi_epi16(_t2, _t3);
+
+    __m128i _v0 = _mm_unpacklo_epi32(_u0, _u2);
+    __m128i _v1 = _mm_unpackhi_epi32(_u0, _u2);
+    __m128i _v2 = _mm_unpacklo_epi32(_u1, _u3);
+    __m128i _v3 = _mm_unpackhi_epi32(_u1, _u3);
+
+    _mm_storel_epi64((__m128i*)outptr, _v0);
+    _mm_storel_epi64((__m128i*)(outptr + outstep), _mm_unpackhi_epi64(_v0, _v0));
+    _mm_storel_epi64((__m128i*)(outptr + outstep * 2), _v1);
+    _mm_storel_epi64((__m128i*)(outptr + outstep * 3), _mm_unpackhi_epi64(_v1, _v1));
+    _mm_storel_epi64((__m128i*)(outptr + outstep * 4), _v2);
+    _mm_storel_epi64((__m128i*)(outptr + outstep * 5), _mm_unpackhi_epi64(_v2, _v2));
+    _mm_storel_epi64((__m128i*)(outptr + outstep * 6), _v3);
+    _mm_storel_epi64((__m128i*)(outptr + outstep * 7), _mm_unpackhi_epi64(_v3, _v3));
+}
+
+template<>
+void kanna_rotate_transpose_8x8<2>(const unsigned char* const* rows, int offset, unsigned char* outptr, ptrdiff_t outstep)
+{
+    __m128i _r0 = _mm_loadu_si128((const __m128i*)(rows[0] + offset));
+    __m128i _r1 = _mm_loadu_si128((const __m128i*)(rows[1] + offset));
+    __m128i _r2 = _mm_loadu_si128((const __m128i*)(rows[2] + offset));
+    __m128i _r3 = _mm_loadu_si128((const __m128i*)(rows[3] + offset));
+    __m128i _r4 = _mm_loadu_si128((const __m128i*)(rows[4] + offset));
+    __m128i _r5 = _mm_loadu_si128((const __m128i*)(rows[5] + offset));
+    __m128i _r6 = _mm_loadu_si128((const __m128i*)(rows[6] + offset));
+    __m128i _r7 = _mm_loadu_si128((const __m128i*)(rows[7] + offset));
+
+    __m128i _t0 = _mm_unpacklo_epi16(_r0, _r1);
+    __m128i _t1 = _mm_unpackhi_epi16(_r0, _r1);
+    __m128i _t2 = _mm_unpacklo_epi16(_r2, _r3);
+    __m128i _t3 = _mm_unpackhi_epi16(_r2, _r3);
+    __m128i _t4 = _mm_unpacklo_epi16(_r4, _r5);
+    __m128i _t5 = _mm_unpackhi_epi16(_r4, _r5);
+    __m128i _t6 = _mm_unpacklo_epi16(_r6, _r7);
+    __m128i _t7 = _mm_unpackhi_epi16(_r6, _r7);
+
+    __m128i _u0 = _mm_unpacklo_epi32(_t0, _t2);
+    __m128i _u1 = _mm_unpackhi_epi32(_t0, _t2);
+    __m128i _u2 = _mm_unpacklo_epi32(_t1, _t3);
+    __m128i _u3 = _mm_unpackhi_epi32(_t1, _t3);
+    __m128i _u4 = _mm_unpacklo_epi32(_t4, _t6);
+    __m128i _u5 = _mm_unpackhi_epi32(_t4, _t6);
+    __m128i _u6 = _mm_unpacklo_epi32(_t5, _t7);
+    __m128i _u7 = _mm_unpackhi_epi32(_t5, _t7);
+
+    _mm_storeu_si128((__m128i*)outptr, _mm_unpacklo_epi64(_u0, _u4));
+    _mm_storeu_si128((__m128i*)(outptr + outstep), _mm_unpackhi_epi64(_u0, _u4));
+    _mm_storeu_si128((__m128i*)(outptr + outstep * 2), _mm_unpacklo_epi64(_u1, _u5));
+    _mm_storeu_si128((__m128i*)(outptr + outstep * 3), _mm_unpackhi_epi64(_u1, _u5));
+    _mm_storeu_si128((__m128i*)(outptr + outstep * 4), _mm_unpacklo_epi64(_u2, _u6));
+    _mm_storeu_si128((__m128i*)(outptr + outstep * 5), _mm_unpackhi_epi64(_u2, _u6));
+    _mm_storeu_si128((__m128i*)(outptr + outstep * 6), _mm_unpacklo_epi64(_u3, _u7));
+    _mm_storeu_si128((__m128i*)(outptr + outstep * 7), _mm_unpackhi_epi64(_u3, _u7));
+}
+
+template<>
+void kanna_rotate_transpose_8x8<4>(const unsigned char* const* rows, int offset, unsigned char* outptr, ptrdiff_t outstep)
+{
+    // four 4x4 blocks of 32bit pixels
+    for (int i = 0; i < 2; i++)
+    {
+        for (int k = 0; k < 2; k++)
+        {
+            __m128i _r0 = _mm_loadu_si128((const __m128i*)(rows[k * 4] + offset + i * 16));
+            __m128i _r1 = _mm_loadu_si128((const __m128i*)(rows[k * 4 + 1] + offset + i * 16));
+            __m128i _r2 = _mm_loadu_si128((const __m128i*)(rows[k * 4 + 2] + offset + i * 16));
+            __m128i _r3 = _mm_loadu_si128((const __m128i*)(rows[k * 4 + 3] + offset + i * 16));
+
+            __m128i _t0 = _mm_unpacklo_epi32(_r0, _r1);
+            __m128i _t1 = _mm_unpacklo_epi32(_r2, _r3);
+            __m128i _t2 = _mm_unpackhi_epi32(_r0, _r1);
+            __m128i _t3 = _mm_unpackhi_epi32(_r2, _r3);
+
+            unsigned char* outptr0 = outptr + outstep * (i * 4) + k * 16;
+
+            _mm_storeu_si128((__m128i*)outptr0, _mm_unpacklo_epi64(_t0, _t1));
+            _mm_storeu_si128((__m128i*)(outptr0 + outstep), _mm_unpackhi_epi64(_t0, _t1));
+            _mm_storeu_si128((__m128i*)(outptr0 + outstep * 2), _mm_unpacklo_epi64(_t2, _t3));
+            _mm_storeu_si128((__m128i*)(outptr0 + outstep * 3), _mm_unpackhi_epi64(_t2, _t3));
+        }
+    }
+}
+#endif // __SSE2__
+
+// type 5 6 7 8 as one transpose, the source rows are visited 8 at a time so that both sides stay in cache
+template<int cn>
+static void kanna_rotate_transpose(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int type)
+{
+    // source pixel x y lands on destination column flipx ? w - 1 - y : y and row flipy ? h - 1 - x : x
+    const bool flipx = type == 6 || type == 7;
+    const bool flipy = type == 7 || type == 8;
+
+    unsigned char* outptr0 = flipy ? dst + (ptrdiff_t)stride * (h - 1) : dst;
+    const ptrdiff_t outstep = flipy ? -(ptrdiff_t)stride : (ptrdiff_t)stride;
+
+    int y = 0;
+    for (; y + 7 < srch; y += 8)
+    {
+        // the eight source rows in destination column order
+        const unsigned char* rows[8];
+        for (int k = 0; k < 8; k++)
+        {
+            rows[k] = src + (ptrdiff_t)srcstride * (flipx ? y + 7 - k : y + k);
+        }
+
+        const int dx = (flipx ? w - 8 - y : y) * cn;
+
+        int x = 0;
+#if __SSE2__
+        for (; x + 7 < srcw; x += 8)
+        {
+            kanna_rotate_transpose_8x8<cn>(rows, x * cn, outptr0 + outstep * x + dx, outstep);
+        }
+#endif // __SSE2__
+        for (; x < srcw; x++)
+        {
+            unsigned char* outptr = outptr0 + outstep * x + dx;
+            for (int k = 0; k < 8; k++)
+            {
+                for (int c = 0; c < cn; c++)
+                {
+                    outptr[k * cn + c] = rows[k][x * cn + c];
+                }
+            }
+        }
+    }
+    for (; y < srch; y++)
+    {
+        const unsigned char* ptr = src + (ptrdiff_t)srcstride * y;
+
+        const int dx = (flipx ? w - 1 - y : y) * cn;
+
+        for (int x = 0; x < srcw; x++)
+        {
+            unsigned char* outptr = outptr0 + outstep * x + dx;
+            for (int c = 0; c < cn; c++)
+            {
+                outptr[c] = ptr[x * cn + c];
+            }
+        }
+    }
+}
+#endif // !__ARM_NEON
+
 void kanna_rotate_c1(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, int type)
 {
     return kanna_rotate_c1(src, srcw, srch, srcw, dst, w, h, w, type);
@@ -5954,6 +6144,14 @@ void kanna_rotate_c1(const unsigned char* src, int srcw, int srch, int srcstride
     // assert srcw == w && srch == h for type 1234
     // assert srcw == h && srch == w for type 5678
 
+#if !__ARM_NEON
+    if (type >= 5 && type <= 8)
+    {
+        kanna_rotate_transpose<1>(src, srcw, srch, srcstride, dst, w, h, stride, type);
+        return;
+    }
+#endif // !__ARM_NEON
+
     switch (type)
     {
     case 1:
@@ -5991,6 +6189,14 @@ void kanna_rotate_c2(const unsigned char* src, int srcw, int srch, int srcstride
     // assert srcw == w && srch == h for type 1234
     // assert srcw == h && srch == w for type 5678
 
+#if !__ARM_NEON
+    if (type >= 5 && type <= 8)
+    {
+        kanna_rotate_transpose<2>(src, srcw, srch, srcstride, dst, w, h, stride, type);
+        return;
+    }
+#endif // !__ARM_NEON
+
     switch (type)
     {
     case 1:
@@ -6028,6 +6234,14 @@ void kanna_rotate_c3(const unsigned char* src, int srcw, int srch, int srcstride
     // assert srcw == w && srch == h for type 1234
     // assert srcw == h && srch == w for type 5678
 
+#if !__ARM_NEON
+    if (type >= 5 && type <= 8)
+    {
+        kanna_rotate_transpose<3>(src, srcw, srch, srcstride, dst, w, h, stride, type);
+        return;
+    }
+#endif // !__ARM_NEON
+
     switch (type)
     {
     case 1:
@@ -6065,6 +6279,14 @@ void kanna_rotate_c4(const unsigned char* src, int srcw, int srch, int srcstride
     // assert srcw == w && srch == h for type 1234
     // assert srcw == h && srch == w for type 5678
 
+#if !__ARM_NEON
+    if (type >= 5 && type <= 8)
+    {
+        kanna_rotate_transpose<4>(src, srcw, srch, srcstride, dst, w, h, stride, type);
+        return;
+    }
+#endif // !__ARM_NEON
+
     switch (type)
     {
     case 1:
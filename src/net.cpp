@@ -19,15 +19,12 @@
 #include "layer_type.h"
 #include "modelbin.h"
 #include "paramdict.h"
+#include "threadpool.h"
 
 #include <stdarg.h>
 #include <stdint.h>
 #include <string.h>
 
-#if NCNN_BENCHMARK
-#include "benchmark.h"
-#endif // NCNN_BENCHMARK
-
 #if NCNN_VULKAN
 #include "command.h"
 #include "pipelinecache.h"
@@ -35,6 +32,36 @@
 
 namespace ncnn {
 
+// collects the per-layer records of one extractor, shared by the inter-layer parallel workers
+class LayerProfiler
+{
+public:
+    void record(const LayerProfile& profile)
+    {
+        lock.lock();
+        profiles.push_back(profile);
+        lock.unlock();
+    }
+
+public:
+    Mutex lock;
+    std::vector<LayerProfile> profiles;
+};
+
+// the planned arenas of one extract target and input shape, see Option::use_shape_plan_cache
+class ShapePlan
+{
+public:
+    // extract blob index, then index dims w h c elempack elemsize of every given blob
+    std::vector<int> key;
+
+    ArenaAllocator blob_allocator;
+    ArenaAllocator workspace_allocator;
+
+    // 0 = recording, 1 = planned
+    int state;
+};
+
 class NetPrivate
 {
 public:
@@ -49,21 +76,42 @@ public:
 #endif // NCNN_VULKAN
 
     friend class Extractor;
-    int forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const;
+    int forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, LayerProfiler* profiler) const;
+
+    // schedule independent layers concurrently, fallback to forward_layer if graph has no branch
+    int forward_layer_parallel(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, LayerProfiler* profiler) const;
 
 #if NCNN_VULKAN
     int forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const;
     int forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<VkMat>& blob_mats_gpu, std::vector<VkImageMat>& blob_mats_gpu_image, VkCompute& cmd, const Option& opt) const;
 #endif // NCNN_VULKAN
 
+    // forward each layer over all samples of the batch, one_blob_only layers take the whole batch at once
+    int forward_layer_batch(int layer_index, std::vector<std::vector<Mat> >& blob_mats_batch, std::vector<Mat>& sample_mats, const Option& opt, LayerProfiler* profiler) const;
+
     int convert_layout(Mat& bottom_blob, const Layer* layer, const Option& opt) const;
 
     int do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats, const Option& opt) const;
+    int do_forward_layer_batch(const Layer* layer, std::vector<std::vector<Mat> >& blob_mats_batch, std::vector<Mat>& sample_mats, const Option& opt) const;
+
+    // do_forward_layer with timing, blob shapes and allocation recorded into profiler
+    int do_forward_layer_profiled(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, LayerProfiler* profiler, int worker_id) const;
+    int do_forward_layer_batch_profiled(int layer_index, std::vector<std::vector<Mat> >& blob_mats_batch, std::vector<Mat>& sample_mats, const Option& opt, LayerProfiler* profiler) const;
 #if NCNN_VULKAN
     int do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const;
     int do_forward_layer(const Layer* layer, std::vector<VkImageMat>& blob_mats_gpu_image, VkCompute& cmd, const Option& opt) const;
 #endif // NCNN_VULKAN
 
+#if NCNN_STDIO
+    int load_prepacked(const DataReader& dr);
+#endif // NCNN_STDIO
+
+    // find or create the plan of the given blobs, return 0 if it is recorded by another extractor or the cache is full
+    // recording is set when the caller forwards with the plan arenas begun
+    ShapePlan* acquire_shape_plan(int blob_index, const std::vector<Mat>& blob_mats, bool& recording) const;
+    void end_shape_plan(ShapePlan* plan) const;
+    void clear_shape_plans();
+
     void update_input_output_indexes();
 #if NCNN_STRING
     void update_input_output_names();
@@ -84,6 +132,24 @@ public:
     PoolAllocator* local_blob_allocator;
     PoolAllocator* local_workspace_allocator;
 
+    // guards shape_plans, shared by all extractors
+    mutable Mutex shape_plan_lock;
+    mutable std::vector<ShapePlan*> shape_plans;
+    int shape_plan_capacity;
+
+#if NCNN_STDIO
+    // keeps the weights referenced by layers valid
+    DataReaderFromMmap* model_mmap;
+    DataReaderFromMmap* prepacked_mmap;
+
+    // transformed weight data for each layer, consumed by load_model
+    std::vector<std::vector<Mat> > prepacked_weights;
+
+    // hash of the weight data read by the last load_model, and the one the prepacked file was saved with
+    uint64_t model_hash;
+    uint64_t prepacked_hash;
+#endif // NCNN_STDIO
+
 #if NCNN_VULKAN
     const VulkanDevice* vkdev;
 
@@ -100,6 +166,15 @@ NetPrivate::NetPrivate(Option& _opt)
     local_blob_allocator = 0;
     local_workspace_allocator = 0;
 
+    shape_plan_capacity = 16;
+
+#if NCNN_STDIO
+    model_mmap = 0;
+    prepacked_mmap = 0;
+    model_hash = 0;
+    prepacked_hash = 0;
+#endif // NCNN_STDIO
+
 #if NCNN_VULKAN
     vkdev = 0;
     weight_vkallocator = 0;
@@ -147,7 +222,7 @@ int NetPrivate::upload_model()
 }
 #endif // NCNN_VULKAN
 
-int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const
+int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, LayerProfiler* profiler) const
 {
     const Layer* layer = layers[layer_index];
 
@@ -160,7 +235,7 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
 
         if (blob_mats[bottom_blob_index].dims == 0)
         {
-            int ret = forward_layer(blobs[bottom_blob_index].producer, blob_mats, opt);
+            int ret = forward_layer(blobs[bottom_blob_index].producer, blob_mats, opt, profiler);
             if (ret != 0)
                 return ret;
         }
@@ -174,7 +249,7 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
 
             if (blob_mats[bottom_blob_index].dims == 0)
             {
-                int ret = forward_layer(blobs[bottom_blob_index].producer, blob_mats, opt);
+                int ret = forward_layer(blobs[bottom_blob_index].producer, blob_mats, opt, profiler);
                 if (ret != 0)
                     return ret;
             }
@@ -195,7 +270,7 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
         bottom_blob.elemsize = blob_mats[bottom_blob_index].elemsize;
     }
 #endif
-    int ret = do_forward_layer(layer, blob_mats, opt);
+    int ret = profiler ? do_forward_layer_profiled(layer_index, blob_mats, opt, profiler, 0) : do_forward_layer(layer, blob_mats, opt);
 #if NCNN_BENCHMARK
     double end = get_current_time();
     if (layer->one_blob_only)
@@ -218,6 +293,386 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
     return 0;
 }
 
+#if NCNN_THREADS
+class ParallelForwardQueue
+{
+public:
+    Mutex lock;
+
+    // each layer is queued exactly once, so no wrap around is needed
+    std::vector<int> layer_indexes;
+    int front;
+    int back;
+};
+
+class ParallelForwardContext
+{
+public:
+    ParallelForwardContext(const NetPrivate* _net, std::vector<Mat>& _blob_mats, const Option& _opt)
+        : net(_net), blob_mats(_blob_mats), opt(_opt)
+    {
+        profiler = 0;
+        worker_count = 0;
+        queues = 0;
+        layer_count = 0;
+        ready_count = 0;
+        running_count = 0;
+        finished_count = 0;
+        ret = 0;
+    }
+
+    ~ParallelForwardContext()
+    {
+        delete[] queues;
+    }
+
+    void push(int worker_id, int layer_index);
+    int pop(int worker_id);
+    void run(int worker_id);
+
+public:
+    const NetPrivate* net;
+    std::vector<Mat>& blob_mats;
+    const Option& opt;
+    LayerProfiler* profiler;
+
+    // the count of bottom blobs not produced yet
+    // -1 for the layers out of this forward
+    std::vector<int> pending;
+
+    // per-worker ready layers
+    // owner pops from back and the idle workers steal from front
+    int worker_count;
+    ParallelForwardQueue* queues;
+
+    Mutex lock;
+    ConditionVariable condition;
+    int layer_count;
+    int ready_count;
+    int running_count;
+    int finished_count;
+    int ret;
+};
+
+void ParallelForwardContext::push(int worker_id, int layer_index)
+{
+    ParallelForwardQueue& q = queues[worker_id];
+    q.lock.lock();
+    q.layer_indexes[q.back++] = layer_index;
+    q.lock.unlock();
+
+    lock.lock();
+    ready_count++;
+    lock.unlock();
+
+    condition.signal();
+}
+
+int ParallelForwardContext::pop(int worker_id)
+{
+    int layer_index = -1;
+
+    // take the most recently readied layer, its input is likely still in cache
+    {
+        ParallelForwardQueue& q = queues[worker_id];
+        q.lock.lock();
+        if (q.back > q.front)
+        {
+            layer_index = q.layer_indexes[--q.back];
+        }
+        q.lock.unlock();
+    }
+
+    // steal the oldest one from others
+    for (int i = 1; layer_index == -1 && i < worker_count; i++)
+    {
+        ParallelForwardQueue& q = queues[(worker_id + i) % worker_count];
+        q.lock.lock();
+        if (q.back > q.front)
+        {
+            layer_index = q.layer_indexes[q.front++];
+        }
+        q.lock.unlock();
+    }
+
+    if (layer_index != -1)
+    {
+        lock.lock();
+        ready_count--;
+        running_count++;
+        lock.unlock();
+    }
+
+    return layer_index;
+}
+
+void ParallelForwardContext::run(int worker_id)
+{
+    for (;;)
+    {
+        int layer_index = pop(worker_id);
+        if (layer_index == -1)
+        {
+            lock.lock();
+            while (ready_count == 0 && finished_count < layer_count && ret == 0)
+            {
+                condition.wait(lock);
+            }
+            bool done = finished_count == layer_count || ret != 0;
+            lock.unlock();
+
+            if (done)
+                break;
+
+            continue;
+        }
+
+        // split threads among the layers running at the same time
+        Option opt_layer = opt;
+        {
+            lock.lock();
+            int concurrent = std::min(running_count + ready_count, worker_count);
+            lock.unlock();
+
+            opt_layer.num_threads = std::max(opt.num_threads / std::max(concurrent, 1), 1);
+        }
+
+        const Layer* layer = net->layers[layer_index];
+
+#if NCNN_BENCHMARK
+        double start = get_current_time();
+#endif
+        int lret = profiler ? net->do_forward_layer_profiled(layer_index, blob_mats, opt_layer, profiler, worker_id) : net->do_forward_layer(layer, blob_mats, opt_layer);
+#if NCNN_BENCHMARK
+        double end = get_current_time();
+        benchmark(layer, start, end);
+#endif
+
+        if (lret == 0)
+        {
+            // ready the consumers whose bottom blobs are all produced
+            for (size_t i = 0; i < layer->tops.size(); i++)
+            {
+                int top_blob_index = layer->tops[i];
+                int consumer = net->blobs[top_blob_index].consumer;
+                if (consumer == -1 || pending[consumer] < 0)
+                    continue;
+
+                const Layer* consumer_layer = net->layers[consumer];
+                for (size_t j = 0; j < consumer_layer->bottoms.size(); j++)
+                {
+                    if (consumer_layer->bottoms[j] != top_blob_index)
+                        continue;
+
+                    if (NCNN_XADD(&pending[consumer], -1) == 1)
+                    {
+                        push(worker_id, consumer);
+                    }
+                }
+            }
+        }
+
+        lock.lock();
+        running_count--;
+        finished_count++;
+        if (lret != 0)
+            ret = lret;
+        bool done = finished_count == layer_count || ret != 0;
+        lock.unlock();
+
+        if (done)
+        {
+            condition.broadcast();
+            break;
+        }
+    }
+}
+
+class ParallelForwardWorkerArgs
+{
+public:
+    ParallelForwardContext* ctx;
+    int worker_id;
+};
+
+static void* parallel_forward_worker(void* args)
+{
+    ParallelForwardWorkerArgs* wargs = (ParallelForwardWorkerArgs*)args;
+    ParallelForwardContext* ctx = wargs->ctx;
+
+    // denormals and blocktime settings are per-thread
+    set_kmp_blocktime(ctx->opt.openmp_blocktime);
+    set_flush_denormals(ctx->opt.flush_denormals);
+
+    ctx->run(wargs->worker_id);
+
+    return 0;
+}
+#endif // NCNN_THREADS
+
+int NetPrivate::forward_layer_parallel(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, LayerProfiler* profiler) const
+{
+#if NCNN_THREADS
+    if (opt.num_threads <= 1)
+        return forward_layer(layer_index, blob_mats, opt, profiler);
+
+    const int total_layer_count = (int)layers.size();
+
+    // collect the layers required for the wanted blob
+    std::vector<int> pending(total_layer_count, -1);
+    std::vector<int> stack;
+    stack.push_back(layer_index);
+    pending[layer_index] = 0;
+    int layer_count = 0;
+    while (!stack.empty())
+    {
+        int i = stack[stack.size() - 1];
+        stack.resize(stack.size() - 1);
+        layer_count++;
+
+        const Layer* layer = layers[i];
+        for (size_t j = 0; j < layer->bottoms.size(); j++)
+        {
+            int bottom_blob_index = layer->bottoms[j];
+            if (blob_mats[bottom_blob_index].dims != 0)
+                continue;
+
+            int producer = blobs[bottom_blob_index].producer;
+            if (producer == -1)
+            {
+                NCNN_LOGE("forward_layer_parallel blob %d has no producer", bottom_blob_index);
+                return -1;
+            }
+
+            pending[i]++;
+
+            if (pending[producer] == -1)
+            {
+                pending[producer] = 0;
+                stack.push_back(producer);
+            }
+        }
+    }
+
+    // estimate the max branch width by topological depth
+    // layers are stored in topological order
+    int max_width = 1;
+    {
+        std::vector<int> depth(total_layer_count, 0);
+        std::vector<int> width(total_layer_count + 1, 0);
+        for (int i = 0; i < total_layer_count; i++)
+        {
+            if (pending[i] == -1)
+                continue;
+
+            const Layer* layer = layers[i];
+            for (size_t j = 0; j < layer->bottoms.size(); j++)
+            {
+                int producer = blobs[layer->bottoms[j]].producer;
+                if (producer != -1 && producer < i && pending[producer] != -1)
+                    depth[i] = std::max(depth[i], depth[producer] + 1);
+            }
+
+            width[depth[i]]++;
+            max_width = std::max(max_width, width[depth[i]]);
+        }
+    }
+
+    const int worker_count = std::min(max_width, opt.num_threads);
+    if (worker_count <= 1)
+        return forward_layer(layer_index, blob_mats, opt, profiler);
+
+    ParallelForwardContext ctx(this, blob_mats, opt);
+    ctx.profiler = profiler;
+    ctx.pending = pending;
+    ctx.layer_count = layer_count;
+    ctx.worker_count = worker_count;
+    ctx.queues = new ParallelForwardQueue[worker_count];
+    for (int i = 0; i < worker_count; i++)
+    {
+        ctx.queues[i].layer_indexes.resize(layer_count);
+        ctx.queues[i].front = 0;
+        ctx.queues[i].back = 0;
+    }
+
+    // distribute the initially ready layers
+    {
+        int worker_id = 0;
+        for (int i = 0; i < total_layer_count; i++)
+        {
+            if (pending[i] != 0)
+                continue;
+
+            ctx.push(worker_id, i);
+            worker_id = (worker_id + 1) % worker_count;
+        }
+    }
+
+    std::vector<ParallelForwardWorkerArgs> wargs(worker_count);
+    std::vector<Thread*> threads(worker_count - 1);
+    for (int i = 0; i < worker_count; i++)
+    {
+        wargs[i].ctx = &ctx;
+        wargs[i].worker_id = i;
+    }
+    for (int i = 1; i < worker_count; i++)
+    {
+        threads[i - 1] = new Thread(parallel_forward_worker, (void*)&wargs[i]);
+    }
+
+    // current thread works as worker 0
+    ctx.run(0);
+
+    for (int i = 1; i < worker_count; i++)
+    {
+        threads[i - 1]->join();
+        delete threads[i - 1];
+    }
+
+    return ctx.ret;
+#else
+    return forward_layer(layer_index, blob_mats, opt, profiler);
+#endif // NCNN_THREADS
+}
+
+int NetPrivate::forward_layer_batch(int layer_index, std::vector<std::vector<Mat> >& blob_mats_batch, std::vector<Mat>& sample_mats, const Option& opt, LayerProfiler* profiler) const
+{
+    const Layer* layer = layers[layer_index];
+
+    // an input layer is reached when its blob was never fed
+    if (layer->one_blob_only && layer->bottoms.empty())
+    {
+        NCNN_LOGE("batch input for layer %d is not set", layer_index);
+        return -1;
+    }
+
+    // load bottom blobs
+    for (size_t i = 0; i < layer->bottoms.size(); i++)
+    {
+        int bottom_blob_index = layer->bottoms[i];
+
+        if (blob_mats_batch[bottom_blob_index].empty())
+        {
+            int ret = forward_layer_batch(blobs[bottom_blob_index].producer, blob_mats_batch, sample_mats, opt, profiler);
+            if (ret != 0)
+                return ret;
+        }
+    }
+
+#if NCNN_BENCHMARK
+    double start = get_current_time();
+#endif
+    int ret = profiler ? do_forward_layer_batch_profiled(layer_index, blob_mats_batch, sample_mats, opt, profiler) : do_forward_layer_batch(layer, blob_mats_batch, sample_mats, opt);
+#if NCNN_BENCHMARK
+    double end = get_current_time();
+    benchmark(layer, start, end);
+#endif
+    if (ret != 0)
+        return ret;
+
+    return 0;
+}
+
 #if NCNN_VULKAN
 int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const
 {
@@ -806,7 +1261,12 @@ int NetPrivate::convert_layout(Mat& bottom_blob, const Layer* layer, const Optio
         {
             if (elembits == 32)
             {
-#if (NCNN_AVX2 || NCNN_AVX)
+#if (NCNN_AVX512 || NCNN_AVX2 || NCNN_AVX)
+#if NCNN_AVX512
+                if (elemcount % 16 == 0 && layer->support_avx512_pack16 && ncnn::cpu_support_x86_avx512())
+                    dst_elempack = 16;
+                else
+#endif
                 if (elemcount % 8 == 0 && (ncnn::cpu_support_x86_avx2() || ncnn::cpu_support_x86_avx()))
                     dst_elempack = 8;
                 else if (elemcount % 4 == 0)
@@ -831,6 +1291,16 @@ int NetPrivate::convert_layout(Mat& bottom_blob, const Layer* layer, const Optio
                 const int packn = ncnn::cpu_riscv_vlenb() / 2;
                 if (elemcount % packn == 0)
                     dst_elempack = packn;
+#elif (NCNN_AVX512 || NCNN_AVX2 || NCNN_AVX)
+#if NCNN_AVX512
+                if (elemcount % 16 == 0 && layer->support_avx512_pack16 && ncnn::cpu_support_x86_avx512())
+                    dst_elempack = 16;
+                else
+#endif
+                if (elemcount % 8 == 0 && (ncnn::cpu_support_x86_avx2() || ncnn::cpu_support_x86_avx()))
+                    dst_elempack = 8;
+                else if (elemcount % 4 == 0)
+                    dst_elempack = 4;
 #else
                 if (elemcount % 4 == 0)
                     dst_elempack = 4;
@@ -872,8 +1342,8 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
 
         if (opt.lightmode)
         {
-            // deep copy for inplace forward if data is shared
-            if (layer->support_inplace && *bottom_blob_ref.refcount != 1)
+            // deep copy for inplace forward if data is shared or external
+            if (layer->support_inplace && (!bottom_blob_ref.refcount || *bottom_blob_ref.refcount != 1))
             {
                 bottom_blob = bottom_blob_ref.clone(opt.blob_allocator);
             }
@@ -925,8 +1395,8 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
 
             if (opt.lightmode)
             {
-                // deep copy for inplace forward if data is shared
-                if (layer->support_inplace && *bottom_blob_ref.refcount != 1)
+                // deep copy for inplace forward if data is shared or external
+                if (layer->support_inplace && (!bottom_blob_ref.refcount || *bottom_blob_ref.refcount != 1))
                 {
                     bottom_blobs[i] = bottom_blob_ref.clone(opt.blob_allocator);
                 }
@@ -986,75 +1456,306 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
     return 0;
 }
 
-#if NCNN_VULKAN
-int NetPrivate::do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const
+int NetPrivate::do_forward_layer_batch(const Layer* layer, std::vector<std::vector<Mat> >& blob_mats_batch, std::vector<Mat>& sample_mats, const Option& opt) const
 {
     if (layer->one_blob_only)
     {
-        // load bottom blob
         int bottom_blob_index = layer->bottoms[0];
         int top_blob_index = layer->tops[0];
 
-        VkMat& bottom_blob_ref = blob_mats_gpu[bottom_blob_index];
-        VkMat bottom_blob;
+        const std::vector<Mat>& bottom_batch_ref = blob_mats_batch[bottom_blob_index];
+        const size_t batch = bottom_batch_ref.size();
 
-        if (opt.lightmode)
+        std::vector<Mat> bottom_batch(batch);
+        for (size_t b = 0; b < batch; b++)
         {
-            // deep copy for inplace forward if data is shared
-            if (layer->support_inplace && *bottom_blob_ref.refcount != 1)
+            if (opt.lightmode)
             {
-                cmd.record_clone(bottom_blob_ref, bottom_blob, opt);
-                //                     NCNN_LOGE("clone %p[+%lu] %p[+%lu]", bottom_blob_ref.buffer(), bottom_blob_ref.buffer_offset(), bottom_blob.buffer(), bottom_blob.buffer_offset());
+                // deep copy for inplace forward if data is shared or external
+                if (layer->support_inplace && (!bottom_batch_ref[b].refcount || *bottom_batch_ref[b].refcount != 1))
+                {
+                    bottom_batch[b] = bottom_batch_ref[b].clone(opt.blob_allocator);
+                }
             }
-        }
-        if (bottom_blob.dims == 0)
-        {
-            bottom_blob = bottom_blob_ref;
+            if (bottom_batch[b].dims == 0)
+            {
+                bottom_batch[b] = bottom_batch_ref[b];
+            }
+
+            convert_layout(bottom_batch[b], layer, opt);
         }
 
         // forward
         if (opt.lightmode && layer->support_inplace)
         {
-            VkMat& bottom_top_blob = bottom_blob;
-            int ret = layer->forward_inplace(bottom_top_blob, cmd, opt);
-            if (ret != 0)
-                return ret;
+            for (size_t b = 0; b < batch; b++)
+            {
+                int ret = layer->forward_inplace(bottom_batch[b], opt);
+                if (ret != 0)
+                    return ret;
+            }
 
-            // store top blob
-            blob_mats_gpu[top_blob_index] = bottom_top_blob;
+            // store top blobs
+            blob_mats_batch[top_blob_index] = bottom_batch;
         }
         else
         {
-            VkMat top_blob;
-            int ret = layer->forward(bottom_blob, top_blob, cmd, opt);
+            std::vector<Mat> top_batch;
+            int ret = layer->forward_batch(bottom_batch, top_batch, opt);
             if (ret != 0)
                 return ret;
 
-            // store top blob
-            blob_mats_gpu[top_blob_index] = top_blob;
+            // store top blobs
+            blob_mats_batch[top_blob_index] = top_batch;
         }
 
         if (opt.lightmode)
         {
             // delete after taken in light mode
-            blob_mats_gpu[bottom_blob_index].release();
+            blob_mats_batch[bottom_blob_index].clear();
         }
     }
     else
     {
-        // load bottom blobs
-        std::vector<VkMat> bottom_blobs(layer->bottoms.size());
-        for (size_t i = 0; i < layer->bottoms.size(); i++)
-        {
-            int bottom_blob_index = layer->bottoms[i];
+        // forward sample by sample through the single blob path
+        const size_t batch = blob_mats_batch[layer->bottoms[0]].size();
+
+        for (size_t i = 0; i < layer->tops.size(); i++)
+        {
+            blob_mats_batch[layer->tops[i]].resize(batch);
+        }
+
+        for (size_t b = 0; b < batch; b++)
+        {
+            for (size_t i = 0; i < layer->bottoms.size(); i++)
+            {
+                int bottom_blob_index = layer->bottoms[i];
+                sample_mats[bottom_blob_index] = blob_mats_batch[bottom_blob_index][b];
+            }
+
+            if (opt.lightmode)
+            {
+                // hand over the only reference so that inplace forward need not clone
+                for (size_t i = 0; i < layer->bottoms.size(); i++)
+                {
+                    int bottom_blob_index = layer->bottoms[i];
+                    blob_mats_batch[bottom_blob_index][b].release();
+                }
+            }
+
+            int ret = do_forward_layer(layer, sample_mats, opt);
+            if (ret != 0)
+                return ret;
+
+            for (size_t i = 0; i < layer->tops.size(); i++)
+            {
+                int top_blob_index = layer->tops[i];
+                blob_mats_batch[top_blob_index][b] = sample_mats[top_blob_index];
+                sample_mats[top_blob_index].release();
+            }
+
+            for (size_t i = 0; i < layer->bottoms.size(); i++)
+            {
+                int bottom_blob_index = layer->bottoms[i];
+                sample_mats[bottom_blob_index].release();
+            }
+        }
+
+        if (opt.lightmode)
+        {
+            // delete after taken in light mode
+            for (size_t i = 0; i < layer->bottoms.size(); i++)
+            {
+                int bottom_blob_index = layer->bottoms[i];
+                blob_mats_batch[bottom_blob_index].clear();
+            }
+        }
+    }
+
+    return 0;
+}
+
+static Mat blob_shape(const Mat& m)
+{
+    // header only, so the profile never keeps blob memory alive
+    Mat shape;
+    shape.dims = m.dims;
+    shape.w = m.w;
+    shape.h = m.h;
+    shape.c = m.c;
+    shape.elempack = m.elempack;
+    shape.elemsize = m.elemsize;
+    return shape;
+}
+
+static size_t blob_bytes_allocated(const Mat& top_blob, const std::vector<const void*>& bottom_datas)
+{
+    // inplace forward hands the bottom data over as top
+    for (size_t i = 0; i < bottom_datas.size(); i++)
+    {
+        if (top_blob.data == bottom_datas[i])
+            return 0;
+    }
+
+    return top_blob.total() * top_blob.elemsize;
+}
+
+static void layer_profile_begin(LayerProfile& profile, int layer_index, const Layer* layer, const Option& opt, int worker_id)
+{
+    profile.layer_index = layer_index;
+    profile.typeindex = layer->typeindex;
+#if NCNN_STRING
+    profile.type = layer->type;
+    profile.name = layer->name;
+#endif // NCNN_STRING
+    profile.num_threads = opt.num_threads;
+    profile.worker_id = worker_id;
+}
+
+int NetPrivate::do_forward_layer_profiled(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, LayerProfiler* profiler, int worker_id) const
+{
+    const Layer* layer = layers[layer_index];
+
+    LayerProfile profile;
+    layer_profile_begin(profile, layer_index, layer, opt, worker_id);
+
+    std::vector<const void*> bottom_datas(layer->bottoms.size());
+    profile.bottom_shapes.resize(layer->bottoms.size());
+    for (size_t i = 0; i < layer->bottoms.size(); i++)
+    {
+        const Mat& bottom_blob = blob_mats[layer->bottoms[i]];
+        bottom_datas[i] = bottom_blob.data;
+        profile.bottom_shapes[i] = blob_shape(bottom_blob);
+    }
+
+    profile.start = get_current_time();
+    int ret = do_forward_layer(layer, blob_mats, opt);
+    profile.end = get_current_time();
+
+    profile.top_shapes.resize(layer->tops.size());
+    for (size_t i = 0; i < layer->tops.size(); i++)
+    {
+        const Mat& top_blob = blob_mats[layer->tops[i]];
+        profile.top_shapes[i] = blob_shape(top_blob);
+        profile.bytes_allocated += blob_bytes_allocated(top_blob, bottom_datas);
+    }
+
+    profiler->record(profile);
+
+    return ret;
+}
+
+int NetPrivate::do_forward_layer_batch_profiled(int layer_index, std::vector<std::vector<Mat> >& blob_mats_batch, std::vector<Mat>& sample_mats, const Option& opt, LayerProfiler* profiler) const
+{
+    const Layer* layer = layers[layer_index];
+
+    LayerProfile profile;
+    layer_profile_begin(profile, layer_index, layer, opt, 0);
+
+    // shapes are the per-sample ones, bytes are summed over the batch
+    std::vector<const void*> bottom_datas;
+    profile.bottom_shapes.resize(layer->bottoms.size());
+    for (size_t i = 0; i < layer->bottoms.size(); i++)
+    {
+        const std::vector<Mat>& bottom_batch = blob_mats_batch[layer->bottoms[i]];
+        for (size_t b = 0; b < bottom_batch.size(); b++)
+        {
+            bottom_datas.push_back(bottom_batch[b].data);
+        }
+        if (!bottom_batch.empty())
+            profile.bottom_shapes[i] = blob_shape(bottom_batch[0]);
+    }
+
+    profile.start = get_current_time();
+    int ret = do_forward_layer_batch(layer, blob_mats_batch, sample_mats, opt);
+    profile.end = get_current_time();
+
+    profile.top_shapes.resize(layer->tops.size());
+    for (size_t i = 0; i < layer->tops.size(); i++)
+    {
+        const std::vector<Mat>& top_batch = blob_mats_batch[layer->tops[i]];
+        for (size_t b = 0; b < top_batch.size(); b++)
+        {
+            profile.bytes_allocated += blob_bytes_allocated(top_batch[b], bottom_datas);
+        }
+        if (!top_batch.empty())
+            profile.top_shapes[i] = blob_shape(top_batch[0]);
+    }
+
+    profiler->record(profile);
+
+    return ret;
+}
+
+#if NCNN_VULKAN
+int NetPrivate::do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const
+{
+    if (layer->one_blob_only)
+    {
+        // load bottom blob
+        int bottom_blob_index = layer->bottoms[0];
+        int top_blob_index = layer->tops[0];
+
+        VkMat& bottom_blob_ref = blob_mats_gpu[bottom_blob_index];
+        VkMat bottom_blob;
+
+        if (opt.lightmode)
+        {
+            // deep copy for inplace forward if data is shared or external
+            if (layer->support_inplace && (!bottom_blob_ref.refcount || *bottom_blob_ref.refcount != 1))
+            {
+                cmd.record_clone(bottom_blob_ref, bottom_blob, opt);
+                //                     NCNN_LOGE("clone %p[+%lu] %p[+%lu]", bottom_blob_ref.buffer(), bottom_blob_ref.buffer_offset(), bottom_blob.buffer(), bottom_blob.buffer_offset());
+            }
+        }
+        if (bottom_blob.dims == 0)
+        {
+            bottom_blob = bottom_blob_ref;
+        }
+
+        // forward
+        if (opt.lightmode && layer->support_inplace)
+        {
+            VkMat& bottom_top_blob = bottom_blob;
+            int ret = layer->forward_inplace(bottom_top_blob, cmd, opt);
+            if (ret != 0)
+                return ret;
+
+            // store top blob
+            blob_mats_gpu[top_blob_index] = bottom_top_blob;
+        }
+        else
+        {
+            VkMat top_blob;
+            int ret = layer->forward(bottom_blob, top_blob, cmd, opt);
+            if (ret != 0)
+                return ret;
+
+            // store top blob
+            blob_mats_gpu[top_blob_index] = top_blob;
+        }
+
+        if (opt.lightmode)
+        {
+            // delete after taken in light mode
+            blob_mats_gpu[bottom_blob_index].release();
+        }
+    }
+    else
+    {
+        // load bottom blobs
+        std::vector<VkMat> bottom_blobs(layer->bottoms.size());
+        for (size_t i = 0; i < layer->bottoms.size(); i++)
+        {
+            int bottom_blob_index = layer->bottoms[i];
 
             VkMat& bottom_blob_ref = blob_mats_gpu[bottom_blob_index];
             bottom_blobs[i].release();
 
             if (opt.lightmode)
             {
-                // deep copy for inplace forward if data is shared
-                if (layer->support_inplace && *bottom_blob_ref.refcount != 1)
+                // deep copy for inplace forward if data is shared or external
+                if (layer->support_inplace && (!bottom_blob_ref.refcount || *bottom_blob_ref.refcount != 1))
                 {
                     cmd.record_clone(bottom_blob_ref, bottom_blobs[i], opt);
                     //                         NCNN_LOGE("clone %p[+%lu] %p[+%lu]", bottom_blob_ref.buffer(), bottom_blob_ref.buffer_offset(), bottom_blobs[i].buffer(), bottom_blobs[i].buffer_offset());
@@ -1126,8 +1827,8 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<VkImageMat>& bl
 
         if (opt.lightmode)
         {
-            // deep copy for inplace forward if data is shared
-            if (layer->support_inplace && *bottom_blob_ref.refcount != 1)
+            // deep copy for inplace forward if data is shared or external
+            if (layer->support_inplace && (!bottom_blob_ref.refcount || *bottom_blob_ref.refcount != 1))
             {
                 cmd.record_clone(bottom_blob_ref, bottom_blob, opt);
                 //                         NCNN_LOGE("clone %p[+%lu] %p[+%lu]", bottom_blob_ref.buffer(), bottom_blob_ref.buffer_offset(), bottom_blob.buffer(), bottom_blob.buffer_offset());
@@ -1178,8 +1879,8 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<VkImageMat>& bl
 
             if (opt.lightmode)
             {
-                // deep copy for inplace forward if data is shared
-                if (layer->support_inplace && *bottom_blob_ref.refcount != 1)
+                // deep copy for inplace forward if data is shared or external
+                if (layer->support_inplace && (!bottom_blob_ref.refcount || *bottom_blob_ref.refcount != 1))
                 {
                     cmd.record_clone(bottom_blob_ref, bottom_blobs[i], opt);
                     //                             NCNN_LOGE("clone %p[+%lu] %p[+%lu]", bottom_blob_ref.buffer(), bottom_blob_ref.buffer_offset(), bottom_blobs[i].buffer(), bottom_blobs[i].buffer_offset());
@@ -1239,6 +1940,74 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<VkImageMat>& bl
 }
 #endif // NCNN_VULKAN
 
+ShapePlan* NetPrivate::acquire_shape_plan(int blob_index, const std::vector<Mat>& blob_mats, bool& recording) const
+{
+    recording = false;
+
+    std::vector<int> key;
+    key.push_back(blob_index);
+    for (size_t i = 0; i < blob_mats.size(); i++)
+    {
+        const Mat& m = blob_mats[i];
+        if (m.dims == 0)
+            continue;
+
+        key.push_back((int)i);
+        key.push_back(m.dims);
+        key.push_back(m.w);
+        key.push_back(m.h);
+        key.push_back(m.c);
+        key.push_back(m.elempack);
+        key.push_back((int)m.elemsize);
+    }
+
+    MutexLockGuard guard(shape_plan_lock);
+
+    for (size_t i = 0; i < shape_plans.size(); i++)
+    {
+        ShapePlan* plan = shape_plans[i];
+        if (plan->key != key)
+            continue;
+
+        // the arenas follow one allocation sequence at a time while recording
+        return plan->state == 1 ? plan : 0;
+    }
+
+    if ((int)shape_plans.size() >= shape_plan_capacity)
+        return 0;
+
+    ShapePlan* plan = new ShapePlan;
+    plan->key = key;
+    plan->state = 0;
+    plan->blob_allocator.begin_plan();
+    plan->workspace_allocator.begin_plan();
+    shape_plans.push_back(plan);
+
+    recording = true;
+    return plan;
+}
+
+void NetPrivate::end_shape_plan(ShapePlan* plan) const
+{
+    plan->blob_allocator.end_plan();
+    plan->workspace_allocator.end_plan();
+
+    MutexLockGuard guard(shape_plan_lock);
+
+    plan->state = 1;
+}
+
+void NetPrivate::clear_shape_plans()
+{
+    MutexLockGuard guard(shape_plan_lock);
+
+    for (size_t i = 0; i < shape_plans.size(); i++)
+    {
+        delete shape_plans[i];
+    }
+    shape_plans.clear();
+}
+
 void NetPrivate::update_input_output_indexes()
 {
     input_blob_indexes.clear();
@@ -1779,6 +2548,100 @@ int Net::load_param_bin(const DataReader& dr)
     return 0;
 }
 
+#if NCNN_STDIO
+// forwards another reader and hashes every byte passing through
+// the hash does not depend on how the data is split into reads
+class DataReaderWithHash : public DataReader
+{
+public:
+    explicit DataReaderWithHash(const DataReader& _dr)
+        : dr(_dr)
+    {
+        hash = 14695981039346656037ULL;
+        tail = 0;
+        tail_size = 0;
+        total_size = 0;
+    }
+
+#if NCNN_STRING
+    virtual int scan(const char* format, void* p) const
+    {
+        return dr.scan(format, p);
+    }
+#endif // NCNN_STRING
+
+    virtual size_t read(void* buf, size_t size) const
+    {
+        size_t nread = dr.read(buf, size);
+        update((const unsigned char*)buf, nread);
+        return nread;
+    }
+
+    virtual size_t reference(size_t size, const void** buf) const
+    {
+        size_t nref = dr.reference(size, buf);
+        if (nref)
+            update((const unsigned char*)*buf, nref);
+        return nref;
+    }
+
+    uint64_t digest() const
+    {
+        return mix(mix(hash, tail), total_size);
+    }
+
+protected:
+    static uint64_t mix(uint64_t h, uint64_t v)
+    {
+        h ^= v;
+        h *= 0x100000001b3ULL;
+        return h ^ (h >> 32);
+    }
+
+    void update(const unsigned char* p, size_t size) const
+    {
+        total_size += size;
+
+        // complete the pending word
+        while (size && tail_size)
+        {
+            tail |= (uint64_t)*p++ << (tail_size * 8);
+            size--;
+            if (++tail_size == 8)
+            {
+                hash = mix(hash, tail);
+                tail = 0;
+                tail_size = 0;
+            }
+        }
+
+        for (; size >= 8; size -= 8)
+        {
+            uint64_t v = 0;
+            for (int i = 0; i < 8; i++)
+            {
+                v |= (uint64_t)p[i] << (i * 8);
+            }
+            hash = mix(hash, v);
+            p += 8;
+        }
+
+        for (; size; size--)
+        {
+            tail |= (uint64_t)*p++ << (tail_size * 8);
+            tail_size++;
+        }
+    }
+
+protected:
+    const DataReader& dr;
+    mutable uint64_t hash;
+    mutable uint64_t tail;
+    mutable int tail_size;
+    mutable uint64_t total_size;
+};
+#endif // NCNN_STDIO
+
 int Net::load_model(const DataReader& dr)
 {
     if (d->layers.empty())
@@ -1789,10 +2652,27 @@ int Net::load_model(const DataReader& dr)
 
     int layer_count = (int)d->layers.size();
 
+    // place the weights first touched by the loading threads
+    const int old_numa_memory_policy = get_numa_memory_policy();
+    if (opt.numa_node >= 0)
+    {
+        set_numa_memory_policy(opt.numa_node);
+    }
+    else if (opt.use_numa_interleave_weights)
+    {
+        set_numa_memory_policy(-2);
+    }
+
     // load file
     int ret = 0;
 
+#if NCNN_STDIO
+    // the hash ties a prepacked file to the weight data it was transformed from
+    DataReaderWithHash hdr(dr);
+    ModelBinFromDataReader mb(hdr);
+#else
     ModelBinFromDataReader mb(dr);
+#endif // NCNN_STDIO
     for (int i = 0; i < layer_count; i++)
     {
         Layer* layer = d->layers[i];
@@ -1824,6 +2704,15 @@ int Net::load_model(const DataReader& dr)
         }
     }
 
+#if NCNN_STDIO
+    d->model_hash = hdr.digest();
+    if (!d->prepacked_weights.empty() && d->prepacked_hash != d->model_hash)
+    {
+        NCNN_LOGE("prepacked file does not match the model weights, transform in create_pipeline");
+        d->prepacked_weights.clear();
+    }
+#endif // NCNN_STDIO
+
 #if NCNN_VULKAN
     if (opt.use_vulkan_compute)
     {
@@ -1848,6 +2737,17 @@ int Net::load_model(const DataReader& dr)
         }
 #endif // NCNN_VULKAN
 
+#if NCNN_STDIO
+        if (i < (int)d->prepacked_weights.size() && !d->prepacked_weights[i].empty())
+        {
+            int pret = layer->set_prepacked(d->prepacked_weights[i]);
+            if (pret != 0)
+            {
+                NCNN_LOGE("layer set_prepacked %d failed, transform in create_pipeline", i);
+            }
+        }
+#endif // NCNN_STDIO
+
         int cret = layer->create_pipeline(opt1);
         if (cret != 0)
         {
@@ -1861,6 +2761,13 @@ int Net::load_model(const DataReader& dr)
         }
     }
 
+#if NCNN_STDIO
+    // layers hold the referenced weight data from here
+    d->prepacked_weights.clear();
+#endif // NCNN_STDIO
+
+    set_numa_memory_policy(old_numa_memory_policy);
+
     if (opt.use_local_pool_allocator)
     {
         if (opt.blob_allocator == 0)
@@ -1949,6 +2856,23 @@ int Net::load_model(FILE* fp)
 
 int Net::load_model(const char* modelpath)
 {
+    if (opt.use_mmap_model)
+    {
+        DataReaderFromMmap* dr = new DataReaderFromMmap(modelpath);
+        if (!dr->empty())
+        {
+            int ret = load_model(*dr);
+
+            // drop the previous mapping only after layers took the new weights
+            delete d->model_mmap;
+            d->model_mmap = dr;
+            return ret;
+        }
+
+        NCNN_LOGE("mmap %s failed, fallback to fread", modelpath);
+        delete dr;
+    }
+
     FILE* fp = fopen(modelpath, "rb");
     if (!fp)
     {
@@ -1960,17 +2884,303 @@ int Net::load_model(const char* modelpath)
     fclose(fp);
     return ret;
 }
-#endif // NCNN_STDIO
 
-int Net::load_param(const unsigned char* _mem)
-{
-    const unsigned char* mem = _mem;
-    DataReaderFromMemory dr(mem);
-    load_param_bin(dr);
-    return static_cast<int>(mem - _mem);
-}
+// prepacked file layout
+//   header    magic version isa sub_isa option_flags layer_count record_count model_hash_lo model_hash_hi
+//   record    layer_index typeindex weight_count
+//   weight    dims w h c elemsize elempack cstep, data aligned to NCNN_MALLOC_ALIGN
+#define NCNN_PREPACKED_MAGIC   0x4b50434e
+#define NCNN_PREPACKED_VERSION 6
 
-int Net::load_model(const unsigned char* _mem)
+static int get_prepacked_isa()
+{
+    // follow the layer variant selection in create_layer
+#if NCNN_RUNTIME_CPU && NCNN_AVX512
+    if (cpu_support_x86_avx512())
+        return 3;
+#endif
+#if NCNN_RUNTIME_CPU && NCNN_AVX2
+    if (cpu_support_x86_avx2())
+        return 2;
+#endif
+#if NCNN_RUNTIME_CPU && NCNN_AVX
+    if (cpu_support_x86_avx())
+        return 1;
+#endif
+#if __AVX512F__
+    return 3;
+#elif __AVX2__
+    return 2;
+#elif __AVX__
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+static int get_prepacked_sub_isa()
+{
+    // extensions that switch int8 and bf16 kernels to other weight layouts
+    int flags = 0;
+    if (cpu_support_x86_avx512_vnni()) flags |= 1 << 0;
+    if (cpu_support_x86_avx_vnni()) flags |= 1 << 1;
+    if (cpu_support_x86_avx512_bf16()) flags |= 1 << 2;
+    return flags;
+}
+
+static int get_prepacked_option_flags(const Option& opt)
+{
+    int flags = 0;
+    if (opt.use_winograd_convolution) flags |= 1 << 0;
+    if (opt.use_sgemm_convolution) flags |= 1 << 1;
+    if (opt.use_int8_inference) flags |= 1 << 2;
+    if (opt.use_packing_layout) flags |= 1 << 3;
+    if (opt.use_fp16_packed) flags |= 1 << 4;
+    if (opt.use_fp16_storage) flags |= 1 << 5;
+    if (opt.use_fp16_arithmetic) flags |= 1 << 6;
+    if (opt.use_int8_packed) flags |= 1 << 7;
+    if (opt.use_int8_storage) flags |= 1 << 8;
+    if (opt.use_int8_arithmetic) flags |= 1 << 9;
+    if (opt.use_bf16_storage) flags |= 1 << 10;
+    if (opt.use_weight_fp16_storage) flags |= 1 << 11;
+    return flags;
+}
+
+int Net::save_prepacked(const char* path) const
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        NCNN_LOGE("fopen %s failed", path);
+        return -1;
+    }
+
+    const int layer_count = (int)d->layers.size();
+
+    std::vector<std::vector<Mat> > layer_weights(layer_count);
+    int record_count = 0;
+    for (int i = 0; i < layer_count; i++)
+    {
+        if (d->layers[i]->get_prepacked(layer_weights[i]) == 0)
+            record_count++;
+        else
+            layer_weights[i].clear();
+    }
+
+    int header[9] = {NCNN_PREPACKED_MAGIC, NCNN_PREPACKED_VERSION, get_prepacked_isa(), get_prepacked_sub_isa(), get_prepacked_option_flags(opt), layer_count, record_count, (int)(uint32_t)d->model_hash, (int)(uint32_t)(d->model_hash >> 32)};
+    size_t nwrite = fwrite(header, sizeof(int), 9, fp);
+    size_t offset = sizeof(header);
+
+    static const unsigned char zeros[NCNN_MALLOC_ALIGN] = {0};
+
+    for (int i = 0; i < layer_count && nwrite; i++)
+    {
+        const std::vector<Mat>& weights = layer_weights[i];
+        if (weights.empty())
+            continue;
+
+        int record[3] = {i, d->layers[i]->typeindex, (int)weights.size()};
+        nwrite = fwrite(record, sizeof(int), 3, fp);
+        offset += sizeof(record);
+
+        for (size_t j = 0; j < weights.size() && nwrite; j++)
+        {
+            const Mat& m = weights[j];
+
+            int shape[7] = {m.dims, m.w, m.h, m.c, (int)m.elemsize, m.elempack, (int)m.cstep};
+            nwrite = fwrite(shape, sizeof(int), 7, fp);
+            offset += sizeof(shape);
+
+            if (m.dims == 0)
+                continue;
+
+            // align data for mapping
+            size_t padding = alignSize(offset, NCNN_MALLOC_ALIGN) - offset;
+            if (padding)
+            {
+                fwrite(zeros, 1, padding, fp);
+                offset += padding;
+            }
+
+            size_t size = m.total() * m.elemsize;
+            nwrite = fwrite(m.data, 1, size, fp);
+            offset += size;
+        }
+    }
+
+    fclose(fp);
+
+    if (!nwrite)
+    {
+        NCNN_LOGE("fwrite %s failed", path);
+        return -1;
+    }
+
+    return 0;
+}
+
+int Net::load_prepacked(const char* path)
+{
+    if (d->layers.empty())
+    {
+        NCNN_LOGE("network graph not ready");
+        return -1;
+    }
+
+    DataReaderFromMmap* mmap_dr = new DataReaderFromMmap(path);
+    if (!mmap_dr->empty())
+    {
+        int ret = d->load_prepacked(*mmap_dr);
+        if (ret != 0)
+        {
+            delete mmap_dr;
+            return ret;
+        }
+
+        delete d->prepacked_mmap;
+        d->prepacked_mmap = mmap_dr;
+        return 0;
+    }
+
+    delete mmap_dr;
+
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+    {
+        NCNN_LOGE("fopen %s failed", path);
+        return -1;
+    }
+
+    DataReaderFromStdio dr(fp);
+    int ret = d->load_prepacked(dr);
+    fclose(fp);
+    return ret;
+}
+
+int NetPrivate::load_prepacked(const DataReader& dr)
+{
+    prepacked_weights.clear();
+
+    int header[9];
+    if (dr.read(header, sizeof(header)) != sizeof(header) || header[0] != NCNN_PREPACKED_MAGIC || header[1] != NCNN_PREPACKED_VERSION)
+    {
+        NCNN_LOGE("invalid prepacked file");
+        return -1;
+    }
+
+    const int layer_count = (int)layers.size();
+    if (header[2] != get_prepacked_isa() || header[3] != get_prepacked_sub_isa() || header[4] != get_prepacked_option_flags(opt) || header[5] != layer_count)
+    {
+        NCNN_LOGE("prepacked file does not match isa %d sub isa %x option flags %x layer count %d", get_prepacked_isa(), get_prepacked_sub_isa(), get_prepacked_option_flags(opt), layer_count);
+        return -1;
+    }
+
+    std::vector<std::vector<Mat> > layer_weights(layer_count);
+
+    const int record_count = header[6];
+    size_t offset = sizeof(header);
+
+    for (int i = 0; i < record_count; i++)
+    {
+        int record[3];
+        if (dr.read(record, sizeof(record)) != sizeof(record))
+        {
+            NCNN_LOGE("prepacked record %d read failed", i);
+            return -1;
+        }
+        offset += sizeof(record);
+
+        const int layer_index = record[0];
+        if (layer_index < 0 || layer_index >= layer_count || layers[layer_index]->typeindex != record[1])
+        {
+            NCNN_LOGE("prepacked record %d does not match layer %d", i, layer_index);
+            return -1;
+        }
+
+        std::vector<Mat>& weights = layer_weights[layer_index];
+        weights.resize(record[2]);
+
+        for (int j = 0; j < record[2]; j++)
+        {
+            int shape[7];
+            if (dr.read(shape, sizeof(shape)) != sizeof(shape))
+            {
+                NCNN_LOGE("prepacked record %d read failed", i);
+                return -1;
+            }
+            offset += sizeof(shape);
+
+            const int dims = shape[0];
+            if (dims == 0)
+                continue;
+
+            const int w = shape[1];
+            const int h = shape[2];
+            const int c = shape[3];
+            const size_t elemsize = (size_t)shape[4];
+            const int elempack = shape[5];
+            const size_t cstep = (size_t)shape[6];
+
+            unsigned char padding[NCNN_MALLOC_ALIGN];
+            size_t padding_size = alignSize(offset, NCNN_MALLOC_ALIGN) - offset;
+            if (padding_size && dr.read(padding, padding_size) != padding_size)
+            {
+                NCNN_LOGE("prepacked record %d read failed", i);
+                return -1;
+            }
+            offset += padding_size;
+
+            const size_t size = cstep * c * elemsize;
+
+            Mat& m = weights[j];
+
+            // try reference data
+            const void* refbuf = 0;
+            if (dr.reference(size, &refbuf) == size)
+            {
+                if (dims == 1) m = Mat(w, (void*)refbuf, elemsize, elempack);
+                if (dims == 2) m = Mat(w, h, (void*)refbuf, elemsize, elempack);
+                if (dims == 3) m = Mat(w, h, c, (void*)refbuf, elemsize, elempack);
+            }
+            else
+            {
+                if (dims == 1) m.create(w, elemsize, elempack);
+                if (dims == 2) m.create(w, h, elemsize, elempack);
+                if (dims == 3) m.create(w, h, c, elemsize, elempack);
+                if (m.empty() || dr.read(m.data, size) != size)
+                {
+                    NCNN_LOGE("prepacked record %d read failed", i);
+                    return -1;
+                }
+            }
+            offset += size;
+
+            if (m.cstep != cstep)
+            {
+                NCNN_LOGE("prepacked record %d has unexpected layout", i);
+                return -1;
+            }
+        }
+    }
+
+    prepacked_weights = layer_weights;
+
+    // checked against the weight data in load_model
+    prepacked_hash = (uint64_t)(uint32_t)header[7] | ((uint64_t)(uint32_t)header[8] << 32);
+
+    return 0;
+}
+#endif // NCNN_STDIO
+
+int Net::load_param(const unsigned char* _mem)
+{
+    const unsigned char* mem = _mem;
+    DataReaderFromMemory dr(mem);
+    load_param_bin(dr);
+    return static_cast<int>(mem - _mem);
+}
+
+int Net::load_model(const unsigned char* _mem)
 {
     const unsigned char* mem = _mem;
     DataReaderFromMemory dr(mem);
@@ -2083,6 +3293,8 @@ void Net::clear()
     }
     d->layers.clear();
 
+    d->clear_shape_plans();
+
     if (d->local_blob_allocator)
     {
         delete d->local_blob_allocator;
@@ -2094,6 +3306,20 @@ void Net::clear()
         d->local_workspace_allocator = 0;
     }
 
+#if NCNN_STDIO
+    if (d->model_mmap)
+    {
+        delete d->model_mmap;
+        d->model_mmap = 0;
+    }
+    if (d->prepacked_mmap)
+    {
+        delete d->prepacked_mmap;
+        d->prepacked_mmap = 0;
+    }
+    d->prepacked_weights.clear();
+#endif // NCNN_STDIO
+
 #if NCNN_VULKAN
     if (d->weight_vkallocator)
     {
@@ -2119,6 +3345,23 @@ Extractor Net::create_extractor() const
     return Extractor(this, d->blobs.size());
 }
 
+void Net::set_plan_cache_capacity(int capacity)
+{
+    d->shape_plan_capacity = capacity;
+}
+
+void Net::clear_plan_cache()
+{
+    d->clear_shape_plans();
+}
+
+int Net::plan_cache_count() const
+{
+    MutexLockGuard guard(d->shape_plan_lock);
+
+    return (int)d->shape_plans.size();
+}
+
 const std::vector<int>& Net::input_indexes() const
 {
     return d->input_blob_indexes;
@@ -2246,6 +3489,80 @@ Layer* Net::create_custom_layer(int index)
     return layer;
 }
 
+// numa node the calling thread is bound to, stored with offset 1 so that the unset value is -1
+static ThreadLocalStorage tls_bound_numa_node;
+
+static void bind_numa_node(Option& opt)
+{
+    const CpuSet& thread_affinity_mask = get_numa_node_affinity_mask(opt.numa_node);
+
+    // memory-only nodes keep the threads where they are
+    const int num_cpus = thread_affinity_mask.num_enabled();
+    if (num_cpus > 0)
+    {
+        opt.num_threads = std::min(opt.num_threads, num_cpus);
+    }
+
+    // bind once per thread, the binding stays for the following extracts
+    const int bound_numa_node = (int)reinterpret_cast<size_t>(tls_bound_numa_node.get()) - 1;
+    if (bound_numa_node == opt.numa_node)
+        return;
+
+    if (num_cpus > 0)
+    {
+        set_cpu_thread_affinity(thread_affinity_mask);
+    }
+
+    set_numa_memory_policy(opt.numa_node);
+
+    tls_bound_numa_node.set(reinterpret_cast<void*>((size_t)(opt.numa_node + 1)));
+}
+
+static void convert_extract_layout(Mat& feat, int type, const Option& opt)
+{
+    if (opt.use_packing_layout && (type == 0) && feat.elempack != 1)
+    {
+        Mat bottom_blob_unpacked;
+        convert_packing(feat, bottom_blob_unpacked, 1, opt);
+        feat = bottom_blob_unpacked;
+    }
+
+    // clang-format off
+    // *INDENT-OFF*
+#if NCNN_ARM82
+    if (opt.use_fp16_storage && cpu_support_arm_asimdhp() && (type == 0))
+    {
+        if (feat.elembits() == 16)
+        {
+            Mat feat_fp32;
+            cast_float16_to_float32(feat, feat_fp32, opt);
+            feat = feat_fp32;
+        }
+    }
+    else
+#endif // NCNN_ARM82
+#if NCNN_BF16
+    if (opt.use_bf16_storage && (type == 0))
+    {
+        if (feat.elembits() == 16)
+        {
+            Mat feat_fp32;
+            cast_bfloat16_to_float32(feat, feat_fp32, opt);
+            feat = feat_fp32;
+        }
+    }
+    else
+#endif // NCNN_BF16
+    if (feat.elembits() == 8 && (type == 0))
+    {
+        Mat feat_fp32;
+        cast_int8_to_float32(feat, feat_fp32, opt);
+        feat = feat_fp32;
+    }
+    // *INDENT-ON*
+    // clang-format on
+}
+
 class ExtractorPrivate
 {
 public:
@@ -2255,8 +3572,12 @@ public:
     }
     const Net* net;
     std::vector<Mat> blob_mats;
+    std::vector<std::vector<Mat> > blob_mats_batch;
     Option opt;
 
+    bool profiling;
+    LayerProfiler profiler;
+
 #if NCNN_VULKAN
     VkAllocator* local_blob_vkallocator;
     VkAllocator* local_staging_vkallocator;
@@ -2270,7 +3591,9 @@ Extractor::Extractor(const Net* _net, size_t blob_count)
     : d(new ExtractorPrivate(_net))
 {
     d->blob_mats.resize(blob_count);
+    d->blob_mats_batch.resize(blob_count);
     d->opt = d->net->opt;
+    d->profiling = false;
 
 #if NCNN_VULKAN
     if (d->net->opt.use_vulkan_compute)
@@ -2296,7 +3619,10 @@ Extractor::Extractor(const Extractor& rhs)
 {
     d->net = rhs.d->net;
     d->blob_mats = rhs.d->blob_mats;
+    d->blob_mats_batch = rhs.d->blob_mats_batch;
     d->opt = rhs.d->opt;
+    d->profiling = rhs.d->profiling;
+    d->profiler.profiles = rhs.d->profiler.profiles;
 
 #if NCNN_VULKAN
     d->local_blob_vkallocator = 0;
@@ -2314,7 +3640,10 @@ Extractor& Extractor::operator=(const Extractor& rhs)
 
     d->net = rhs.d->net;
     d->blob_mats = rhs.d->blob_mats;
+    d->blob_mats_batch = rhs.d->blob_mats_batch;
     d->opt = rhs.d->opt;
+    d->profiling = rhs.d->profiling;
+    d->profiler.profiles = rhs.d->profiler.profiles;
 
 #if NCNN_VULKAN
     d->local_blob_vkallocator = 0;
@@ -2330,6 +3659,7 @@ Extractor& Extractor::operator=(const Extractor& rhs)
 void Extractor::clear()
 {
     d->blob_mats.clear();
+    d->blob_mats_batch.clear();
 
 #if NCNN_VULKAN
     if (d->opt.use_vulkan_compute)
@@ -2349,6 +3679,29 @@ void Extractor::clear()
 #endif // NCNN_VULKAN
 }
 
+void Extractor::reset()
+{
+    for (size_t i = 0; i < d->blob_mats.size(); i++)
+    {
+        d->blob_mats[i].release();
+    }
+    for (size_t i = 0; i < d->blob_mats_batch.size(); i++)
+    {
+        d->blob_mats_batch[i].clear();
+    }
+
+#if NCNN_VULKAN
+    for (size_t i = 0; i < d->blob_mats_gpu.size(); i++)
+    {
+        d->blob_mats_gpu[i].release();
+    }
+    for (size_t i = 0; i < d->blob_mats_gpu_image.size(); i++)
+    {
+        d->blob_mats_gpu_image[i].release();
+    }
+#endif // NCNN_VULKAN
+}
+
 void Extractor::set_light_mode(bool enable)
 {
     d->opt.lightmode = enable;
@@ -2359,6 +3712,11 @@ void Extractor::set_num_threads(int num_threads)
     d->opt.num_threads = num_threads;
 }
 
+void Extractor::set_numa_node(int numa_node)
+{
+    d->opt.numa_node = numa_node;
+}
+
 void Extractor::set_blob_allocator(Allocator* allocator)
 {
     d->opt.blob_allocator = allocator;
@@ -2369,6 +3727,28 @@ void Extractor::set_workspace_allocator(Allocator* allocator)
     d->opt.workspace_allocator = allocator;
 }
 
+void Extractor::set_profiling(bool enable)
+{
+    d->profiling = enable;
+
+    if (enable)
+    {
+        d->profiler.profiles.clear();
+    }
+}
+
+const std::vector<LayerProfile>& Extractor::layer_profiles() const
+{
+    return d->profiler.profiles;
+}
+
+#if NCNN_STDIO
+int Extractor::save_chrome_trace(const char* path) const
+{
+    return ncnn::save_chrome_trace(path, d->profiler.profiles);
+}
+#endif // NCNN_STDIO
+
 #if NCNN_VULKAN
 void Extractor::set_vulkan_compute(bool enable)
 {
@@ -2434,6 +3814,42 @@ int Extractor::extract(const char* blob_name, Mat& feat, int type)
 
     return extract(blob_index, feat, type);
 }
+
+int Extractor::input(const char* blob_name, const std::vector<Mat>& in_batch)
+{
+    int blob_index = d->net->find_blob_index_by_name(blob_name);
+    if (blob_index == -1)
+    {
+        NCNN_LOGE("Try");
+        const std::vector<const char*>& input_names = d->net->input_names();
+        for (size_t i = 0; i < input_names.size(); i++)
+        {
+            NCNN_LOGE("    ex.input(\"%s\", in%d);", input_names[i], (int)i);
+        }
+
+        return -1;
+    }
+
+    return input(blob_index, in_batch);
+}
+
+int Extractor::extract(const char* blob_name, std::vector<Mat>& feat_batch, int type)
+{
+    int blob_index = d->net->find_blob_index_by_name(blob_name);
+    if (blob_index == -1)
+    {
+        NCNN_LOGE("Try");
+        const std::vector<const char*>& output_names = d->net->output_names();
+        for (size_t i = 0; i < output_names.size(); i++)
+        {
+            NCNN_LOGE("    ex.extract(\"%s\", out%d);", output_names[i], (int)i);
+        }
+
+        return -1;
+    }
+
+    return extract(blob_index, feat_batch, type);
+}
 #endif // NCNN_STRING
 
 int Extractor::input(int blob_index, const Mat& in)
@@ -2459,10 +3875,24 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
 
     int ret = 0;
 
+    ShapePlan* plan = 0;
+
     if (d->blob_mats[blob_index].dims == 0)
     {
         int layer_index = d->net->blobs()[blob_index].producer;
 
+        // use the planned arenas of this input shape unless allocators are given
+        bool plan_recording = false;
+        if (d->opt.use_shape_plan_cache && !d->opt.use_vulkan_compute)
+        {
+            const bool local_blob_allocator = !d->opt.blob_allocator || d->opt.blob_allocator == d->net->d->local_blob_allocator;
+            const bool local_workspace_allocator = !d->opt.workspace_allocator || d->opt.workspace_allocator == d->net->d->local_workspace_allocator;
+            if (local_blob_allocator && local_workspace_allocator)
+            {
+                plan = d->net->d->acquire_shape_plan(blob_index, d->blob_mats, plan_recording);
+            }
+        }
+
         // use local allocator
         if (d->opt.use_local_pool_allocator)
         {
@@ -2476,6 +3906,27 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
             }
         }
 
+        Option opt = d->opt;
+        if (plan)
+        {
+            opt.blob_allocator = &plan->blob_allocator;
+            opt.workspace_allocator = &plan->workspace_allocator;
+        }
+
+        // run on the cores and memory of one numa node
+        if (opt.numa_node >= 0 && !opt.use_vulkan_compute)
+        {
+            bind_numa_node(opt);
+        }
+
+        // lease cores shared with the other extractors
+        std::vector<int> leased_cpus;
+        CpuSet unleased_affinity_mask;
+        if (opt.thread_pool && !opt.use_vulkan_compute)
+        {
+            opt.num_threads = opt.thread_pool->acquire(opt.num_threads, leased_cpus, unleased_affinity_mask);
+        }
+
 #if NCNN_VULKAN
         if (d->opt.use_vulkan_compute)
         {
@@ -2556,64 +4007,162 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
                 }
             }
         }
+        else if (d->opt.use_parallel_layer_forward)
+        {
+            ret = d->net->d->forward_layer_parallel(layer_index, d->blob_mats, opt, d->profiling ? &d->profiler : 0);
+        }
         else
         {
-            ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
+            ret = d->net->d->forward_layer(layer_index, d->blob_mats, opt, d->profiling ? &d->profiler : 0);
         }
 #else
-        ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
+        if (d->opt.use_parallel_layer_forward)
+        {
+            ret = d->net->d->forward_layer_parallel(layer_index, d->blob_mats, opt, d->profiling ? &d->profiler : 0);
+        }
+        else
+        {
+            ret = d->net->d->forward_layer(layer_index, d->blob_mats, opt, d->profiling ? &d->profiler : 0);
+        }
 #endif // NCNN_VULKAN
+
+        if (opt.thread_pool)
+        {
+            opt.thread_pool->release(leased_cpus, unleased_affinity_mask);
+        }
+
+        if (plan_recording)
+        {
+            d->net->d->end_shape_plan(plan);
+        }
     }
 
     feat = d->blob_mats[blob_index];
 
-    if (d->opt.use_packing_layout && (type == 0) && feat.elempack != 1)
+    convert_extract_layout(feat, type, d->opt);
+
+    if (d->opt.use_local_pool_allocator && feat.allocator == d->net->d->local_blob_allocator)
     {
-        Mat bottom_blob_unpacked;
-        convert_packing(feat, bottom_blob_unpacked, 1, d->opt);
-        feat = bottom_blob_unpacked;
+        // detach the returned mat from local pool allocator
+        // so we could destroy net instance much earlier
+        feat = feat.clone();
+    }
+    if (plan && feat.allocator == &plan->blob_allocator)
+    {
+        // detach the returned mat from the plan arena
+        // so the next inference of this shape gets the whole arena
+        feat = feat.clone();
     }
 
-    // clang-format off
-    // *INDENT-OFF*
-#if NCNN_ARM82
-    if (d->opt.use_fp16_storage && cpu_support_arm_asimdhp() && (type == 0))
+    set_kmp_blocktime(old_blocktime);
+    set_flush_denormals(old_flush_denormals);
+
+    return ret;
+}
+
+int Extractor::input(int blob_index, const std::vector<Mat>& in_batch)
+{
+    if (blob_index < 0 || blob_index >= (int)d->blob_mats_batch.size())
+        return -1;
+
+    if (in_batch.empty())
     {
-        if (feat.elembits() == 16)
-        {
-            Mat feat_fp32;
-            cast_float16_to_float32(feat, feat_fp32, d->opt);
-            feat = feat_fp32;
-        }
+        NCNN_LOGE("input batch is empty");
+        return -1;
     }
-    else
-#endif // NCNN_ARM82
-#if NCNN_BF16
-    if (d->opt.use_bf16_storage && (type == 0))
+
+    for (size_t i = 1; i < in_batch.size(); i++)
     {
-        if (feat.elembits() == 16)
+        const Mat& m0 = in_batch[0];
+        const Mat& m = in_batch[i];
+        if (m.dims != m0.dims || m.w != m0.w || m.h != m0.h || m.c != m0.c || m.elemsize != m0.elemsize || m.elempack != m0.elempack)
         {
-            Mat feat_fp32;
-            cast_bfloat16_to_float32(feat, feat_fp32, d->opt);
-            feat = feat_fp32;
+            NCNN_LOGE("input batch sample %d shape mismatch", (int)i);
+            return -1;
         }
     }
-    else
-#endif // NCNN_BF16
-    if (feat.elembits() == 8 && (type == 0))
+
+    d->blob_mats_batch[blob_index] = in_batch;
+
+    return 0;
+}
+
+int Extractor::extract(int blob_index, std::vector<Mat>& feat_batch, int type)
+{
+    if (blob_index < 0 || blob_index >= (int)d->blob_mats_batch.size())
+        return -1;
+
+#if NCNN_VULKAN
+    if (d->opt.use_vulkan_compute)
     {
-        Mat feat_fp32;
-        cast_int8_to_float32(feat, feat_fp32, d->opt);
-        feat = feat_fp32;
+        NCNN_LOGE("batch extract is not supported with vulkan compute");
+        return -1;
     }
-    // *INDENT-ON*
-    // clang-format on
+#endif // NCNN_VULKAN
 
-    if (d->opt.use_local_pool_allocator && feat.allocator == d->net->d->local_blob_allocator)
+    int old_blocktime = get_kmp_blocktime();
+    set_kmp_blocktime(d->opt.openmp_blocktime);
+
+    int old_flush_denormals = get_flush_denormals();
+    set_flush_denormals(d->opt.flush_denormals);
+
+    int ret = 0;
+
+    if (d->blob_mats_batch[blob_index].empty())
     {
-        // detach the returned mat from local pool allocator
-        // so we could destroy net instance much earlier
-        feat = feat.clone();
+        int layer_index = d->net->blobs()[blob_index].producer;
+
+        // use local allocator
+        if (d->opt.use_local_pool_allocator)
+        {
+            if (!d->opt.blob_allocator)
+            {
+                d->opt.blob_allocator = d->net->d->local_blob_allocator;
+            }
+            if (!d->opt.workspace_allocator)
+            {
+                d->opt.workspace_allocator = d->net->d->local_workspace_allocator;
+            }
+        }
+
+        // run on the cores and memory of one numa node
+        Option opt = d->opt;
+        if (opt.numa_node >= 0)
+        {
+            bind_numa_node(opt);
+        }
+
+        // lease cores shared with the other extractors
+        std::vector<int> leased_cpus;
+        CpuSet unleased_affinity_mask;
+        if (opt.thread_pool)
+        {
+            opt.num_threads = opt.thread_pool->acquire(opt.num_threads, leased_cpus, unleased_affinity_mask);
+        }
+
+        std::vector<Mat> sample_mats(d->blob_mats_batch.size());
+        ret = d->net->d->forward_layer_batch(layer_index, d->blob_mats_batch, sample_mats, opt, d->profiling ? &d->profiler : 0);
+
+        if (opt.thread_pool)
+        {
+            opt.thread_pool->release(leased_cpus, unleased_affinity_mask);
+        }
+    }
+
+    feat_batch = d->blob_mats_batch[blob_index];
+
+    for (size_t i = 0; i < feat_batch.size(); i++)
+    {
+        Mat& feat = feat_batch[i];
+
+        convert_extract_layout(feat, type, d->opt);
+
+        if (d->opt.use_local_pool_allocator && feat.allocator == d->net->d->local_blob_allocator)
+        {
+            // detach the returned mat from local pool allocator
+            // so we could destroy net instance much earlier
+            feat = feat.clone();
+        }
     }
 
     set_kmp_blocktime(old_blocktime);
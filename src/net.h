@@ -15,6 +15,7 @@
 #ifndef NCNN_NET_H
 #define NCNN_NET_H
 
+#include "benchmark.h"
 #include "blob.h"
 #include "layer.h"
 #include "mat.h"
@@ -92,6 +93,16 @@ public:
     // return 0 if success
     int load_model(FILE* fp);
     int load_model(const char* modelpath);
+
+    // save weight data transformed in create_pipeline, call after load_model
+    // the file only fits the same param, model weights, option flags and cpu isa
+    // return 0 if success
+    int save_prepacked(const char* path) const;
+
+    // reuse transformed weight data from save_prepacked, call between load_param and load_model
+    // the file is mapped when possible so that the weight data is referenced instead of copied
+    // return 0 if success
+    int load_prepacked(const char* path);
 #endif // NCNN_STDIO
 
     // load network structure from external memory
@@ -129,6 +140,16 @@ public:
     // construct an Extractor from network
     Extractor create_extractor() const;
 
+    // max input shapes planned by use_shape_plan_cache, further shapes run unplanned
+    // default is 16
+    void set_plan_cache_capacity(int capacity);
+
+    // drop all planned arenas, no extractor of this net must be alive
+    void clear_plan_cache();
+
+    // input shapes planned by use_shape_plan_cache
+    int plan_cache_count() const;
+
     // get input/output indexes/names
     const std::vector<int>& input_indexes() const;
     const std::vector<int>& output_indexes() const;
@@ -175,6 +196,10 @@ public:
     // clear blob mats and alloctors
     void clear();
 
+    // release all blob mats but keep the extractor ready for new input
+    // so one extractor can be recycled over many inferences
+    void reset();
+
     // enable light mode
     // intermediate blob will be recycled when enabled
     // enabled by default
@@ -185,12 +210,31 @@ public:
     // default count is system depended
     void set_num_threads(int num_threads);
 
+    // run on the cores and memory of one numa node, -1 to leave it to the system
+    // the calling thread and its openmp threads stay bound afterwards
+    // this will overwrite the numa_node of the net option
+    void set_numa_node(int numa_node);
+
     // set blob memory allocator
     void set_blob_allocator(Allocator* allocator);
 
     // set workspace memory allocator
     void set_workspace_allocator(Allocator* allocator);
 
+    // record per-layer time, blob shapes, allocated bytes and thread count on the following cpu forward
+    // enabling clears the previous records
+    // disabled by default, which costs one branch per layer
+    void set_profiling(bool enable);
+
+    // the records collected since profiling was enabled, in execution order
+    const std::vector<LayerProfile>& layer_profiles() const;
+
+#if NCNN_STDIO
+    // write the records as chrome trace event json
+    // return 0 if success
+    int save_chrome_trace(const char* path) const;
+#endif // NCNN_STDIO
+
 #if NCNN_VULKAN
     void set_vulkan_compute(bool enable);
 
@@ -211,6 +255,18 @@ public:
     // type = 0, default
     // type = 1, do not convert fp16/bf16 or / and packing
     int extract(const char* blob_name, Mat& feat, int type = 0);
+
+    // set batch input by blob name, all samples must have the same shape
+    // return 0 if success
+    int input(const char* blob_name, const std::vector<Mat>& in_batch);
+
+    // get batch result by blob name
+    // layers receive the whole batch, which lets gemm-like layers share one pass over the weights
+    // batch forward always runs on cpu
+    // return 0 if success
+    // type = 0, default
+    // type = 1, do not convert fp16/bf16 or / and packing
+    int extract(const char* blob_name, std::vector<Mat>& feat_batch, int type = 0);
 #endif // NCNN_STRING
 
     // set input by blob index
@@ -223,6 +279,16 @@ public:
     // type = 1, do not convert fp16/bf16 or / and packing
     int extract(int blob_index, Mat& feat, int type = 0);
 
+    // set batch input by blob index, all samples must have the same shape
+    // return 0 if success
+    int input(int blob_index, const std::vector<Mat>& in_batch);
+
+    // get batch result by blob index
+    // return 0 if success
+    // type = 0, default
+    // type = 1, do not convert fp16/bf16 or / and packing
+    int extract(int blob_index, std::vector<Mat>& feat_batch, int type = 0);
+
 #if NCNN_VULKAN
 #if NCNN_STRING
     // set input by blob name
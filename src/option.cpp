@@ -65,6 +65,15 @@ Option::Option()
     flush_denormals = 3;
 
     use_local_pool_allocator = true;
+
+    use_parallel_layer_forward = false;
+    use_mmap_model = false;
+    use_shape_plan_cache = false;
+    use_numa_interleave_weights = false;
+
+    thread_pool = 0;
+
+    numa_node = -1;
 }
 
 } // namespace ncnn
@@ -25,6 +25,7 @@ class PipelineCache;
 #endif // NCNN_VULKAN
 
 class Allocator;
+class ThreadPool;
 class NCNN_EXPORT Option
 {
 public:
@@ -131,10 +132,33 @@ public:
 
     bool use_local_pool_allocator;
 
-    bool use_reserved_1;
-    bool use_reserved_2;
-    bool use_reserved_3;
-    bool use_reserved_4;
+    // enable inter-layer parallel forward
+    // independent branches are scheduled onto concurrent workers
+    // and num_threads is split among the layers running at the same time
+    // blob_allocator and workspace_allocator must be thread-safe when enabled
+    // disabled by default
+    bool use_parallel_layer_forward;
+
+    // map the model file in Net::load_model(const char*)
+    // weights are referenced from the mapped pages instead of being copied
+    // so processes loading the same file share the physical memory
+    // the file must not be truncated or rewritten while the net is alive
+    // disabled by default
+    bool use_mmap_model;
+
+    // cache one planned blob and workspace arena per input shape
+    // the first extract of a new input shape records the allocation sequence
+    // later extracts of the same shape run without touching the heap
+    // only applies when no blob_allocator and workspace_allocator are set
+    // disabled by default
+    bool use_shape_plan_cache;
+
+    // spread the weight pages over all numa nodes in Net::load_model when numa_node is -1
+    // so that the threads on every node read the weights at the same average bandwidth
+    // weights of use_mmap_model stay in the page cache
+    // disabled by default
+    bool use_numa_interleave_weights;
+
     bool use_reserved_5;
     bool use_reserved_6;
     bool use_reserved_7;
@@ -142,6 +166,20 @@ public:
     bool use_reserved_9;
     bool use_reserved_10;
     bool use_reserved_11;
+
+    // cpu cores shared with the extractors of other nets
+    // each extract leases a part of the pool and num_threads becomes the upper limit
+    // default value is null that runs with num_threads as is
+    ThreadPool* thread_pool;
+
+    // numa node of the weights and the extractors, linux only
+    // Net::load_model places the weights on this node
+    // and extract runs on the cores and memory of this node
+    // load one net per node to replicate the weights
+    // the first extract on a thread binds the thread and its openmp threads to the node
+    // the binding stays after extract returns and is not applied again on that thread
+    // default value is -1 that leaves the placement to the system
+    int numa_node;
 };
 
 } // namespace ncnn
@@ -0,0 +1,610 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "sessionpool.h"
+
+#include "allocator.h"
+#include "benchmark.h"
+
+#include <algorithm>
+#include <limits.h>
+#include <list>
+#if NCNN_STRING
+#include <string>
+#endif // NCNN_STRING
+
+namespace ncnn {
+
+class SessionRequestPrivate
+{
+public:
+    // blob index -1 means looking up the name
+    std::vector<int> input_indexes;
+    std::vector<Mat> inputs;
+    std::vector<int> extract_indexes;
+    std::vector<int> extract_types;
+#if NCNN_STRING
+    std::vector<std::string> input_names;
+    std::vector<std::string> extract_names;
+#endif // NCNN_STRING
+
+    std::vector<Mat> outputs;
+
+    mutable Mutex lock;
+    ConditionVariable condition;
+
+    // 0 = idle, 1 = queued or running, 2 = done
+    int state;
+    int ret;
+
+    // timestamps in ms from get_current_time()
+    double submit_time;
+    double queue_delay;
+    int batch_size;
+};
+
+SessionRequest::SessionRequest()
+    : d(new SessionRequestPrivate)
+{
+    d->state = 0;
+    d->ret = 0;
+    d->submit_time = 0.0;
+    d->queue_delay = 0.0;
+    d->batch_size = 0;
+}
+
+SessionRequest::~SessionRequest()
+{
+    if (d->state == 1)
+    {
+        NCNN_LOGE("FATAL ERROR! session request destroyed in flight");
+    }
+
+    delete d;
+}
+
+SessionRequest::SessionRequest(const SessionRequest&)
+    : d(0)
+{
+}
+
+SessionRequest& SessionRequest::operator=(const SessionRequest&)
+{
+    return *this;
+}
+
+#if NCNN_STRING
+void SessionRequest::input(const char* blob_name, const Mat& in)
+{
+    d->input_indexes.push_back(-1);
+    d->input_names.push_back(blob_name);
+    d->inputs.push_back(in);
+}
+
+void SessionRequest::extract(const char* blob_name, int type)
+{
+    d->extract_indexes.push_back(-1);
+    d->extract_names.push_back(blob_name);
+    d->extract_types.push_back(type);
+}
+#endif // NCNN_STRING
+
+void SessionRequest::input(int blob_index, const Mat& in)
+{
+    d->input_indexes.push_back(blob_index);
+#if NCNN_STRING
+    d->input_names.push_back(std::string());
+#endif // NCNN_STRING
+    d->inputs.push_back(in);
+}
+
+void SessionRequest::extract(int blob_index, int type)
+{
+    d->extract_indexes.push_back(blob_index);
+#if NCNN_STRING
+    d->extract_names.push_back(std::string());
+#endif // NCNN_STRING
+    d->extract_types.push_back(type);
+}
+
+void SessionRequest::clear()
+{
+    if (d->state == 1)
+    {
+        NCNN_LOGE("session request clear in flight");
+        return;
+    }
+
+    d->input_indexes.clear();
+    d->inputs.clear();
+    d->extract_indexes.clear();
+    d->extract_types.clear();
+#if NCNN_STRING
+    d->input_names.clear();
+    d->extract_names.clear();
+#endif // NCNN_STRING
+    d->outputs.clear();
+    d->state = 0;
+    d->ret = 0;
+    d->queue_delay = 0.0;
+    d->batch_size = 0;
+}
+
+int SessionRequest::wait()
+{
+    d->lock.lock();
+    while (d->state == 1)
+    {
+        d->condition.wait(d->lock);
+    }
+    int ret = d->ret;
+    d->lock.unlock();
+
+    return ret;
+}
+
+bool SessionRequest::done() const
+{
+    MutexLockGuard guard(d->lock);
+
+    return d->state == 2;
+}
+
+const std::vector<Mat>& SessionRequest::outputs() const
+{
+    return d->outputs;
+}
+
+int SessionRequest::batch_size() const
+{
+    return d->batch_size;
+}
+
+double SessionRequest::queue_delay() const
+{
+    return d->queue_delay;
+}
+
+SessionPoolStat::SessionPoolStat()
+{
+    batch_count = 0;
+    request_count = 0;
+    max_batch_size = 0;
+    total_queue_delay = 0.0;
+    max_queue_delay = 0.0;
+}
+
+class SessionPoolWorker
+{
+public:
+    SessionPoolWorker(const Net* net, int num_threads)
+        : ex(net->create_extractor())
+    {
+        ex.set_num_threads(num_threads);
+        ex.set_blob_allocator(&blob_allocator);
+        ex.set_workspace_allocator(&workspace_allocator);
+    }
+
+    ~SessionPoolWorker()
+    {
+        // give the recycled blobs back before the allocators go away
+        ex.clear();
+    }
+
+    int run(SessionRequestPrivate* request);
+
+    // forward the requests as one batch and scatter the results back
+    int run_batch(const std::vector<SessionRequestPrivate*>& batch);
+
+public:
+    // blob allocator is only touched by the thread owning this worker
+    // workspace allocator may be called by the openmp threads inside layers
+    UnlockedPoolAllocator blob_allocator;
+    PoolAllocator workspace_allocator;
+    Extractor ex;
+
+    SessionPoolPrivate* pool;
+    Thread* thread;
+};
+
+int SessionPoolWorker::run(SessionRequestPrivate* request)
+{
+    int ret = 0;
+
+    for (size_t i = 0; i < request->inputs.size() && ret == 0; i++)
+    {
+#if NCNN_STRING
+        if (request->input_indexes[i] == -1)
+        {
+            ret = ex.input(request->input_names[i].c_str(), request->inputs[i]);
+            continue;
+        }
+#endif // NCNN_STRING
+        ret = ex.input(request->input_indexes[i], request->inputs[i]);
+    }
+
+    request->outputs.resize(request->extract_indexes.size());
+    for (size_t i = 0; i < request->extract_indexes.size() && ret == 0; i++)
+    {
+        Mat& feat = request->outputs[i];
+
+#if NCNN_STRING
+        if (request->extract_indexes[i] == -1)
+        {
+            ret = ex.extract(request->extract_names[i].c_str(), feat, request->extract_types[i]);
+        }
+        else
+#endif // NCNN_STRING
+        {
+            ret = ex.extract(request->extract_indexes[i], feat, request->extract_types[i]);
+        }
+
+        if (feat.allocator == &blob_allocator)
+        {
+            // detach the result from the worker allocator
+            // so it could be released on any thread
+            feat = feat.clone();
+        }
+    }
+
+    // intermediate blobs go back to the worker allocator on this thread
+    ex.reset();
+
+    return ret;
+}
+
+int SessionPoolWorker::run_batch(const std::vector<SessionRequestPrivate*>& batch)
+{
+    const SessionRequestPrivate* first = batch[0];
+    const size_t n = batch.size();
+
+    int ret = 0;
+
+    std::vector<Mat> in_batch(n);
+    for (size_t i = 0; i < first->inputs.size() && ret == 0; i++)
+    {
+        for (size_t b = 0; b < n; b++)
+        {
+            in_batch[b] = batch[b]->inputs[i];
+        }
+
+#if NCNN_STRING
+        if (first->input_indexes[i] == -1)
+        {
+            ret = ex.input(first->input_names[i].c_str(), in_batch);
+            continue;
+        }
+#endif // NCNN_STRING
+        ret = ex.input(first->input_indexes[i], in_batch);
+    }
+    in_batch.clear();
+
+    for (size_t b = 0; b < n; b++)
+    {
+        batch[b]->outputs.resize(first->extract_indexes.size());
+    }
+
+    std::vector<Mat> feat_batch;
+    for (size_t i = 0; i < first->extract_indexes.size() && ret == 0; i++)
+    {
+#if NCNN_STRING
+        if (first->extract_indexes[i] == -1)
+        {
+            ret = ex.extract(first->extract_names[i].c_str(), feat_batch, first->extract_types[i]);
+        }
+        else
+#endif // NCNN_STRING
+        {
+            ret = ex.extract(first->extract_indexes[i], feat_batch, first->extract_types[i]);
+        }
+
+        for (size_t b = 0; b < n && b < feat_batch.size(); b++)
+        {
+            Mat& feat = batch[b]->outputs[i];
+            feat = feat_batch[b];
+
+            if (feat.allocator == &blob_allocator)
+            {
+                // detach the result from the worker allocator
+                // so it could be released on any thread
+                feat = feat.clone();
+            }
+        }
+    }
+    feat_batch.clear();
+
+    // intermediate blobs go back to the worker allocator on this thread
+    ex.reset();
+
+    return ret;
+}
+
+class SessionPoolPrivate
+{
+public:
+    std::vector<SessionPoolWorker*> workers;
+
+    mutable Mutex lock;
+    ConditionVariable not_empty;
+    ConditionVariable not_full;
+    std::list<SessionRequestPrivate*> queue;
+    int queue_capacity;
+    bool stopping;
+
+    int max_batch_size;
+    double max_delay_ms;
+
+    SessionPoolStat stat;
+};
+
+static bool session_request_batchable(const SessionRequestPrivate* a, const SessionRequestPrivate* b)
+{
+    if (a->input_indexes != b->input_indexes || a->extract_indexes != b->extract_indexes || a->extract_types != b->extract_types)
+        return false;
+
+#if NCNN_STRING
+    if (a->input_names != b->input_names || a->extract_names != b->extract_names)
+        return false;
+#endif // NCNN_STRING
+
+    for (size_t i = 0; i < a->inputs.size(); i++)
+    {
+        const Mat& m0 = a->inputs[i];
+        const Mat& m = b->inputs[i];
+        if (m.dims != m0.dims || m.w != m0.w || m.h != m0.h || m.c != m0.c || m.elemsize != m0.elemsize || m.elempack != m0.elempack)
+            return false;
+    }
+
+    return true;
+}
+
+static void session_pool_collect(SessionPoolPrivate* d, std::vector<SessionRequestPrivate*>& batch)
+{
+    // take the queued requests that batch with the first one, keep the order of the others
+    std::list<SessionRequestPrivate*>::iterator it = d->queue.begin();
+    while (it != d->queue.end() && (int)batch.size() < d->max_batch_size)
+    {
+        if (session_request_batchable(batch[0], *it))
+        {
+            batch.push_back(*it);
+            it = d->queue.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+static void session_request_finish(SessionRequestPrivate* request, int ret)
+{
+    request->lock.lock();
+    request->ret = ret;
+    request->state = 2;
+    request->condition.broadcast();
+    request->lock.unlock();
+}
+
+#if NCNN_THREADS
+static void* session_pool_worker(void* args)
+{
+    SessionPoolWorker* worker = (SessionPoolWorker*)args;
+    SessionPoolPrivate* d = worker->pool;
+
+    std::vector<SessionRequestPrivate*> batch;
+
+    for (;;)
+    {
+        d->lock.lock();
+        while (d->queue.empty() && !d->stopping)
+        {
+            d->not_empty.wait(d->lock);
+        }
+        if (d->queue.empty())
+        {
+            // stopping and drained
+            d->lock.unlock();
+            break;
+        }
+
+        batch.clear();
+        batch.push_back(d->queue.front());
+        d->queue.pop_front();
+        session_pool_collect(d, batch);
+
+        // wait for more requests within the latency budget of the first one
+        while ((int)batch.size() < d->max_batch_size && !d->stopping)
+        {
+            const double remaining = batch[0]->submit_time + d->max_delay_ms - get_current_time();
+            if (remaining <= 0.0)
+                break;
+
+            // clamp so that a long max_delay_ms does not overflow the microsecond count
+            const double timeout_us = std::min(remaining * 1000 + 1, (double)INT_MAX);
+            d->not_empty.timedwait(d->lock, (int)timeout_us);
+            session_pool_collect(d, batch);
+        }
+
+        d->not_full.broadcast();
+        d->lock.unlock();
+
+        const double start = get_current_time();
+
+        int ret = batch.size() == 1 ? worker->run(batch[0]) : worker->run_batch(batch);
+
+        d->lock.lock();
+        d->stat.batch_count++;
+        d->stat.request_count += (int)batch.size();
+        d->stat.max_batch_size = std::max(d->stat.max_batch_size, (int)batch.size());
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+            const double queue_delay = start - batch[i]->submit_time;
+            d->stat.total_queue_delay += queue_delay;
+            d->stat.max_queue_delay = std::max(d->stat.max_queue_delay, queue_delay);
+        }
+        d->lock.unlock();
+
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+            batch[i]->queue_delay = start - batch[i]->submit_time;
+            batch[i]->batch_size = (int)batch.size();
+
+            session_request_finish(batch[i], ret);
+        }
+    }
+
+    return 0;
+}
+#endif // NCNN_THREADS
+
+SessionPool::SessionPool(const Net* net, int worker_count, int num_threads, int queue_capacity)
+    : d(new SessionPoolPrivate)
+{
+    d->queue_capacity = std::max(queue_capacity, 1);
+    d->stopping = false;
+    d->max_batch_size = 1;
+    d->max_delay_ms = 0.0;
+
+    worker_count = std::max(worker_count, 1);
+    d->workers.resize(worker_count);
+    for (int i = 0; i < worker_count; i++)
+    {
+        SessionPoolWorker* worker = new SessionPoolWorker(net, num_threads);
+        worker->pool = d;
+        worker->thread = 0;
+        d->workers[i] = worker;
+    }
+
+#if NCNN_THREADS
+    for (int i = 0; i < worker_count; i++)
+    {
+        d->workers[i]->thread = new Thread(session_pool_worker, d->workers[i]);
+    }
+#endif // NCNN_THREADS
+}
+
+SessionPool::~SessionPool()
+{
+    d->lock.lock();
+    d->stopping = true;
+    d->not_empty.broadcast();
+    d->not_full.broadcast();
+    d->lock.unlock();
+
+    for (size_t i = 0; i < d->workers.size(); i++)
+    {
+        SessionPoolWorker* worker = d->workers[i];
+        if (worker->thread)
+        {
+            worker->thread->join();
+            delete worker->thread;
+        }
+        delete worker;
+    }
+
+    delete d;
+}
+
+SessionPool::SessionPool(const SessionPool&)
+    : d(0)
+{
+}
+
+SessionPool& SessionPool::operator=(const SessionPool&)
+{
+    return *this;
+}
+
+static int session_pool_enqueue(SessionPoolPrivate* d, SessionRequestPrivate* request, bool blocking)
+{
+    request->lock.lock();
+    if (request->state == 1)
+    {
+        request->lock.unlock();
+        NCNN_LOGE("session request submitted twice");
+        return -1;
+    }
+    request->state = 1;
+    request->outputs.clear();
+    request->submit_time = get_current_time();
+    request->lock.unlock();
+
+#if NCNN_THREADS
+    d->lock.lock();
+    while (blocking && (int)d->queue.size() >= d->queue_capacity && !d->stopping)
+    {
+        d->not_full.wait(d->lock);
+    }
+    if (d->stopping || (int)d->queue.size() >= d->queue_capacity)
+    {
+        d->lock.unlock();
+
+        request->lock.lock();
+        request->state = 0;
+        request->lock.unlock();
+        return -1;
+    }
+    d->queue.push_back(request);
+    d->not_empty.signal();
+    d->lock.unlock();
+#else
+    (void)blocking;
+
+    // no worker thread, forward on the caller
+    int ret = d->workers[0]->run(request);
+
+    d->stat.batch_count++;
+    d->stat.request_count++;
+    d->stat.max_batch_size = 1;
+
+    request->batch_size = 1;
+    session_request_finish(request, ret);
+#endif // NCNN_THREADS
+
+    return 0;
+}
+
+int SessionPool::submit(SessionRequest* request)
+{
+    return session_pool_enqueue(d, request->d, true);
+}
+
+int SessionPool::try_submit(SessionRequest* request)
+{
+    return session_pool_enqueue(d, request->d, false);
+}
+
+int SessionPool::pending_count() const
+{
+    MutexLockGuard guard(d->lock);
+
+    return (int)d->queue.size();
+}
+
+void SessionPool::set_batching(int max_batch_size, double max_delay_ms)
+{
+    MutexLockGuard guard(d->lock);
+
+    d->max_batch_size = std::max(max_batch_size, 1);
+    d->max_delay_ms = std::max(max_delay_ms, 0.0);
+}
+
+SessionPoolStat SessionPool::stat() const
+{
+    MutexLockGuard guard(d->lock);
+
+    return d->stat;
+}
+
+} // namespace ncnn
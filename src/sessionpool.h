@@ -0,0 +1,137 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef NCNN_SESSIONPOOL_H
+#define NCNN_SESSIONPOOL_H
+
+#include "mat.h"
+#include "net.h"
+#include "platform.h"
+
+namespace ncnn {
+
+class SessionRequestPrivate;
+class NCNN_EXPORT SessionRequest
+{
+public:
+    SessionRequest();
+    ~SessionRequest();
+
+#if NCNN_STRING
+    // set input by blob name
+    void input(const char* blob_name, const Mat& in);
+
+    // get result by blob name into outputs() in call order
+    void extract(const char* blob_name, int type = 0);
+#endif // NCNN_STRING
+
+    // set input by blob index
+    void input(int blob_index, const Mat& in);
+
+    // get result by blob index into outputs() in call order
+    void extract(int blob_index, int type = 0);
+
+    // drop inputs, outputs and the extract list
+    // so the request can be filled again
+    void clear();
+
+    // block until the request is processed
+    // return 0 if success
+    int wait();
+
+    // return true if processed, never blocks
+    bool done() const;
+
+    // results of extract(), valid after wait()
+    const std::vector<Mat>& outputs() const;
+
+    // requests forwarded together with this one, valid after wait()
+    int batch_size() const;
+
+    // milliseconds from submit to the start of forward, valid after wait()
+    double queue_delay() const;
+
+private:
+    SessionRequest(const SessionRequest&);
+    SessionRequest& operator=(const SessionRequest&);
+
+private:
+    friend class SessionPool;
+    SessionRequestPrivate* const d;
+};
+
+class NCNN_EXPORT SessionPoolStat
+{
+public:
+    SessionPoolStat();
+
+    // forwards run and requests served by them
+    int batch_count;
+    int request_count;
+
+    // the largest batch forwarded
+    int max_batch_size;
+
+    // milliseconds from submit to the start of forward
+    double total_queue_delay;
+    double max_queue_delay;
+};
+
+class SessionPoolPrivate;
+class NCNN_EXPORT SessionPool
+{
+public:
+    // start worker_count threads, each recycles one extractor of net
+    // with its own unlocked blob allocator and workspace allocator
+    // num_threads is the openmp thread count inside each worker
+    // queue_capacity bounds the requests waiting for a worker
+    // net must be loaded and outlive the pool
+    SessionPool(const Net* net, int worker_count, int num_threads = 1, int queue_capacity = 64);
+
+    // process the queued requests and stop all workers
+    ~SessionPool();
+
+    // enqueue request, block while the queue is full
+    // request must stay alive until wait() returns
+    // return 0 if success, -1 if the pool is stopping or request is in flight
+    int submit(SessionRequest* request);
+
+    // enqueue request without blocking
+    // return 0 if success, -1 if the queue is full
+    int try_submit(SessionRequest* request);
+
+    // requests waiting for a worker
+    int pending_count() const;
+
+    // coalesce concurrent requests into one batched forward
+    // a worker holds the first request up to max_delay_ms while collecting up to max_batch_size requests
+    // requests batch together when they give the same input blobs and shapes and extract the same blobs
+    // use few workers, so that the waiting requests are not taken by idle ones
+    // default max_batch_size is 1 that forwards every request alone
+    void set_batching(int max_batch_size, double max_delay_ms);
+
+    // statistics of the forwarded requests
+    SessionPoolStat stat() const;
+
+private:
+    SessionPool(const SessionPool&);
+    SessionPool& operator=(const SessionPool&);
+
+private:
+    SessionPoolPrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_SESSIONPOOL_H
@@ -17,7 +17,8 @@
 #if NCNN_SIMPLEOMP
 
 #include "simpleomp.h"
-#include "cpu.h" // ncnn::get_cpu_count()
+#include "benchmark.h" // ncnn::get_current_time()
+#include "cpu.h"       // ncnn::get_cpu_count()
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -25,6 +26,12 @@
 #include <stdint.h>
 #include <stdarg.h>
 
+#if defined(_WIN32)
+#include <windows.h> // SwitchToThread()
+#else
+#include <sched.h> // sched_yield()
+#endif
+
 extern "C" typedef void (*kmpc_micro)(int32_t* gtid, int32_t* tid, ...);
 extern "C" typedef void (*kmpc_micro_0)(int32_t* gtid, int32_t* tid);
 extern "C" typedef void (*kmpc_micro_1)(int32_t* gtid, int32_t* tid, void*);
@@ -54,8 +61,76 @@ static void* kmp_threadfunc(void* args);
 } // extern "C"
 #endif
 
+// the time in ms that threads spin before sleeping, see kmp_set_blocktime()
+static int g_kmp_blocktime = 0;
+
+static inline void kmp_cpu_relax()
+{
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || (defined(__arm__) && __ARM_ARCH >= 7)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+// give the cpu to another runnable thread
+static inline void kmp_yield()
+{
+#if defined(_WIN32)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
 namespace ncnn {
 
+// a dynamic loop as seen by one thread, every thread of the team inits the same bounds
+class KMPLoop
+{
+public:
+    int schedule;
+    uint64_t lower;
+    int64_t incr;
+    uint64_t trip_count;
+    uint64_t chunk;
+
+    // per-thread progress for static schedules
+    uint64_t static_index;
+
+    // loops this thread has entered in the region, numbering the loop instances
+    uint64_t dispatch_count;
+
+    // next normalized iteration claimed by dynamic and guided schedules, shared by the team
+    uint64_t* next;
+};
+
+#define KMP_DISPATCH_CHUNK 8
+
+// one claim counter per loop instance, chained as the region enters more loops
+// the threads of a team may run one after another, so a counter is never recycled within the region
+class KMPDispatchChunk
+{
+public:
+    uint64_t next[KMP_DISPATCH_CHUNK];
+    KMPDispatchChunk* more;
+};
+
+// state shared by the threads of one parallel region, lives on the master stack
+class KMPTeam
+{
+public:
+    int num_threads;
+
+    // counters of the first loop instances, every thread enters the same loops in the same order
+    KMPDispatchChunk dispatch;
+
+    // indexed by thread num
+    KMPLoop* loops;
+};
+
 class KMPTask
 {
 public:
@@ -65,106 +140,184 @@ public:
     void** argv;
     int num_threads;
 
+    KMPTeam* team;
+
     // per-task
     int thread_num;
 
-    // finish status
+    // finish status, decremented by each thread of the team
     int* num_threads_to_wait;
-    Mutex* finish_lock;
-    ConditionVariable* finish_condition;
 };
 
+// lock-free bounded ring for many producers and many consumers
+// consumers spin for blocktime before sleeping, producers only wake the sleeping ones
 class KMPTaskQueue
 {
 public:
     KMPTaskQueue(int _max_size)
     {
-        max_size = _max_size;
-        tasks = new KMPTask*[max_size];
-        size = 0;
-        front = 0;
-        back = 0;
+        max_size = 1;
+        while (max_size < _max_size)
+            max_size <<= 1;
+
+        slots = new KMPTaskSlot[max_size];
+        for (int i = 0; i < max_size; i++)
+        {
+            slots[i].sequence = i;
+            slots[i].task = 0;
+        }
+
+        enqueue_pos = 0;
+        dequeue_pos = 0;
+        sleepers = 0;
     }
 
     ~KMPTaskQueue()
     {
-        delete[] tasks;
+        delete[] slots;
     }
 
     void dispatch(KMPTask* v, int n)
     {
-        lock.lock();
+        for (int i = 0; i < n; i++)
+        {
+            while (!try_put(&v[i]))
+            {
+                // full, consumers are busy draining
+                kmp_cpu_relax();
+            }
+        }
 
-        if (size + n > max_size)
+        // pairs with the fence in get(), either the sleeper sees the tasks or we see the sleeper
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&sleepers, __ATOMIC_RELAXED) > 0)
         {
+            lock.lock();
+            condition.broadcast();
             lock.unlock();
+        }
+    }
 
-            for (int i = 0; i < n; i++)
+    void get(KMPTask*& v)
+    {
+        const int blocktime = __atomic_load_n(&g_kmp_blocktime, __ATOMIC_RELAXED);
+        if (blocktime > 0)
+        {
+            const double start = ncnn::get_current_time();
+            for (int i = 0;; i++)
             {
-                put(&v[i]);
+                if (try_get(v))
+                    return;
+
+                kmp_cpu_relax();
+
+                if ((i & 255) == 255)
+                {
+                    if (ncnn::get_current_time() - start >= blocktime)
+                        break;
+
+                    // let the other threads run when cpus are oversubscribed
+                    kmp_yield();
+                }
             }
+        }
+        else if (try_get(v))
+        {
             return;
         }
 
-        for (int i = 0; i < n; i++)
+        lock.lock();
+        __atomic_add_fetch(&sleepers, 1, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        while (!try_get(v))
         {
-            tasks[back] = &v[i];
-            back++;
-            if (back == max_size)
-                back = 0;
+            condition.wait(lock);
         }
-
-        size += n;
-
+        __atomic_sub_fetch(&sleepers, 1, __ATOMIC_SEQ_CST);
         lock.unlock();
-
-        condition.signal();
     }
 
-    void put(KMPTask* v)
+private:
+    bool try_put(KMPTask* v)
     {
-        lock.lock();
-        while (size >= max_size)
+        size_t pos = __atomic_load_n(&enqueue_pos, __ATOMIC_RELAXED);
+        KMPTaskSlot* slot;
+        for (;;)
         {
-            condition.wait(lock);
+            slot = &slots[pos & (max_size - 1)];
+            size_t seq = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+            intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+            if (dif == 0)
+            {
+                if (__atomic_compare_exchange_n(&enqueue_pos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                    break;
+            }
+            else if (dif < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = __atomic_load_n(&enqueue_pos, __ATOMIC_RELAXED);
+            }
         }
-        tasks[back] = v;
-        back++;
-        if (back == max_size)
-            back = 0;
-        size++;
-        lock.unlock();
 
-        condition.signal();
+        slot->task = v;
+        __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+        return true;
     }
 
-    void get(KMPTask*& v)
+    bool try_get(KMPTask*& v)
     {
-        lock.lock();
-        while (size == 0)
+        size_t pos = __atomic_load_n(&dequeue_pos, __ATOMIC_RELAXED);
+        KMPTaskSlot* slot;
+        for (;;)
         {
-            condition.wait(lock);
+            slot = &slots[pos & (max_size - 1)];
+            size_t seq = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+            intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (dif == 0)
+            {
+                if (__atomic_compare_exchange_n(&dequeue_pos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                    break;
+            }
+            else if (dif < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = __atomic_load_n(&dequeue_pos, __ATOMIC_RELAXED);
+            }
         }
-        v = tasks[front];
-        front++;
-        if (front == max_size)
-            front = 0;
-        size--;
-        lock.unlock();
 
-        condition.signal();
+        v = slot->task;
+        __atomic_store_n(&slot->sequence, pos + max_size, __ATOMIC_RELEASE);
+        return true;
     }
 
 private:
-    Mutex lock;
-    ConditionVariable condition;
+    struct KMPTaskSlot
+    {
+        size_t sequence;
+        KMPTask* task;
+    };
 
-    // ring buffer queue
+    // ring buffer queue, max_size is power of two
     int max_size;
-    KMPTask** tasks;
-    int size;
-    int front;
-    int back;
+    KMPTaskSlot* slots;
+
+    // keep the producer and consumer cursors on separate cache lines
+    char pad0[64];
+    size_t enqueue_pos;
+    char pad1[64];
+    size_t dequeue_pos;
+    char pad2[64];
+
+    // consumers sleeping on condition
+    int sleepers;
+    Mutex lock;
+    ConditionVariable condition;
 };
 
 class KMPGlobal
@@ -176,6 +329,7 @@ public:
         kmp_threads = 0;
         kmp_threads_tid = 0;
         kmp_task_queue = 0;
+        finish_sleepers = 0;
     }
 
     ~KMPGlobal()
@@ -225,8 +379,6 @@ public:
                 tasks[i].num_threads = kmp_max_threads;
                 tasks[i].thread_num = i + 1;
                 tasks[i].num_threads_to_wait = 0;
-                tasks[i].finish_lock = 0;
-                tasks[i].finish_condition = 0;
             }
 
             // dispatch 1 ~ kmp_max_threads
@@ -254,6 +406,12 @@ public:
     ncnn::Thread** kmp_threads;
     int* kmp_threads_tid;
     ncnn::KMPTaskQueue* kmp_task_queue;
+
+    // masters that gave up spinning for their team, shared so that the last worker
+    // never touches the stack of a master that has already returned
+    int finish_sleepers;
+    ncnn::Mutex finish_lock;
+    ncnn::ConditionVariable finish_condition;
 };
 
 } // namespace ncnn
@@ -264,12 +422,187 @@ static ncnn::KMPGlobal g_kmp_global;
 
 static ncnn::ThreadLocalStorage tls_num_threads;
 static ncnn::ThreadLocalStorage tls_thread_num;
+static ncnn::ThreadLocalStorage tls_team;
 
 static void init_g_kmp_global()
 {
     g_kmp_global.init();
 }
 
+// sched_type of the llvm openmp abi
+enum
+{
+    kmp_sch_static_chunked = 33,
+    kmp_sch_static = 34,
+    kmp_sch_dynamic_chunked = 35,
+    kmp_sch_guided_chunked = 36,
+    kmp_sch_runtime = 37,
+    kmp_sch_auto = 38,
+    kmp_sch_guided_iterative_chunked = 42,
+    kmp_sch_guided_analytical_chunked = 43,
+
+    kmp_sch_modifier_monotonic = 1 << 29,
+    kmp_sch_modifier_nonmonotonic = 1 << 30
+};
+
+static int kmp_loop_schedule(int32_t schedule)
+{
+    schedule &= ~(kmp_sch_modifier_monotonic | kmp_sch_modifier_nonmonotonic);
+
+    if (schedule > 128)
+    {
+        // nomerge
+        schedule -= 128;
+    }
+    else if (schedule > 64)
+    {
+        // ordered, chunks are handed out in order but ordered blocks are not supported
+        schedule -= 32;
+    }
+
+    switch (schedule)
+    {
+    case kmp_sch_static_chunked:
+    case kmp_sch_static:
+    case kmp_sch_dynamic_chunked:
+        return schedule;
+    case kmp_sch_guided_chunked:
+    case kmp_sch_guided_iterative_chunked:
+    case kmp_sch_guided_analytical_chunked:
+    case kmp_sch_auto:
+        return kmp_sch_guided_chunked;
+    case kmp_sch_runtime:
+    default:
+        // OMP_SCHEDULE is not parsed
+        return kmp_sch_dynamic_chunked;
+    }
+}
+
+template<typename T, typename ST>
+static void kmp_dispatch_init(int32_t gtid, int32_t schedule, T lb, T ub, ST st, ST chunk)
+{
+    ncnn::KMPTeam* team = (ncnn::KMPTeam*)tls_team.get();
+    ncnn::KMPLoop& loop = team->loops[gtid];
+
+    // normalize to iterations 0 ~ trip_count-1, sign extension keeps the difference exact
+    uint64_t trip_count = 0;
+    if (st > 0 && ub >= lb)
+        trip_count = ((uint64_t)ub - (uint64_t)lb) / (uint64_t)st + 1;
+    if (st < 0 && lb >= ub)
+        trip_count = ((uint64_t)lb - (uint64_t)ub) / (uint64_t)(-(int64_t)st) + 1;
+
+    loop.schedule = kmp_loop_schedule(schedule);
+    loop.lower = (uint64_t)lb;
+    loop.incr = (int64_t)st;
+    loop.trip_count = trip_count;
+    loop.chunk = chunk > 0 ? (uint64_t)chunk : 1;
+    loop.static_index = 0;
+
+    // find the counter of this loop instance, the first thread getting past the chain appends a zeroed chunk
+    uint64_t index = loop.dispatch_count++;
+    ncnn::KMPDispatchChunk* dispatch = &team->dispatch;
+    while (index >= KMP_DISPATCH_CHUNK)
+    {
+        ncnn::KMPDispatchChunk* more = __atomic_load_n(&dispatch->more, __ATOMIC_ACQUIRE);
+        if (!more)
+        {
+            ncnn::KMPDispatchChunk* fresh = new ncnn::KMPDispatchChunk;
+            memset(fresh, 0, sizeof(ncnn::KMPDispatchChunk));
+
+            if (__atomic_compare_exchange_n(&dispatch->more, &more, fresh, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            {
+                more = fresh;
+            }
+            else
+            {
+                // another thread won, more holds its chunk
+                delete fresh;
+            }
+        }
+
+        dispatch = more;
+        index -= KMP_DISPATCH_CHUNK;
+    }
+
+    loop.next = &dispatch->next[index];
+}
+
+template<typename T, typename ST>
+static int kmp_dispatch_next(int32_t gtid, int32_t* p_last, T* p_lb, T* p_ub, ST* p_st)
+{
+    ncnn::KMPTeam* team = (ncnn::KMPTeam*)tls_team.get();
+    ncnn::KMPLoop& loop = team->loops[gtid];
+
+    const uint64_t trip_count = loop.trip_count;
+    const uint64_t num_threads = team->num_threads;
+
+    uint64_t begin = 0;
+    uint64_t count = 0;
+
+    switch (loop.schedule)
+    {
+    case kmp_sch_static:
+    {
+        // one contiguous block per thread
+        if (loop.static_index++ != 0)
+            return 0;
+
+        uint64_t count_per_thread = trip_count / num_threads;
+        uint64_t remain = trip_count % num_threads;
+        begin = gtid * count_per_thread + std::min(remain, (uint64_t)gtid);
+        count = count_per_thread + ((uint64_t)gtid < remain ? 1 : 0);
+        break;
+    }
+    case kmp_sch_static_chunked:
+    {
+        // round robin chunks
+        begin = (loop.static_index++ * num_threads + gtid) * loop.chunk;
+        if (begin >= trip_count)
+            return 0;
+
+        count = std::min(loop.chunk, trip_count - begin);
+        break;
+    }
+    case kmp_sch_dynamic_chunked:
+    {
+        begin = __atomic_fetch_add(loop.next, loop.chunk, __ATOMIC_RELAXED);
+        if (begin >= trip_count)
+            return 0;
+
+        count = std::min(loop.chunk, trip_count - begin);
+        break;
+    }
+    case kmp_sch_guided_chunked:
+    {
+        // claim a share of the remaining iterations, shrinking down to chunk
+        begin = __atomic_load_n(loop.next, __ATOMIC_RELAXED);
+        for (;;)
+        {
+            if (begin >= trip_count)
+                return 0;
+
+            uint64_t remain = trip_count - begin;
+            count = std::min(std::max(remain / (num_threads * 2), loop.chunk), remain);
+
+            if (__atomic_compare_exchange_n(loop.next, &begin, begin + count, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                break;
+        }
+        break;
+    }
+    }
+
+    if (count == 0)
+        return 0;
+
+    *p_lb = (T)(loop.lower + begin * (uint64_t)loop.incr);
+    *p_ub = (T)(loop.lower + (begin + count - 1) * (uint64_t)loop.incr);
+    *p_st = (ST)loop.incr;
+    if (p_last)
+        *p_last = begin + count == trip_count;
+
+    return 1;
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -306,12 +639,13 @@ int omp_get_thread_num()
 
 int kmp_get_blocktime()
 {
-    return 0;
+    return __atomic_load_n(&g_kmp_blocktime, __ATOMIC_RELAXED);
 }
 
-void kmp_set_blocktime(int /*blocktime*/)
+void kmp_set_blocktime(int blocktime)
 {
-    // always passive, ignore
+    // shared by all threads, 0 sleeps right away
+    __atomic_store_n(&g_kmp_blocktime, blocktime > 0 ? blocktime : 0, __ATOMIC_RELAXED);
 }
 
 static int kmp_invoke_microtask(kmpc_micro fn, int gtid, int tid, int argc, void** argv)
@@ -376,6 +710,65 @@ static int kmp_invoke_microtask(kmpc_micro fn, int gtid, int tid, int argc, void
     return 0;
 }
 
+static void kmp_task_finish(int* num_threads_to_wait)
+{
+    if (__atomic_sub_fetch(num_threads_to_wait, 1, __ATOMIC_SEQ_CST) != 0)
+        return;
+
+    // the team is done, wake the master if it is sleeping
+    if (__atomic_load_n(&g_kmp_global.finish_sleepers, __ATOMIC_SEQ_CST) > 0)
+    {
+        g_kmp_global.finish_lock.lock();
+        g_kmp_global.finish_condition.broadcast();
+        g_kmp_global.finish_lock.unlock();
+    }
+}
+
+static void kmp_wait_finish(int* num_threads_to_wait)
+{
+    const int blocktime = __atomic_load_n(&g_kmp_blocktime, __ATOMIC_RELAXED);
+    if (blocktime > 0)
+    {
+        const double start = ncnn::get_current_time();
+        for (int i = 0;; i++)
+        {
+            if (__atomic_load_n(num_threads_to_wait, __ATOMIC_ACQUIRE) == 0)
+                return;
+
+            kmp_cpu_relax();
+
+            if ((i & 255) == 255)
+            {
+                if (ncnn::get_current_time() - start >= blocktime)
+                    break;
+
+                // let the other threads run when cpus are oversubscribed
+                kmp_yield();
+            }
+        }
+    }
+
+    g_kmp_global.finish_lock.lock();
+    __atomic_add_fetch(&g_kmp_global.finish_sleepers, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(num_threads_to_wait, __ATOMIC_SEQ_CST) != 0)
+    {
+        g_kmp_global.finish_condition.wait(g_kmp_global.finish_lock);
+    }
+    __atomic_sub_fetch(&g_kmp_global.finish_sleepers, 1, __ATOMIC_SEQ_CST);
+    g_kmp_global.finish_lock.unlock();
+}
+
+static void kmp_free_dispatch(ncnn::KMPTeam* team)
+{
+    ncnn::KMPDispatchChunk* dispatch = team->dispatch.more;
+    while (dispatch)
+    {
+        ncnn::KMPDispatchChunk* more = dispatch->more;
+        delete dispatch;
+        dispatch = more;
+    }
+}
+
 static void* kmp_threadfunc(void* args)
 {
     int tid = *(int*)args;
@@ -392,19 +785,12 @@ static void* kmp_threadfunc(void* args)
 
         tls_num_threads.set(reinterpret_cast<void*>((size_t)task->num_threads));
         tls_thread_num.set(reinterpret_cast<void*>((size_t)task->thread_num));
+        tls_team.set(task->team);
 
         kmp_invoke_microtask(task->fn, task->thread_num, tid, task->argc, task->argv);
 
-        // update finished
-        {
-            task->finish_lock->lock();
-            *task->num_threads_to_wait = *task->num_threads_to_wait - 1;
-            if (*task->num_threads_to_wait == 0)
-            {
-                task->finish_condition->signal();
-            }
-            task->finish_lock->unlock();
-        }
+        // update finished, task lives on the master stack and is gone afterwards
+        kmp_task_finish(task->num_threads_to_wait);
     }
 
     // fprintf(stderr, "exit\n");
@@ -440,21 +826,38 @@ void __kmpc_fork_call(void* /*loc*/, int32_t argc, kmpc_micro fn, ...)
         va_end(ap);
     }
 
+    // the enclosing team when nested, restored on return
+    void* outer_thread_num = tls_thread_num.get();
+    void* outer_team = tls_team.get();
+
+    ncnn::KMPTeam team;
+    team.num_threads = num_threads;
+    memset(&team.dispatch, 0, sizeof(team.dispatch));
+    team.loops = (ncnn::KMPLoop*)alloca(num_threads * sizeof(ncnn::KMPLoop));
+    for (int i = 0; i < num_threads; i++)
+    {
+        team.loops[i].dispatch_count = 0;
+    }
+
+    tls_team.set(&team);
+
     if (g_kmp_global.kmp_max_threads == 1 || num_threads == 1)
     {
         for (int i = 0; i < num_threads; i++)
         {
             tls_thread_num.set(reinterpret_cast<void*>((size_t)i));
 
-            kmp_invoke_microtask(fn, 0, 0, argc, argv);
+            kmp_invoke_microtask(fn, i, 0, argc, argv);
         }
 
+        kmp_free_dispatch(&team);
+
+        tls_thread_num.set(outer_thread_num);
+        tls_team.set(outer_team);
         return;
     }
 
     int num_threads_to_wait = num_threads - 1;
-    ncnn::Mutex finish_lock;
-    ncnn::ConditionVariable finish_condition;
 
     // TODO portable stack allocation
     ncnn::KMPTask* tasks = (ncnn::KMPTask*)alloca((num_threads - 1) * sizeof(ncnn::KMPTask));
@@ -464,10 +867,9 @@ void __kmpc_fork_call(void* /*loc*/, int32_t argc, kmpc_micro fn, ...)
         tasks[i].argc = argc;
         tasks[i].argv = (void**)argv;
         tasks[i].num_threads = num_threads;
+        tasks[i].team = &team;
         tasks[i].thread_num = i + 1;
         tasks[i].num_threads_to_wait = &num_threads_to_wait;
-        tasks[i].finish_lock = &finish_lock;
-        tasks[i].finish_condition = &finish_condition;
     }
 
     // dispatch 1 ~ num_threads
@@ -480,15 +882,13 @@ void __kmpc_fork_call(void* /*loc*/, int32_t argc, kmpc_micro fn, ...)
         kmp_invoke_microtask(fn, 0, 0, argc, argv);
     }
 
-    // wait for finished
-    {
-        finish_lock.lock();
-        if (num_threads_to_wait != 0)
-        {
-            finish_condition.wait(finish_lock);
-        }
-        finish_lock.unlock();
-    }
+    // wait for finished, spin for blocktime then sleep
+    kmp_wait_finish(&num_threads_to_wait);
+
+    kmp_free_dispatch(&team);
+
+    tls_thread_num.set(outer_thread_num);
+    tls_team.set(outer_team);
 }
 
 void __kmpc_for_static_init_4(void* /*loc*/, int32_t gtid, int32_t /*sched*/, int32_t* last, int32_t* lower, int32_t* upper, int32_t* /*stride*/, int32_t /*incr*/, int32_t /*chunk*/)
@@ -561,6 +961,78 @@ void __kmpc_for_static_fini(void* /*loc*/, int32_t gtid)
     (void)gtid;
 }
 
+void __kmpc_dispatch_init_4(void* /*loc*/, int32_t gtid, int32_t schedule, int32_t lb, int32_t ub, int32_t st, int32_t chunk)
+{
+    // NCNN_LOGE("__kmpc_dispatch_init_4");
+    kmp_dispatch_init(gtid, schedule, lb, ub, st, chunk);
+}
+
+void __kmpc_dispatch_init_4u(void* /*loc*/, int32_t gtid, int32_t schedule, uint32_t lb, uint32_t ub, int32_t st, int32_t chunk)
+{
+    // NCNN_LOGE("__kmpc_dispatch_init_4u");
+    kmp_dispatch_init(gtid, schedule, lb, ub, st, chunk);
+}
+
+void __kmpc_dispatch_init_8(void* /*loc*/, int32_t gtid, int32_t schedule, int64_t lb, int64_t ub, int64_t st, int64_t chunk)
+{
+    // NCNN_LOGE("__kmpc_dispatch_init_8");
+    kmp_dispatch_init(gtid, schedule, lb, ub, st, chunk);
+}
+
+void __kmpc_dispatch_init_8u(void* /*loc*/, int32_t gtid, int32_t schedule, uint64_t lb, uint64_t ub, int64_t st, int64_t chunk)
+{
+    // NCNN_LOGE("__kmpc_dispatch_init_8u");
+    kmp_dispatch_init(gtid, schedule, lb, ub, st, chunk);
+}
+
+int __kmpc_dispatch_next_4(void* /*loc*/, int32_t gtid, int32_t* p_last, int32_t* p_lb, int32_t* p_ub, int32_t* p_st)
+{
+    // NCNN_LOGE("__kmpc_dispatch_next_4");
+    return kmp_dispatch_next(gtid, p_last, p_lb, p_ub, p_st);
+}
+
+int __kmpc_dispatch_next_4u(void* /*loc*/, int32_t gtid, int32_t* p_last, uint32_t* p_lb, uint32_t* p_ub, int32_t* p_st)
+{
+    // NCNN_LOGE("__kmpc_dispatch_next_4u");
+    return kmp_dispatch_next(gtid, p_last, p_lb, p_ub, p_st);
+}
+
+int __kmpc_dispatch_next_8(void* /*loc*/, int32_t gtid, int32_t* p_last, int64_t* p_lb, int64_t* p_ub, int64_t* p_st)
+{
+    // NCNN_LOGE("__kmpc_dispatch_next_8");
+    return kmp_dispatch_next(gtid, p_last, p_lb, p_ub, p_st);
+}
+
+int __kmpc_dispatch_next_8u(void* /*loc*/, int32_t gtid, int32_t* p_last, uint64_t* p_lb, uint64_t* p_ub, int64_t* p_st)
+{
+    // NCNN_LOGE("__kmpc_dispatch_next_8u");
+    return kmp_dispatch_next(gtid, p_last, p_lb, p_ub, p_st);
+}
+
+void __kmpc_dispatch_fini_4(void* /*loc*/, int32_t gtid)
+{
+    // NCNN_LOGE("__kmpc_dispatch_fini_4");
+    (void)gtid;
+}
+
+void __kmpc_dispatch_fini_4u(void* /*loc*/, int32_t gtid)
+{
+    // NCNN_LOGE("__kmpc_dispatch_fini_4u");
+    (void)gtid;
+}
+
+void __kmpc_dispatch_fini_8(void* /*loc*/, int32_t gtid)
+{
+    // NCNN_LOGE("__kmpc_dispatch_fini_8");
+    (void)gtid;
+}
+
+void __kmpc_dispatch_fini_8u(void* /*loc*/, int32_t gtid)
+{
+    // NCNN_LOGE("__kmpc_dispatch_fini_8u");
+    (void)gtid;
+}
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
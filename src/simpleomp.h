@@ -23,6 +23,7 @@
 
 // This minimal openmp runtime implementation only supports the llvm openmp abi
 // and only supports #pragma omp parallel for num_threads(X)
+// with static, dynamic and guided schedule, one loop per parallel region
 
 #ifdef __cplusplus
 extern "C" {
@@ -0,0 +1,182 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "threadpool.h"
+
+namespace ncnn {
+
+class ThreadPoolPrivate
+{
+public:
+    void init(const CpuSet& cpuset);
+
+    // all cores, and the ones not leased used as a stack
+    std::vector<int> cpus;
+    std::vector<int> free_cpus;
+
+    // leases held and acquire calls waiting for a free core
+    int holder_count;
+    int waiter_count;
+
+    bool cpu_pinning;
+
+    mutable Mutex lock;
+    ConditionVariable condition;
+};
+
+void ThreadPoolPrivate::init(const CpuSet& cpuset)
+{
+    holder_count = 0;
+    waiter_count = 0;
+    cpu_pinning = false;
+
+    const int num_enabled = cpuset.num_enabled();
+    for (int i = 0; (int)cpus.size() < num_enabled; i++)
+    {
+        if (cpuset.is_enabled(i))
+            cpus.push_back(i);
+    }
+
+    if (cpus.empty())
+    {
+        NCNN_LOGE("thread pool cpuset is empty, fallback to one core");
+        cpus.push_back(0);
+    }
+
+    // lease the lower cores first
+    for (int i = (int)cpus.size() - 1; i >= 0; i--)
+    {
+        free_cpus.push_back(cpus[i]);
+    }
+}
+
+ThreadPool::ThreadPool()
+    : d(new ThreadPoolPrivate)
+{
+    // all cores when there is no big cluster, same as get_big_cpu_count()
+    const CpuSet& big_cpuset = get_cpu_thread_affinity_mask(2);
+    d->init(big_cpuset.num_enabled() ? big_cpuset : get_cpu_thread_affinity_mask(0));
+}
+
+ThreadPool::ThreadPool(const CpuSet& cpuset)
+    : d(new ThreadPoolPrivate)
+{
+    d->init(cpuset);
+}
+
+ThreadPool::~ThreadPool()
+{
+    if (d->holder_count != 0)
+    {
+        NCNN_LOGE("FATAL ERROR! thread pool destroyed with %d leases held", d->holder_count);
+    }
+
+    delete d;
+}
+
+ThreadPool::ThreadPool(const ThreadPool&)
+    : d(0)
+{
+}
+
+ThreadPool& ThreadPool::operator=(const ThreadPool&)
+{
+    return *this;
+}
+
+void ThreadPool::set_cpu_pinning(bool enabled)
+{
+    MutexLockGuard guard(d->lock);
+    d->cpu_pinning = enabled;
+}
+
+int ThreadPool::acquire(int num_threads, std::vector<int>& cpus, CpuSet& previous_mask)
+{
+    cpus.clear();
+    previous_mask.disable_all();
+
+    bool cpu_pinning = false;
+    {
+        MutexLockGuard guard(d->lock);
+
+        d->waiter_count++;
+        while (d->free_cpus.empty())
+        {
+            d->condition.wait(d->lock);
+        }
+        d->waiter_count--;
+
+        // even share among the holders, the waiters and this one
+        const int share = std::max((int)d->cpus.size() / (d->holder_count + d->waiter_count + 1), 1);
+        const int count = std::min(std::min(std::max(num_threads, 1), share), (int)d->free_cpus.size());
+
+        for (int i = 0; i < count; i++)
+        {
+            cpus.push_back(d->free_cpus.back());
+            d->free_cpus.pop_back();
+        }
+
+        d->holder_count++;
+        cpu_pinning = d->cpu_pinning;
+    }
+
+    if (cpu_pinning && get_cpu_thread_affinity(previous_mask) == 0)
+    {
+        CpuSet thread_affinity_mask;
+        for (size_t i = 0; i < cpus.size(); i++)
+        {
+            thread_affinity_mask.enable(cpus[i]);
+        }
+
+        set_cpu_thread_affinity(thread_affinity_mask);
+    }
+
+    return (int)cpus.size();
+}
+
+void ThreadPool::release(const std::vector<int>& cpus, const CpuSet& previous_mask)
+{
+    if (cpus.empty())
+        return;
+
+    // unpin before the cores go to another lease
+    if (previous_mask.num_enabled() > 0)
+    {
+        set_cpu_thread_affinity(previous_mask);
+    }
+
+    MutexLockGuard guard(d->lock);
+
+    for (size_t i = 0; i < cpus.size(); i++)
+    {
+        d->free_cpus.push_back(cpus[i]);
+    }
+
+    d->holder_count--;
+
+    d->condition.broadcast();
+}
+
+int ThreadPool::cpu_count() const
+{
+    return (int)d->cpus.size();
+}
+
+int ThreadPool::free_cpu_count() const
+{
+    MutexLockGuard guard(d->lock);
+    return (int)d->free_cpus.size();
+}
+
+} // namespace ncnn
@@ -0,0 +1,70 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef NCNN_THREADPOOL_H
+#define NCNN_THREADPOOL_H
+
+#include "cpu.h"
+#include "platform.h"
+
+namespace ncnn {
+
+// cpu cores shared by the openmp teams of concurrent extractors
+// assign one pool to Option::thread_pool of every net in the process
+// so that the extractors partition the cores instead of oversubscribing them
+class ThreadPoolPrivate;
+class NCNN_EXPORT ThreadPool
+{
+public:
+    // share the big cores
+    ThreadPool();
+
+    // share the cores enabled in cpuset
+    ThreadPool(const CpuSet& cpuset);
+
+    ~ThreadPool();
+
+    // bind the openmp threads of the calling thread to the cores of each lease
+    // needs a runtime with per-thread teams such as libgomp and libomp
+    // only implemented on linux and android
+    // disabled by default
+    void set_cpu_pinning(bool enabled);
+
+    // lease up to num_threads free cores, block while all cores are leased
+    // a lease is capped at an even share among the holders and the waiters
+    // return the granted thread count, the leased cores are stored in cpus
+    // with cpu pinning, the affinity of the calling thread before pinning is stored in previous_mask
+    int acquire(int num_threads, std::vector<int>& cpus, CpuSet& previous_mask);
+
+    // give back the cores of a lease
+    // and restore the affinity saved by acquire on the calling thread and its openmp threads
+    void release(const std::vector<int>& cpus, const CpuSet& previous_mask);
+
+    // cores managed by the pool
+    int cpu_count() const;
+
+    // cores not leased
+    int free_cpu_count() const;
+
+private:
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+private:
+    ThreadPoolPrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_THREADPOOL_H
@@ -0,0 +1,365 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "allocator.h"
+#include "platform.h"
+
+// a and c never live at the same time, b overlaps both
+static void arena_sequence(ncnn::ArenaAllocator& allocator, void** ptrs)
+{
+    ptrs[0] = allocator.fastMalloc(1000);
+    ptrs[1] = allocator.fastMalloc(2000);
+    memset(ptrs[0], 1, 1000);
+    memset(ptrs[1], 2, 2000);
+    allocator.fastFree(ptrs[0]);
+
+    ptrs[2] = allocator.fastMalloc(1000);
+    memset(ptrs[2], 3, 1000);
+    allocator.fastFree(ptrs[1]);
+    allocator.fastFree(ptrs[2]);
+}
+
+static int test_arena_allocator_plan()
+{
+    ncnn::ArenaAllocator allocator;
+
+    void* ptrs[3];
+
+    allocator.begin_plan();
+    arena_sequence(allocator, ptrs);
+    if (allocator.end_plan() != 0)
+    {
+        fprintf(stderr, "arena end_plan failed\n");
+        return -1;
+    }
+
+    // a and c share memory, b does not
+    const size_t planned_bytes = allocator.planned_bytes();
+    if (planned_bytes < 3000 || planned_bytes >= 4000)
+    {
+        fprintf(stderr, "arena planned %lu bytes, expect 3000 ~ 4000\n", (unsigned long)planned_bytes);
+        return -1;
+    }
+
+    void* planned_ptrs[3];
+    arena_sequence(allocator, planned_ptrs);
+
+    if (allocator.fallback_count() != 0 || planned_ptrs[0] != planned_ptrs[2] || planned_ptrs[0] == planned_ptrs[1])
+    {
+        fprintf(stderr, "arena replay does not follow the plan, fallback %lu\n", (unsigned long)allocator.fallback_count());
+        return -1;
+    }
+
+    // the plan is reused by every following run
+    for (int i = 0; i < 3; i++)
+    {
+        void* again_ptrs[3];
+        arena_sequence(allocator, again_ptrs);
+
+        if (memcmp(again_ptrs, planned_ptrs, sizeof(planned_ptrs)) != 0)
+        {
+            fprintf(stderr, "arena run %d does not reuse the plan\n", i);
+            return -1;
+        }
+    }
+
+    if (allocator.fallback_count() != 0)
+    {
+        fprintf(stderr, "arena plan reuse falls back to heap %lu times\n", (unsigned long)allocator.fallback_count());
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_arena_allocator_fallback()
+{
+    ncnn::ArenaAllocator allocator;
+
+    void* ptrs[3];
+
+    allocator.begin_plan();
+    arena_sequence(allocator, ptrs);
+    allocator.end_plan();
+
+    // an output of the previous run is still held, the next run must not overwrite it
+    void* held = allocator.fastMalloc(1000);
+    memset(held, 7, 1000);
+
+    void* ptr = allocator.fastMalloc(1000);
+    if (ptr == held || allocator.fallback_count() != 1)
+    {
+        fprintf(stderr, "arena overlapping lifetime is not served from heap, fallback %lu\n", (unsigned long)allocator.fallback_count());
+        return -1;
+    }
+    memset(ptr, 8, 1000);
+
+    if (((const unsigned char*)held)[999] != 7)
+    {
+        fprintf(stderr, "arena held memory was overwritten\n");
+        return -1;
+    }
+
+    allocator.fastFree(ptr);
+    allocator.fastFree(held);
+
+    // a size out of the plan comes from heap too
+    ptr = allocator.fastMalloc(5000);
+    memset(ptr, 9, 5000);
+    allocator.fastFree(ptr);
+
+    if (allocator.fallback_count() != 2)
+    {
+        fprintf(stderr, "arena unplanned size is not served from heap, fallback %lu\n", (unsigned long)allocator.fallback_count());
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_lockfree_pool_allocator_reuse()
+{
+    ncnn::LockFreePoolAllocator allocator;
+
+    void* ptr0 = allocator.fastMalloc(1000);
+    allocator.fastFree(ptr0);
+
+    // same size class
+    void* ptr1 = allocator.fastMalloc(990);
+    allocator.fastFree(ptr1);
+
+    if (ptr0 != ptr1 || allocator.hit_count() != 1 || allocator.miss_count() != 1)
+    {
+        fprintf(stderr, "lock-free pool does not reuse the cached block, hit %lu miss %lu\n", (unsigned long)allocator.hit_count(), (unsigned long)allocator.miss_count());
+        return -1;
+    }
+
+    if (allocator.cached_bytes() == 0)
+    {
+        fprintf(stderr, "lock-free pool caches nothing\n");
+        return -1;
+    }
+
+    allocator.clear();
+
+    if (allocator.cached_bytes() != 0)
+    {
+        fprintf(stderr, "lock-free pool clear leaves %lu bytes\n", (unsigned long)allocator.cached_bytes());
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_lockfree_pool_allocator_max_cached_bytes()
+{
+    ncnn::LockFreePoolAllocator allocator;
+    allocator.set_max_cached_bytes(100000);
+
+    void* ptrs[16];
+    for (int i = 0; i < 16; i++)
+    {
+        ptrs[i] = allocator.fastMalloc(20000);
+    }
+    for (int i = 0; i < 16; i++)
+    {
+        allocator.fastFree(ptrs[i]);
+    }
+
+    if (allocator.cached_bytes() == 0 || allocator.cached_bytes() > 100000)
+    {
+        fprintf(stderr, "lock-free pool caches %lu bytes over the 100000 bytes budget\n", (unsigned long)allocator.cached_bytes());
+        return -1;
+    }
+
+    allocator.clear();
+
+    return 0;
+}
+
+#if NCNN_THREADS
+#define CROSS_THREAD_BLOCK_COUNT 64
+
+struct cross_thread_args
+{
+    ncnn::LockFreePoolAllocator* allocator;
+    void** ptrs;
+};
+
+static void* cross_thread_free(void* args)
+{
+    const cross_thread_args* a = (const cross_thread_args*)args;
+
+    for (int i = 0; i < CROSS_THREAD_BLOCK_COUNT; i++)
+    {
+        a->allocator->fastFree(a->ptrs[i]);
+    }
+
+    return 0;
+}
+
+static void* cross_thread_churn(void* args)
+{
+    ncnn::LockFreePoolAllocator* allocator = (ncnn::LockFreePoolAllocator*)args;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        const size_t size = 64 + (i % 13) * 100;
+        unsigned char* ptr = (unsigned char*)allocator->fastMalloc(size);
+        memset(ptr, i & 0xff, size);
+        allocator->fastFree(ptr);
+    }
+
+    return 0;
+}
+
+static void* thread_exit_free(void* args)
+{
+    ncnn::LockFreePoolAllocator* allocator = (ncnn::LockFreePoolAllocator*)args;
+
+    // only a few blocks, all of them stay in the thread cache
+    void* ptrs[2];
+    for (int i = 0; i < 2; i++)
+    {
+        ptrs[i] = allocator->fastMalloc(4096);
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        allocator->fastFree(ptrs[i]);
+    }
+
+    return 0;
+}
+
+static int test_lockfree_pool_allocator_thread_exit()
+{
+#if defined _WIN32 && !(defined __MINGW32__)
+    // tls slots have no thread exit callback there
+    return 0;
+#else
+    ncnn::LockFreePoolAllocator allocator;
+
+    ncnn::Thread t(thread_exit_free, &allocator);
+    t.join();
+
+    // the exited thread returned its cached blocks to the shared slots
+    void* ptrs[2];
+    for (int i = 0; i < 2; i++)
+    {
+        ptrs[i] = allocator.fastMalloc(4096);
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        allocator.fastFree(ptrs[i]);
+    }
+
+    if (allocator.hit_count() != 2 || allocator.miss_count() != 2)
+    {
+        fprintf(stderr, "lock-free pool strands the blocks of an exited thread, hit %lu miss %lu\n", (unsigned long)allocator.hit_count(), (unsigned long)allocator.miss_count());
+        return -1;
+    }
+
+    allocator.clear();
+
+    return 0;
+#endif
+}
+
+static int test_lockfree_pool_allocator_cross_thread()
+{
+    ncnn::LockFreePoolAllocator allocator;
+
+    // allocate here, free on another thread
+    void* ptrs[CROSS_THREAD_BLOCK_COUNT];
+    for (int i = 0; i < CROSS_THREAD_BLOCK_COUNT; i++)
+    {
+        ptrs[i] = allocator.fastMalloc(4096);
+        memset(ptrs[i], i, 4096);
+    }
+
+    cross_thread_args args = {&allocator, ptrs};
+    ncnn::Thread t(cross_thread_free, &args);
+    t.join();
+
+    // the blocks freed over there are taken back here through the shared slots
+    const size_t hit_count = allocator.hit_count();
+    for (int i = 0; i < CROSS_THREAD_BLOCK_COUNT; i++)
+    {
+        ptrs[i] = allocator.fastMalloc(4096);
+    }
+    for (int i = 0; i < CROSS_THREAD_BLOCK_COUNT; i++)
+    {
+        allocator.fastFree(ptrs[i]);
+    }
+
+    if (allocator.hit_count() == hit_count)
+    {
+        fprintf(stderr, "lock-free pool does not reuse blocks freed on another thread\n");
+        return -1;
+    }
+
+    // concurrent malloc and free
+    const int thread_count = 4;
+    ncnn::Thread* threads[thread_count];
+    for (int i = 0; i < thread_count; i++)
+    {
+        threads[i] = new ncnn::Thread(cross_thread_churn, &allocator);
+    }
+    for (int i = 0; i < thread_count; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    if (allocator.hit_count() + allocator.miss_count() != CROSS_THREAD_BLOCK_COUNT * 2 + 1000 * thread_count)
+    {
+        fprintf(stderr, "lock-free pool counts %lu hits and %lu misses\n", (unsigned long)allocator.hit_count(), (unsigned long)allocator.miss_count());
+        return -1;
+    }
+
+    allocator.clear();
+
+    if (allocator.cached_bytes() != 0)
+    {
+        fprintf(stderr, "lock-free pool clear leaves %lu bytes\n", (unsigned long)allocator.cached_bytes());
+        return -1;
+    }
+
+    return 0;
+}
+#else  // NCNN_THREADS
+static int test_lockfree_pool_allocator_thread_exit()
+{
+    return 0;
+}
+
+static int test_lockfree_pool_allocator_cross_thread()
+{
+    return 0;
+}
+#endif // NCNN_THREADS
+
+int main()
+{
+    return 0
+           || test_arena_allocator_plan()
+           || test_arena_allocator_fallback()
+           || test_lockfree_pool_allocator_reuse()
+           || test_lockfree_pool_allocator_max_cached_bytes()
+           || test_lockfree_pool_allocator_thread_exit()
+           || test_lockfree_pool_allocator_cross_thread();
+}
@@ -91,6 +91,7 @@ static int test_convolutiondepthwise_0()
                   || test_convolutiondepthwise(15, 7, 15, 15, k, d, s, p, 1, 15)
                   || test_convolutiondepthwise(15, 7, 16, 8, k, d, s, p, 0, 2)
                   || test_convolutiondepthwise(15, 7, 16, 16, k, d, s, p, 1, 16)
+                  || test_convolutiondepthwise(15, 7, 32, 32, k, d, s, p, 1, 2)
                   || test_convolutiondepthwise(18, 17, 1, 1, k, d, s, p, 1, 1)
                   || test_convolutiondepthwise(18, 17, 2, 2, k, d, s, p, 0, 1)
                   || test_convolutiondepthwise(18, 17, 2, 2, k, d, s, p, 1, 2)
@@ -104,6 +105,7 @@ static int test_convolutiondepthwise_0()
                   || test_convolutiondepthwise(18, 17, 15, 15, k, d, s, p, 1, 15)
                   || test_convolutiondepthwise(18, 17, 16, 8, k, d, s, p, 0, 2)
                   || test_convolutiondepthwise(18, 17, 16, 16, k, d, s, p, 1, 16)
+                  || test_convolutiondepthwise(18, 17, 32, 48, k, d, s, p, 0, 2)
                   || test_convolutiondepthwise(25, 33, 1, 1, k, d, s, p, 1, 1)
                   || test_convolutiondepthwise(25, 33, 2, 2, k, d, s, p, 0, 1)
                   || test_convolutiondepthwise(25, 33, 2, 2, k, d, s, p, 1, 2)
@@ -101,6 +101,43 @@ static int test_cpu_powersave()
     }
 }
 
+static int test_cpu_numa()
+{
+    const int numa_node_count = ncnn::get_numa_node_count();
+    if (numa_node_count < 1)
+    {
+        fprintf(stderr, "There must be at least one numa node\n");
+        return 1;
+    }
+
+    // every cpu belongs to at most one node
+    int num_cpus = 0;
+    for (int i = 0; i < numa_node_count; i++)
+    {
+        num_cpus += ncnn::get_numa_node_affinity_mask(i).num_enabled();
+    }
+
+    if (num_cpus < 1 || num_cpus > ncnn::get_cpu_count())
+    {
+        fprintf(stderr, "numa nodes hold %d cpus, expect 1 ~ %d\n", num_cpus, ncnn::get_cpu_count());
+        return 1;
+    }
+
+    if (ncnn::get_numa_memory_policy() != -1)
+    {
+        fprintf(stderr, "By default numa memory policy must be -1\n");
+        return 1;
+    }
+
+    if (ncnn::set_numa_memory_policy(-3) != -1 || ncnn::set_numa_memory_policy(numa_node_count) != -1)
+    {
+        fprintf(stderr, "Set numa memory policy for `-3 < argument < %d` works incorrectly.\n", numa_node_count);
+        return 1;
+    }
+
+    return 0;
+}
+
 #else
 
 static int test_cpu_info()
@@ -108,6 +145,11 @@ static int test_cpu_info()
     return 0;
 }
 
+static int test_cpu_numa()
+{
+    return 0;
+}
+
 static int test_cpu_omp()
 {
     return 0;
@@ -126,5 +168,6 @@ int main()
            || test_cpu_set()
            || test_cpu_info()
            || test_cpu_omp()
-           || test_cpu_powersave();
+           || test_cpu_powersave()
+           || test_cpu_numa();
 }
@@ -89,7 +89,9 @@ static int test_deconvolution_0()
                   || test_deconvolution(9, 7, 8, 4, kdsp[i][0], kdsp[i][1], kdsp[i][2], kdsp[i][3], 1, 0, 0, 7, 5)
                   || test_deconvolution(9, 7, 8, 13, kdsp[i][0], kdsp[i][1], kdsp[i][2], kdsp[i][3], 0, 2, 2, 0, 0)
                   || test_deconvolution(9, 7, 13, 8, kdsp[i][0], kdsp[i][1], kdsp[i][2], kdsp[i][3], 1, 2, 0, 0, 0)
-                  || test_deconvolution(9, 7, 16, 16, kdsp[i][0], kdsp[i][1], kdsp[i][2], kdsp[i][3], 0, 0, 2, 7, 5);
+                  || test_deconvolution(9, 7, 16, 16, kdsp[i][0], kdsp[i][1], kdsp[i][2], kdsp[i][3], 0, 0, 2, 7, 5)
+                  || test_deconvolution(9, 7, 3, 32, kdsp[i][0], kdsp[i][1], kdsp[i][2], kdsp[i][3], 1, 0, 0, 0, 0)
+                  || test_deconvolution(9, 7, 32, 3, kdsp[i][0], kdsp[i][1], kdsp[i][2], kdsp[i][3], 1, 0, 0, 0, 0);
 
         if (ret != 0)
             return -1;
@@ -142,6 +142,7 @@ static int test_innerproduct_3()
            || test_innerproduct_int8(RandomMat(2, 2, 7), 7, 1)
            || test_innerproduct_int8(RandomMat(4, 3, 8), 3, 1)
            || test_innerproduct_int8(RandomMat(6, 2, 8), 8, 1)
+           || test_innerproduct_int8(RandomMat(5, 3, 3), 16, 1)
            || test_innerproduct_int8(RandomMat(8, 3, 15), 15, 1)
            || test_innerproduct_int8(RandomMat(7, 2, 16), 4, 1)
            || test_innerproduct_int8(RandomMat(6, 3, 16), 16, 1);
@@ -355,6 +355,313 @@ static int test_mat_pixel_yuv420sp2rgb(int w, int h)
     return 0;
 }
 
+static bool mat_channels_equal(const ncnn::Mat& a, const ncnn::Mat& b)
+{
+    // compare channel by channel, the cstep padding between channels is uninitialized
+    for (int q = 0; q < a.c; q++)
+    {
+        if (memcmp(a.channel(q), b.channel(q), a.w * a.h * sizeof(float)) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+static int test_mat_pixel_from_yuv420(int w, int h, int target_width, int target_height)
+{
+    ncnn::Mat nv21 = RandomMat(w, h / 2 * 3, 1);
+
+    ncnn::Mat nv12 = nv21.clone();
+    ncnn::Mat i420 = nv21.clone();
+
+    // swap VU to UV, and split VU into U and V planes
+    const unsigned char* vu = (const unsigned char*)nv21 + w * h;
+    unsigned char* uv = (unsigned char*)nv12 + w * h;
+    unsigned char* u = (unsigned char*)i420 + w * h;
+    unsigned char* v = u + w * h / 4;
+    for (int i = 0; i < w * h / 4; i++)
+    {
+        uv[i * 2] = vu[i * 2 + 1];
+        uv[i * 2 + 1] = vu[i * 2];
+        u[i] = vu[i * 2 + 1];
+        v[i] = vu[i * 2];
+    }
+
+    ncnn::Mat rgb(w, h, 3u, 3);
+    yuv420sp2rgb(nv21, w, h, rgb);
+
+    ncnn::Mat ref_rgb = ncnn::Mat::from_pixels(rgb, ncnn::Mat::PIXEL_RGB, w, h);
+    ncnn::Mat ref_bgr = ncnn::Mat::from_pixels(rgb, ncnn::Mat::PIXEL_RGB2BGR, w, h);
+
+    const unsigned char* yuvs[3] = {nv21, nv12, i420};
+    const int types[3] = {ncnn::Mat::PIXEL_NV212RGB, ncnn::Mat::PIXEL_NV122RGB, ncnn::Mat::PIXEL_I4202RGB};
+    const int types_bgr[3] = {ncnn::Mat::PIXEL_NV212BGR, ncnn::Mat::PIXEL_NV122BGR, ncnn::Mat::PIXEL_I4202BGR};
+
+    ncnn::Mat resized[3];
+    for (int i = 0; i < 3; i++)
+    {
+        ncnn::Mat m = ncnn::Mat::from_pixels(yuvs[i], types[i], w, h);
+        ncnn::Mat m2 = ncnn::Mat::from_pixels(yuvs[i], types_bgr[i], w, h);
+        if (m.empty() || m2.empty() || !mat_channels_equal(m, ref_rgb) || !mat_channels_equal(m2, ref_bgr))
+        {
+            fprintf(stderr, "test_mat_pixel_from_yuv420 failed w=%d h=%d type=%d\n", w, h, types[i]);
+            return -1;
+        }
+
+        resized[i] = ncnn::Mat::from_pixels_resize(yuvs[i], types[i], w, h, target_width, target_height);
+        if (resized[i].w != target_width || resized[i].h != target_height || resized[i].c != 3)
+        {
+            fprintf(stderr, "test_mat_pixel_from_yuv420 resize failed w=%d h=%d type=%d\n", w, h, types[i]);
+            return -1;
+        }
+    }
+
+    // all layouts carry the same samples and resize identically
+    if (!mat_channels_equal(resized[0], resized[1]) || !mat_channels_equal(resized[0], resized[2]))
+    {
+        fprintf(stderr, "test_mat_pixel_from_yuv420 resize mismatch w=%d h=%d target=%d %d\n", w, h, target_width, target_height);
+        return -1;
+    }
+
+    // roi on even coordinates matches the roi of the converted image
+    const int roix = w / 4 / 2 * 2;
+    const int roiy = h / 4 / 2 * 2;
+    const int roiw = w - roix - 1;
+    const int roih = h - roiy;
+    ncnn::Mat ref_roi = ncnn::Mat::from_pixels_roi(rgb, ncnn::Mat::PIXEL_RGB, w, h, roix, roiy, roiw, roih);
+    for (int i = 0; i < 3; i++)
+    {
+        ncnn::Mat m = ncnn::Mat::from_pixels_roi(yuvs[i], types[i], w, h, roix, roiy, roiw, roih);
+        if (m.empty() || !mat_channels_equal(m, ref_roi))
+        {
+            fprintf(stderr, "test_mat_pixel_from_yuv420 roi failed w=%d h=%d type=%d roi=%d %d %d %d\n", w, h, types[i], roix, roiy, roiw, roih);
+            return -1;
+        }
+
+        // odd roi origin splits a chroma sample
+        ncnn::Mat m2 = ncnn::Mat::from_pixels_roi(yuvs[i], types[i], w, h, 1, 0, w - 1, h);
+        if (!m2.empty())
+        {
+            fprintf(stderr, "test_mat_pixel_from_yuv420 odd roi accepted w=%d h=%d type=%d\n", w, h, types[i]);
+            return -1;
+        }
+    }
+
+    // yuv420 without a convert target is rejected
+    const int bare_types[3] = {ncnn::Mat::PIXEL_NV21, ncnn::Mat::PIXEL_NV12, ncnn::Mat::PIXEL_I420};
+    for (int i = 0; i < 3; i++)
+    {
+        ncnn::Mat m = ncnn::Mat::from_pixels(yuvs[i], bare_types[i], w, h);
+        ncnn::Mat m2 = ncnn::Mat::from_pixels_roi(yuvs[i], bare_types[i], w, h, 0, 0, w, h);
+        if (!m.empty() || !m2.empty())
+        {
+            fprintf(stderr, "test_mat_pixel_from_yuv420 bare type %d accepted\n", bare_types[i]);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+struct pixel_convert_ref_t
+{
+    int type;
+    int src_channels;
+    int dst_channels;
+    // source channel of each destination channel, -1 for opaque alpha, -2 for gray from the first three entries as r g b
+    int map[4];
+};
+
+static const pixel_convert_ref_t g_from_pixels_ref[] = {
+    {ncnn::Mat::PIXEL_GRAY, 1, 1, {0}},
+    {ncnn::Mat::PIXEL_RGB, 3, 3, {0, 1, 2}},
+    {ncnn::Mat::PIXEL_RGBA, 4, 4, {0, 1, 2, 3}},
+    {ncnn::Mat::PIXEL_RGB2BGR, 3, 3, {2, 1, 0}},
+    {ncnn::Mat::PIXEL_RGB2GRAY, 3, 1, {-2, 0, 1, 2}},
+    {ncnn::Mat::PIXEL_BGR2GRAY, 3, 1, {-2, 2, 1, 0}},
+    {ncnn::Mat::PIXEL_RGB2RGBA, 3, 4, {0, 1, 2, -1}},
+    {ncnn::Mat::PIXEL_BGR2RGBA, 3, 4, {2, 1, 0, -1}},
+    {ncnn::Mat::PIXEL_GRAY2RGB, 1, 3, {0, 0, 0}},
+    {ncnn::Mat::PIXEL_GRAY2RGBA, 1, 4, {0, 0, 0, -1}},
+    {ncnn::Mat::PIXEL_RGBA2RGB, 4, 3, {0, 1, 2}},
+    {ncnn::Mat::PIXEL_RGBA2BGR, 4, 3, {2, 1, 0}},
+    {ncnn::Mat::PIXEL_RGBA2GRAY, 4, 1, {-2, 0, 1, 2}},
+    {ncnn::Mat::PIXEL_RGBA2BGRA, 4, 4, {2, 1, 0, 3}},
+    {ncnn::Mat::PIXEL_BGRA2GRAY, 4, 1, {-2, 2, 1, 0}},
+};
+
+static const pixel_convert_ref_t g_to_pixels_ref[] = {
+    {ncnn::Mat::PIXEL_GRAY, 1, 1, {0}},
+    {ncnn::Mat::PIXEL_RGB, 3, 3, {0, 1, 2}},
+    {ncnn::Mat::PIXEL_RGBA, 4, 4, {0, 1, 2, 3}},
+    {ncnn::Mat::PIXEL_BGR2RGB, 3, 3, {2, 1, 0}},
+    {ncnn::Mat::PIXEL_RGB2RGBA, 3, 4, {0, 1, 2, -1}},
+    {ncnn::Mat::PIXEL_BGR2RGBA, 3, 4, {2, 1, 0, -1}},
+    {ncnn::Mat::PIXEL_GRAY2RGBA, 1, 4, {0, 0, 0, -1}},
+    {ncnn::Mat::PIXEL_RGBA2BGRA, 4, 4, {2, 1, 0, 3}},
+};
+
+static int test_mat_pixel_from_pixels_ref(int w, int h, int wpad)
+{
+    const int count = sizeof(g_from_pixels_ref) / sizeof(g_from_pixels_ref[0]);
+    for (int t = 0; t < count; t++)
+    {
+        const pixel_convert_ref_t& r = g_from_pixels_ref[t];
+
+        const int stride = w * r.src_channels + wpad;
+        ncnn::Mat a = RandomMat(stride, h, 1);
+
+        ncnn::Mat m = ncnn::Mat::from_pixels(a, r.type, w, h, stride);
+        if (m.w != w || m.h != h || m.c != r.dst_channels)
+        {
+            fprintf(stderr, "test_mat_pixel_from_pixels_ref shape mismatch w=%d h=%d wpad=%d pixel_type=%d\n", w, h, wpad, r.type);
+            return -1;
+        }
+
+        for (int q = 0; q < r.dst_channels; q++)
+        {
+            const float* ptr = m.channel(q);
+            for (int y = 0; y < h; y++)
+            {
+                const unsigned char* p = (const unsigned char*)a + y * stride;
+                for (int x = 0; x < w; x++)
+                {
+                    const unsigned char* px = p + x * r.src_channels;
+
+                    float v;
+                    if (r.map[0] == -2)
+                        v = (float)((px[r.map[1]] * 77 + px[r.map[2]] * 150 + px[r.map[3]] * 29) >> 8);
+                    else if (r.map[q] == -1)
+                        v = 255.f;
+                    else
+                        v = (float)px[r.map[q]];
+
+                    if (ptr[y * w + x] != v)
+                    {
+                        fprintf(stderr, "test_mat_pixel_from_pixels_ref failed w=%d h=%d wpad=%d pixel_type=%d at %d %d %d got %f expect %f\n", w, h, wpad, r.type, q, y, x, ptr[y * w + x], v);
+                        return -1;
+                    }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_to_pixels_ref(int w, int h, int wpad)
+{
+    const int count = sizeof(g_to_pixels_ref) / sizeof(g_to_pixels_ref[0]);
+    for (int t = 0; t < count; t++)
+    {
+        const pixel_convert_ref_t& r = g_to_pixels_ref[t];
+
+        // cover truncation and saturation on both ends
+        ncnn::Mat m(w, h, r.src_channels);
+        for (int q = 0; q < r.src_channels; q++)
+        {
+            float* ptr = m.channel(q);
+            for (int i = 0; i < w * h; i++)
+            {
+                ptr[i] = (RAND() % 3200) / 10.f - 30.f;
+            }
+        }
+
+        const int stride = w * r.dst_channels + wpad;
+        ncnn::Mat b = FilledMat(stride, h, 1, 0);
+        m.to_pixels(b, r.type, stride);
+
+        for (int y = 0; y < h; y++)
+        {
+            const unsigned char* p = (const unsigned char*)b + y * stride;
+            for (int x = 0; x < w; x++)
+            {
+                for (int k = 0; k < r.dst_channels; k++)
+                {
+                    int v = 255;
+                    if (r.map[k] != -1)
+                    {
+                        v = (int)m.channel(r.map[k])[y * w + x];
+                        v = v < 0 ? 0 : v > 255 ? 255 : v;
+                    }
+
+                    if (p[x * r.dst_channels + k] != v)
+                    {
+                        fprintf(stderr, "test_mat_pixel_to_pixels_ref failed w=%d h=%d wpad=%d pixel_type=%d at %d %d %d got %d expect %d\n", w, h, wpad, r.type, y, x, k, p[x * r.dst_channels + k], v);
+                        return -1;
+                    }
+                }
+            }
+
+            for (int x = w * r.dst_channels; x < stride; x++)
+            {
+                if (p[x] != 0)
+                {
+                    fprintf(stderr, "test_mat_pixel_to_pixels_ref wrote into stride gap w=%d h=%d wpad=%d pixel_type=%d\n", w, h, wpad, r.type);
+                    return -1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_option(int w, int h, int roix, int roiy, int roiw, int roih, int num_threads)
+{
+    ncnn::Option opt;
+    opt.num_threads = num_threads;
+
+    const int count = sizeof(g_from_pixels_ref) / sizeof(g_from_pixels_ref[0]);
+    for (int t = 0; t < count; t++)
+    {
+        const pixel_convert_ref_t& r = g_from_pixels_ref[t];
+
+        ncnn::Mat a = RandomMat(w, h, r.src_channels);
+
+        ncnn::Mat m0 = ncnn::Mat::from_pixels_roi(a, r.type, w, h, roix, roiy, roiw, roih);
+        ncnn::Mat m1 = ncnn::Mat::from_pixels_roi(a, r.type, w, h, roix, roiy, roiw, roih, opt);
+
+        if (m0.w != m1.w || m0.h != m1.h || m0.c != m1.c)
+        {
+            fprintf(stderr, "test_mat_pixel_option from_pixels_roi shape mismatch w=%d h=%d roi=[%d %d %d %d] num_threads=%d pixel_type=%d\n", w, h, roix, roiy, roiw, roih, num_threads, r.type);
+            return -1;
+        }
+
+        for (int q = 0; q < m0.c; q++)
+        {
+            if (memcmp(m0.channel(q), m1.channel(q), roiw * roih * sizeof(float)) != 0)
+            {
+                fprintf(stderr, "test_mat_pixel_option from_pixels_roi failed w=%d h=%d roi=[%d %d %d %d] num_threads=%d pixel_type=%d\n", w, h, roix, roiy, roiw, roih, num_threads, r.type);
+                return -1;
+            }
+        }
+    }
+
+    const int to_count = sizeof(g_to_pixels_ref) / sizeof(g_to_pixels_ref[0]);
+    for (int t = 0; t < to_count; t++)
+    {
+        const pixel_convert_ref_t& r = g_to_pixels_ref[t];
+
+        ncnn::Mat a = RandomMat(w, h, r.src_channels);
+
+        ncnn::Mat m = ncnn::Mat::from_pixels(a, r.src_channels == 1 ? ncnn::Mat::PIXEL_GRAY : r.src_channels == 3 ? ncnn::Mat::PIXEL_RGB : ncnn::Mat::PIXEL_RGBA, w, h);
+
+        ncnn::Mat b0 = FilledMat(w, h, r.dst_channels, 0);
+        ncnn::Mat b1 = FilledMat(w, h, r.dst_channels, 0);
+        m.to_pixels(b0, r.type);
+        m.to_pixels(b1, r.type, opt);
+
+        if (memcmp(b0, b1, w * h * r.dst_channels) != 0)
+        {
+            fprintf(stderr, "test_mat_pixel_option to_pixels failed w=%d h=%d num_threads=%d pixel_type=%d\n", w, h, num_threads, r.type);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
 static int test_mat_pixel_0()
 {
     return 0
@@ -424,6 +731,39 @@ static int test_mat_pixel_6()
            || test_mat_pixel_yuv420sp2rgb(6, 6);
 }
 
+static int test_mat_pixel_7()
+{
+    return 0
+           || test_mat_pixel_from_pixels_ref(1, 1, 0)
+           || test_mat_pixel_from_pixels_ref(16, 3, 0)
+           || test_mat_pixel_from_pixels_ref(37, 7, 0)
+           || test_mat_pixel_from_pixels_ref(37, 7, 5)
+           || test_mat_pixel_from_pixels_ref(64, 5, 3)
+           || test_mat_pixel_to_pixels_ref(1, 1, 0)
+           || test_mat_pixel_to_pixels_ref(16, 3, 0)
+           || test_mat_pixel_to_pixels_ref(37, 7, 0)
+           || test_mat_pixel_to_pixels_ref(37, 7, 5)
+           || test_mat_pixel_to_pixels_ref(64, 5, 3);
+}
+
+static int test_mat_pixel_8()
+{
+    return 0
+           || test_mat_pixel_option(15, 15, 0, 0, 15, 15, 4)
+           || test_mat_pixel_option(67, 33, 3, 5, 50, 27, 4)
+           || test_mat_pixel_option(40, 3, 1, 0, 35, 3, 8)
+           || test_mat_pixel_option(21, 9, 2, 2, 17, 1, 2);
+}
+
+static int test_mat_pixel_9()
+{
+    return 0
+           || test_mat_pixel_from_yuv420(4, 4, 5, 3)
+           || test_mat_pixel_from_yuv420(16, 16, 16, 16)
+           || test_mat_pixel_from_yuv420(38, 22, 19, 11)
+           || test_mat_pixel_from_yuv420(64, 34, 100, 70);
+}
+
 int main()
 {
     SRAND(7767517);
@@ -435,5 +775,8 @@ int main()
            || test_mat_pixel_3()
            || test_mat_pixel_4()
            || test_mat_pixel_5()
-           || test_mat_pixel_6();
+           || test_mat_pixel_6()
+           || test_mat_pixel_7()
+           || test_mat_pixel_8()
+           || test_mat_pixel_9();
 }
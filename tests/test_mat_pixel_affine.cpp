@@ -17,6 +17,7 @@
 
 #include <math.h>
 #include <string.h>
+#include <vector>
 
 static struct prng_rand_t g_prng_rand_state;
 #define SRAND(seed) prng_srand(seed, &g_prng_rand_state)
@@ -499,9 +500,79 @@ static int test_mat_pixel_affine_1()
            || test_mat_pixel_affine_yuv420sp(220, 340);
 }
 
+static void warpaffine_bilinear(const ncnn::Mat& a, int w, int h, int c, ncnn::Mat& b, int target_width, int target_height, const float* tm, int type)
+{
+    if (c == 1) ncnn::warpaffine_bilinear_c1(a, w, h, b, target_width, target_height, tm, type, 0x20406080);
+    if (c == 2) ncnn::warpaffine_bilinear_c2(a, w, h, b, target_width, target_height, tm, type, 0x20406080);
+    if (c == 3) ncnn::warpaffine_bilinear_c3(a, w, h, b, target_width, target_height, tm, type, 0x20406080);
+    if (c == 4) ncnn::warpaffine_bilinear_c4(a, w, h, b, target_width, target_height, tm, type, 0x20406080);
+}
+
+static int test_mat_pixel_affine_batch(int w, int h, int target_width, int target_height, int count, int num_threads)
+{
+    ncnn::Option opt;
+    opt.num_threads = num_threads;
+
+    for (int c = 1; c <= 4; c++)
+    {
+        ncnn::Mat a = RandomMat(w, h, c);
+
+        std::vector<float> tms(count * 6);
+        for (int i = 0; i < count; i++)
+        {
+            // regions all over the source, some of them partially outside
+            ncnn::get_rotation_matrix(i * 37.f, 0.5f + i * 0.25f, (float)(RAND() % w), (float)(RAND() % h), &tms[i * 6]);
+        }
+
+        for (int type = 0; type >= -233; type -= 233)
+        {
+            std::vector<ncnn::Mat> expect(count);
+            std::vector<ncnn::Mat> outs(count);
+            std::vector<unsigned char*> dsts(count);
+            for (int i = 0; i < count; i++)
+            {
+                expect[i] = ncnn::Mat(target_width, target_height, (size_t)c, c);
+                memset(expect[i], 0, target_width * target_height * c);
+                warpaffine_bilinear(a, w, h, c, expect[i], target_width, target_height, &tms[i * 6], type);
+
+                outs[i] = ncnn::Mat(target_width, target_height, (size_t)c, c);
+                memset(outs[i], 0, target_width * target_height * c);
+                dsts[i] = outs[i];
+            }
+
+            const int srcstride = w * c;
+            const int stride = target_width * c;
+            if (c == 1) ncnn::warpaffine_bilinear_batch_c1(a, w, h, srcstride, dsts.data(), target_width, target_height, stride, tms.data(), count, type, 0x20406080, opt);
+            if (c == 2) ncnn::warpaffine_bilinear_batch_c2(a, w, h, srcstride, dsts.data(), target_width, target_height, stride, tms.data(), count, type, 0x20406080, opt);
+            if (c == 3) ncnn::warpaffine_bilinear_batch_c3(a, w, h, srcstride, dsts.data(), target_width, target_height, stride, tms.data(), count, type, 0x20406080, opt);
+            if (c == 4) ncnn::warpaffine_bilinear_batch_c4(a, w, h, srcstride, dsts.data(), target_width, target_height, stride, tms.data(), count, type, 0x20406080, opt);
+
+            for (int i = 0; i < count; i++)
+            {
+                if (memcmp(expect[i], outs[i], target_width * target_height * c) != 0)
+                {
+                    fprintf(stderr, "test_mat_pixel_affine_batch failed w=%d h=%d target_width=%d target_height=%d count=%d num_threads=%d c=%d type=%d i=%d\n", w, h, target_width, target_height, count, num_threads, c, type, i);
+                    return -1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_affine_2()
+{
+    return 0
+           || test_mat_pixel_affine_batch(120, 160, 112, 112, 1, 1)
+           || test_mat_pixel_affine_batch(120, 160, 112, 112, 2, 4)
+           || test_mat_pixel_affine_batch(220, 330, 43, 37, 9, 4)
+           || test_mat_pixel_affine_batch(220, 330, 17, 29, 5, 2);
+}
+
 int main()
 {
     SRAND(7767517);
 
-    return test_mat_pixel_affine_0() || test_mat_pixel_affine_1();
+    return test_mat_pixel_affine_0() || test_mat_pixel_affine_1() || test_mat_pixel_affine_2();
 }
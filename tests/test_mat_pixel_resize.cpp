@@ -276,6 +276,190 @@ static int test_mat_pixel_roi_resize_bgra(int w, int h, int roix, int roiy, int
     return 0;
 }
 
+static int test_mat_pixel_roi_resize_normalize(int w, int h, int roix, int roiy, int roiw, int roih, int target_width, int target_height)
+{
+    const int pixel_types[] = {
+        ncnn::Mat::PIXEL_GRAY, ncnn::Mat::PIXEL_RGB, ncnn::Mat::PIXEL_RGBA, ncnn::Mat::PIXEL_RGB2BGR,
+        ncnn::Mat::PIXEL_RGB2GRAY, ncnn::Mat::PIXEL_BGR2GRAY, ncnn::Mat::PIXEL_RGB2RGBA, ncnn::Mat::PIXEL_BGR2RGBA,
+        ncnn::Mat::PIXEL_GRAY2RGB, ncnn::Mat::PIXEL_GRAY2RGBA, ncnn::Mat::PIXEL_RGBA2RGB, ncnn::Mat::PIXEL_RGBA2BGR,
+        ncnn::Mat::PIXEL_RGBA2GRAY, ncnn::Mat::PIXEL_RGBA2BGRA, ncnn::Mat::PIXEL_BGRA2GRAY
+    };
+
+    const float mean_vals[4] = {103.94f, 116.78f, 123.68f, 127.5f};
+    const float norm_vals[4] = {0.017f, 0.018f, 0.019f, 0.02f};
+
+    ncnn::Option opt;
+    opt.num_threads = 3;
+
+    for (int i = 0; i < (int)(sizeof(pixel_types) / sizeof(pixel_types[0])); i++)
+    {
+        const int type = pixel_types[i];
+        const int type_from = type & ncnn::Mat::PIXEL_FORMAT_MASK;
+        const int src_channels = type_from == ncnn::Mat::PIXEL_GRAY ? 1 : (type_from == ncnn::Mat::PIXEL_RGB || type_from == ncnn::Mat::PIXEL_BGR) ? 3 : 4;
+
+        ncnn::Mat a = RandomMat(w, h, src_channels);
+
+        // reference is the resize, normalize and packing passes one after another
+        ncnn::Mat b = ncnn::Mat::from_pixels_roi_resize(a, type, w, h, w * src_channels, roix, roiy, roiw, roih, target_width, target_height);
+        b.substract_mean_normalize(mean_vals, norm_vals);
+
+        for (int elempack = 1; elempack <= 4; elempack += 3)
+        {
+            if (b.c % elempack != 0)
+                continue;
+
+            ncnn::Mat c;
+            ncnn::convert_packing(b, c, elempack);
+
+            ncnn::Mat d = ncnn::Mat::from_pixels_roi_resize_normalize(a, type, w, h, w * src_channels, roix, roiy, roiw, roih, target_width, target_height, mean_vals, norm_vals, elempack, opt);
+
+            // the reference rounds the resized pixels and truncates gray to uint8
+            if (Compare(c, d, 0.05f) != 0)
+            {
+                fprintf(stderr, "test_mat_pixel_roi_resize_normalize failed w=%d h=%d roi=[%d %d %d %d] target_width=%d target_height=%d pixel_type=%d elempack=%d\n", w, h, roix, roiy, roiw, roih, target_width, target_height, type, elempack);
+                return -1;
+            }
+
+            ncnn::Option opt1;
+            opt1.num_threads = 1;
+            ncnn::Mat e = ncnn::Mat::from_pixels_roi_resize_normalize(a, type, w, h, w * src_channels, roix, roiy, roiw, roih, target_width, target_height, mean_vals, norm_vals, elempack, opt1);
+
+            if (Compare(e, d, 0.f) != 0)
+            {
+                fprintf(stderr, "test_mat_pixel_roi_resize_normalize threads mismatch w=%d h=%d roi=[%d %d %d %d] target_width=%d target_height=%d pixel_type=%d elempack=%d\n", w, h, roix, roiy, roiw, roih, target_width, target_height, type, elempack);
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_resize_threads(int w, int h, int ch, int target_width, int target_height)
+{
+    ncnn::Mat a = RandomMat(w, h, ch);
+
+    ncnn::Mat b(target_width, target_height, 1, (size_t)ch, ch);
+    ncnn::Mat c(target_width, target_height, 1, (size_t)ch, ch);
+
+    ncnn::Option opt;
+    opt.num_threads = 3;
+
+    const int srcstride = w * ch;
+    const int stride = target_width * ch;
+
+    if (ch == 1) resize_bilinear_c1(a, w, h, b, target_width, target_height);
+    if (ch == 2) resize_bilinear_c2(a, w, h, b, target_width, target_height);
+    if (ch == 3) resize_bilinear_c3(a, w, h, b, target_width, target_height);
+    if (ch == 4) resize_bilinear_c4(a, w, h, b, target_width, target_height);
+
+    if (ch == 1) resize_bilinear_c1(a, w, h, srcstride, c, target_width, target_height, stride, opt);
+    if (ch == 2) resize_bilinear_c2(a, w, h, srcstride, c, target_width, target_height, stride, opt);
+    if (ch == 3) resize_bilinear_c3(a, w, h, srcstride, c, target_width, target_height, stride, opt);
+    if (ch == 4) resize_bilinear_c4(a, w, h, srcstride, c, target_width, target_height, stride, opt);
+
+    if (memcmp(b, c, target_width * target_height * ch) != 0)
+    {
+        fprintf(stderr, "test_mat_pixel_resize_threads failed w=%d h=%d ch=%d target_width=%d target_height=%d\n", w, h, ch, target_width, target_height);
+        return -1;
+    }
+
+    return 0;
+}
+
+// weighted average of the source pixels covered by each destination pixel
+static void resize_area_naive(const unsigned char* src, int w, int h, int ch, unsigned char* dst, int target_width, int target_height)
+{
+    const double scale_x = (double)w / target_width;
+    const double scale_y = (double)h / target_height;
+
+    for (int dy = 0; dy < target_height; dy++)
+    {
+        const double fy0 = dy * scale_y;
+        const double fy1 = fy0 + scale_y;
+
+        for (int dx = 0; dx < target_width; dx++)
+        {
+            const double fx0 = dx * scale_x;
+            const double fx1 = fx0 + scale_x;
+
+            for (int k = 0; k < ch; k++)
+            {
+                double sum = 0.0;
+                for (int y = (int)fy0; y < h && y < fy1; y++)
+                {
+                    const double wy = std::min(fy1, y + 1.0) - std::max(fy0, (double)y);
+                    for (int x = (int)fx0; x < w && x < fx1; x++)
+                    {
+                        const double wx = std::min(fx1, x + 1.0) - std::max(fx0, (double)x);
+                        sum += src[(y * w + x) * ch + k] * wx * wy;
+                    }
+                }
+
+                dst[(dy * target_width + dx) * ch + k] = (unsigned char)(sum / (scale_x * scale_y) + 0.5);
+            }
+        }
+    }
+}
+
+static int test_mat_pixel_resize_area(int w, int h, int ch, int target_width, int target_height)
+{
+    ncnn::Mat a = RandomMat(w, h, ch);
+
+    ncnn::Mat b(target_width, target_height, 1, (size_t)ch, ch);
+    ncnn::Mat c(target_width, target_height, 1, (size_t)ch, ch);
+    ncnn::Mat d(target_width, target_height, 1, (size_t)ch, ch);
+
+    ncnn::Option opt;
+    opt.num_threads = 3;
+
+    const int srcstride = w * ch;
+    const int stride = target_width * ch;
+
+    if (ch == 1) resize_area_c1(a, w, h, b, target_width, target_height);
+    if (ch == 2) resize_area_c2(a, w, h, b, target_width, target_height);
+    if (ch == 3) resize_area_c3(a, w, h, b, target_width, target_height);
+    if (ch == 4) resize_area_c4(a, w, h, b, target_width, target_height);
+
+    if (ch == 1) resize_area_c1(a, w, h, srcstride, c, target_width, target_height, stride, opt);
+    if (ch == 2) resize_area_c2(a, w, h, srcstride, c, target_width, target_height, stride, opt);
+    if (ch == 3) resize_area_c3(a, w, h, srcstride, c, target_width, target_height, stride, opt);
+    if (ch == 4) resize_area_c4(a, w, h, srcstride, c, target_width, target_height, stride, opt);
+
+    if (memcmp(b, c, target_width * target_height * ch) != 0)
+    {
+        fprintf(stderr, "test_mat_pixel_resize_area threads mismatch w=%d h=%d ch=%d target_width=%d target_height=%d\n", w, h, ch, target_width, target_height);
+        return -1;
+    }
+
+    if (target_width > w || target_height > h)
+    {
+        // enlarging falls back to bilinear
+        if (ch == 1) resize_bilinear_c1(a, w, h, d, target_width, target_height);
+        if (ch == 2) resize_bilinear_c2(a, w, h, d, target_width, target_height);
+        if (ch == 3) resize_bilinear_c3(a, w, h, d, target_width, target_height);
+        if (ch == 4) resize_bilinear_c4(a, w, h, d, target_width, target_height);
+    }
+    else
+    {
+        resize_area_naive(a, w, h, ch, d, target_width, target_height);
+    }
+
+    const unsigned char* pb = b;
+    const unsigned char* pd = d;
+    for (int i = 0; i < target_width * target_height * ch; i++)
+    {
+        // float accumulation may round the other way
+        if (abs(pb[i] - pd[i]) > 1)
+        {
+            fprintf(stderr, "test_mat_pixel_resize_area failed w=%d h=%d ch=%d target_width=%d target_height=%d  at %d expect %d but got %d\n", w, h, ch, target_width, target_height, i, pd[i], pb[i]);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
 static int test_mat_pixel_0()
 {
     for (int c = 1; c <= 4; c++)
@@ -314,9 +498,42 @@ static int test_mat_pixel_2()
            || test_mat_pixel_roi_resize_bgra(15, 15, 7, 3, 1, 1, 1, 1);
 }
 
+static int test_mat_pixel_3()
+{
+    return 0
+           || test_mat_pixel_roi_resize_normalize(16, 16, 0, 0, 16, 16, 16, 16)
+           || test_mat_pixel_roi_resize_normalize(16, 16, 1, 1, 13, 13, 10, 11)
+           || test_mat_pixel_roi_resize_normalize(33, 23, 2, 3, 27, 19, 5, 6)
+           || test_mat_pixel_roi_resize_normalize(15, 15, 3, 4, 5, 4, 11, 13)
+           || test_mat_pixel_roi_resize_normalize(40, 30, 0, 5, 40, 20, 23, 9);
+}
+
+static int test_mat_pixel_4()
+{
+    for (int c = 1; c <= 4; c++)
+    {
+        int ret = 0
+                  || test_mat_pixel_resize_threads(24, 48, c, 24, 48)
+                  || test_mat_pixel_resize_threads(13, 17, c, 11, 14)
+                  || test_mat_pixel_resize_threads(67, 45, c, 31, 23)
+                  || test_mat_pixel_resize_threads(5, 4, c, 11, 16)
+                  || test_mat_pixel_resize_area(24, 48, c, 24, 48)
+                  || test_mat_pixel_resize_area(64, 48, c, 16, 12)
+                  || test_mat_pixel_resize_area(33, 23, c, 5, 6)
+                  || test_mat_pixel_resize_area(67, 45, c, 31, 23)
+                  || test_mat_pixel_resize_area(37, 19, c, 36, 2)
+                  || test_mat_pixel_resize_area(5, 4, c, 11, 16);
+
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
 int main()
 {
     SRAND(7767517);
 
-    return test_mat_pixel_0() || test_mat_pixel_1() || test_mat_pixel_2();
+    return test_mat_pixel_0() || test_mat_pixel_1() || test_mat_pixel_2() || test_mat_pixel_3() || test_mat_pixel_4();
 }
@@ -175,6 +175,44 @@ static int test_mat_pixel_rotate_0()
            || test_mat_pixel_rotate_c4(22, 33);
 }
 
+static int test_mat_pixel_rotate_transpose(int w, int h, int c)
+{
+    ncnn::Mat a0 = RandomMat(w, h, c);
+
+    for (int type = 5; type <= 8; type++)
+    {
+        ncnn::Mat a1(h, w, (size_t)c, c);
+
+        if (c == 1)
+            ncnn::kanna_rotate_c1(a0, w, h, a1, h, w, type);
+        if (c == 2)
+            ncnn::kanna_rotate_c2(a0, w, h, a1, h, w, type);
+        if (c == 3)
+            ncnn::kanna_rotate_c3(a0, w, h, a1, h, w, type);
+        if (c == 4)
+            ncnn::kanna_rotate_c4(a0, w, h, a1, h, w, type);
+
+        // 5 = transpose, 6 = rotate 90, 7 = transverse, 8 = rotate 270
+        const unsigned char* p0 = a0;
+        const unsigned char* p1 = a1;
+        for (int y = 0; y < w; y++)
+        {
+            for (int x = 0; x < h; x++)
+            {
+                int sx = (type == 7 || type == 8) ? w - 1 - y : y;
+                int sy = (type == 6 || type == 7) ? h - 1 - x : x;
+                if (memcmp(p1 + (y * h + x) * c, p0 + (sy * w + sx) * c, c) != 0)
+                {
+                    fprintf(stderr, "test_mat_pixel_rotate_transpose failed w=%d h=%d c=%d type=%d\n", w, h, c, type);
+                    return -1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
 static int test_mat_pixel_rotate_yuv420sp(int w, int h)
 {
     ncnn::Mat a0 = RandomMat(w, h * 3 / 2, 1);
@@ -214,11 +252,27 @@ static int test_mat_pixel_rotate_1()
            || test_mat_pixel_rotate_yuv420sp(22, 34);
 }
 
+static int test_mat_pixel_rotate_2()
+{
+    return 0
+           || test_mat_pixel_rotate_transpose(3, 5, 1)
+           || test_mat_pixel_rotate_transpose(35, 41, 1)
+           || test_mat_pixel_rotate_transpose(35, 41, 2)
+           || test_mat_pixel_rotate_transpose(35, 41, 3)
+           || test_mat_pixel_rotate_transpose(35, 41, 4)
+           || test_mat_pixel_rotate_transpose(64, 24, 1)
+           || test_mat_pixel_rotate_transpose(64, 24, 4)
+           || test_mat_pixel_rotate_c1(40, 33)
+           || test_mat_pixel_rotate_c3(40, 33)
+           || test_mat_pixel_rotate_yuv420sp(36, 50);
+}
+
 int main()
 {
     SRAND(7767517);
 
     return 0
            || test_mat_pixel_rotate_0()
-           || test_mat_pixel_rotate_1();
+           || test_mat_pixel_rotate_1()
+           || test_mat_pixel_rotate_2();
 }
@@ -0,0 +1,121 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <stdio.h>
+#include <string.h>
+
+// more loops than one dispatch chunk of simpleomp holds
+#define LOOP_COUNT 12
+#define ITER_COUNT 1000
+
+static int check_counts(const int* counts, const char* schedule)
+{
+    for (int i = 0; i < LOOP_COUNT; i++)
+    {
+        for (int j = 0; j < ITER_COUNT; j++)
+        {
+            int count = counts[i * ITER_COUNT + j];
+            if (count != 1)
+            {
+                fprintf(stderr, "%s loop %d iteration %d runs %d times\n", schedule, i, j, count);
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+// every loop instance in one parallel region hands out its own iterations
+// nowait lets fast threads enter the next loop while others are still in the previous one
+static int test_openmp_dynamic_loops(int num_threads)
+{
+    static int counts[LOOP_COUNT * ITER_COUNT];
+    memset(counts, 0, sizeof(counts));
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        for (int i = 0; i < LOOP_COUNT; i++)
+        {
+            #pragma omp for schedule(dynamic) nowait
+            for (int j = 0; j < ITER_COUNT; j++)
+            {
+                #pragma omp atomic
+                counts[i * ITER_COUNT + j]++;
+            }
+        }
+    }
+
+    return check_counts(counts, "dynamic");
+}
+
+static int test_openmp_guided_loops(int num_threads)
+{
+    static int counts[LOOP_COUNT * ITER_COUNT];
+    memset(counts, 0, sizeof(counts));
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        for (int i = 0; i < LOOP_COUNT; i++)
+        {
+            // alternate with dynamic so that both kinds share the loop numbering
+            if (i % 2 == 0)
+            {
+                #pragma omp for schedule(guided) nowait
+                for (int j = 0; j < ITER_COUNT; j++)
+                {
+                    #pragma omp atomic
+                    counts[i * ITER_COUNT + j]++;
+                }
+            }
+            else
+            {
+                #pragma omp for schedule(dynamic, 7) nowait
+                for (int j = 0; j < ITER_COUNT; j++)
+                {
+                    #pragma omp atomic
+                    counts[i * ITER_COUNT + j]++;
+                }
+            }
+        }
+    }
+
+    return check_counts(counts, "guided");
+}
+
+static int test_openmp(int num_threads)
+{
+    // repeat so that a stale counter from the previous region shows up
+    for (int i = 0; i < 3; i++)
+    {
+        int ret = test_openmp_dynamic_loops(num_threads)
+                  || test_openmp_guided_loops(num_threads);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_openmp failed num_threads=%d\n", num_threads);
+            return ret;
+        }
+    }
+
+    return 0;
+}
+
+int main()
+{
+    return 0
+           || test_openmp(1)
+           || test_openmp(2)
+           || test_openmp(4)
+           || test_openmp(8);
+}
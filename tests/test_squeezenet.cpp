@@ -14,9 +14,12 @@
 
 #include "platform.h"
 #include "net.h"
+#include "sessionpool.h"
+#include "threadpool.h"
 #include "testutil.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -156,18 +159,18 @@ static ncnn::Mat read_file_content(const char* filepath)
     return m;
 }
 
-static int test_squeezenet(const ncnn::Option& opt, int load_model_type, float epsilon = 0.001)
-{
-    ncnn::Net squeezenet;
-
-    squeezenet.opt = opt;
-
 #ifdef __EMSCRIPTEN__
 #define MODEL_DIR "/working"
 #else
 #define MODEL_DIR "../../examples"
 #endif
 
+static int test_squeezenet(const ncnn::Option& opt, int load_model_type, float epsilon = 0.001)
+{
+    ncnn::Net squeezenet;
+
+    squeezenet.opt = opt;
+
     std::string param_str;
     ncnn::Mat param_data;
     ncnn::Mat model_data;
@@ -229,6 +232,396 @@ static int test_squeezenet(const ncnn::Option& opt, int load_model_type, float e
     return check_top3(cls_scores, epsilon);
 }
 
+// the plain model files, optionally with transformed weights from a prepacked file
+static int load_squeezenet(ncnn::Net& squeezenet, const ncnn::Option& opt, const char* prepacked_path = 0)
+{
+    squeezenet.opt = opt;
+
+    int ret = squeezenet.load_param(MODEL_DIR "/squeezenet_v1.1.param");
+    if (ret != 0)
+    {
+        fprintf(stderr, "load_param failed %d\n", ret);
+        return -1;
+    }
+
+    if (prepacked_path)
+    {
+        ret = squeezenet.load_prepacked(prepacked_path);
+        if (ret != 0)
+        {
+            fprintf(stderr, "load_prepacked failed %d\n", ret);
+            return -1;
+        }
+    }
+
+    ret = squeezenet.load_model(MODEL_DIR "/squeezenet_v1.1.bin");
+    if (ret != 0)
+    {
+        fprintf(stderr, "load_model failed %d\n", ret);
+        return -1;
+    }
+
+    return 0;
+}
+
+static ncnn::Mat squeezenet_input()
+{
+    ncnn::Mat in = generate_ncnn_logo(ncnn::Mat::PIXEL_BGR, 227, 227);
+
+    const float mean_vals[3] = {104.f, 117.f, 123.f};
+    in.substract_mean_normalize(mean_vals, 0);
+
+    return in;
+}
+
+static int check_squeezenet_top3(const ncnn::Mat& out, float epsilon)
+{
+    std::vector<float> cls_scores;
+    cls_scores.resize(out.w);
+    for (int j = 0; j < out.w; j++)
+    {
+        cls_scores[j] = out[j];
+    }
+
+    return check_top3(cls_scores, epsilon);
+}
+
+static int test_squeezenet_batch(const ncnn::Option& opt, int batch, float epsilon = 0.001)
+{
+    ncnn::Net squeezenet;
+    if (load_squeezenet(squeezenet, opt) != 0)
+        return -1;
+
+    ncnn::Mat in = squeezenet_input();
+
+    std::vector<ncnn::Mat> in_batch(batch);
+    for (int i = 0; i < batch; i++)
+    {
+        in_batch[i] = in.clone();
+    }
+
+    ncnn::Extractor ex = squeezenet.create_extractor();
+
+    if (ex.input("data", std::vector<ncnn::Mat>()) != -1)
+    {
+        fprintf(stderr, "empty input batch must be rejected\n");
+        return -1;
+    }
+
+    std::vector<ncnn::Mat> out_batch;
+    ex.input("data", in_batch);
+    int ret = ex.extract("prob", out_batch);
+    if (ret != 0 || (int)out_batch.size() != batch)
+    {
+        fprintf(stderr, "extract batch failed %d\n", ret);
+        return -1;
+    }
+
+    for (int i = 0; i < batch; i++)
+    {
+        ret = check_squeezenet_top3(out_batch[i], epsilon);
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+static int test_squeezenet_prepacked(const ncnn::Option& opt, float epsilon = 0.001)
+{
+    const char* prepacked_path = "squeezenet_v1.1.prepacked";
+
+    // transform once and save
+    {
+        ncnn::Net squeezenet;
+        if (load_squeezenet(squeezenet, opt) != 0)
+            return -1;
+
+        int ret = squeezenet.save_prepacked(prepacked_path);
+        if (ret != 0)
+        {
+            fprintf(stderr, "save_prepacked failed %d\n", ret);
+            remove(prepacked_path);
+            return -1;
+        }
+    }
+
+    ncnn::Net squeezenet;
+    int ret = load_squeezenet(squeezenet, opt, prepacked_path);
+    if (ret != 0)
+    {
+        remove(prepacked_path);
+        return ret;
+    }
+
+    // the weight data is referenced from the mapped file when create_pipeline skips the transform
+    // a weight transformed again is allocated and has a refcount
+    int prepacked_layer_count = 0;
+    for (size_t i = 0; i < squeezenet.layers().size(); i++)
+    {
+        std::vector<ncnn::Mat> weights;
+        if (squeezenet.layers()[i]->get_prepacked(weights) != 0)
+            continue;
+
+        for (size_t j = 0; j < weights.size(); j++)
+        {
+            if (!weights[j].empty() && weights[j].refcount)
+            {
+                fprintf(stderr, "layer %d weight %d is not the prepacked one\n", (int)i, (int)j);
+                remove(prepacked_path);
+                return -1;
+            }
+        }
+
+        prepacked_layer_count++;
+    }
+
+    if (prepacked_layer_count == 0)
+    {
+        fprintf(stderr, "no layer takes prepacked weights\n");
+        remove(prepacked_path);
+        return -1;
+    }
+
+    ncnn::Extractor ex = squeezenet.create_extractor();
+
+    ncnn::Mat out;
+    ex.input("data", squeezenet_input());
+    ret = ex.extract("prob", out);
+
+    remove(prepacked_path);
+
+    if (ret != 0)
+    {
+        fprintf(stderr, "extract failed %d\n", ret);
+        return ret;
+    }
+
+    return check_squeezenet_top3(out, epsilon);
+}
+
+static int test_squeezenet_profiling(const ncnn::Option& opt)
+{
+    ncnn::Net squeezenet;
+    if (load_squeezenet(squeezenet, opt) != 0)
+        return -1;
+
+    ncnn::Mat in = squeezenet_input();
+
+    ncnn::Extractor ex = squeezenet.create_extractor();
+    ex.set_profiling(true);
+
+    ncnn::Mat out;
+    ex.input("data", in);
+    ex.extract("prob", out);
+
+    // every layer except the input runs exactly once
+    const std::vector<ncnn::LayerProfile>& profiles = ex.layer_profiles();
+    if (profiles.size() + 1 != squeezenet.layers().size())
+    {
+        fprintf(stderr, "layer_profiles count %d, expect %d\n", (int)profiles.size(), (int)squeezenet.layers().size() - 1);
+        return -1;
+    }
+
+    for (size_t i = 0; i < profiles.size(); i++)
+    {
+        const ncnn::LayerProfile& p = profiles[i];
+        const ncnn::Layer* layer = squeezenet.layers()[p.layer_index];
+        if (p.end < p.start || p.top_shapes.size() != layer->tops.size() || p.bottom_shapes.size() != layer->bottoms.size() || p.top_shapes[0].dims == 0)
+        {
+            fprintf(stderr, "layer_profiles %d invalid\n", p.layer_index);
+            return -1;
+        }
+    }
+
+    // prob is the last layer
+    const ncnn::LayerProfile& last = profiles[profiles.size() - 1];
+    if (last.layer_index != (int)squeezenet.layers().size() - 1 || last.top_shapes[0].w != out.w)
+    {
+        fprintf(stderr, "layer_profiles last %d w=%d, expect %d w=%d\n", last.layer_index, last.top_shapes[0].w, (int)squeezenet.layers().size() - 1, out.w);
+        return -1;
+    }
+#if NCNN_STRING
+    if (last.name != "prob")
+    {
+        fprintf(stderr, "layer_profiles last %s, expect prob\n", last.name.c_str());
+        return -1;
+    }
+#endif // NCNN_STRING
+
+    const char* trace_path = "squeezenet_v1.1.trace.json";
+    int ret = ex.save_chrome_trace(trace_path);
+    if (ret != 0)
+    {
+        fprintf(stderr, "save_chrome_trace failed %d\n", ret);
+        return -1;
+    }
+
+    FILE* fp = fopen(trace_path, "rb");
+    if (!fp)
+    {
+        fprintf(stderr, "save_chrome_trace wrote no %s\n", trace_path);
+        return -1;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    const long trace_size = ftell(fp);
+    fclose(fp);
+    remove(trace_path);
+
+    if (trace_size <= 0)
+    {
+        fprintf(stderr, "save_chrome_trace wrote an empty %s\n", trace_path);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_squeezenet_plan_cache(const ncnn::Option& opt, float epsilon = 0.001)
+{
+    ncnn::Net squeezenet;
+    if (load_squeezenet(squeezenet, opt) != 0)
+        return -1;
+
+    ncnn::Mat in = squeezenet_input();
+
+    // the first run records, the following ones forward in the planned arenas
+    ncnn::Mat out0;
+    const void* planned_data = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        ncnn::Mat out;
+        {
+            ncnn::Extractor ex = squeezenet.create_extractor();
+
+            ex.input("data", in);
+            ex.extract("prob", out);
+        }
+
+        int ret = check_squeezenet_top3(out, epsilon);
+        if (ret != 0)
+            return ret;
+
+        if (squeezenet.plan_cache_count() != 1)
+        {
+            fprintf(stderr, "plan_cache_count %d after run %d, expect 1\n", squeezenet.plan_cache_count(), i);
+            return -1;
+        }
+
+        if (i == 0)
+        {
+            out0 = out.clone();
+            continue;
+        }
+
+        // same input, same kernels, bit identical output
+        if (out.total() != out0.total() || memcmp(out.data, out0.data, out.total() * out.elemsize) != 0)
+        {
+            fprintf(stderr, "plan cache run %d output differs from the recording run\n", i);
+            return -1;
+        }
+
+        // a planned run places the output at the same arena offset again
+        if (i == 1)
+        {
+            planned_data = out.data;
+        }
+        else if (out.data != planned_data)
+        {
+            fprintf(stderr, "plan cache run %d does not reuse the planned arena\n", i);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_squeezenet_session_pool(const ncnn::Option& opt, int worker_count, int max_batch_size, float epsilon = 0.001)
+{
+    ncnn::Net squeezenet;
+    if (load_squeezenet(squeezenet, opt) != 0)
+        return -1;
+
+    // odd requests get a dimmed input, so that a batched output landing on the wrong request shows up
+    ncnn::Mat inputs[2];
+    inputs[0] = squeezenet_input();
+    inputs[1] = inputs[0].clone();
+    {
+        const float norm_vals[3] = {0.8f, 0.8f, 0.8f};
+        inputs[1].substract_mean_normalize(0, norm_vals);
+    }
+
+    // reference output of each input from a plain extractor
+    ncnn::Mat ref_outs[2];
+    for (int i = 0; i < 2; i++)
+    {
+        ncnn::Extractor ex = squeezenet.create_extractor();
+        ex.input("data", inputs[i]);
+        ex.extract("prob", ref_outs[i]);
+    }
+
+    // without batching, more requests than queue slots, so submit waits for the workers
+    // with batching, all requests queue at once so the worker can coalesce them
+    const int request_count = 8;
+    const int queue_capacity = max_batch_size > 1 ? request_count : 2;
+    ncnn::SessionRequest requests[request_count];
+
+    ncnn::SessionPool pool(&squeezenet, worker_count, 1, queue_capacity);
+    pool.set_batching(max_batch_size, 1000.0);
+
+    for (int i = 0; i < request_count; i++)
+    {
+        requests[i].input("data", inputs[i % 2]);
+        requests[i].extract("prob");
+
+        int ret = pool.submit(&requests[i]);
+        if (ret != 0)
+        {
+            fprintf(stderr, "session pool submit %d failed\n", i);
+            return ret;
+        }
+    }
+
+    for (int i = 0; i < request_count; i++)
+    {
+        int ret = requests[i].wait();
+        if (ret != 0)
+            return ret;
+
+        const ncnn::Mat& out = requests[i].outputs()[0];
+
+        if (i % 2 == 0)
+        {
+            ret = check_squeezenet_top3(out, epsilon);
+            if (ret != 0)
+                return ret;
+        }
+
+        if (CompareMat(out, ref_outs[i % 2], 0.001) != 0)
+        {
+            fprintf(stderr, "session pool request %d batch_size %d differs from the single request output\n", i, requests[i].batch_size());
+            return -1;
+        }
+    }
+
+    const ncnn::SessionPoolStat stat = pool.stat();
+    if (stat.request_count != request_count || stat.max_batch_size > max_batch_size)
+    {
+        fprintf(stderr, "session pool stat request_count %d max_batch_size %d, expect %d %d\n", stat.request_count, stat.max_batch_size, request_count, max_batch_size);
+        return -1;
+    }
+
+    // the single worker finds the other requests queued while holding the first one
+    if (max_batch_size > 1 && stat.max_batch_size <= 1)
+    {
+        fprintf(stderr, "session pool coalesced no requests, max_batch_size %d\n", stat.max_batch_size);
+        return -1;
+    }
+
+    return 0;
+}
+
 int main()
 {
 #ifdef __EMSCRIPTEN__
@@ -315,5 +708,164 @@ int main()
 #endif // NCNN_VULKAN
     }
 
+    // inter-layer parallel forward on fire modules
+    {
+        ncnn::Option opt;
+        opt.num_threads = 4;
+        opt.use_parallel_layer_forward = true;
+        opt.use_vulkan_compute = false;
+
+        int ret = test_squeezenet(opt, 0, 0.01);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet cpu failed use_parallel_layer_forward=%d num_threads=%d\n", opt.use_parallel_layer_forward, opt.num_threads);
+            return ret;
+        }
+    }
+
+    // batched forward through one extractor
+    {
+        ncnn::Option opt;
+        opt.use_vulkan_compute = false;
+
+        int ret = test_squeezenet_batch(opt, 4, 0.01);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_batch cpu failed batch=%d\n", 4);
+            return ret;
+        }
+    }
+
+    // weights referenced from the mapped model file
+    {
+        ncnn::Option opt;
+        opt.use_mmap_model = true;
+        opt.use_vulkan_compute = false;
+
+        int ret = test_squeezenet(opt, 0);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet cpu failed use_mmap_model=%d\n", opt.use_mmap_model);
+            return ret;
+        }
+    }
+
+    // transformed weights saved and reused
+    {
+        ncnn::Option opt;
+        opt.use_vulkan_compute = false;
+
+        int ret = test_squeezenet_prepacked(opt);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_prepacked cpu failed\n");
+            return ret;
+        }
+    }
+
+    // per-layer records on serial and inter-layer parallel forward
+    for (int i = 0; i < 2; i++)
+    {
+        ncnn::Option opt;
+        opt.use_vulkan_compute = false;
+        opt.use_parallel_layer_forward = i == 1;
+        opt.num_threads = 4;
+
+        int ret = test_squeezenet_profiling(opt);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_profiling cpu failed use_parallel_layer_forward=%d\n", opt.use_parallel_layer_forward);
+            return ret;
+        }
+    }
+
+    // repeated inference of one input shape through the plan cache
+    {
+        ncnn::Option opt;
+        opt.use_shape_plan_cache = true;
+        opt.use_vulkan_compute = false;
+
+        int ret = test_squeezenet_plan_cache(opt);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_plan_cache cpu failed use_shape_plan_cache=%d\n", opt.use_shape_plan_cache);
+            return ret;
+        }
+    }
+
+    // requests from a bounded queue served by recycled extractors, alone and coalesced into batches
+    for (int i = 0; i < 2; i++)
+    {
+        ncnn::Option opt;
+        opt.use_vulkan_compute = false;
+
+        const int worker_count = i == 0 ? 2 : 1;
+        const int max_batch_size = i == 0 ? 1 : 4;
+
+        int ret = test_squeezenet_session_pool(opt, worker_count, max_batch_size, 0.01);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_session_pool cpu failed worker_count=%d max_batch_size=%d\n", worker_count, max_batch_size);
+            return ret;
+        }
+    }
+
+    // concurrent extractors leasing cores from one shared thread pool
+    {
+        ncnn::CpuSet cpuset;
+        for (int i = 0; i < 4; i++)
+        {
+            cpuset.enable(i);
+        }
+
+        ncnn::ThreadPool thread_pool(cpuset);
+
+        ncnn::Option opt;
+        opt.use_vulkan_compute = false;
+        opt.thread_pool = &thread_pool;
+
+        int ret = test_squeezenet_session_pool(opt, 2, 1, 0.01);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_session_pool cpu failed thread_pool cpu_count=%d\n", thread_pool.cpu_count());
+            return ret;
+        }
+
+        if (thread_pool.free_cpu_count() != thread_pool.cpu_count())
+        {
+            fprintf(stderr, "thread pool free_cpu_count %d, expect %d\n", thread_pool.free_cpu_count(), thread_pool.cpu_count());
+            return -1;
+        }
+
+#if defined __ANDROID__ || defined __linux__
+        // a pinned extract gives the caller its affinity back
+        thread_pool.set_cpu_pinning(true);
+
+        ncnn::CpuSet affinity_mask_before;
+        ncnn::get_cpu_thread_affinity(affinity_mask_before);
+
+        ncnn::Net squeezenet;
+        if (load_squeezenet(squeezenet, opt) != 0)
+            return -1;
+
+        ncnn::Extractor ex = squeezenet.create_extractor();
+        ex.input("data", squeezenet_input());
+
+        ncnn::Mat out;
+        ret = ex.extract("prob", out);
+        if (ret != 0)
+            return ret;
+
+        ncnn::CpuSet affinity_mask_after;
+        ncnn::get_cpu_thread_affinity(affinity_mask_after);
+
+        if (memcmp(&affinity_mask_before.cpu_set, &affinity_mask_after.cpu_set, sizeof(cpu_set_t)) != 0)
+        {
+            fprintf(stderr, "thread pool pinning left %d cores in the affinity, expect %d\n", affinity_mask_after.num_enabled(), affinity_mask_before.num_enabled());
+            return -1;
+        }
+#endif
+    }
+
     return 0;
 }
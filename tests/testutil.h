@@ -415,7 +415,12 @@ int test_layer_cpu(int typeindex, const ncnn::ParamDict& pd, const std::vector<n
 
             if (elembits == 32)
             {
-#if (NCNN_AVX2 || NCNN_AVX)
+#if (NCNN_AVX512 || NCNN_AVX2 || NCNN_AVX)
+#if NCNN_AVX512
+                if (elemcount % 16 == 0 && op->support_avx512_pack16 && ncnn::cpu_support_x86_avx512())
+                    dst_elempack = 16;
+                else
+#endif
                 if (elemcount % 8 == 0 && (ncnn::cpu_support_x86_avx2() || ncnn::cpu_support_x86_avx()))
                     dst_elempack = 8;
                 else if (elemcount % 4 == 0)
@@ -440,6 +445,16 @@ int test_layer_cpu(int typeindex, const ncnn::ParamDict& pd, const std::vector<n
                 const int packn = ncnn::cpu_riscv_vlenb() / 2;
                 if (elemcount % packn == 0)
                     dst_elempack = packn;
+#elif (NCNN_AVX512 || NCNN_AVX2 || NCNN_AVX)
+#if NCNN_AVX512
+                if (elemcount % 16 == 0 && op->support_avx512_pack16 && ncnn::cpu_support_x86_avx512())
+                    dst_elempack = 16;
+                else
+#endif
+                if (elemcount % 8 == 0 && (ncnn::cpu_support_x86_avx2() || ncnn::cpu_support_x86_avx()))
+                    dst_elempack = 8;
+                else if (elemcount % 4 == 0)
+                    dst_elempack = 4;
 #else
                 if (elemcount % 4 == 0)
                     dst_elempack = 4;
@@ -834,7 +849,12 @@ int test_layer_cpu(int typeindex, const ncnn::ParamDict& pd, const std::vector<n
 
         if (elembits == 32)
         {
-#if (NCNN_AVX2 || NCNN_AVX)
+#if (NCNN_AVX512 || NCNN_AVX2 || NCNN_AVX)
+#if NCNN_AVX512
+            if (elemcount % 16 == 0 && op->support_avx512_pack16 && ncnn::cpu_support_x86_avx512())
+                dst_elempack = 16;
+            else
+#endif
             if (elemcount % 8 == 0 && (ncnn::cpu_support_x86_avx2() || ncnn::cpu_support_x86_avx()))
                 dst_elempack = 8;
             else if (elemcount % 4 == 0)
@@ -859,6 +879,16 @@ int test_layer_cpu(int typeindex, const ncnn::ParamDict& pd, const std::vector<n
             const int packn = ncnn::cpu_riscv_vlenb() / 2;
             if (elemcount % packn == 0)
                 dst_elempack = packn;
+#elif (NCNN_AVX512 || NCNN_AVX2 || NCNN_AVX)
+#if NCNN_AVX512
+            if (elemcount % 16 == 0 && op->support_avx512_pack16 && ncnn::cpu_support_x86_avx512())
+                dst_elempack = 16;
+            else
+#endif
+            if (elemcount % 8 == 0 && (ncnn::cpu_support_x86_avx2() || ncnn::cpu_support_x86_avx()))
+                dst_elempack = 8;
+            else if (elemcount % 4 == 0)
+                dst_elempack = 4;
 #else
             if (elemcount % 4 == 0)
                 dst_elempack = 4;